@@ -12,6 +12,7 @@ extern "C" {
 }
 
 #include "sai_redis_internal.h"
+#include "sairedis.h"
 
 #include "swss/redisclient.h"
 #include "swss/dbconnector.h"
@@ -22,6 +23,7 @@ extern "C" {
 #include "swss/table.h"
 #include "swss/select.h"
 #include "swss/logger.h"
+#include "swss/recorder.h"
 #include "meta/sai_meta.h"
 
 /*
@@ -32,6 +34,7 @@ extern "C" {
 #define MAX_SWITCHES 0x100
 
 void redis_clear_switch_ids();
+void redis_clear_virtual_object_ids();
 void redis_free_virtual_object_id(
         _In_ sai_object_id_t object_id);
 
@@ -58,10 +61,13 @@ extern std::string joinFieldValues(
 extern volatile bool g_record;
 extern volatile bool g_useTempView;
 extern volatile bool g_asicInitViewMode;
-extern volatile bool g_logrotate;
+extern volatile bool g_recordBinary;
+
+extern swss::Recorder g_recorder;
 
 extern service_method_table_t                       g_services;
 extern std::shared_ptr<swss::ProducerTable>         g_asicState;
+extern std::shared_ptr<swss::ProducerTable>         g_redisGetRequest;
 extern std::shared_ptr<swss::ConsumerTable>         g_redisGetConsumer;
 extern std::shared_ptr<swss::NotificationConsumer>  g_redisNotifications;
 extern std::shared_ptr<swss::RedisClient>           g_redisClient;
@@ -154,8 +160,19 @@ sai_status_t internal_redis_bulk_generic_create(
         _In_ const std::vector<std::string> &serialized_object_ids,
         _In_ const uint32_t *attr_count,
         _In_ const sai_attribute_t *const *attr_list,
+        _In_ bool wait,
         _Inout_ sai_status_t *object_statuses);
 
+sai_status_t internal_redis_bulk_object_create(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t *const *attrs,
+        _In_ sai_bulk_op_type_t type,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses);
+
 // REMOVE
 
 sai_status_t redis_generic_remove(
@@ -171,6 +188,26 @@ sai_status_t redis_generic_remove_neighbor_entry(
 sai_status_t redis_generic_remove_route_entry(
         _In_ const sai_route_entry_t* route_entry);
 
+sai_status_t internal_redis_bulk_generic_remove(
+        _In_ sai_object_type_t object_type,
+        _In_ const std::vector<std::string> &serialized_object_ids,
+        _In_ bool wait,
+        _Inout_ sai_status_t *object_statuses);
+
+sai_status_t internal_redis_bulk_object_remove(
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_type_t type,
+        _Out_ sai_status_t *object_statuses);
+
+/*
+ * Passed to metadata to remove objects already removed by a bulk call.
+ */
+sai_status_t redis_dummy_remove_bulk_object(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_object_id_t object_id);
+
 // SET
 
 sai_status_t redis_generic_set(
@@ -194,7 +231,8 @@ sai_status_t internal_redis_bulk_generic_set(
         _In_ sai_object_type_t object_type,
         _In_ const std::vector<std::string> &serialized_object_ids,
         _In_ const sai_attribute_t *attr_list,
-        _In_ const sai_status_t *object_statuses);
+        _In_ bool wait,
+        _Inout_ sai_status_t *object_statuses);
 
 // GET
 
@@ -219,6 +257,80 @@ sai_status_t redis_generic_get_route_entry(
         _In_ uint32_t attr_count,
         _Out_ sai_attribute_t *attr_list);
 
+bool internal_redis_bulk_op_type(
+        _Inout_ sai_bulk_op_type_t &type,
+        _Out_ bool &wait);
+
+uint64_t internal_redis_bulk_request_id(
+        _In_ bool wait);
+
+std::string internal_redis_bulk_op(
+        _In_ const std::string &op,
+        _In_ uint64_t request_id);
+
+sai_status_t internal_redis_bulk_wait_response(
+        _In_ size_t object_count,
+        _In_ size_t sent_count,
+        _In_ uint64_t request_id,
+        _Inout_ sai_status_t *object_statuses);
+
+sai_status_t internal_redis_get_process(
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t attr_count,
+        _Out_ sai_attribute_t *attr_list,
+        _In_ swss::KeyOpFieldsValuesTuple &kco);
+
+void clear_oid_values(
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t attr_count,
+        _Out_ sai_attribute_t *attr_list);
+
+// GET RESPONSES
+
+void start_get_response_thread();
+void stop_get_response_thread();
+
+/*
+ * Ordering of the gets sent on GETREQUEST with the operations written to
+ * ASIC_STATE, each write must be tracked once it is written.
+ */
+
+void internal_redis_track_write();
+
+void internal_redis_track_object(
+        _In_ sai_object_type_t object_type,
+        _In_ const std::string &serialized_object_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list);
+
+void internal_redis_track_remove(
+        _In_ sai_object_type_t object_type,
+        _In_ const std::string &serialized_object_id);
+
+void internal_redis_reset_get_sequence(
+        _In_ bool synced);
+
+bool internal_redis_get_sequence_synced();
+
+void internal_redis_set_get_binary_encoding(
+        _In_ bool binary);
+
+uint64_t internal_redis_send_get_request(
+        _In_ sai_object_type_t object_type,
+        _In_ const std::string &serialized_object_id,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t *attr_list,
+        _In_ sai_redis_get_response_fn callback,
+        _In_ void *context);
+
+bool internal_redis_wait_get_response(
+        _In_ uint64_t request_id,
+        _Out_ swss::KeyOpFieldsValuesTuple &kco);
+
+bool internal_redis_wait_response(
+        _In_ const std::string &op,
+        _Out_ swss::KeyOpFieldsValuesTuple &kco);
+
 // notifications
 
 void handle_notification(
@@ -9,6 +9,14 @@ extern "C" {
 #define SYNCD_APPLY_VIEW "APPLY_VIEW"
 #define ASIC_STATE_TABLE "ASIC_STATE"
 #define TEMP_PREFIX      "TEMP_"
+#define GET_REQUEST_TABLE  "GETREQUEST"
+#define GET_RESPONSE_TABLE "GETRESPONSE"
+
+/*
+ * Field of notify and of its response with the version of the binary
+ * encoding of gets supported by sairedis and syncd.
+ */
+#define SYNCD_BINARY_ENCODING "BINARY_ENCODING"
 
 typedef enum _sai_redis_notify_syncd_t
 {
@@ -85,8 +93,8 @@ typedef enum _sai_redis_switch_attr_t
     /**
      * @brief Log rotate.
      *
-     * This is action attribute. When set to true then at the next log line
-     * write it will close recording file and open it again. This is desired
+     * This is action attribute. When set to true then recording thread will
+     * close recording file and open it again. This is desired
      * when doing log rotate, since sairedis holds handle to recording file for
      * performance reasons. We are assuming logrotate will move recording file
      * to ".n" suffix, and when we reopen file, we will actually create new
@@ -101,6 +109,21 @@ typedef enum _sai_redis_switch_attr_t
      */
     SAI_REDIS_SWITCH_ATTR_PERFORM_LOG_ROTATE,
 
+    /**
+     * @brief Recording format.
+     *
+     * When set to true recording is written in binary format to
+     * sairedis.rec.bin, which is smaller and cheaper to write. Use
+     * swssrecconvert to convert it to text format for saiplayer.
+     *
+     * It will have only impact on next created recording.
+     *
+     * @type bool
+     * @flags CREATE_AND_SET
+     * @default false
+     */
+    SAI_REDIS_SWITCH_ATTR_RECORDING_BINARY,
+
 } sai_redis_switch_attr_t;
 
 /*
@@ -110,9 +133,26 @@ typedef enum _sai_redis_switch_attr_t
  * in syncd bulk API will be splitted to separate call's until proper SDK
  * support will be added.
  *
- * Currently bulk operation type is skipped, and all operation must end with
- * success.
+ * Syncd executes every object of a bulk operation even if some of them fail,
+ * see SAI_REDIS_BULK_OP_TYPE_WAIT_RESPONSE to get per object statuses back.
+ * Operation type is only applied to metadata check.
+ */
+
+/**
+ * @brief Bulk operation type flag, wait for syncd to execute the objects.
+ *
+ * When OR-ed with bulk operation type, the call waits until syncd executed
+ * the objects which passed metadata check and returns the status syncd got
+ * for each of them. Objects which failed in syncd are reverted in metadata,
+ * so caller can retry them. If syncd doesn't respond in time, objects keep
+ * their metadata status and stay in metadata as sent.
+ *
+ * Without it bulk calls only return metadata statuses.
  */
+#define SAI_REDIS_BULK_OP_TYPE_WAIT_RESPONSE 0x100
+
+#define SAI_REDIS_BULK_OP_TYPE_WAIT(type) \
+    ((sai_bulk_op_type_t)((type) | SAI_REDIS_BULK_OP_TYPE_WAIT_RESPONSE))
 
 #ifndef SAI_STATUS_NOT_EXECUTED
 #define SAI_STATUS_NOT_EXECUTED                     SAI_STATUS_CODE(0x00000017L)
@@ -232,4 +272,115 @@ sai_status_t redis_bulk_object_remove_next_hop_group_members(
         _In_ sai_bulk_op_type_t type,
         _Out_ sai_status_t *object_statuses);
 
+/**
+ * @brief Bulk create ACL entry
+ *
+ * @param[in] switch_id Switch id
+ * @param[in] object_count Number of objects to create
+ * @param[in] attr_count List of attr_count. Caller passes the number
+ *    of attribute for each object to create.
+ * @param[in] attr_list List of attributes for every object.
+ * @param[in] type Bulk operation type.
+ * @param[out] object_id List of object ids returned, null for objects
+ *    which failed
+ * @param[out] object_statuses List of status for every object. Caller needs to
+ * allocate the buffer
+ *
+ * @return #SAI_STATUS_SUCCESS on success when all objects are created or
+ * #SAI_STATUS_FAILURE when any of the objects fails to create.
+ */
+sai_status_t redis_bulk_object_create_acl_entries(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t *const *attr_list,
+        _In_ sai_bulk_op_type_t type,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses);
+
+/**
+ * @brief Bulk remove ACL entry
+ *
+ * @param[in] object_count Number of objects to remove
+ * @param[in] object_id List of objects to remove
+ * @param[in] type Bulk operation type.
+ * @param[out] object_statuses List of status for every object. Caller needs to
+ * allocate the buffer
+ *
+ * @return #SAI_STATUS_SUCCESS on success when all objects are removed or
+ * #SAI_STATUS_FAILURE when any of the objects fails to remove.
+ */
+sai_status_t redis_bulk_object_remove_acl_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_type_t type,
+        _Out_ sai_status_t *object_statuses);
+
+/**
+ * @brief Bulk create ACL counter, same as #redis_bulk_object_create_acl_entries
+ */
+sai_status_t redis_bulk_object_create_acl_counters(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t *const *attr_list,
+        _In_ sai_bulk_op_type_t type,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses);
+
+/**
+ * @brief Bulk remove ACL counter, same as #redis_bulk_object_remove_acl_entries
+ */
+sai_status_t redis_bulk_object_remove_acl_counters(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_type_t type,
+        _Out_ sai_status_t *object_statuses);
+
+/**
+ * @brief Asynchronous get response callback
+ *
+ * Called from the sairedis get response thread when the response of the
+ * get is received or the get times out. SAI APIs must not be called from
+ * it, since the thread may be delivering the response they wait for.
+ *
+ * @param[in] context Context passed to the get
+ * @param[in] status Status of the get
+ * @param[in] attr_count Number of attributes
+ * @param[in] attr_list Attribute list passed to the get, filled on success
+ */
+typedef void (*sai_redis_get_response_fn)(
+        _In_ void *context,
+        _In_ sai_status_t status,
+        _In_ uint32_t attr_count,
+        _In_ sai_attribute_t *attr_list);
+
+/**
+ * @brief Get attributes of an object without waiting for the response
+ *
+ * Several gets can be in flight at once, syncd serves them before the
+ * operations queued in ASIC_STATE except the ones on the same object which
+ * were issued before the get. Object ids returned are not validated against
+ * the local metadata.
+ *
+ * Available once syncd was notified with SAI_REDIS_SWITCH_ATTR_NOTIFY_SYNCD.
+ *
+ * @param[in] object_type Object type
+ * @param[in] object_id Object id
+ * @param[in] attr_count Number of attributes
+ * @param[inout] attr_list Attribute list, must stay valid until the callback
+ * @param[in] callback Called once with the result when the get is sent
+ * @param[in] context Passed to the callback
+ *
+ * @return #SAI_STATUS_SUCCESS if the get was sent, failure status code
+ * otherwise and the callback is not called.
+ */
+sai_status_t sai_redis_get_attribute_async(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_object_id_t object_id,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t *attr_list,
+        _In_ sai_redis_get_response_fn callback,
+        _In_ void *context);
+
 #endif // __SAIREDIS__
@@ -1,5 +1,89 @@
 #include "sai_redis.h"
 
+sai_status_t redis_bulk_object_create_acl_entries(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t *const *attr_list,
+        _In_ sai_bulk_op_type_t type,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+{
+    MUTEX();
+
+    SWSS_LOG_ENTER();
+
+    return internal_redis_bulk_object_create(
+            SAI_OBJECT_TYPE_ACL_ENTRY,
+            switch_id,
+            object_count,
+            attr_count,
+            attr_list,
+            type,
+            object_id,
+            object_statuses);
+}
+
+sai_status_t redis_bulk_object_remove_acl_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_type_t type,
+        _Out_ sai_status_t *object_statuses)
+{
+    MUTEX();
+
+    SWSS_LOG_ENTER();
+
+    return internal_redis_bulk_object_remove(
+            SAI_OBJECT_TYPE_ACL_ENTRY,
+            object_count,
+            object_id,
+            type,
+            object_statuses);
+}
+
+sai_status_t redis_bulk_object_create_acl_counters(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t *const *attr_list,
+        _In_ sai_bulk_op_type_t type,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+{
+    MUTEX();
+
+    SWSS_LOG_ENTER();
+
+    return internal_redis_bulk_object_create(
+            SAI_OBJECT_TYPE_ACL_COUNTER,
+            switch_id,
+            object_count,
+            attr_count,
+            attr_list,
+            type,
+            object_id,
+            object_statuses);
+}
+
+sai_status_t redis_bulk_object_remove_acl_counters(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_type_t type,
+        _Out_ sai_status_t *object_statuses)
+{
+    MUTEX();
+
+    SWSS_LOG_ENTER();
+
+    return internal_redis_bulk_object_remove(
+            SAI_OBJECT_TYPE_ACL_COUNTER,
+            object_count,
+            object_id,
+            type,
+            object_statuses);
+}
+
 REDIS_GENERIC_QUAD(ACL_TABLE,acl_table);
 REDIS_GENERIC_QUAD(ACL_ENTRY,acl_entry);
 REDIS_GENERIC_QUAD(ACL_COUNTER,acl_counter);
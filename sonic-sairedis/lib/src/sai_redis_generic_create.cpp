@@ -1,9 +1,24 @@
 #include "sai_redis.h"
 #include "meta/saiserialize.h"
 #include "meta/saiattributelist.h"
+#include "meta/saividallocator.h"
 
 bool switch_ids[MAX_SWITCHES] = {};
 
+/*
+ * Virtual ids are leased from VIDCOUNTER in ranges, not one INCR per
+ * object, syncd leases the ids of the objects it discovers the same way.
+ */
+
+SaiVidAllocator g_vidAllocator("VIDCOUNTER");
+
+void redis_clear_virtual_object_ids()
+{
+    SWSS_LOG_ENTER();
+
+    g_vidAllocator.reset();
+}
+
 void redis_clear_switch_ids()
 {
     SWSS_LOG_ENTER();
@@ -177,7 +192,7 @@ sai_object_id_t redis_create_virtual_object_id(
 
     int index = redis_get_switch_id_index(switch_id);
 
-    uint64_t virtual_id = g_redisClient->incr("VIDCOUNTER");
+    uint64_t virtual_id = g_vidAllocator.allocate(*g_redisClient);
 
     sai_object_id_t object_id = redis_construct_object_id(object_type, index, virtual_id);
 
@@ -233,6 +248,9 @@ sai_status_t internal_redis_generic_create(
 
     g_asicState->set(key, entry, "create");
 
+    internal_redis_track_write();
+    internal_redis_track_object(object_type, serialized_object_id, attr_count, attr_list);
+
     // we assume create will always succeed which may not be true
     // we should make this synchronous call
     return SAI_STATUS_SUCCESS;
@@ -302,6 +320,7 @@ sai_status_t redis_bulk_generic_create(
             serialized_object_ids,
             attr_count,
             attr_list,
+            false,
             object_statuses);
 }
 
@@ -310,6 +329,7 @@ sai_status_t internal_redis_bulk_generic_create(
         _In_ const std::vector<std::string> &serialized_object_ids,
         _In_ const uint32_t *attr_count,
         _In_ const sai_attribute_t *const *attr_list,
+        _In_ bool wait,
         _Inout_ sai_status_t *object_statuses)
 {
     SWSS_LOG_ENTER();
@@ -317,7 +337,7 @@ sai_status_t internal_redis_bulk_generic_create(
     std::string str_object_type = sai_serialize_object_type(object_type);
 
     std::vector<swss::FieldValueTuple> entries;
-    std::vector<swss::FieldValueTuple> entriesWithStatus;
+    std::vector<std::string> str_attrs;
 
     /*
      * We are recording all entries and their statuses, but we send to sairedis
@@ -333,19 +353,13 @@ sai_status_t internal_redis_bulk_generic_create(
 
         std::string str_attr = joinFieldValues(entry);
 
-        std::string str_status = sai_serialize_status(object_statuses[idx]);
-
-        std::string joined = str_attr + "|" + str_status;
-
-        swss::FieldValueTuple fvt(serialized_object_ids[idx] , joined);
-
-        entriesWithStatus.push_back(fvt);
+        str_attrs.push_back(str_attr);
 
         if (object_statuses[idx] != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_WARN("skipping %s since status is %s",
                     serialized_object_ids[idx].c_str(),
-                    str_status.c_str());
+                    sai_serialize_status(object_statuses[idx]).c_str());
 
             continue;
         }
@@ -360,15 +374,43 @@ sai_status_t internal_redis_bulk_generic_create(
      * with previous
      */
 
+    // key:         object_type:count
+    // field:       object_id
+    // value:       object_attrs
+    std::string key = str_object_type + ":" + std::to_string(entries.size());
+
+    uint64_t request_id = internal_redis_bulk_request_id(wait);
+
+    if (entries.size())
+    {
+        g_asicState->set(key, entries, internal_redis_bulk_op("bulkcreate", request_id));
+
+        internal_redis_track_write();
+
+        for (size_t idx = 0; idx < serialized_object_ids.size(); ++idx)
+        {
+            if (object_statuses[idx] == SAI_STATUS_SUCCESS)
+            {
+                internal_redis_track_object(object_type, serialized_object_ids[idx], attr_count[idx], attr_list[idx]);
+            }
+        }
+    }
+
+    sai_status_t status = internal_redis_bulk_wait_response(
+            serialized_object_ids.size(),
+            entries.size(),
+            request_id,
+            object_statuses);
+
     if (g_record)
     {
         std::string joined;
 
-        for (const auto &e: entriesWithStatus)
+        for (size_t idx = 0; idx < serialized_object_ids.size(); ++idx)
         {
             // ||obj_id|attr=val|attr=val|status||obj_id|attr=val|attr=val|status
 
-            joined += "||" + fvField(e) + "|" + fvValue(e);
+            joined += "||" + serialized_object_ids[idx] + "|" + str_attrs[idx] + "|" + sai_serialize_status(object_statuses[idx]);
         }
 
         /*
@@ -378,17 +420,7 @@ sai_status_t internal_redis_bulk_generic_create(
         recordLine("C|" + str_object_type + joined);
     }
 
-    // key:         object_type:count
-    // field:       object_id
-    // value:       object_attrs
-    std::string key = str_object_type + ":" + std::to_string(entries.size());
-
-    if (entries.size())
-    {
-        g_asicState->set(key, entries, "bulkcreate");
-    }
-
-    return SAI_STATUS_SUCCESS;
+    return status;
 }
 
 sai_status_t redis_generic_create_fdb_entry(
@@ -438,3 +470,116 @@ sai_status_t redis_generic_create_route_entry(
             attr_count,
             attr_list);
 }
+
+static sai_status_t redis_dummy_create_bulk_object(
+        _In_ sai_object_type_t object_type,
+        _Out_ sai_object_id_t *object_id,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Objects are validated one by one but sent to syncd in bulk, so only
+     * virtual id is created here.
+     */
+
+    *object_id = redis_create_virtual_object_id(object_type, switch_id);
+
+    if (*object_id == SAI_NULL_OBJECT_ID)
+    {
+        SWSS_LOG_ERROR("failed to create %s, with switch id: %s",
+                sai_serialize_object_type(object_type).c_str(),
+                sai_serialize_object_id(switch_id).c_str());
+
+        return SAI_STATUS_INSUFFICIENT_RESOURCES;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t internal_redis_bulk_object_create(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t *const *attrs,
+        _In_ sai_bulk_op_type_t type,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+{
+    SWSS_LOG_ENTER();
+
+    bool wait;
+
+    if (!internal_redis_bulk_op_type(type, wait))
+    {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    std::vector<std::string> serialized_object_ids;
+
+    for (uint32_t idx = 0; idx < object_count; ++idx)
+    {
+        object_statuses[idx] = SAI_STATUS_NOT_EXECUTED;
+        object_id[idx] = SAI_NULL_OBJECT_ID;
+    }
+
+    for (uint32_t idx = 0; idx < object_count; ++idx)
+    {
+        object_statuses[idx] = meta_sai_create_oid(
+                object_type,
+                &object_id[idx],
+                switch_id,
+                attr_count[idx],
+                attrs[idx],
+                &redis_dummy_create_bulk_object);
+
+        if (object_statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("failed on index %u", idx);
+
+            if (type == SAI_BULK_OP_TYPE_STOP_ON_ERROR)
+            {
+                SWSS_LOG_NOTICE("stop on error since previous operation failed");
+                break;
+            }
+        }
+    }
+
+    for (uint32_t idx = 0; idx < object_count; ++idx)
+    {
+        serialized_object_ids.push_back(sai_serialize_object_id(object_id[idx]));
+    }
+
+    std::vector<sai_status_t> meta_statuses(object_statuses, object_statuses + object_count);
+
+    sai_status_t status = internal_redis_bulk_generic_create(
+            object_type,
+            serialized_object_ids,
+            attr_count,
+            attrs,
+            wait,
+            object_statuses);
+
+    for (uint32_t idx = 0; idx < object_count; ++idx)
+    {
+        if (meta_statuses[idx] == SAI_STATUS_SUCCESS && object_statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            /*
+             * Syncd failed to create this object, remove it from metadata
+             * to release the references it holds.
+             */
+
+            meta_sai_remove_oid(
+                    object_type,
+                    object_id[idx],
+                    &redis_dummy_remove_bulk_object);
+
+            object_id[idx] = SAI_NULL_OBJECT_ID;
+        }
+    }
+
+    return status;
+}
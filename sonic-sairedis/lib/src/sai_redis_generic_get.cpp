@@ -1,6 +1,7 @@
 #include "sai_redis.h"
 #include "meta/saiserialize.h"
 #include "meta/saiattributelist.h"
+#include "meta/saiserializebinary.h"
 
 sai_status_t internal_redis_get_process(
         _In_ sai_object_type_t object_type,
@@ -23,53 +24,31 @@ sai_status_t internal_redis_get_process(
 
     sai_deserialize_status(str_sai_status, status);
 
+    // attributes of binary gets are all in one value
+    bool binary = (values.size() == 1 && fvField(values[0]) == SAI_SERIALIZE_BINARY_ATTR_LIST);
+
     // we could deserialize directly to user data, but list is alocated by deserializer
     if (status == SAI_STATUS_SUCCESS)
     {
-        SaiAttributeList list(object_type, values, false);
+        std::shared_ptr<SaiAttributeList> list = binary
+            ? std::make_shared<SaiAttributeList>(object_type, fvValue(values[0]), false)
+            : std::make_shared<SaiAttributeList>(object_type, values, false);
 
-        transfer_attributes(object_type, attr_count, list.get_attr_list(), attr_list, false);
+        transfer_attributes(object_type, attr_count, list->get_attr_list(), attr_list, false);
     }
     else if (status == SAI_STATUS_BUFFER_OVERFLOW)
     {
-        SaiAttributeList list(object_type, values, true);
+        std::shared_ptr<SaiAttributeList> list = binary
+            ? std::make_shared<SaiAttributeList>(object_type, fvValue(values[0]), true)
+            : std::make_shared<SaiAttributeList>(object_type, values, true);
 
         // no need for id fix since this is overflow
-        transfer_attributes(object_type, attr_count, list.get_attr_list(), attr_list, true);
+        transfer_attributes(object_type, attr_count, list->get_attr_list(), attr_list, true);
     }
 
     return status;
 }
 
-std::string getSelectResultAsString(int result)
-{
-    SWSS_LOG_ENTER();
-
-    std::string res;
-
-    switch (result)
-    {
-        case swss::Select::FD:
-            res = "FD";
-            break;
-
-        case swss::Select::ERROR:
-            res = "ERROR";
-            break;
-
-        case swss::Select::TIMEOUT:
-            res = "TIMEOUT";
-            break;
-
-        default:
-            SWSS_LOG_WARN("non recognized select result: %d", result);
-            res = std::to_string(result);
-            break;
-    }
-
-    return res;
-}
-
 void clear_oid_values(
         _In_ sai_object_type_t object_type,
         _In_ uint32_t attr_count,
@@ -157,99 +136,210 @@ sai_status_t internal_redis_generic_get(
 {
     SWSS_LOG_ENTER();
 
-    /*
-     * Since user may reuse buffers, then oid list buffers maybe not cleared
-     * and contain som garbage, let's clean them so we send all oids as null to
-     * syncd.
-     */
+    swss::KeyOpFieldsValuesTuple kco;
+
+    bool received;
+
+    if (internal_redis_get_sequence_synced())
+    {
+        uint64_t request_id = internal_redis_send_get_request(
+                object_type,
+                serialized_object_id,
+                attr_count,
+                attr_list,
+                NULL,
+                NULL);
+
+        /*
+         * API lock stays held while waiting, metadata must not change before
+         * the response is processed. Callers which don't want to wait use
+         * sai_redis_get_attribute_async.
+         */
+
+        received = internal_redis_wait_get_response(request_id, kco);
+    }
+    else
+    {
+        /*
+         * Before syncd is notified the get can't be ordered with the
+         * operations in ASIC_STATE, send it there.
+         */
 
-    clear_oid_values(object_type, attr_count, attr_list);
+        clear_oid_values(object_type, attr_count, attr_list);
 
-    std::vector<swss::FieldValueTuple> entry = SaiAttributeList::serialize_attr_list(
+        std::vector<swss::FieldValueTuple> entry = SaiAttributeList::serialize_attr_list(
+                object_type,
+                attr_count,
+                attr_list,
+                false);
+
+        std::string str_object_type = sai_serialize_object_type(object_type);
+
+        std::string key = str_object_type + ":" + serialized_object_id;
+
+        SWSS_LOG_DEBUG("generic get key: %s, fields: %lu", key.c_str(), entry.size());
+
+        if (g_record)
+        {
+            recordLine("g|" + key + "|" + joinFieldValues(entry));
+        }
+
+        // get is special, it will not put data
+        // into asic view, only to message queue
+        g_asicState->set(key, entry, "get");
+
+        internal_redis_track_write();
+
+        received = internal_redis_wait_response("getresponse", kco);
+
+        if (g_record)
+        {
+            // first serialized is status
+            recordLine(received ? "G|" + kfvKey(kco) + "|" + joinFieldValues(kfvFieldsValues(kco)) : "G|SAI_STATUS_FAILURE");
+        }
+    }
+
+    if (!received)
+    {
+        SWSS_LOG_ERROR("generic get failed to get response");
+
+        return SAI_STATUS_FAILURE;
+    }
+
+    sai_status_t status = internal_redis_get_process(
             object_type,
             attr_count,
             attr_list,
-            false);
+            kco);
+
+    SWSS_LOG_DEBUG("generic get status: %d", status);
+
+    return status;
+}
+
+/*
+ * Bulk operations send to syncd only the objects which succeeded metadata
+ * check, syncd responds with status of each of them in the same order.
+ *
+ * Operations which wait for the response are tagged "<op>:<request_id>" and
+ * syncd responds with "bulkresponse:<request_id>", so a late response of an
+ * operation which timed out is not taken for the response of the next one.
+ */
+
+static uint64_t g_bulkRequestId = 0;
+
+bool internal_redis_bulk_op_type(
+        _Inout_ sai_bulk_op_type_t &type,
+        _Out_ bool &wait)
+{
+    SWSS_LOG_ENTER();
 
-    std::string str_object_type = sai_serialize_object_type(object_type);
+    wait = (type & SAI_REDIS_BULK_OP_TYPE_WAIT_RESPONSE) != 0;
+
+    type = (sai_bulk_op_type_t)(type & ~SAI_REDIS_BULK_OP_TYPE_WAIT_RESPONSE);
+
+    switch (type)
+    {
+        case SAI_BULK_OP_TYPE_STOP_ON_ERROR:
+        case SAI_BULK_OP_TYPE_INGORE_ERROR:
+            return true;
+
+        default:
 
-    std::string key = str_object_type + ":" + serialized_object_id;
+            SWSS_LOG_ERROR("invalid bulk operation type %d", type);
 
-    SWSS_LOG_DEBUG("generic get key: %s, fields: %lu", key.c_str(), entry.size());
+            return false;
+    }
+}
+
+uint64_t internal_redis_bulk_request_id(
+        _In_ bool wait)
+{
+    SWSS_LOG_ENTER();
+
+    return wait ? ++g_bulkRequestId : 0;
+}
+
+std::string internal_redis_bulk_op(
+        _In_ const std::string &op,
+        _In_ uint64_t request_id)
+{
+    SWSS_LOG_ENTER();
 
-    if (g_record)
+    if (request_id == 0)
     {
-        recordLine("g|" + key + "|" + joinFieldValues(entry));
+        return op;
     }
 
-    // get is special, it will not put data
-    // into asic view, only to message queue
-    g_asicState->set(key, entry, "get");
+    return op + ":" + std::to_string(request_id);
+}
 
-    // wait for response
+sai_status_t internal_redis_bulk_wait_response(
+        _In_ size_t object_count,
+        _In_ size_t sent_count,
+        _In_ uint64_t request_id,
+        _Inout_ sai_status_t *object_statuses)
+{
+    SWSS_LOG_ENTER();
 
-    swss::Select s;
+    /*
+     * Bulk set is buffered when pipeline is enabled, it must reach syncd
+     * before we start waiting.
+     */
 
-    s.addSelectable(g_redisGetConsumer.get());
+    g_asicState->flush();
 
-    while (true)
+    if (request_id && sent_count)
     {
-        SWSS_LOG_DEBUG("wait for response");
+        swss::KeyOpFieldsValuesTuple kco;
 
-        swss::Selectable *sel;
+        SWSS_LOG_DEBUG("wait for bulk response %lu", request_id);
 
-        int fd;
+        bool received = internal_redis_wait_response(internal_redis_bulk_op("bulkresponse", request_id), kco);
 
-        int result = s.select(&sel, &fd, GET_RESPONSE_TIMEOUT);
+        const std::vector<swss::FieldValueTuple> &values = kfvFieldsValues(kco);
 
-        if (result == swss::Select::OBJECT)
+        if (received && values.size() != sent_count)
         {
-            swss::KeyOpFieldsValuesTuple kco;
-
-            g_redisGetConsumer->pop(kco);
+            SWSS_LOG_ERROR("bulk response has %zu statuses, expected %zu", values.size(), sent_count);
 
-            const std::string &op = kfvOp(kco);
-            const std::string &opkey = kfvKey(kco);
+            received = false;
+        }
 
-            SWSS_LOG_DEBUG("response: op = %s, key = %s", opkey.c_str(), op.c_str());
+        if (!received)
+        {
+            /*
+             * We don't know whether syncd executed the objects, they stay in
+             * metadata as sent and keep metadata status.
+             */
 
-            if (op != "getresponse") // ignore non response messages
-            {
-                continue;
-            }
+            SWSS_LOG_ERROR("no bulk response %lu, assuming objects were executed", request_id);
+        }
 
-            sai_status_t status = internal_redis_get_process(
-                    object_type,
-                    attr_count,
-                    attr_list,
-                    kco);
+        size_t sent = 0;
 
-            if (g_record)
+        for (size_t idx = 0; received && idx < object_count; ++idx)
+        {
+            if (object_statuses[idx] != SAI_STATUS_SUCCESS)
             {
-                const std::string &str_status = kfvKey(kco);
-                const std::vector<swss::FieldValueTuple> &values = kfvFieldsValues(kco);
-
-                // first serialized is status
-                recordLine("G|" + str_status + "|" + joinFieldValues(values));
+                continue;
             }
 
-            SWSS_LOG_DEBUG("generic get status: %d", status);
+            sai_deserialize_status(fvValue(values[sent]), object_statuses[idx]);
 
-            return status;
+            sent++;
         }
-
-        SWSS_LOG_ERROR("generic get failed due to SELECT operation result: %s", getSelectResultAsString(result).c_str());
-        break;
     }
 
-    if (g_record)
+    for (size_t idx = 0; idx < object_count; ++idx)
     {
-        recordLine("G|SAI_STATUS_FAILURE");
+        if (object_statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            return SAI_STATUS_FAILURE;
+        }
     }
 
-    SWSS_LOG_ERROR("generic get failed to get response");
-
-    return SAI_STATUS_FAILURE;
+    return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t redis_generic_get(
@@ -21,9 +21,87 @@ sai_status_t internal_redis_generic_remove(
 
     g_asicState->del(key, "remove");
 
+    internal_redis_track_write();
+    internal_redis_track_remove(object_type, serialized_object_id);
+
     return SAI_STATUS_SUCCESS;
 }
 
+sai_status_t internal_redis_bulk_generic_remove(
+        _In_ sai_object_type_t object_type,
+        _In_ const std::vector<std::string> &serialized_object_ids,
+        _In_ bool wait,
+        _Inout_ sai_status_t *object_statuses)
+{
+    SWSS_LOG_ENTER();
+
+    std::string str_object_type = sai_serialize_object_type(object_type);
+
+    std::vector<swss::FieldValueTuple> entries;
+
+    for (size_t idx = 0; idx < serialized_object_ids.size(); ++idx)
+    {
+        if (object_statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_WARN("skipping %s since status is %s",
+                    serialized_object_ids[idx].c_str(),
+                    sai_serialize_status(object_statuses[idx]).c_str());
+
+            continue;
+        }
+
+        entries.emplace_back(serialized_object_ids[idx], "");
+    }
+
+    // key:         object_type:count
+    // field:       object_id
+    // value:       empty
+    std::string key = str_object_type + ":" + std::to_string(entries.size());
+
+    uint64_t request_id = internal_redis_bulk_request_id(wait);
+
+    if (entries.size())
+    {
+        g_asicState->set(key, entries, internal_redis_bulk_op("bulkremove", request_id));
+
+        internal_redis_track_write();
+
+        for (size_t idx = 0; idx < serialized_object_ids.size(); ++idx)
+        {
+            if (object_statuses[idx] == SAI_STATUS_SUCCESS)
+            {
+                internal_redis_track_remove(object_type, serialized_object_ids[idx]);
+            }
+        }
+    }
+
+    sai_status_t status = internal_redis_bulk_wait_response(
+            serialized_object_ids.size(),
+            entries.size(),
+            request_id,
+            object_statuses);
+
+    if (g_record)
+    {
+        std::string joined;
+
+        for (size_t idx = 0; idx < serialized_object_ids.size(); ++idx)
+        {
+            // ||obj_id|status||obj_id|status
+
+            joined += "||" + serialized_object_ids[idx] + "|" + sai_serialize_status(object_statuses[idx]);
+        }
+
+        /*
+         * Capital 'R' stads for bulk REMOVE operation.
+         */
+
+        recordLine("R|" + str_object_type + joined);
+    }
+
+    return status;
+}
+
 sai_status_t redis_generic_remove(
         _In_ sai_object_type_t object_type,
         _In_ sai_object_id_t object_id)
@@ -86,3 +164,97 @@ sai_status_t redis_generic_remove_route_entry(
             SAI_OBJECT_TYPE_ROUTE_ENTRY,
             str_route_entry);
 }
+
+sai_status_t redis_dummy_remove_bulk_object(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_object_id_t object_id)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Used to update metadata after bulk operations, nothing is sent to
+     * syncd here.
+     */
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t internal_redis_bulk_object_remove(
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_type_t type,
+        _Out_ sai_status_t *object_statuses)
+{
+    SWSS_LOG_ENTER();
+
+    bool wait;
+
+    if (!internal_redis_bulk_op_type(type, wait))
+    {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    std::vector<std::string> serialized_object_ids;
+
+    for (uint32_t idx = 0; idx < object_count; ++idx)
+    {
+        object_statuses[idx] = SAI_STATUS_NOT_EXECUTED;
+
+        serialized_object_ids.push_back(sai_serialize_object_id(object_id[idx]));
+    }
+
+    /*
+     * Same as for routes, only objects metadata allows to remove are sent to
+     * syncd, and they are removed from metadata only after syncd removed
+     * them.
+     */
+
+    for (uint32_t idx = 0; idx < object_count; ++idx)
+    {
+        object_statuses[idx] = meta_sai_validate_remove_oid(object_type, object_id[idx]);
+
+        if (object_statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("failed on index %u: %s",
+                    idx,
+                    serialized_object_ids[idx].c_str());
+
+            if (type == SAI_BULK_OP_TYPE_STOP_ON_ERROR)
+            {
+                SWSS_LOG_NOTICE("stop on error since previous operation failed");
+                break;
+            }
+        }
+    }
+
+    sai_status_t status = internal_redis_bulk_generic_remove(
+            object_type,
+            serialized_object_ids,
+            wait,
+            object_statuses);
+
+    for (uint32_t idx = 0; idx < object_count; ++idx)
+    {
+        if (object_statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            continue;
+        }
+
+        object_statuses[idx] = meta_sai_remove_oid(
+                object_type,
+                object_id[idx],
+                &redis_dummy_remove_bulk_object);
+
+        if (object_statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("failed on index %u: %s",
+                    idx,
+                    serialized_object_ids[idx].c_str());
+
+            status = SAI_STATUS_FAILURE;
+        }
+    }
+
+    return status;
+}
@@ -28,6 +28,9 @@ sai_status_t internal_redis_generic_set(
 
     g_asicState->set(key, entry, "set");
 
+    internal_redis_track_write();
+    internal_redis_track_object(object_type, serialized_object_id, 1, attr);
+
     return SAI_STATUS_SUCCESS;
 }
 
@@ -35,14 +38,15 @@ sai_status_t internal_redis_bulk_generic_set(
         _In_ sai_object_type_t object_type,
         _In_ const std::vector<std::string> &serialized_object_ids,
         _In_ const sai_attribute_t *attr_list,
-        _In_ const sai_status_t *object_statuses)
+        _In_ bool wait,
+        _Inout_ sai_status_t *object_statuses)
 {
     SWSS_LOG_ENTER();
 
     std::string str_object_type = sai_serialize_object_type(object_type);
 
     std::vector<swss::FieldValueTuple> entries;
-    std::vector<swss::FieldValueTuple> entriesWithStatus;
+    std::vector<std::string> str_attrs;
 
     /*
      * We are recording all entries and their statuses, but we send to sairedis
@@ -58,19 +62,13 @@ sai_status_t internal_redis_bulk_generic_set(
 
         std::string str_attr = joinFieldValues(entry);
 
-        std::string str_status = sai_serialize_status(object_statuses[idx]);
-
-        std::string joined = str_attr + "|" + str_status;
-
-        swss::FieldValueTuple fvt(serialized_object_ids[idx] , joined);
-
-        entriesWithStatus.push_back(fvt);
+        str_attrs.push_back(str_attr);
 
         if (object_statuses[idx] != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_WARN("skipping %s since status is %s",
                     serialized_object_ids[idx].c_str(),
-                    str_status.c_str());
+                    sai_serialize_status(object_statuses[idx]).c_str());
 
             continue;
         }
@@ -85,15 +83,40 @@ sai_status_t internal_redis_bulk_generic_set(
      * with previous
      */
 
+    std::string key = str_object_type + ":" + std::to_string(entries.size());
+
+    uint64_t request_id = internal_redis_bulk_request_id(wait);
+
+    if (entries.size())
+    {
+        g_asicState->set(key, entries, internal_redis_bulk_op("bulkset", request_id));
+
+        internal_redis_track_write();
+
+        for (size_t idx = 0; idx < serialized_object_ids.size(); ++idx)
+        {
+            if (object_statuses[idx] == SAI_STATUS_SUCCESS)
+            {
+                internal_redis_track_object(object_type, serialized_object_ids[idx], 1, &attr_list[idx]);
+            }
+        }
+    }
+
+    sai_status_t status = internal_redis_bulk_wait_response(
+            serialized_object_ids.size(),
+            entries.size(),
+            request_id,
+            object_statuses);
+
     if (g_record)
     {
         std::string joined;
 
-        for (const auto &e: entriesWithStatus)
+        for (size_t idx = 0; idx < serialized_object_ids.size(); ++idx)
         {
             // ||obj_id|attr=val|attr=val|status||obj_id|attr=val|attr=val|status
 
-            joined += "||" + fvField(e) + "|" + fvValue(e);
+            joined += "||" + serialized_object_ids[idx] + "|" + str_attrs[idx] + "|" + sai_serialize_status(object_statuses[idx]);
         }
 
         /*
@@ -103,14 +126,7 @@ sai_status_t internal_redis_bulk_generic_set(
         recordLine("S|" + str_object_type + joined);
     }
 
-    std::string key = str_object_type + ":" + std::to_string(entries.size());
-
-    if (entries.size())
-    {
-        g_asicState->set(key, entries, "bulkset");
-    }
-
-    return SAI_STATUS_SUCCESS;
+    return status;
 }
 
 
@@ -0,0 +1,721 @@
+#include "sai_redis.h"
+#include "sairedis.h"
+
+#include "meta/saiserialize.h"
+#include "meta/saiserializebinary.h"
+#include "meta/saiattributelist.h"
+#include "swss/selectableevent.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <thread>
+
+/*
+ * Gets are tagged with a request id and sent on GETREQUEST, which syncd
+ * serves before ASIC_STATE, so any number of them can be in flight and
+ * they don't wait behind a backlog of routes. Each get carries the sequence
+ * number of the last ASIC_STATE operation which may change the object, and
+ * syncd holds the get until it executed that operation.
+ *
+ * Responses are all received by the get response thread. Tagged responses
+ * complete their request, other responses (notify, bulk and gets sent
+ * before syncd was notified) are queued for the API waiting for them.
+ */
+
+/*
+ * Objects are tracked in a fixed number of buckets, objects sharing a
+ * bucket only make gets wait longer than needed.
+ */
+#define OBJECT_SEQUENCE_BUCKETS 0x1000
+
+/*
+ * Interval at which the response thread expires asynchronous gets.
+ */
+#define GET_RESPONSE_POLL_INTERVAL (1000)
+
+struct GetRequest
+{
+    sai_object_type_t object_type;
+    std::string key;
+    std::vector<swss::FieldValueTuple> values;
+
+    uint32_t attr_count;
+    sai_attribute_t *attr_list;
+
+    sai_redis_get_response_fn callback; /* NULL for synchronous get */
+    void *context;
+
+    std::chrono::steady_clock::time_point deadline;
+
+    bool done;
+    bool cancelled; /* response thread stopped */
+    swss::KeyOpFieldsValuesTuple response;
+};
+
+/*
+ * Protected by g_apimutex.
+ */
+
+static bool g_getSequenceSynced = false;
+static bool g_getBinaryEncoding = false;
+static uint64_t g_asicStateSequence = 0;
+static uint64_t g_removeSequence = 0;
+static std::vector<uint64_t> g_objectSequence(OBJECT_SEQUENCE_BUCKETS, 0);
+
+/*
+ * Protected by g_getMutex.
+ */
+
+static std::mutex g_getMutex;
+static std::condition_variable g_getCond;
+static uint64_t g_getRequestId = 0;
+static std::map<uint64_t, GetRequest> g_getRequests;
+static std::deque<swss::KeyOpFieldsValuesTuple> g_responses;
+
+// this event is used to nice end get response thread
+static swss::SelectableEvent g_getResponseThreadEvent;
+static std::shared_ptr<std::thread> g_getResponseThread;
+
+static size_t object_bucket(
+        _In_ sai_object_type_t object_type,
+        _In_ const std::string &serialized_object_id)
+{
+    SWSS_LOG_ENTER();
+
+    auto info = sai_metadata_get_object_type_info(object_type);
+
+    if (info != NULL && !info->isnonobjectid)
+    {
+        sai_object_id_t object_id;
+        sai_deserialize_object_id(serialized_object_id, object_id);
+
+        return object_id % OBJECT_SEQUENCE_BUCKETS;
+    }
+
+    return std::hash<std::string>()(serialized_object_id) % OBJECT_SEQUENCE_BUCKETS;
+}
+
+static void track_object_ids(
+        _In_ uint32_t count,
+        _In_ const sai_object_id_t *object_ids)
+{
+    SWSS_LOG_ENTER();
+
+    for (uint32_t idx = 0; idx < count && object_ids != NULL; ++idx)
+    {
+        g_objectSequence[object_ids[idx] % OBJECT_SEQUENCE_BUCKETS] = g_asicStateSequence;
+    }
+}
+
+void internal_redis_track_write()
+{
+    SWSS_LOG_ENTER();
+
+    g_asicStateSequence++;
+}
+
+void internal_redis_track_object(
+        _In_ sai_object_type_t object_type,
+        _In_ const std::string &serialized_object_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+{
+    SWSS_LOG_ENTER();
+
+    g_objectSequence[object_bucket(object_type, serialized_object_id)] = g_asicStateSequence;
+
+    /*
+     * Objects referenced by attributes may change too, like the member list
+     * of a lag when a lag member is created.
+     */
+
+    for (uint32_t idx = 0; idx < attr_count; ++idx)
+    {
+        const sai_attribute_t &attr = attr_list[idx];
+
+        auto meta = sai_metadata_get_attr_metadata(object_type, attr.id);
+
+        if (meta == NULL)
+        {
+            continue;
+        }
+
+        switch (meta->attrvaluetype)
+        {
+            case SAI_ATTR_VALUE_TYPE_OBJECT_ID:
+                track_object_ids(1, &attr.value.oid);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_OBJECT_LIST:
+                track_object_ids(attr.value.objlist.count, attr.value.objlist.list);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_ID:
+                track_object_ids(1, &attr.value.aclfield.data.oid);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
+                track_object_ids(attr.value.aclfield.data.objlist.count, attr.value.aclfield.data.objlist.list);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_ID:
+                track_object_ids(1, &attr.value.aclaction.parameter.oid);
+                break;
+
+            case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
+                track_object_ids(attr.value.aclaction.parameter.objlist.count, attr.value.aclaction.parameter.objlist.list);
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+void internal_redis_track_remove(
+        _In_ sai_object_type_t object_type,
+        _In_ const std::string &serialized_object_id)
+{
+    SWSS_LOG_ENTER();
+
+    g_objectSequence[object_bucket(object_type, serialized_object_id)] = g_asicStateSequence;
+
+    /*
+     * Attributes of the removed object are not known here, and it may be
+     * referenced by the objects they point to, so all gets wait for object
+     * id removals. Route, neighbor and fdb entries are not referenced.
+     */
+
+    auto info = sai_metadata_get_object_type_info(object_type);
+
+    if (info != NULL && !info->isnonobjectid)
+    {
+        g_removeSequence = g_asicStateSequence;
+    }
+}
+
+void internal_redis_reset_get_sequence(
+        _In_ bool synced)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Syncd restarts counting after each notify, which it executed once
+     * we get its response.
+     */
+
+    g_getSequenceSynced = synced;
+    g_asicStateSequence = 0;
+    g_removeSequence = 0;
+
+    std::fill(g_objectSequence.begin(), g_objectSequence.end(), 0);
+}
+
+bool internal_redis_get_sequence_synced()
+{
+    SWSS_LOG_ENTER();
+
+    return g_getSequenceSynced;
+}
+
+void internal_redis_set_get_binary_encoding(
+        _In_ bool binary)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_NOTICE("sending gets in %s encoding", binary ? "binary" : "text");
+
+    g_getBinaryEncoding = binary;
+}
+
+static uint64_t get_sequence(
+        _In_ sai_object_type_t object_type,
+        _In_ const std::string &serialized_object_id)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Switch attributes like available resources depend on all objects.
+     */
+
+    if (object_type == SAI_OBJECT_TYPE_SWITCH)
+    {
+        return g_asicStateSequence;
+    }
+
+    return std::max(g_removeSequence, g_objectSequence[object_bucket(object_type, serialized_object_id)]);
+}
+
+uint64_t internal_redis_send_get_request(
+        _In_ sai_object_type_t object_type,
+        _In_ const std::string &serialized_object_id,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t *attr_list,
+        _In_ sai_redis_get_response_fn callback,
+        _In_ void *context)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Since user may reuse buffers, then oid list buffers maybe not cleared
+     * and contain som garbage, let's clean them so we send all oids as null to
+     * syncd.
+     */
+
+    clear_oid_values(object_type, attr_count, attr_list);
+
+    GetRequest request;
+
+    request.object_type = object_type;
+    request.key = sai_serialize_object_type(object_type) + ":" + serialized_object_id;
+
+    /*
+     * Text values are only needed in the recording when gets are binary.
+     */
+
+    if (!g_getBinaryEncoding || g_record)
+    {
+        request.values = SaiAttributeList::serialize_attr_list(object_type, attr_count, attr_list, false);
+    }
+
+    request.attr_count = attr_count;
+    request.attr_list = attr_list;
+    request.callback = callback;
+    request.context = context;
+    request.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(GET_RESPONSE_TIMEOUT);
+    request.done = false;
+    request.cancelled = false;
+
+    uint64_t sequence = get_sequence(object_type, serialized_object_id);
+
+    /*
+     * Operations the get depends on must be in ASIC_STATE when syncd sees
+     * the get, pipelined sets may be still buffered.
+     */
+
+    g_asicState->flush();
+
+    std::string key = request.key;
+    std::vector<swss::FieldValueTuple> values = request.values;
+
+    if (g_getBinaryEncoding)
+    {
+        sai_object_meta_key_t meta_key;
+
+        sai_deserialize_object_meta_key(request.key, meta_key);
+
+        key = sai_serialize_binary_object_meta_key(meta_key);
+
+        values = {
+            swss::FieldValueTuple(SAI_SERIALIZE_BINARY_ATTR_LIST,
+                    sai_serialize_binary_attr_list(object_type, attr_count, attr_list, false))
+        };
+    }
+
+    uint64_t request_id;
+
+    {
+        std::lock_guard<std::mutex> lock(g_getMutex);
+
+        request_id = ++g_getRequestId;
+
+        g_getRequests[request_id] = std::move(request);
+    }
+
+    SWSS_LOG_DEBUG("get request %lu: %s:%s, sequence %lu",
+            request_id,
+            sai_serialize_object_type(object_type).c_str(),
+            serialized_object_id.c_str(),
+            sequence);
+
+    // key:         object_type:object_id, or binary meta key
+    // op:          get:request_id:sequence
+    std::string op = "get:" + std::to_string(request_id) + ":" + std::to_string(sequence);
+
+    g_redisGetRequest->set(key, values, op);
+
+    return request_id;
+}
+
+static void record_get(
+        _In_ const GetRequest &request,
+        _In_ const swss::KeyOpFieldsValuesTuple *response)
+{
+    SWSS_LOG_ENTER();
+
+    if (!g_record)
+    {
+        return;
+    }
+
+    /*
+     * Gets in flight overlap, the request is recorded with its response so
+     * the player still finds them next to each other.
+     */
+
+    recordLine("g|" + request.key + "|" + joinFieldValues(request.values));
+
+    if (response == NULL)
+    {
+        recordLine("G|SAI_STATUS_FAILURE");
+        return;
+    }
+
+    const std::vector<swss::FieldValueTuple> &values = kfvFieldsValues(*response);
+
+    if (values.size() == 1 && fvField(values[0]) == SAI_SERIALIZE_BINARY_ATTR_LIST)
+    {
+        /*
+         * Recording is always in text.
+         */
+
+        sai_status_t status;
+
+        sai_deserialize_status(kfvKey(*response), status);
+
+        bool countOnly = (status == SAI_STATUS_BUFFER_OVERFLOW);
+
+        SaiAttributeList list(request.object_type, fvValue(values[0]), countOnly);
+
+        auto text = SaiAttributeList::serialize_attr_list(request.object_type, list.get_attr_count(), list.get_attr_list(), countOnly);
+
+        recordLine("G|" + kfvKey(*response) + "|" + joinFieldValues(text));
+
+        return;
+    }
+
+    // first serialized is status
+    recordLine("G|" + kfvKey(*response) + "|" + joinFieldValues(values));
+}
+
+bool internal_redis_wait_get_response(
+        _In_ uint64_t request_id,
+        _Out_ swss::KeyOpFieldsValuesTuple &kco)
+{
+    SWSS_LOG_ENTER();
+
+    std::unique_lock<std::mutex> lock(g_getMutex);
+
+    auto deadline = g_getRequests.at(request_id).deadline;
+
+    /*
+     * Request is looked up again after each wake up, no reference into the
+     * map is kept while waiting.
+     */
+
+    auto it = g_getRequests.find(request_id);
+
+    while (!it->second.done && !it->second.cancelled)
+    {
+        bool timeout = g_getCond.wait_until(lock, deadline) == std::cv_status::timeout;
+
+        it = g_getRequests.find(request_id);
+
+        if (timeout)
+        {
+            break;
+        }
+    }
+
+    bool done = it->second.done;
+
+    if (done)
+    {
+        kco = std::move(it->second.response);
+    }
+
+    record_get(it->second, done ? &kco : NULL);
+
+    g_getRequests.erase(it);
+
+    // stop_get_response_thread waits for the cancelled requests to be erased
+    g_getCond.notify_all();
+
+    return done;
+}
+
+bool internal_redis_wait_response(
+        _In_ const std::string &op,
+        _Out_ swss::KeyOpFieldsValuesTuple &kco)
+{
+    SWSS_LOG_ENTER();
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(GET_RESPONSE_TIMEOUT);
+
+    std::unique_lock<std::mutex> lock(g_getMutex);
+
+    while (true)
+    {
+        while (!g_responses.empty())
+        {
+            kco = std::move(g_responses.front());
+
+            g_responses.pop_front();
+
+            if (kfvOp(kco) == op)
+            {
+                return true;
+            }
+
+            // ignore non response messages
+            SWSS_LOG_NOTICE("ignoring response %s while waiting for %s", kfvOp(kco).c_str(), op.c_str());
+        }
+
+        if (g_getCond.wait_until(lock, deadline) == std::cv_status::timeout && g_responses.empty())
+        {
+            SWSS_LOG_ERROR("timeout waiting for %s response", op.c_str());
+
+            return false;
+        }
+    }
+}
+
+static void complete_async_get(
+        _In_ GetRequest &request,
+        _In_ swss::KeyOpFieldsValuesTuple *response)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * The API lock is not taken here, it may be held by an API waiting for
+     * a response from this thread.
+     */
+
+    sai_status_t status = SAI_STATUS_FAILURE;
+
+    if (response != NULL)
+    {
+        status = internal_redis_get_process(request.object_type, request.attr_count, request.attr_list, *response);
+    }
+    else
+    {
+        SWSS_LOG_ERROR("get %s timed out", request.key.c_str());
+    }
+
+    record_get(request, response);
+
+    request.callback(request.context, status, request.attr_count, request.attr_list);
+}
+
+static void dispatch_response(
+        _In_ swss::KeyOpFieldsValuesTuple &kco)
+{
+    SWSS_LOG_ENTER();
+
+    const std::string &op = kfvOp(kco);
+
+    const std::string prefix = "getresponse:";
+
+    std::unique_lock<std::mutex> lock(g_getMutex);
+
+    if (op.compare(0, prefix.size(), prefix) != 0)
+    {
+        g_responses.push_back(kco);
+
+        g_getCond.notify_all();
+
+        return;
+    }
+
+    uint64_t request_id = std::stoull(op.substr(prefix.size()));
+
+    auto it = g_getRequests.find(request_id);
+
+    if (it == g_getRequests.end())
+    {
+        SWSS_LOG_WARN("dropping response of expired get request %lu", request_id);
+
+        return;
+    }
+
+    if (it->second.callback == NULL)
+    {
+        it->second.response = kco;
+        it->second.done = true;
+
+        g_getCond.notify_all();
+
+        return;
+    }
+
+    GetRequest request = std::move(it->second);
+
+    g_getRequests.erase(it);
+
+    lock.unlock();
+
+    complete_async_get(request, &kco);
+}
+
+static void expire_async_gets()
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<GetRequest> expired;
+
+    {
+        std::lock_guard<std::mutex> lock(g_getMutex);
+
+        auto now = std::chrono::steady_clock::now();
+
+        for (auto it = g_getRequests.begin(); it != g_getRequests.end();)
+        {
+            if (it->second.callback != NULL && it->second.deadline < now)
+            {
+                expired.push_back(std::move(it->second));
+
+                it = g_getRequests.erase(it);
+            }
+            else
+            {
+                it++;
+            }
+        }
+    }
+
+    for (auto &request: expired)
+    {
+        complete_async_get(request, NULL);
+    }
+}
+
+static void get_response_thread()
+{
+    SWSS_LOG_ENTER();
+
+    swss::Select s;
+
+    s.addSelectable(g_redisGetConsumer.get());
+    s.addSelectable(&g_getResponseThreadEvent);
+
+    while (g_run)
+    {
+        swss::Selectable *sel;
+
+        int fd;
+
+        int result = s.select(&sel, &fd, GET_RESPONSE_POLL_INTERVAL);
+
+        if (sel == &g_getResponseThreadEvent)
+        {
+            // user requested api uninitialize
+            break;
+        }
+
+        if (result == swss::Select::OBJECT)
+        {
+            swss::KeyOpFieldsValuesTuple kco;
+
+            g_redisGetConsumer->pop(kco);
+
+            SWSS_LOG_DEBUG("response: op = %s, key = %s", kfvOp(kco).c_str(), kfvKey(kco).c_str());
+
+            dispatch_response(kco);
+        }
+
+        expire_async_gets();
+    }
+}
+
+void start_get_response_thread()
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_DEBUG("creating get response thread");
+
+    g_getResponseThread = std::make_shared<std::thread>(std::thread(get_response_thread));
+}
+
+void stop_get_response_thread()
+{
+    SWSS_LOG_ENTER();
+
+    g_getResponseThreadEvent.notify();
+
+    g_getResponseThread->join();
+
+    std::vector<GetRequest> cancelled;
+
+    {
+        std::unique_lock<std::mutex> lock(g_getMutex);
+
+        g_responses.clear();
+
+        /*
+         * Synchronous gets fail and are erased by their waiters, asynchronous
+         * gets are completed with failure below.
+         */
+
+        for (auto it = g_getRequests.begin(); it != g_getRequests.end();)
+        {
+            if (it->second.callback == NULL)
+            {
+                it->second.cancelled = true;
+                it++;
+            }
+            else
+            {
+                cancelled.push_back(std::move(it->second));
+
+                it = g_getRequests.erase(it);
+            }
+        }
+
+        g_getCond.notify_all();
+
+        g_getCond.wait(lock, [] { return g_getRequests.empty(); });
+    }
+
+    for (auto &request: cancelled)
+    {
+        complete_async_get(request, NULL);
+    }
+}
+
+sai_status_t sai_redis_get_attribute_async(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_object_id_t object_id,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t *attr_list,
+        _In_ sai_redis_get_response_fn callback,
+        _In_ void *context)
+{
+    MUTEX();
+
+    SWSS_LOG_ENTER();
+
+    if (callback == NULL)
+    {
+        SWSS_LOG_ERROR("callback is NULL");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (!g_getSequenceSynced)
+    {
+        SWSS_LOG_ERROR("asynchronous get is not available before syncd is notified");
+
+        return SAI_STATUS_NOT_SUPPORTED;
+    }
+
+    sai_status_t status = meta_sai_validate_get_oid(object_type, object_id, attr_count, attr_list);
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    internal_redis_send_get_request(
+            object_type,
+            sai_serialize_object_id(object_id),
+            attr_count,
+            attr_list,
+            callback,
+            context);
+
+    return SAI_STATUS_SUCCESS;
+}
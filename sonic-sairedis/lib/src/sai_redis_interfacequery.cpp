@@ -16,7 +16,9 @@ std::shared_ptr<std::thread> notification_thread;
 
 std::shared_ptr<swss::DBConnector>          g_db;
 std::shared_ptr<swss::DBConnector>          g_dbNtf;
+std::shared_ptr<swss::DBConnector>          g_dbGet;
 std::shared_ptr<swss::ProducerTable>        g_asicState;
+std::shared_ptr<swss::ProducerTable>        g_redisGetRequest;
 std::shared_ptr<swss::ConsumerTable>        g_redisGetConsumer;
 std::shared_ptr<swss::NotificationConsumer> g_redisNotifications;
 std::shared_ptr<swss::RedisClient>          g_redisClient;
@@ -51,6 +53,12 @@ void clear_local_state()
      */
 
     redis_clear_switch_ids();
+
+    /*
+     * ASIC DB could have been flushed, lease new virtual ids.
+     */
+
+    redis_clear_virtual_object_ids();
 }
 
 void ntf_thread()
@@ -119,8 +127,10 @@ sai_status_t sai_api_initialize(
 
     g_db                 = std::make_shared<swss::DBConnector>(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
     g_dbNtf              = std::make_shared<swss::DBConnector>(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
+    g_dbGet              = std::make_shared<swss::DBConnector>(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
     g_asicState          = std::make_shared<swss::ProducerTable>(g_db.get(), ASIC_STATE_TABLE);
-    g_redisGetConsumer   = std::make_shared<swss::ConsumerTable>(g_db.get(), "GETRESPONSE");
+    g_redisGetRequest    = std::make_shared<swss::ProducerTable>(g_db.get(), GET_REQUEST_TABLE);
+    g_redisGetConsumer   = std::make_shared<swss::ConsumerTable>(g_dbGet.get(), GET_RESPONSE_TABLE);
     g_redisNotifications = std::make_shared<swss::NotificationConsumer>(g_dbNtf.get(), "NOTIFICATIONS");
     g_redisClient        = std::make_shared<swss::RedisClient>(g_db.get());
 
@@ -130,6 +140,8 @@ sai_status_t sai_api_initialize(
 
     g_useTempView = false;
 
+    internal_redis_reset_get_sequence(false);
+
     g_run = true;
 
     setRecording(g_record);
@@ -138,6 +150,8 @@ sai_status_t sai_api_initialize(
 
     notification_thread = std::make_shared<std::thread>(std::thread(ntf_thread));
 
+    start_get_response_thread();
+
     g_apiInitialized = true;
 
     return SAI_STATUS_SUCCESS;
@@ -165,6 +179,8 @@ sai_status_t sai_api_uninitialize(void)
 
     notification_thread->join();
 
+    stop_get_response_thread();
+
     g_apiInitialized = false;
 
     return SAI_STATUS_SUCCESS;
@@ -1,4 +1,5 @@
 #include "sai_redis.h"
+#include "meta/saiserialize.h"
 
 sai_status_t redis_bulk_object_create_next_hop_group_members(
         _In_ sai_object_id_t switch_id,
@@ -13,8 +14,15 @@ sai_status_t redis_bulk_object_create_next_hop_group_members(
 
     SWSS_LOG_ENTER();
 
-    return redis_bulk_generic_create(SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER, object_count, object_id
-        , switch_id, attr_count, attrs, object_statuses);
+    return internal_redis_bulk_object_create(
+            SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER,
+            switch_id,
+            object_count,
+            attr_count,
+            attrs,
+            type,
+            object_id,
+            object_statuses);
 }
 
 sai_status_t redis_bulk_object_remove_next_hop_group_members(
@@ -27,7 +35,12 @@ sai_status_t redis_bulk_object_remove_next_hop_group_members(
 
     SWSS_LOG_ENTER();
 
-    return SAI_STATUS_NOT_IMPLEMENTED;
+    return internal_redis_bulk_object_remove(
+            SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER,
+            object_count,
+            object_id,
+            type,
+            object_statuses);
 }
 
 REDIS_GENERIC_QUAD(NEXT_HOP_GROUP,next_hop_group);
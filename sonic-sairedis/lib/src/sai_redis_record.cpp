@@ -4,89 +4,45 @@
 
 std::string logOutputDir = ".";
 
-std::string getTimestamp()
-{
-    SWSS_LOG_ENTER();
-
-    char buffer[64];
-    struct timeval tv;
-
-    gettimeofday(&tv, NULL);
-
-    size_t size = strftime(buffer, 32 ,"%Y-%m-%d.%T.", localtime(&tv.tv_sec));
-
-    snprintf(&buffer[size], 32, "%06ld", tv.tv_usec);
-
-    return std::string(buffer);
-}
-
 // recording needs to be enabled explicitly
 volatile bool g_record = false;
-volatile bool g_logrotate = false;
+volatile bool g_recordBinary = false;
 
-std::ofstream recording;
-std::mutex g_recordMutex;
+/*
+ * Lines are queued and written to file by recorder thread, so recording
+ * doesn't block API calls on formatting timestamps and writing file.
+ */
+swss::Recorder g_recorder;
 
-std::string recfile = "dummy.rec";
-
-void logfileReopen()
+void recordLine(std::string s)
 {
     SWSS_LOG_ENTER();
 
-    recording.close();
-
-    /*
-     * On log rotate we will use the same file name, we are assuming that
-     * logrotate deamon move filename to filename.1 and we will create new
-     * empty file here.
-     */
-
-    recording.open(recfile, std::ofstream::out | std::ofstream::app);
-
-    if (!recording.is_open())
-    {
-        SWSS_LOG_ERROR("failed to open recording file %s: %s", recfile.c_str(), strerror(errno));
-        return;
-    }
+    g_recorder.record(s);
 }
 
-void recordLine(std::string s)
+void startRecording()
 {
-    std::lock_guard<std::mutex> lock(g_recordMutex);
-
     SWSS_LOG_ENTER();
 
-    if (recording.is_open())
-    {
-        recording << getTimestamp() << "|" << s << std::endl;
-    }
+    std::string recfile = logOutputDir + "/sairedis.rec";
 
-    if (g_logrotate)
-    {
-        g_logrotate = false;
+    swss::Recorder::Format format = swss::Recorder::TEXT;
 
-        logfileReopen();
+    if (g_recordBinary)
+    {
+        /*
+         * Binary recording can be converted to text recording which
+         * saiplayer reads by swssrecconvert.
+         */
 
-        /* double check since reopen could fail */
+        recfile += ".bin";
 
-        if (recording.is_open())
-        {
-            recording << getTimestamp() << "|" << "#|logrotate on: " << recfile << std::endl;
-        }
+        format = swss::Recorder::BINARY;
     }
-}
-
-void startRecording()
-{
-    SWSS_LOG_ENTER();
-
-    recfile = logOutputDir + "/sairedis.rec";
-
-    recording.open(recfile, std::ofstream::out | std::ofstream::app);
 
-    if (!recording.is_open())
+    if (!g_recorder.open(recfile, format))
     {
-        SWSS_LOG_ERROR("failed to open recording file %s: %s", recfile.c_str(), strerror(errno));
         return;
     }
 
@@ -99,11 +55,11 @@ void stopRecording()
 {
     SWSS_LOG_ENTER();
 
-    if (recording.is_open())
+    if (g_recorder.isOpen())
     {
-        recording.close();
+        g_recorder.close();
 
-        SWSS_LOG_NOTICE("stopped recording: %s", recfile.c_str());
+        SWSS_LOG_NOTICE("stopped recording: %s", g_recorder.getFile().c_str());
     }
 }
 
@@ -27,6 +27,19 @@ sai_status_t redis_dummy_create_route_entry(
     return SAI_STATUS_SUCCESS;
 }
 
+sai_status_t redis_dummy_remove_route_entry(
+        _In_ const sai_route_entry_t *route_entry)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Used to update metadata after bulk operations, for routes which syncd
+     * removed or failed to create, nothing is sent to syncd here.
+     */
+
+    return SAI_STATUS_SUCCESS;
+}
+
 sai_status_t sai_bulk_create_route_entry(
         _In_ uint32_t object_count,
         _In_ const sai_route_entry_t *route_entry,
@@ -67,18 +80,11 @@ sai_status_t sai_bulk_create_route_entry(
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
-    switch (type)
-    {
-        case SAI_BULK_OP_TYPE_STOP_ON_ERROR:
-        case SAI_BULK_OP_TYPE_INGORE_ERROR:
-             // ok
-             break;
-
-        default:
-
-             SWSS_LOG_ERROR("invalid bulk operation type %d", type);
+    bool wait;
 
-             return SAI_STATUS_INVALID_PARAMETER;
+    if (!internal_redis_bulk_op_type(type, wait))
+    {
+        return SAI_STATUS_INVALID_PARAMETER;
     }
 
     if (object_statuses == NULL)
@@ -129,16 +135,34 @@ sai_status_t sai_bulk_create_route_entry(
         }
     }
 
+    std::vector<sai_status_t> meta_statuses(object_statuses, object_statuses + object_count);
+
     /*
      * TODO: we need to record operation type
      */
 
-    return internal_redis_bulk_generic_create(
+    sai_status_t status = internal_redis_bulk_generic_create(
             SAI_OBJECT_TYPE_ROUTE_ENTRY,
             serialized_object_ids,
             attr_count,
             attr_list,
+            wait,
             object_statuses);
+
+    for (uint32_t idx = 0; idx < object_count; ++idx)
+    {
+        if (meta_statuses[idx] == SAI_STATUS_SUCCESS && object_statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            /*
+             * Syncd failed to create this route, remove it from metadata so
+             * it can be created again.
+             */
+
+            meta_sai_remove_route_entry(&route_entry[idx], &redis_dummy_remove_route_entry);
+        }
+    }
+
+    return status;
 }
 
 sai_status_t sai_bulk_remove_route_entry(
@@ -151,7 +175,95 @@ sai_status_t sai_bulk_remove_route_entry(
 
     SWSS_LOG_ENTER();
 
-    return SAI_STATUS_NOT_IMPLEMENTED;
+    if (object_count < 1)
+    {
+        SWSS_LOG_ERROR("expected at least 1 object to remove");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (route_entry == NULL)
+    {
+        SWSS_LOG_ERROR("route_entry is NULL");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    bool wait;
+
+    if (!internal_redis_bulk_op_type(type, wait))
+    {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (object_statuses == NULL)
+    {
+        SWSS_LOG_ERROR("object_statuses is NULL");
+
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    std::vector<std::string> serialized_object_ids;
+
+    for (uint32_t idx = 0; idx < object_count; ++idx)
+    {
+        object_statuses[idx] = SAI_STATUS_NOT_EXECUTED;
+
+        serialized_object_ids.push_back(
+                sai_serialize_route_entry(route_entry[idx]));
+    }
+
+    /*
+     * Route removal can't be reverted in metadata since attributes are gone,
+     * so unlike create and set, routes are only validated here and removed
+     * from metadata after syncd removed them. Routes metadata rejects are
+     * not sent to syncd.
+     */
+
+    for (uint32_t idx = 0; idx < object_count; ++idx)
+    {
+        object_statuses[idx] = meta_sai_validate_remove_route_entry(&route_entry[idx]);
+
+        if (object_statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("failed on index %u: %s",
+                    idx,
+                    serialized_object_ids[idx].c_str());
+
+            if (type == SAI_BULK_OP_TYPE_STOP_ON_ERROR)
+            {
+                SWSS_LOG_NOTICE("stop on error since previous operation failed");
+                break;
+            }
+        }
+    }
+
+    sai_status_t status = internal_redis_bulk_generic_remove(
+            SAI_OBJECT_TYPE_ROUTE_ENTRY,
+            serialized_object_ids,
+            wait,
+            object_statuses);
+
+    for (uint32_t idx = 0; idx < object_count; ++idx)
+    {
+        if (object_statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            continue;
+        }
+
+        object_statuses[idx] = meta_sai_remove_route_entry(&route_entry[idx], &redis_dummy_remove_route_entry);
+
+        if (object_statuses[idx] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("failed on index %u: %s",
+                    idx,
+                    serialized_object_ids[idx].c_str());
+
+            status = SAI_STATUS_FAILURE;
+        }
+    }
+
+    return status;
 }
 
 sai_status_t redis_dummy_set_route_entry(
@@ -202,18 +314,11 @@ sai_status_t sai_bulk_set_route_entry_attribute(
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
-    switch (type)
-    {
-        case SAI_BULK_OP_TYPE_STOP_ON_ERROR:
-        case SAI_BULK_OP_TYPE_INGORE_ERROR:
-             // ok
-             break;
-
-        default:
+    bool wait;
 
-             SWSS_LOG_ERROR("invalid bulk operation type %d", type);
-
-             return SAI_STATUS_INVALID_PARAMETER;
+    if (!internal_redis_bulk_op_type(type, wait))
+    {
+        return SAI_STATUS_INVALID_PARAMETER;
     }
 
     if (object_statuses == NULL)
@@ -237,8 +342,20 @@ sai_status_t sai_bulk_set_route_entry_attribute(
                 sai_serialize_route_entry(route_entry[idx]));
     }
 
+    /*
+     * Values in metadata before the set, to revert routes which syncd failed
+     * to set.
+     */
+
+    std::vector<sai_attribute_t> previous_attrs(object_count);
+    std::vector<bool> has_previous(object_count);
+
     for (uint32_t idx = 0; idx < object_count; ++idx)
     {
+        sai_object_meta_key_t meta_key = { .objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY, .objectkey = { .key = { .route_entry = route_entry[idx] } } };
+
+        has_previous[idx] = meta_get_previous_attr(meta_key, attr_list[idx].id, previous_attrs[idx]);
+
         sai_status_t status =
             meta_sai_set_route_entry(
                     &route_entry[idx],
@@ -263,15 +380,40 @@ sai_status_t sai_bulk_set_route_entry_attribute(
         }
     }
 
+    std::vector<sai_status_t> meta_statuses(object_statuses, object_statuses + object_count);
+
     /*
      * TODO: we need to record operation type
      */
 
-    return internal_redis_bulk_generic_set(
+    sai_status_t status = internal_redis_bulk_generic_set(
             SAI_OBJECT_TYPE_ROUTE_ENTRY,
             serialized_object_ids,
             attr_list,
+            wait,
             object_statuses);
+
+    for (uint32_t idx = object_count; idx-- > 0;)
+    {
+        if (meta_statuses[idx] != SAI_STATUS_SUCCESS || object_statuses[idx] == SAI_STATUS_SUCCESS)
+        {
+            continue;
+        }
+
+        /*
+         * Syncd failed to set this route, restore the previous value so the
+         * set can be retried. Done backwards since a route can be set more
+         * than once in one call.
+         */
+
+        if (!has_previous[idx] ||
+                meta_sai_set_route_entry(&route_entry[idx], &previous_attrs[idx], &redis_dummy_set_route_entry) != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("failed to restore previous value of %s", serialized_object_ids[idx].c_str());
+        }
+    }
+
+    return status;
 }
 
 sai_status_t sai_bulk_get_route_entry_attribute(
@@ -2,6 +2,7 @@
 #include "sairedis.h"
 
 #include "meta/saiserialize.h"
+#include "meta/saiserializebinary.h"
 
 #include <thread>
 
@@ -13,7 +14,14 @@ sai_status_t sai_redis_internal_notify_syncd(
 {
     SWSS_LOG_ENTER();
 
-    std::vector<swss::FieldValueTuple> entry;
+    /*
+     * Offer binary encoding of gets, syncd returns the version in the
+     * response when it supports it.
+     */
+
+    std::vector<swss::FieldValueTuple> entry = {
+        swss::FieldValueTuple(SYNCD_BINARY_ENCODING, std::to_string(SAI_SERIALIZE_BINARY_VERSION))
+    };
 
     // ASIC INIT/APPLY view with small letter 'a'
     // and response is recorded as capital letter 'A'
@@ -25,59 +33,58 @@ sai_status_t sai_redis_internal_notify_syncd(
 
     g_asicState->set(key, entry, "notify");
 
-    swss::Select s;
+    internal_redis_track_write();
 
-    s.addSelectable(g_redisGetConsumer.get());
+    SWSS_LOG_NOTICE("wait for notify response");
 
-    while (true)
-    {
-        SWSS_LOG_NOTICE("wait for notify response");
+    swss::KeyOpFieldsValuesTuple kco;
 
-        swss::Selectable *sel;
+    if (!internal_redis_wait_response("notify", kco))
+    {
+        SWSS_LOG_ERROR("notify syncd failed to get response");
 
-        int fd;
+        /*
+         * We don't know whether syncd executed it, gets can't be ordered
+         * with ASIC_STATE until the next notify.
+         */
 
-        int result = s.select(&sel, &fd, GET_RESPONSE_TIMEOUT);
+        internal_redis_reset_get_sequence(false);
 
-        if (result == swss::Select::OBJECT)
+        if (g_record)
         {
-            swss::KeyOpFieldsValuesTuple kco;
-
-            g_redisGetConsumer->pop(kco);
+            recordLine("A|SAI_STATUS_FAILURE");
+        }
 
-            const std::string &op = kfvOp(kco);
-            const std::string &opkey = kfvKey(kco);
+        return SAI_STATUS_FAILURE;
+    }
 
-            SWSS_LOG_NOTICE("notify response: %s", opkey.c_str());
+    const std::string &opkey = kfvKey(kco);
 
-            if (op != "notify")
-            {
-                continue;
-            }
+    SWSS_LOG_NOTICE("notify response: %s", opkey.c_str());
 
-            if (g_record)
-            {
-                recordLine("A|" + opkey);
-            }
+    internal_redis_reset_get_sequence(true);
 
-            sai_status_t status;
-            sai_deserialize_status(opkey, status);
+    bool binary = false;
 
-            return status;
+    for (const auto &fv: kfvFieldsValues(kco))
+    {
+        if (fvField(fv) == SYNCD_BINARY_ENCODING && fvValue(fv) == std::to_string(SAI_SERIALIZE_BINARY_VERSION))
+        {
+            binary = true;
         }
-
-        SWSS_LOG_ERROR("notify syncd failed to get response result from select: %d", result);
-        break;
     }
 
-    SWSS_LOG_ERROR("notify syncd failed to get response");
+    internal_redis_set_get_binary_encoding(binary);
 
     if (g_record)
     {
-        recordLine("A|SAI_STATUS_FAILURE");
+        recordLine("A|" + opkey);
     }
 
-    return SAI_STATUS_FAILURE;
+    sai_status_t status;
+    sai_deserialize_status(opkey, status);
+
+    return status;
 }
 
 sai_status_t sai_redis_notify_syncd(
@@ -225,14 +232,11 @@ sai_status_t redis_set_switch_attribute(
     {
         /*
          * Let's avoid using mutexes, since this attribute could be used in
-         * signal handler, so check it's value here. If set this attribute will
-         * be performed from multiple threads there is possibility for race
-         * condition here, but this doesn't matter since we only set logrotate
-         * flag, and if that happens we will just reopen file less times then
-         * actual set operation was called.
+         * signal handler, so check it's value here. Recorder only sets
+         * atomic flag here, file is reopened by recorder thread.
          */
 
-        g_logrotate = true;
+        g_recorder.rotate();
 
         return SAI_STATUS_SUCCESS;
     }
@@ -272,6 +276,10 @@ sai_status_t redis_set_switch_attribute(
             case SAI_REDIS_SWITCH_ATTR_RECORDING_OUTPUT_DIR:
                 return setRecordingOutputDir(*attr);
 
+            case SAI_REDIS_SWITCH_ATTR_RECORDING_BINARY:
+                g_recordBinary = attr->value.booldata;
+                return SAI_STATUS_SUCCESS;
+
             default:
                 break;
         }
@@ -84,10 +84,7 @@ void test_enable_recording()
     ASSERT_SUCCESS("Failed to enable recording");
 }
 
-class SaiAttrWrapper;
-extern std::unordered_map<std::string,
-       std::unordered_map<sai_attr_id_t,
-       std::shared_ptr<SaiAttrWrapper>>> ObjectAttrHash;
+extern void create_object(const sai_object_meta_key_t& meta_key);
 extern void object_reference_insert(sai_object_id_t oid);
 
 sai_object_id_t create_dummy_object_id(
@@ -142,8 +139,7 @@ void test_bulk_next_hop_group_member_create()
     sai_object_id_t hopgroup = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP_GROUP);
     object_reference_insert(hopgroup);
     sai_object_meta_key_t meta_key_hopgruop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP_GROUP, .objectkey = { .key = { .object_id = hopgroup } } };
-    std::string hopgroup_key = sai_serialize_object_meta_key(meta_key_hopgruop);
-    ObjectAttrHash[hopgroup_key] = { };
+    create_object(meta_key_hopgruop);
 
     for (uint32_t i = 0; i <  count; ++i)
     {
@@ -151,8 +147,7 @@ void test_bulk_next_hop_group_member_create()
         sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP);
         object_reference_insert(hop);
         sai_object_meta_key_t meta_key_hop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP, .objectkey = { .key = { .object_id = hop } } };
-        std::string hop_key = sai_serialize_object_meta_key(meta_key_hop);
-        ObjectAttrHash[hop_key] = { };
+        create_object(meta_key_hop);
 
         std::vector<sai_attribute_t> list(2);
         sai_attribute_t &attr1 = list[0];
@@ -183,6 +178,95 @@ void test_bulk_next_hop_group_member_create()
     }
 }
 
+void test_bulk_acl_counter_create_remove()
+{
+    SWSS_LOG_ENTER();
+
+    swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_NOTICE);
+
+    meta_init_db();
+    redis_clear_switch_ids();
+
+    swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_DEBUG);
+
+    sai_status_t    status;
+
+    sai_switch_api_t *sai_switch_api = NULL;
+
+    sai_api_query(SAI_API_SWITCH, (void**)&sai_switch_api);
+
+    uint32_t count = 3;
+
+    sai_attribute_t swattr;
+
+    swattr.id = SAI_SWITCH_ATTR_INIT_SWITCH;
+    swattr.value.booldata = true;
+
+    sai_object_id_t switch_id;
+    status = sai_switch_api->create_switch(&switch_id, 1, &swattr);
+
+    ASSERT_SUCCESS("Failed to create switch");
+
+    // acl table
+    sai_object_id_t table = create_dummy_object_id(SAI_OBJECT_TYPE_ACL_TABLE);
+    object_reference_insert(table);
+    sai_object_meta_key_t meta_key_table = { .objecttype = SAI_OBJECT_TYPE_ACL_TABLE, .objectkey = { .key = { .object_id = table } } };
+    create_object(meta_key_table);
+
+    std::vector<sai_attribute_t> counter_attrs(count);
+    std::vector<const sai_attribute_t *> counter_attrs_array;
+    std::vector<uint32_t> counter_attrs_count(count, 1);
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        counter_attrs[i].id = SAI_ACL_COUNTER_ATTR_TABLE_ID;
+        counter_attrs[i].value.oid = table;
+
+        counter_attrs_array.push_back(&counter_attrs[i]);
+    }
+
+    std::vector<sai_status_t> statuses(count);
+    std::vector<sai_object_id_t> object_id(count);
+
+    status = redis_bulk_object_create_acl_counters(switch_id, count, counter_attrs_count.data(), counter_attrs_array.data(),
+            SAI_BULK_OP_TYPE_INGORE_ERROR, object_id.data(), statuses.data());
+
+    ASSERT_SUCCESS("Failed to create acl counters");
+
+    for (size_t j = 0; j < statuses.size(); j++)
+    {
+        status = statuses[j];
+        ASSERT_SUCCESS("Failed to create acl counter # %zu", j);
+    }
+
+    status = redis_bulk_object_remove_acl_counters(count, object_id.data(), SAI_BULK_OP_TYPE_INGORE_ERROR, statuses.data());
+
+    ASSERT_SUCCESS("Failed to remove acl counters");
+
+    for (size_t j = 0; j < statuses.size(); j++)
+    {
+        status = statuses[j];
+        ASSERT_SUCCESS("Failed to remove acl counter # %zu", j);
+    }
+
+    // removed counters are rejected by metadata before reaching syncd
+
+    status = redis_bulk_object_remove_acl_counters(count, object_id.data(), SAI_BULK_OP_TYPE_INGORE_ERROR, statuses.data());
+
+    if (status == SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_THROW("Removing removed acl counters should fail");
+    }
+
+    for (size_t j = 0; j < statuses.size(); j++)
+    {
+        if (statuses[j] == SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_THROW("Removed acl counter # %zu was removed again", j);
+        }
+    }
+}
+
 void test_bulk_route_set()
 {
     SWSS_LOG_ENTER();
@@ -231,15 +315,13 @@ void test_bulk_route_set()
         sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER);
         object_reference_insert(vr);
         sai_object_meta_key_t meta_key_vr = { .objecttype = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .objectkey = { .key = { .object_id = vr } } };
-        std::string vr_key = sai_serialize_object_meta_key(meta_key_vr);
-        ObjectAttrHash[vr_key] = { };
+        create_object(meta_key_vr);
 
         // next hop
         sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP);
         object_reference_insert(hop);
         sai_object_meta_key_t meta_key_hop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP, .objectkey = { .key = { .object_id = hop } } };
-        std::string hop_key = sai_serialize_object_meta_key(meta_key_hop);
-        ObjectAttrHash[hop_key] = { };
+        create_object(meta_key_hop);
 
         route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
         route_entry.destination.addr.ip4 = htonl(0x0a000000 | i);
@@ -333,6 +415,8 @@ int main()
 
         test_bulk_next_hop_group_member_create();
 
+        test_bulk_acl_counter_create_remove();
+
         test_bulk_route_set();
 
         sai_api_uninitialize();
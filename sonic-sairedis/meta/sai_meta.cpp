@@ -9,6 +9,7 @@
 #include <iostream>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <set>
 #include <memory>
 #include <map>
@@ -139,13 +140,218 @@ std::string get_attr_info(const sai_attr_metadata_t& md)
 #define META_LOG_THROW(md, format, ...) SWSS_LOG_THROW("%s " format, get_attr_info(md).c_str(), ##__VA_ARGS__)
 
 /*
+ * Meta DB is keyed on binary object meta key, so no key serialization is
+ * needed on each API call. Hash and compare only look at key members used by
+ * given object type, since non object id structs can contain padding and
+ * unions.
+ */
+
+static inline void meta_hash_combine(
+        _Inout_ size_t& seed,
+        _In_ uint64_t value)
+{
+    seed ^= std::hash<uint64_t>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+static void meta_hash_ip_address(
+        _Inout_ size_t& seed,
+        _In_ sai_ip_addr_family_t family,
+        _In_ const sai_ip_addr_t& addr)
+{
+    meta_hash_combine(seed, family);
+
+    if (family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        meta_hash_combine(seed, addr.ip4);
+        return;
+    }
+
+    uint64_t ip6[2];
+
+    memcpy(ip6, addr.ip6, sizeof(ip6));
+
+    meta_hash_combine(seed, ip6[0]);
+    meta_hash_combine(seed, ip6[1]);
+}
+
+static bool meta_equal_ip_address(
+        _In_ sai_ip_addr_family_t family,
+        _In_ const sai_ip_addr_t& a,
+        _In_ const sai_ip_addr_t& b)
+{
+    if (family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        return a.ip4 == b.ip4;
+    }
+
+    return memcmp(a.ip6, b.ip6, sizeof(a.ip6)) == 0;
+}
+
+struct MetaKeyHash
+{
+    size_t operator()(
+            _In_ const sai_object_meta_key_t& meta_key) const
+    {
+        size_t seed = meta_key.objecttype;
+
+        switch (meta_key.objecttype)
+        {
+            case SAI_OBJECT_TYPE_FDB_ENTRY:
+                {
+                    const auto& fe = meta_key.objectkey.key.fdb_entry;
+
+                    uint64_t mac = 0;
+
+                    memcpy(&mac, fe.mac_address, sizeof(fe.mac_address));
+
+                    meta_hash_combine(seed, fe.switch_id);
+                    meta_hash_combine(seed, mac);
+                    meta_hash_combine(seed, fe.vlan_id);
+                    meta_hash_combine(seed, fe.bridge_type);
+                    meta_hash_combine(seed, fe.bridge_id);
+                }
+                break;
+
+            case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+                {
+                    const auto& re = meta_key.objectkey.key.route_entry;
+
+                    meta_hash_combine(seed, re.switch_id);
+                    meta_hash_combine(seed, re.vr_id);
+                    meta_hash_ip_address(seed, re.destination.addr_family, re.destination.addr);
+                    meta_hash_ip_address(seed, re.destination.addr_family, re.destination.mask);
+                }
+                break;
+
+            case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+                {
+                    const auto& ne = meta_key.objectkey.key.neighbor_entry;
+
+                    meta_hash_combine(seed, ne.switch_id);
+                    meta_hash_combine(seed, ne.rif_id);
+                    meta_hash_ip_address(seed, ne.ip_address.addr_family, ne.ip_address.addr);
+                }
+                break;
+
+            default:
+                meta_hash_combine(seed, meta_key.objectkey.key.object_id);
+                break;
+        }
+
+        return seed;
+    }
+};
+
+struct MetaKeyEqual
+{
+    bool operator()(
+            _In_ const sai_object_meta_key_t& a,
+            _In_ const sai_object_meta_key_t& b) const
+    {
+        if (a.objecttype != b.objecttype)
+        {
+            return false;
+        }
+
+        switch (a.objecttype)
+        {
+            case SAI_OBJECT_TYPE_FDB_ENTRY:
+                {
+                    const auto& fa = a.objectkey.key.fdb_entry;
+                    const auto& fb = b.objectkey.key.fdb_entry;
+
+                    return fa.switch_id == fb.switch_id &&
+                        memcmp(fa.mac_address, fb.mac_address, sizeof(fa.mac_address)) == 0 &&
+                        fa.vlan_id == fb.vlan_id &&
+                        fa.bridge_type == fb.bridge_type &&
+                        fa.bridge_id == fb.bridge_id;
+                }
+
+            case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+                {
+                    const auto& ra = a.objectkey.key.route_entry;
+                    const auto& rb = b.objectkey.key.route_entry;
+
+                    return ra.switch_id == rb.switch_id &&
+                        ra.vr_id == rb.vr_id &&
+                        ra.destination.addr_family == rb.destination.addr_family &&
+                        meta_equal_ip_address(ra.destination.addr_family, ra.destination.addr, rb.destination.addr) &&
+                        meta_equal_ip_address(ra.destination.addr_family, ra.destination.mask, rb.destination.mask);
+                }
+
+            case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+                {
+                    const auto& na = a.objectkey.key.neighbor_entry;
+                    const auto& nb = b.objectkey.key.neighbor_entry;
+
+                    return na.switch_id == nb.switch_id &&
+                        na.rif_id == nb.rif_id &&
+                        na.ip_address.addr_family == nb.ip_address.addr_family &&
+                        meta_equal_ip_address(na.ip_address.addr_family, na.ip_address.addr, nb.ip_address.addr);
+                }
+
+            default:
+                return a.objectkey.key.object_id == b.objectkey.key.object_id;
+        }
+    }
+};
+
+/*
+ * Single meta DB entry. Attributes are kept in flat vector, since objects
+ * have only few attributes set. For object ids entry also holds reference
+ * count, so both are found with one lookup. Reference can be inserted before
+ * object is created, so they are tracked separately.
+ *
  * Non object is don't need reference count since they are leafs and can be
  * removed at any time.
  */
 
-static std::unordered_map<sai_object_id_t,int32_t> ObjectReferences;
-static std::unordered_map<std::string,std::string> AttributeKeys;
-std::unordered_map<std::string,std::unordered_map<sai_attr_id_t,std::shared_ptr<SaiAttrWrapper>>> ObjectAttrHash;
+class MetaObject
+{
+    public:
+
+        bool created = false;
+
+        bool referenced = false;
+
+        int32_t references = 0;
+
+        std::vector<std::shared_ptr<SaiAttrWrapper>> attrs;
+
+        /*
+         * Constructed key of KEY attributes, empty if object don't have any.
+         */
+
+        std::string attributeKey;
+};
+
+static std::unordered_map<sai_object_meta_key_t, MetaObject, MetaKeyHash, MetaKeyEqual> ObjectHash;
+static std::unordered_set<std::string> AttributeKeys;
+
+sai_object_meta_key_t object_reference_meta_key(
+        _In_ sai_object_id_t oid)
+{
+    SWSS_LOG_ENTER();
+
+    sai_object_meta_key_t meta_key = { .objecttype = sai_object_type_query(oid), .objectkey = { .key = { .object_id = oid } } };
+
+    return meta_key;
+}
+
+MetaObject* object_reference_entry(
+        _In_ sai_object_id_t oid)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = ObjectHash.find(object_reference_meta_key(oid));
+
+    if (it == ObjectHash.end() || !it->second.referenced)
+    {
+        return NULL;
+    }
+
+    return &it->second;
+}
 
 // GENERIC REFERENCE FUNCTIONS
 
@@ -154,7 +360,7 @@ bool object_reference_exists(
 {
     SWSS_LOG_ENTER();
 
-    bool exists = ObjectReferences.find(oid) != ObjectReferences.end();
+    bool exists = object_reference_entry(oid) != NULL;
 
     SWSS_LOG_DEBUG("object 0x%lx refrence: %s", oid, exists ? "exists" : "missing");
 
@@ -175,14 +381,16 @@ void object_reference_inc(
         return;
     }
 
-    if (!object_reference_exists(oid))
+    MetaObject* entry = object_reference_entry(oid);
+
+    if (entry == NULL)
     {
         SWSS_LOG_THROW("FATAL: object oid 0x%lx not in reference map", oid);
     }
 
-    ObjectReferences[oid]++;
+    entry->references++;
 
-    SWSS_LOG_DEBUG("increased reference on oid 0x%lx to %d", oid, ObjectReferences[oid]);
+    SWSS_LOG_DEBUG("increased reference on oid 0x%lx to %d", oid, entry->references);
 }
 
 void object_reference_dec(
@@ -199,19 +407,21 @@ void object_reference_dec(
         return;
     }
 
-    if (!object_reference_exists(oid))
+    MetaObject* entry = object_reference_entry(oid);
+
+    if (entry == NULL)
     {
         SWSS_LOG_THROW("FATAL: object oid 0x%lx not in reference map", oid);
     }
 
-    ObjectReferences[oid]--;
+    entry->references--;
 
-    if (ObjectReferences[oid] < 0)
+    if (entry->references < 0)
     {
         SWSS_LOG_THROW("FATAL: object oid 0x%lx reference count is negative!", oid);
     }
 
-    SWSS_LOG_DEBUG("decreased reference on oid 0x%lx to %d", oid, ObjectReferences[oid]);
+    SWSS_LOG_DEBUG("decreased reference on oid 0x%lx to %d", oid, entry->references);
 }
 
 void object_reference_dec(
@@ -241,12 +451,15 @@ void object_reference_insert(
 {
     SWSS_LOG_ENTER();
 
-    if (object_reference_exists(oid))
+    auto& entry = ObjectHash[object_reference_meta_key(oid)];
+
+    if (entry.referenced)
     {
         SWSS_LOG_THROW("FATAL: object oid 0x%lx already in reference map", oid);
     }
 
-    ObjectReferences[oid] = 0;
+    entry.referenced = true;
+    entry.references = 0;
 
     SWSS_LOG_DEBUG("inserted reference on 0x%lx", oid);
 }
@@ -256,9 +469,11 @@ int32_t object_reference_count(
 {
     SWSS_LOG_ENTER();
 
-    if (object_reference_exists(oid))
+    MetaObject* entry = object_reference_entry(oid);
+
+    if (entry != NULL)
     {
-        int32_t count = ObjectReferences[oid];
+        int32_t count = entry->references;
 
         SWSS_LOG_DEBUG("reference count on oid 0x%lx is %d", oid, count);
 
@@ -273,31 +488,43 @@ void object_reference_remove(
 {
     SWSS_LOG_ENTER();
 
-    if (object_reference_exists(oid))
+    auto it = ObjectHash.find(object_reference_meta_key(oid));
+
+    if (it == ObjectHash.end() || !it->second.referenced)
     {
-        int32_t count = object_reference_count(oid);
+        return;
+    }
 
-        if (count > 0)
-        {
-            SWSS_LOG_THROW("FATAL: removing object oid 0x%lx but reference count is: %d", oid, count);
-        }
+    int32_t count = it->second.references;
+
+    if (count > 0)
+    {
+        SWSS_LOG_THROW("FATAL: removing object oid 0x%lx but reference count is: %d", oid, count);
     }
 
     SWSS_LOG_DEBUG("removing object oid 0x%lx reference", oid);
 
-    ObjectReferences.erase(oid);
+    it->second.referenced = false;
+
+    if (!it->second.created)
+    {
+        ObjectHash.erase(it);
+    }
 }
 
-bool object_exists(
-        _In_ const std::string& key)
+MetaObject* object_entry(
+        _In_ const sai_object_meta_key_t& meta_key)
 {
     SWSS_LOG_ENTER();
 
-    bool exists = ObjectAttrHash.find(key) != ObjectAttrHash.end();
+    auto it = ObjectHash.find(meta_key);
 
-    SWSS_LOG_DEBUG("%s %s", key.c_str(), exists ? "exists" : "missing");
+    if (it == ObjectHash.end() || !it->second.created)
+    {
+        return NULL;
+    }
 
-    return exists;
+    return &it->second;
 }
 
 bool object_exists(
@@ -305,9 +532,7 @@ bool object_exists(
 {
     SWSS_LOG_ENTER();
 
-    std::string key = sai_serialize_object_meta_key(meta_key);
-
-    return object_exists(key);
+    return object_entry(meta_key) != NULL;
 }
 
 sai_status_t meta_init_db()
@@ -318,8 +543,7 @@ sai_status_t meta_init_db()
      * This DB will contain objects from all switches.
      */
 
-    ObjectReferences.clear();
-    ObjectAttrHash.clear();
+    ObjectHash.clear();
     AttributeKeys.clear();
 
     return SAI_STATUS_SUCCESS;
@@ -331,34 +555,113 @@ const sai_attribute_t* get_object_previous_attr(
 {
     SWSS_LOG_ENTER();
 
-    std::string key = sai_serialize_object_meta_key(meta_key);
-
-    auto it = ObjectAttrHash.find(key);
+    MetaObject* entry = object_entry(meta_key);
 
-    if (it == ObjectAttrHash.end())
+    if (entry == NULL)
     {
-        SWSS_LOG_ERROR("object key %s not found", key.c_str());
+        SWSS_LOG_ERROR("object key %s not found", sai_serialize_object_meta_key(meta_key).c_str());
 
         return NULL;
     }
 
-    auto ita = it->second.find(md.attrid);
+    for (const auto& attr: entry->attrs)
+    {
+        if (attr->getattr()->id == md.attrid)
+        {
+            /*
+             * NOTE: this is actually dangerous since we possibly expose memory
+             * on attribute list that could be already freed.
+             */
 
-    if (ita == it->second.end())
+            return attr->getattr();
+        }
+    }
+
+    /*
+     * Attribute id not found.
+     */
+
+    return NULL;
+}
+
+bool meta_get_previous_attr(
+        _In_ const sai_object_meta_key_t& meta_key,
+        _In_ sai_attr_id_t attr_id,
+        _Out_ sai_attribute_t &attr)
+{
+    SWSS_LOG_ENTER();
+
+    auto mdp = sai_metadata_get_attr_metadata(meta_key.objecttype, attr_id);
+
+    if (mdp == NULL)
     {
-        /*
-         * Attribute id not found.
-         */
+        SWSS_LOG_ERROR("unable to find attribute metadata %d for %s",
+                attr_id,
+                sai_serialize_object_type(meta_key.objecttype).c_str());
 
-        return NULL;
+        return false;
+    }
+
+    const sai_attr_metadata_t& md = *mdp;
+
+    switch (md.attrvaluetype)
+    {
+        case SAI_ATTR_VALUE_TYPE_BOOL:
+        case SAI_ATTR_VALUE_TYPE_UINT8:
+        case SAI_ATTR_VALUE_TYPE_INT8:
+        case SAI_ATTR_VALUE_TYPE_UINT16:
+        case SAI_ATTR_VALUE_TYPE_INT16:
+        case SAI_ATTR_VALUE_TYPE_UINT32:
+        case SAI_ATTR_VALUE_TYPE_INT32:
+        case SAI_ATTR_VALUE_TYPE_UINT64:
+        case SAI_ATTR_VALUE_TYPE_INT64:
+        case SAI_ATTR_VALUE_TYPE_MAC:
+        case SAI_ATTR_VALUE_TYPE_IPV4:
+        case SAI_ATTR_VALUE_TYPE_IPV6:
+        case SAI_ATTR_VALUE_TYPE_IP_ADDRESS:
+        case SAI_ATTR_VALUE_TYPE_OBJECT_ID:
+            break;
+
+        default:
+
+            /*
+             * Lists are owned by metadata, they can't be handed out.
+             */
+
+            META_LOG_ERROR(md, "previous value of this attribute type can't be copied");
+
+            return false;
+    }
+
+    if (object_entry(meta_key) == NULL)
+    {
+        SWSS_LOG_ERROR("object key %s not found", sai_serialize_object_meta_key(meta_key).c_str());
+
+        return false;
+    }
+
+    const sai_attribute_t *previous = get_object_previous_attr(meta_key, md);
+
+    if (previous != NULL)
+    {
+        attr = *previous;
+
+        return true;
     }
 
     /*
-     * NOTE: this is actually dangerous since we possibly expose memory on
-     * attribute list that could be already freed.
+     * Attribute was not set, it has its default value.
      */
 
-    return ita->second->getattr();
+    if (md.defaultvaluetype == SAI_DEFAULT_VALUE_TYPE_CONST && md.defaultvalue != NULL)
+    {
+        attr.id = attr_id;
+        attr.value = *md.defaultvalue;
+
+        return true;
+    }
+
+    return false;
 }
 
 void set_object(
@@ -368,38 +671,68 @@ void set_object(
 {
     SWSS_LOG_ENTER();
 
-    std::string key = sai_serialize_object_meta_key(meta_key);
+    MetaObject* entry = object_entry(meta_key);
 
-    if (!object_exists(key))
+    if (entry == NULL)
     {
-        SWSS_LOG_THROW("FATAL: object %s don't exists", key.c_str());
+        SWSS_LOG_THROW("FATAL: object %s don't exists", sai_serialize_object_meta_key(meta_key).c_str());
     }
 
-    META_LOG_DEBUG(md, "set attribute %d on %s", attr->id, key.c_str());
+    META_LOG_DEBUG(md, "set attribute %d", attr->id);
+
+    auto wrapper = std::make_shared<SaiAttrWrapper>(&md, *attr);
 
-    ObjectAttrHash[key][attr->id] = std::make_shared<SaiAttrWrapper>(&md, *attr);
+    for (auto& a: entry->attrs)
+    {
+        if (a->getattr()->id == attr->id)
+        {
+            a = wrapper;
+            return;
+        }
+    }
+
+    entry->attrs.push_back(wrapper);
 }
 
 const std::vector<std::shared_ptr<SaiAttrWrapper>> get_object_attributes(
         _In_ const sai_object_meta_key_t& meta_key)
 {
-    std::string key = sai_serialize_object_meta_key(meta_key);
+    MetaObject* entry = object_entry(meta_key);
 
-    if (!object_exists(key))
+    if (entry == NULL)
     {
-        SWSS_LOG_THROW("FATAL: object %s don't exists", key.c_str());
+        SWSS_LOG_THROW("FATAL: object %s don't exists", sai_serialize_object_meta_key(meta_key).c_str());
     }
 
-    std::vector<std::shared_ptr<SaiAttrWrapper>> attrs;
+    return entry->attrs;
+}
 
-    const auto& hash = ObjectAttrHash[key];
+bool attribute_key_exists(
+        _In_ const std::string& attributeKey)
+{
+    SWSS_LOG_ENTER();
 
-    for (auto it = hash.begin(); it != hash.end(); ++it)
+    return AttributeKeys.find(attributeKey) != AttributeKeys.end();
+}
+
+void set_object_attribute_key(
+        _In_ const sai_object_meta_key_t& meta_key,
+        _In_ const std::string& attributeKey)
+{
+    SWSS_LOG_ENTER();
+
+    MetaObject* entry = object_entry(meta_key);
+
+    if (entry == NULL)
     {
-        attrs.push_back(it->second);
+        SWSS_LOG_THROW("FATAL: object %s don't exists", sai_serialize_object_meta_key(meta_key).c_str());
     }
 
-    return attrs;
+    AttributeKeys.erase(entry->attributeKey);
+
+    entry->attributeKey = attributeKey;
+
+    AttributeKeys.insert(attributeKey);
 }
 
 void remove_object(
@@ -407,16 +740,32 @@ void remove_object(
 {
     SWSS_LOG_ENTER();
 
-    std::string key = sai_serialize_object_meta_key(meta_key);
+    auto it = ObjectHash.find(meta_key);
 
-    if (!object_exists(key))
+    if (it == ObjectHash.end() || !it->second.created)
     {
-        SWSS_LOG_THROW("FATAL: object %s don't exists", key.c_str());
+        SWSS_LOG_THROW("FATAL: object %s don't exists", sai_serialize_object_meta_key(meta_key).c_str());
     }
 
-    SWSS_LOG_DEBUG("removing object %s", key.c_str());
+    auto& entry = it->second;
+
+    if (!entry.attributeKey.empty())
+    {
+        SWSS_LOG_DEBUG("erasing attributes key %s", entry.attributeKey.c_str());
+
+        AttributeKeys.erase(entry.attributeKey);
+    }
 
-    ObjectAttrHash.erase(key);
+    if (entry.referenced)
+    {
+        entry.created = false;
+        entry.attrs.clear();
+        entry.attributeKey.clear();
+    }
+    else
+    {
+        ObjectHash.erase(it);
+    }
 }
 
 void create_object(
@@ -424,16 +773,14 @@ void create_object(
 {
     SWSS_LOG_ENTER();
 
-    std::string key = sai_serialize_object_meta_key(meta_key);
+    auto& entry = ObjectHash[meta_key];
 
-    if (object_exists(key))
+    if (entry.created)
     {
-        SWSS_LOG_THROW("FATAL: object %s already exists", key.c_str());
+        SWSS_LOG_THROW("FATAL: object %s already exists", sai_serialize_object_meta_key(meta_key).c_str());
     }
 
-    SWSS_LOG_DEBUG("creating object %s", key.c_str());
-
-    ObjectAttrHash[key] = {};
+    entry.created = true;
 }
 
 sai_status_t meta_generic_validation_objlist(
@@ -1304,11 +1651,9 @@ sai_status_t meta_generic_validation_create(
     if (info->isnonobjectid)
     {
         // just sanity check if object already exists
-        std::string key = sai_serialize_object_meta_key(meta_key);
-
-        if (object_exists(key))
+        if (object_exists(meta_key))
         {
-            SWSS_LOG_ERROR("object key %s already exists", key.c_str());
+            SWSS_LOG_ERROR("object key %s already exists", sai_serialize_object_meta_key(meta_key).c_str());
 
             return SAI_STATUS_ITEM_ALREADY_EXISTS;
         }
@@ -1531,16 +1876,13 @@ sai_status_t meta_generic_validation_create(
     {
         std::string key = construct_key(meta_key, attr_count, attr_list);
 
-        for (auto& it: AttributeKeys)
-        {
-            // since we didn't created oid yet, we don't know if attribute key exists, check all
+        // since we didn't created oid yet, we don't know if attribute key exists, check all
 
-            if (it.second == key)
-            {
-                SWSS_LOG_ERROR("attribute key %s already exists, can't create", key.c_str());
+        if (attribute_key_exists(key))
+        {
+            SWSS_LOG_ERROR("attribute key %s already exists, can't create", key.c_str());
 
-                return SAI_STATUS_INVALID_PARAMETER;
-            }
+            return SAI_STATUS_INVALID_PARAMETER;
         }
     }
 
@@ -1552,11 +1894,9 @@ sai_status_t meta_generic_validation_remove(
 {
     SWSS_LOG_ENTER();
 
-    std::string key = sai_serialize_object_meta_key(meta_key);
-
-    if (!object_exists(key))
+    if (!object_exists(meta_key))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", sai_serialize_object_meta_key(meta_key).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -1972,9 +2312,7 @@ sai_status_t meta_generic_validation_set(
 
         if (get_object_previous_attr(meta_key, md) == NULL)
         {
-            std::string key = sai_serialize_object_meta_key(meta_key);
-
-            META_LOG_WARN(md, "set for conditional, but not found in local db, object %s created on switch ?", key.c_str());
+            META_LOG_WARN(md, "set for conditional, but not found in local db, object %s created on switch ?", sai_serialize_object_meta_key(meta_key).c_str());
         }
         else
         {
@@ -1986,11 +2324,9 @@ sai_status_t meta_generic_validation_set(
 
     // check if object on which we perform operation exists
 
-    std::string key = sai_serialize_object_meta_key(meta_key);
-
-    if (!object_exists(key))
+    if (!object_exists(meta_key))
     {
-        META_LOG_ERROR(md, "object key %s doesn't exist", key.c_str());
+        META_LOG_ERROR(md, "object key %s doesn't exist", sai_serialize_object_meta_key(meta_key).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -1999,7 +2335,7 @@ sai_status_t meta_generic_validation_set(
 
     if (info->isnonobjectid)
     {
-        SWSS_LOG_DEBUG("object key exists: %s", key.c_str());
+        SWSS_LOG_DEBUG("object key exists");
     }
     else
     {
@@ -2103,10 +2439,8 @@ sai_status_t meta_generic_validation_get(
             // (this will not respect create_only with default)
             if (get_object_previous_attr(meta_key, md) == NULL)
             {
-                std::string key = sai_serialize_object_meta_key(meta_key);
-
                 // XXX produces too much noise
-                // META_LOG_WARN(md, "get for conditional, but not found in local db, object %s created on switch ?", key.c_str());
+                // META_LOG_WARN(md, "get for conditional, but not found in local db, object %s created on switch ?", sai_serialize_object_meta_key(meta_key).c_str());
             }
             else
             {
@@ -2253,11 +2587,9 @@ sai_status_t meta_generic_validation_get(
         }
     }
 
-    std::string key = sai_serialize_object_meta_key(meta_key);
-
-    if (!object_exists(key))
+    if (!object_exists(meta_key))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", sai_serialize_object_meta_key(meta_key).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -2266,7 +2598,7 @@ sai_status_t meta_generic_validation_get(
 
     if (info->isnonobjectid)
     {
-        SWSS_LOG_DEBUG("object key exists: %s", key.c_str());
+        SWSS_LOG_DEBUG("object key exists");
     }
     else
     {
@@ -2307,11 +2639,9 @@ void meta_generic_validation_post_create(
 {
     SWSS_LOG_ENTER();
 
-    std::string key = sai_serialize_object_meta_key(meta_key);
-
-    if (object_exists(key))
+    if (object_exists(meta_key))
     {
-        SWSS_LOG_ERROR("object key %s already exists (vendor bug?)", key.c_str());
+        SWSS_LOG_ERROR("object key %s already exists (vendor bug?)", sai_serialize_object_meta_key(meta_key).c_str());
 
         // this may produce inconsistency
     }
@@ -2535,9 +2865,7 @@ void meta_generic_validation_post_create(
 
     if (haskeys)
     {
-        std::string ok = sai_serialize_object_meta_key(meta_key);
-
-        AttributeKeys[ok] = construct_key(meta_key, attr_count, attr_list);
+        set_object_attribute_key(meta_key, construct_key(meta_key, attr_count, attr_list));
     }
 }
 
@@ -2695,15 +3023,6 @@ void meta_generic_validation_post_remove(
     }
 
     remove_object(meta_key);
-
-    std::string ok = sai_serialize_object_meta_key(meta_key);
-
-    if (AttributeKeys.find(ok) != AttributeKeys.end())
-    {
-        SWSS_LOG_DEBUG("erasing attributes key %s", AttributeKeys[ok].c_str());
-
-        AttributeKeys.erase(ok);
-    }
 }
 
 void meta_generic_validation_post_set(
@@ -2733,10 +3052,8 @@ void meta_generic_validation_post_set(
              * If default value type will be internal then we should warn.
              */
 
-            std::string key = sai_serialize_object_meta_key(meta_key);
-
             // XXX produces too much noise
-            // META_LOG_WARN(md, "post set, not in local db, FIX snoop!: %s", key.c_str());
+            // META_LOG_WARN(md, "post set, not in local db, FIX snoop!: %s", sai_serialize_object_meta_key(meta_key).c_str());
         }
     }
 
@@ -2948,10 +3265,8 @@ void meta_generic_validation_post_get_objlist(
     {
         if (get_object_previous_attr(meta_key, md) == NULL)
         {
-            std::string key = sai_serialize_object_meta_key(meta_key);
-
             // XXX produces too much noise
-            // META_LOG_WARN(md, "post get, not in local db, FIX snoop!: %s", key.c_str());
+            // META_LOG_WARN(md, "post get, not in local db, FIX snoop!: %s", sai_serialize_object_meta_key(meta_key).c_str());
         }
     }
 
@@ -3303,13 +3618,11 @@ sai_status_t meta_sai_validate_fdb_entry(
 
     sai_object_meta_key_t meta_key_fdb = { .objecttype = SAI_OBJECT_TYPE_FDB_ENTRY, .objectkey = { .key = { .fdb_entry = *fdb_entry } } };
 
-    std::string key_fdb = sai_serialize_object_meta_key(meta_key_fdb);
-
     if (create)
     {
-        if (object_exists(key_fdb))
+        if (object_exists(meta_key_fdb))
         {
-            SWSS_LOG_ERROR("object key %s already exists", key_fdb.c_str());
+            SWSS_LOG_ERROR("object key %s already exists", sai_serialize_object_meta_key(meta_key_fdb).c_str());
 
             return SAI_STATUS_ITEM_ALREADY_EXISTS;
         }
@@ -3319,9 +3632,9 @@ sai_status_t meta_sai_validate_fdb_entry(
 
     // set, get, remove
 
-    if (!object_exists(key_fdb) && !get)
+    if (!object_exists(meta_key_fdb) && !get)
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_fdb.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", sai_serialize_object_meta_key(meta_key_fdb).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -3589,24 +3902,20 @@ sai_status_t meta_sai_validate_neighbor_entry(
 
     sai_object_meta_key_t meta_key_rif = { .objecttype = expected, .objectkey = { .key = { .object_id = rif } } };
 
-    std::string key_rif = sai_serialize_object_meta_key(meta_key_rif);
-
-    if (!object_exists(key_rif))
+    if (!object_exists(meta_key_rif))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_rif.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", sai_serialize_object_meta_key(meta_key_rif).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
 
     sai_object_meta_key_t meta_key_neighbor = { .objecttype = SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, .objectkey = { .key = { .neighbor_entry = *neighbor_entry } } };
 
-    std::string key_neighbor = sai_serialize_object_meta_key(meta_key_neighbor);
-
     if (create)
     {
-        if (object_exists(key_neighbor))
+        if (object_exists(meta_key_neighbor))
         {
-            SWSS_LOG_ERROR("object key %s already exists", key_neighbor.c_str());
+            SWSS_LOG_ERROR("object key %s already exists", sai_serialize_object_meta_key(meta_key_neighbor).c_str());
 
             return SAI_STATUS_ITEM_ALREADY_EXISTS;
         }
@@ -3616,9 +3925,9 @@ sai_status_t meta_sai_validate_neighbor_entry(
 
     // set, get, remove
 
-    if (!object_exists(key_neighbor))
+    if (!object_exists(meta_key_neighbor))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_neighbor.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", sai_serialize_object_meta_key(meta_key_neighbor).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -3896,11 +4205,9 @@ sai_status_t meta_sai_validate_route_entry(
 
     sai_object_meta_key_t meta_key_vr = { .objecttype = expected, .objectkey = { .key = { .object_id = vr } } };
 
-    std::string key_vr = sai_serialize_object_meta_key(meta_key_vr);
-
-    if (!object_exists(key_vr))
+    if (!object_exists(meta_key_vr))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_vr.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", sai_serialize_object_meta_key(meta_key_vr).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -3909,13 +4216,11 @@ sai_status_t meta_sai_validate_route_entry(
 
     sai_object_meta_key_t meta_key_route = { .objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY, .objectkey = { .key = { .route_entry = *route_entry } } };
 
-    std::string key_route = sai_serialize_object_meta_key(meta_key_route);
-
     if (create)
     {
-        if (object_exists(key_route))
+        if (object_exists(meta_key_route))
         {
-            SWSS_LOG_ERROR("object key %s already exists", key_route.c_str());
+            SWSS_LOG_ERROR("object key %s already exists", sai_serialize_object_meta_key(meta_key_route).c_str());
 
             return SAI_STATUS_ITEM_ALREADY_EXISTS;
         }
@@ -3925,9 +4230,9 @@ sai_status_t meta_sai_validate_route_entry(
 
     // set, get, remove
 
-    if (!object_exists(key_route))
+    if (!object_exists(meta_key_route))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_route.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", sai_serialize_object_meta_key(meta_key_route).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -3985,9 +4290,8 @@ sai_status_t meta_sai_create_route_entry(
     return status;
 }
 
-sai_status_t meta_sai_remove_route_entry(
-        _In_ const sai_route_entry_t* route_entry,
-        _In_ sai_remove_route_entry_fn remove)
+sai_status_t meta_sai_validate_remove_route_entry(
+        _In_ const sai_route_entry_t* route_entry)
 {
     SWSS_LOG_ENTER();
 
@@ -4000,13 +4304,24 @@ sai_status_t meta_sai_remove_route_entry(
 
     sai_object_meta_key_t meta_key = { .objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY, .objectkey = { .key = { .route_entry = *route_entry  } } };
 
-    status = meta_generic_validation_remove(meta_key);
+    return meta_generic_validation_remove(meta_key);
+}
+
+sai_status_t meta_sai_remove_route_entry(
+        _In_ const sai_route_entry_t* route_entry,
+        _In_ sai_remove_route_entry_fn remove)
+{
+    SWSS_LOG_ENTER();
+
+    sai_status_t status = meta_sai_validate_remove_route_entry(route_entry);
 
     if (status != SAI_STATUS_SUCCESS)
     {
         return status;
     }
 
+    sai_object_meta_key_t meta_key = { .objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY, .objectkey = { .key = { .route_entry = *route_entry  } } };
+
     if (remove == NULL)
     {
         SWSS_LOG_ERROR("remove function pointer is NULL");
@@ -4203,11 +4518,9 @@ sai_status_t meta_sai_validate_oid(
 
     sai_object_meta_key_t meta_key_oid = { .objecttype = expected, .objectkey = { .key = { .object_id = oid } } };
 
-    std::string key_oid = sai_serialize_object_meta_key(meta_key_oid);
-
-    if (!object_exists(key_oid))
+    if (!object_exists(meta_key_oid))
     {
-        SWSS_LOG_ERROR("object key %s doesn't exist", key_oid.c_str());
+        SWSS_LOG_ERROR("object key %s doesn't exist", sai_serialize_object_meta_key(meta_key_oid).c_str());
 
         return SAI_STATUS_INVALID_PARAMETER;
     }
@@ -4280,10 +4593,9 @@ sai_status_t meta_sai_create_oid(
     return status;
 }
 
-sai_status_t meta_sai_remove_oid(
+sai_status_t meta_sai_validate_remove_oid(
         _In_ sai_object_type_t object_type,
-        _In_ sai_object_id_t object_id,
-        _In_ sai_remove_generic_fn remove)
+        _In_ sai_object_id_t object_id)
 {
     SWSS_LOG_ENTER();
 
@@ -4296,13 +4608,25 @@ sai_status_t meta_sai_remove_oid(
 
     sai_object_meta_key_t meta_key = { .objecttype = object_type, .objectkey = { .key = { .object_id  = object_id } } };
 
-    status = meta_generic_validation_remove(meta_key);
+    return meta_generic_validation_remove(meta_key);
+}
+
+sai_status_t meta_sai_remove_oid(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_object_id_t object_id,
+        _In_ sai_remove_generic_fn remove)
+{
+    SWSS_LOG_ENTER();
+
+    sai_status_t status = meta_sai_validate_remove_oid(object_type, object_id);
 
     if (status != SAI_STATUS_SUCCESS)
     {
         return status;
     }
 
+    sai_object_meta_key_t meta_key = { .objecttype = object_type, .objectkey = { .key = { .object_id  = object_id } } };
+
     if (remove == NULL)
     {
         SWSS_LOG_ERROR("remove function pointer is NULL");
@@ -4379,12 +4703,11 @@ sai_status_t meta_sai_set_oid(
     return status;
 }
 
-sai_status_t meta_sai_get_oid(
+sai_status_t meta_sai_validate_get_oid(
         _In_ sai_object_type_t object_type,
         _In_ sai_object_id_t object_id,
         _In_ uint32_t attr_count,
-        _Inout_ sai_attribute_t *attr_list,
-        _In_ sai_get_generic_attribute_fn get)
+        _In_ const sai_attribute_t *attr_list)
 {
     SWSS_LOG_ENTER();
 
@@ -4397,13 +4720,27 @@ sai_status_t meta_sai_get_oid(
 
     sai_object_meta_key_t meta_key = { .objecttype = object_type, .objectkey = { .key = { .object_id  = object_id } } };
 
-    status = meta_generic_validation_get(meta_key, attr_count, attr_list);
+    return meta_generic_validation_get(meta_key, attr_count, attr_list);
+}
+
+sai_status_t meta_sai_get_oid(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_object_id_t object_id,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t *attr_list,
+        _In_ sai_get_generic_attribute_fn get)
+{
+    SWSS_LOG_ENTER();
+
+    sai_status_t status = meta_sai_validate_get_oid(object_type, object_id, attr_count, attr_list);
 
     if (status != SAI_STATUS_SUCCESS)
     {
         return status;
     }
 
+    sai_object_meta_key_t meta_key = { .objecttype = object_type, .objectkey = { .key = { .object_id  = object_id } } };
+
     if (get == NULL)
     {
         SWSS_LOG_ERROR("get function pointer is NULL");
@@ -4446,15 +4783,13 @@ void meta_sai_on_fdb_event_single(
 
     const sai_object_meta_key_t meta_key_fdb = { .objecttype = SAI_OBJECT_TYPE_FDB_ENTRY, .objectkey = { .key = { .fdb_entry = data.fdb_entry } } };
 
-    std::string key_fdb = sai_serialize_object_meta_key(meta_key_fdb);
-
     switch (data.event_type)
     {
         case SAI_FDB_EVENT_LEARNED:
 
-            if (object_exists(key_fdb))
+            if (object_exists(meta_key_fdb))
             {
-                SWSS_LOG_WARN("object key %s alearedy exists, but received LEARNED event", key_fdb.c_str());
+                SWSS_LOG_WARN("object key %s alearedy exists, but received LEARNED event", sai_serialize_object_meta_key(meta_key_fdb).c_str());
                 break;
             }
 
@@ -4484,7 +4819,7 @@ void meta_sai_on_fdb_event_single(
                 }
                 else
                 {
-                    SWSS_LOG_ERROR("failed to insert %s received in notification: %s", key_fdb.c_str(), sai_serialize_status(status).c_str());
+                    SWSS_LOG_ERROR("failed to insert %s received in notification: %s", sai_serialize_object_meta_key(meta_key_fdb).c_str(), sai_serialize_status(status).c_str());
                 }
             }
 
@@ -4493,9 +4828,9 @@ void meta_sai_on_fdb_event_single(
         case SAI_FDB_EVENT_AGED:
         case SAI_FDB_EVENT_FLUSHED:
 
-            if (!object_exists(key_fdb))
+            if (!object_exists(meta_key_fdb))
             {
-                SWSS_LOG_WARN("object key %s doesn't exist but received AGED/FLUSHED event", key_fdb.c_str());
+                SWSS_LOG_WARN("object key %s doesn't exist but received AGED/FLUSHED event", sai_serialize_object_meta_key(meta_key_fdb).c_str());
                 break;
             }
 
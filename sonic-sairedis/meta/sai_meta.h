@@ -66,6 +66,24 @@ extern sai_status_t meta_sai_get_oid(
         _Inout_ sai_attribute_t *attr_list,
         _In_ sai_get_generic_attribute_fn get);
 
+/*
+ * Validation done by meta_sai_get_oid before calling get, for gets
+ * which complete asynchronously.
+ */
+extern sai_status_t meta_sai_validate_get_oid(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_object_id_t object_id,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list);
+
+/*
+ * Validation done by meta_sai_remove_oid before calling remove, for bulk
+ * removes which are sent to syncd before metadata is updated.
+ */
+extern sai_status_t meta_sai_validate_remove_oid(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_object_id_t object_id);
+
 // META FDB
 
 extern sai_status_t meta_sai_create_fdb_entry(
@@ -124,6 +142,12 @@ extern sai_status_t meta_sai_remove_route_entry(
         _In_ const sai_route_entry_t* route_entry,
         _In_ sai_remove_route_entry_fn remove);
 
+/*
+ * Validation done by meta_sai_remove_route_entry before calling remove.
+ */
+extern sai_status_t meta_sai_validate_remove_route_entry(
+        _In_ const sai_route_entry_t* route_entry);
+
 extern sai_status_t meta_sai_set_route_entry(
         _In_ const sai_route_entry_t* route_entry,
         _In_ const sai_attribute_t *attr,
@@ -135,6 +159,18 @@ extern sai_status_t meta_sai_get_route_entry(
         _Inout_ sai_attribute_t *attr_list,
         _In_ sai_get_route_entry_attribute_fn get);
 
+/**
+ * @brief Get attribute value stored in metadata.
+ *
+ * Used to revert a set which failed in syncd. When attribute was not set its
+ * const default value is returned. Only attributes without lists are
+ * supported, returns false otherwise or when object doesn't exist.
+ */
+extern bool meta_get_previous_attr(
+        _In_ const sai_object_meta_key_t& meta_key,
+        _In_ sai_attr_id_t attr_id,
+        _Out_ sai_attribute_t &attr);
+
 // NOTIFICATIONS
 
 extern void meta_sai_on_fdb_event(
@@ -1,6 +1,7 @@
 #include "saiattributelist.h"
 #include "sai_meta.h"
 #include "saiserialize.h"
+#include "saiserializebinary.h"
 
 SaiAttributeList::SaiAttributeList(
         _In_ const sai_object_type_t object_type,
@@ -39,6 +40,21 @@ SaiAttributeList::SaiAttributeList(
     }
 }
 
+SaiAttributeList::SaiAttributeList(
+        _In_ const sai_object_type_t object_type,
+        _In_ const std::string &binary_attr_list,
+        _In_ bool countOnly)
+{
+    sai_deserialize_binary_attr_list(binary_attr_list, object_type, m_attr_list, countOnly);
+
+    for (const auto &attr: m_attr_list)
+    {
+        auto meta = sai_metadata_get_attr_metadata(object_type, attr.id);
+
+        m_attr_value_type_list.push_back(meta->attrvaluetype);
+    }
+}
+
 SaiAttributeList::~SaiAttributeList()
 {
     size_t attr_count = m_attr_list.size();
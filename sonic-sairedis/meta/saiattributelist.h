@@ -21,6 +21,14 @@ class SaiAttributeList
                 _In_ const std::vector<swss::FieldValueTuple> &values,
                 _In_ bool countOnly);
 
+        /*
+         * From a list encoded by sai_serialize_binary_attr_list.
+         */
+        SaiAttributeList(
+                _In_ const sai_object_type_t object_type,
+                _In_ const std::string &binary_attr_list,
+                _In_ bool countOnly);
+
         ~SaiAttributeList();
 
         sai_attribute_t* get_attr_list();
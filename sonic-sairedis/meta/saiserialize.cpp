@@ -716,6 +716,14 @@ std::string sai_serialize_queue_stat(
     return sai_serialize_enum(counter, &sai_metadata_enum_sai_queue_stat_t);
 }
 
+std::string sai_serialize_ingress_priority_group_stat(
+        _In_ const sai_ingress_priority_group_stat_t counter)
+{
+    SWSS_LOG_ENTER();
+
+    return sai_serialize_enum(counter, &sai_metadata_enum_sai_ingress_priority_group_stat_t);
+}
+
 std::string sai_serialize_switch_oper_status(
         _In_ sai_object_id_t switch_id,
         _In_ sai_switch_oper_status_t status)
@@ -2804,3 +2812,12 @@ void sai_deserialize_queue_stat(
     sai_deserialize_enum(s, &sai_metadata_enum_sai_queue_stat_t, (int32_t&)stat);
 }
 
+void sai_deserialize_ingress_priority_group_stat(
+        _In_ const std::string& s,
+        _Out_ sai_ingress_priority_group_stat_t& stat)
+{
+    SWSS_LOG_ENTER();
+
+    sai_deserialize_enum(s, &sai_metadata_enum_sai_ingress_priority_group_stat_t, (int32_t&)stat);
+}
+
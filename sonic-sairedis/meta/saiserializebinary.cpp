@@ -0,0 +1,815 @@
+#include "saiserializebinary.h"
+#include "saiserialize.h"
+
+#include "swss/logger.h"
+
+#include <string.h>
+#include <type_traits>
+
+#define BINARY_MARKER '#'
+
+static const char g_base64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static std::string base64_encode(
+        _In_ const std::string &data)
+{
+    SWSS_LOG_ENTER();
+
+    std::string s;
+
+    s.reserve((data.size() + 2) / 3 * 4);
+
+    const unsigned char *p = reinterpret_cast<const unsigned char*>(data.data());
+
+    size_t size = data.size();
+    size_t i = 0;
+
+    for (; i + 2 < size; i += 3)
+    {
+        uint32_t n = (uint32_t)(p[i] << 16 | p[i + 1] << 8 | p[i + 2]);
+
+        s += g_base64[n >> 18 & 0x3f];
+        s += g_base64[n >> 12 & 0x3f];
+        s += g_base64[n >> 6 & 0x3f];
+        s += g_base64[n & 0x3f];
+    }
+
+    if (i < size)
+    {
+        uint32_t n = (uint32_t)(p[i] << 16);
+
+        if (i + 1 < size)
+        {
+            n |= (uint32_t)(p[i + 1] << 8);
+        }
+
+        s += g_base64[n >> 18 & 0x3f];
+        s += g_base64[n >> 12 & 0x3f];
+        s += (i + 1 < size) ? g_base64[n >> 6 & 0x3f] : '=';
+        s += '=';
+    }
+
+    return s;
+}
+
+static int base64_value(
+        _In_ char c)
+{
+    if (c >= 'A' && c <= 'Z')
+        return c - 'A';
+
+    if (c >= 'a' && c <= 'z')
+        return c - 'a' + 26;
+
+    if (c >= '0' && c <= '9')
+        return c - '0' + 52;
+
+    if (c == '+')
+        return 62;
+
+    if (c == '/')
+        return 63;
+
+    SWSS_LOG_THROW("invalid base64 character %d", c);
+}
+
+static std::string base64_decode(
+        _In_ const std::string &s,
+        _In_ size_t offset)
+{
+    SWSS_LOG_ENTER();
+
+    if ((s.size() - offset) % 4 != 0)
+    {
+        SWSS_LOG_THROW("invalid base64 length %zu", s.size() - offset);
+    }
+
+    std::string data;
+
+    data.reserve((s.size() - offset) / 4 * 3);
+
+    for (size_t i = offset; i < s.size(); i += 4)
+    {
+        uint32_t n = (uint32_t)(base64_value(s[i]) << 18 | base64_value(s[i + 1]) << 12);
+
+        data += (char)(n >> 16 & 0xff);
+
+        if (s[i + 2] == '=')
+        {
+            break;
+        }
+
+        n |= (uint32_t)(base64_value(s[i + 2]) << 6);
+
+        data += (char)(n >> 8 & 0xff);
+
+        if (s[i + 3] == '=')
+        {
+            break;
+        }
+
+        n |= (uint32_t)base64_value(s[i + 3]);
+
+        data += (char)(n & 0xff);
+    }
+
+    return data;
+}
+
+static std::string armor(
+        _In_ const std::string &data)
+{
+    SWSS_LOG_ENTER();
+
+    std::string s(1, BINARY_MARKER);
+
+    s += (char)('0' + SAI_SERIALIZE_BINARY_VERSION);
+
+    return s + base64_encode(data);
+}
+
+static std::string unarmor(
+        _In_ const std::string &s)
+{
+    SWSS_LOG_ENTER();
+
+    if (!sai_is_binary_serialized(s))
+    {
+        SWSS_LOG_THROW("not binary serialized: %s", s.c_str());
+    }
+
+    if (s[1] != '0' + SAI_SERIALIZE_BINARY_VERSION)
+    {
+        SWSS_LOG_THROW("unsupported binary serialization version %c, expected %d", s[1], SAI_SERIALIZE_BINARY_VERSION);
+    }
+
+    return base64_decode(s, 2);
+}
+
+class BinaryWriter
+{
+    public:
+
+        template<typename T>
+        void put(
+                _In_ const T &value)
+        {
+            m_data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void put_bytes(
+                _In_ const void *data,
+                _In_ size_t size)
+        {
+            m_data.append(static_cast<const char*>(data), size);
+        }
+
+        void put_string(
+                _In_ const std::string &s)
+        {
+            put((uint32_t)s.size());
+            put_bytes(s.data(), s.size());
+        }
+
+        template<typename T>
+        void put_list(
+                _In_ const T &list,
+                _In_ bool countOnly)
+        {
+            put(list.count);
+
+            uint8_t present = (!countOnly && list.list != NULL) ? 1 : 0;
+
+            put(present);
+
+            if (present)
+            {
+                put_bytes(list.list, sizeof(*list.list) * list.count);
+            }
+        }
+
+        void put_ip_address(
+                _In_ const sai_ip_address_t &ip)
+        {
+            put((uint8_t)ip.addr_family);
+
+            if (ip.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+            {
+                put(ip.addr.ip4);
+            }
+            else
+            {
+                put(ip.addr.ip6);
+            }
+        }
+
+        void put_ip_prefix(
+                _In_ const sai_ip_prefix_t &prefix)
+        {
+            put((uint8_t)prefix.addr_family);
+
+            if (prefix.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+            {
+                put(prefix.addr.ip4);
+                put(prefix.mask.ip4);
+            }
+            else
+            {
+                put(prefix.addr.ip6);
+                put(prefix.mask.ip6);
+            }
+        }
+
+        std::string m_data;
+};
+
+class BinaryReader
+{
+    public:
+
+        BinaryReader(
+                _In_ const std::string &data):
+            m_data(data),
+            m_offset(0)
+        {
+        }
+
+        void get_bytes(
+                _Out_ void *data,
+                _In_ size_t size)
+        {
+            if (size > m_data.size() - m_offset)
+            {
+                SWSS_LOG_THROW("binary data too short, reading %zu bytes at %zu of %zu", size, m_offset, m_data.size());
+            }
+
+            memcpy(data, m_data.data() + m_offset, size);
+
+            m_offset += size;
+        }
+
+        template<typename T>
+        void get(
+                _Out_ T &value)
+        {
+            get_bytes(&value, sizeof(T));
+        }
+
+        std::string get_string()
+        {
+            uint32_t size;
+
+            get(size);
+
+            if (size > m_data.size() - m_offset)
+            {
+                SWSS_LOG_THROW("binary string of %u bytes longer than data, at %zu of %zu", size, m_offset, m_data.size());
+            }
+
+            std::string s(size, '\0');
+
+            get_bytes(&s[0], size);
+
+            return s;
+        }
+
+        template<typename T>
+        void get_list(
+                _Out_ T &list,
+                _In_ bool countOnly)
+        {
+            get(list.count);
+
+            uint8_t present;
+
+            get(present);
+
+            if (countOnly || !present)
+            {
+                list.list = NULL;
+                return;
+            }
+
+            if (list.count > (m_data.size() - m_offset) / sizeof(*list.list))
+            {
+                SWSS_LOG_THROW("binary list of %u items longer than data, at %zu of %zu", list.count, m_offset, m_data.size());
+            }
+
+            list.list = new typename std::remove_pointer<decltype(list.list)>::type[list.count];
+
+            get_bytes(list.list, sizeof(*list.list) * list.count);
+        }
+
+        void get_ip_address(
+                _Out_ sai_ip_address_t &ip)
+        {
+            uint8_t family;
+
+            get(family);
+
+            ip.addr_family = (sai_ip_addr_family_t)family;
+
+            if (ip.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+            {
+                get(ip.addr.ip4);
+            }
+            else
+            {
+                get(ip.addr.ip6);
+            }
+        }
+
+        void get_ip_prefix(
+                _Out_ sai_ip_prefix_t &prefix)
+        {
+            uint8_t family;
+
+            get(family);
+
+            prefix.addr_family = (sai_ip_addr_family_t)family;
+
+            if (prefix.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+            {
+                get(prefix.addr.ip4);
+                get(prefix.mask.ip4);
+            }
+            else
+            {
+                get(prefix.addr.ip6);
+                get(prefix.mask.ip6);
+            }
+        }
+
+        bool end() const
+        {
+            return m_offset == m_data.size();
+        }
+
+    private:
+
+        const std::string &m_data;
+
+        size_t m_offset;
+};
+
+bool sai_is_binary_serialized(
+        _In_ const std::string &s)
+{
+    return s.size() >= 2 && s[0] == BINARY_MARKER;
+}
+
+std::string sai_serialize_binary_object_meta_key(
+        _In_ const sai_object_meta_key_t &meta_key)
+{
+    SWSS_LOG_ENTER();
+
+    BinaryWriter w;
+
+    w.put((uint32_t)meta_key.objecttype);
+
+    switch (meta_key.objecttype)
+    {
+        case SAI_OBJECT_TYPE_FDB_ENTRY:
+            {
+                const auto &fdb_entry = meta_key.objectkey.key.fdb_entry;
+
+                w.put(fdb_entry.switch_id);
+                w.put(fdb_entry.mac_address);
+                w.put(fdb_entry.vlan_id);
+                w.put((int32_t)fdb_entry.bridge_type);
+                w.put(fdb_entry.bridge_id);
+            }
+            break;
+
+        case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+            {
+                const auto &route_entry = meta_key.objectkey.key.route_entry;
+
+                w.put(route_entry.switch_id);
+                w.put(route_entry.vr_id);
+                w.put_ip_prefix(route_entry.destination);
+            }
+            break;
+
+        case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+            {
+                const auto &neighbor_entry = meta_key.objectkey.key.neighbor_entry;
+
+                w.put(neighbor_entry.switch_id);
+                w.put(neighbor_entry.rif_id);
+                w.put_ip_address(neighbor_entry.ip_address);
+            }
+            break;
+
+        default:
+
+            if (meta_key.objecttype == SAI_OBJECT_TYPE_NULL || meta_key.objecttype >= SAI_OBJECT_TYPE_MAX)
+            {
+                SWSS_LOG_THROW("invalid object type value %d", meta_key.objecttype);
+            }
+
+            w.put(meta_key.objectkey.key.object_id);
+            break;
+    }
+
+    return armor(w.m_data);
+}
+
+void sai_deserialize_binary_object_meta_key(
+        _In_ const std::string &s,
+        _Out_ sai_object_meta_key_t &meta_key)
+{
+    SWSS_LOG_ENTER();
+
+    std::string data = unarmor(s);
+
+    BinaryReader r(data);
+
+    uint32_t object_type;
+
+    r.get(object_type);
+
+    meta_key.objecttype = (sai_object_type_t)object_type;
+
+    switch (meta_key.objecttype)
+    {
+        case SAI_OBJECT_TYPE_FDB_ENTRY:
+            {
+                auto &fdb_entry = meta_key.objectkey.key.fdb_entry;
+
+                int32_t bridge_type;
+
+                r.get(fdb_entry.switch_id);
+                r.get(fdb_entry.mac_address);
+                r.get(fdb_entry.vlan_id);
+                r.get(bridge_type);
+                r.get(fdb_entry.bridge_id);
+
+                fdb_entry.bridge_type = (sai_fdb_entry_bridge_type_t)bridge_type;
+            }
+            break;
+
+        case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+            {
+                auto &route_entry = meta_key.objectkey.key.route_entry;
+
+                r.get(route_entry.switch_id);
+                r.get(route_entry.vr_id);
+                r.get_ip_prefix(route_entry.destination);
+            }
+            break;
+
+        case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+            {
+                auto &neighbor_entry = meta_key.objectkey.key.neighbor_entry;
+
+                r.get(neighbor_entry.switch_id);
+                r.get(neighbor_entry.rif_id);
+                r.get_ip_address(neighbor_entry.ip_address);
+            }
+            break;
+
+        default:
+
+            if (meta_key.objecttype == SAI_OBJECT_TYPE_NULL || meta_key.objecttype >= SAI_OBJECT_TYPE_MAX)
+            {
+                SWSS_LOG_THROW("invalid object type value %u", object_type);
+            }
+
+            r.get(meta_key.objectkey.key.object_id);
+            break;
+    }
+
+    if (!r.end())
+    {
+        SWSS_LOG_THROW("trailing data in binary key of %s", sai_serialize_object_type(meta_key.objecttype).c_str());
+    }
+}
+
+static void serialize_binary_attr_value(
+        _In_ BinaryWriter &w,
+        _In_ const sai_attr_metadata_t &meta,
+        _In_ const sai_attribute_t &attr,
+        _In_ bool countOnly)
+{
+    SWSS_LOG_ENTER();
+
+    const sai_attribute_value_t &value = attr.value;
+
+    switch (meta.attrvaluetype)
+    {
+        case SAI_ATTR_VALUE_TYPE_BOOL:
+            w.put((uint8_t)value.booldata);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_CHARDATA:
+            w.put(value.chardata);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_UINT8:
+            w.put(value.u8);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_INT8:
+            w.put(value.s8);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_UINT16:
+            w.put(value.u16);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_INT16:
+            w.put(value.s16);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_UINT32:
+            w.put(value.u32);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_INT32:
+            w.put(value.s32);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_UINT64:
+            w.put(value.u64);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_INT64:
+            w.put(value.s64);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_MAC:
+            w.put(value.mac);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_IPV4:
+            w.put(value.ip4);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_IPV6:
+            w.put(value.ip6);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_POINTER:
+            w.put(value.ptr);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_IP_ADDRESS:
+            w.put_ip_address(value.ipaddr);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_OBJECT_ID:
+            w.put(value.oid);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_OBJECT_LIST:
+            w.put_list(value.objlist, countOnly);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_UINT8_LIST:
+            w.put_list(value.u8list, countOnly);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_INT8_LIST:
+            w.put_list(value.s8list, countOnly);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_UINT16_LIST:
+            w.put_list(value.u16list, countOnly);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_INT16_LIST:
+            w.put_list(value.s16list, countOnly);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_UINT32_LIST:
+            w.put_list(value.u32list, countOnly);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_INT32_LIST:
+            w.put_list(value.s32list, countOnly);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_UINT32_RANGE:
+            w.put(value.u32range);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_INT32_RANGE:
+            w.put(value.s32range);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_VLAN_LIST:
+            w.put_list(value.vlanlist, countOnly);
+            break;
+
+        default:
+
+            /*
+             * Values with nested lists are rare, they keep their text form.
+             */
+
+            w.put_string(sai_serialize_attr_value(meta, attr, countOnly));
+            break;
+    }
+}
+
+static void deserialize_binary_attr_value(
+        _In_ BinaryReader &r,
+        _In_ const sai_attr_metadata_t &meta,
+        _Out_ sai_attribute_t &attr,
+        _In_ bool countOnly)
+{
+    SWSS_LOG_ENTER();
+
+    sai_attribute_value_t &value = attr.value;
+
+    switch (meta.attrvaluetype)
+    {
+        case SAI_ATTR_VALUE_TYPE_BOOL:
+            {
+                uint8_t b;
+                r.get(b);
+                value.booldata = (b != 0);
+            }
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_CHARDATA:
+            r.get(value.chardata);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_UINT8:
+            r.get(value.u8);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_INT8:
+            r.get(value.s8);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_UINT16:
+            r.get(value.u16);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_INT16:
+            r.get(value.s16);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_UINT32:
+            r.get(value.u32);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_INT32:
+            r.get(value.s32);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_UINT64:
+            r.get(value.u64);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_INT64:
+            r.get(value.s64);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_MAC:
+            r.get(value.mac);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_IPV4:
+            r.get(value.ip4);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_IPV6:
+            r.get(value.ip6);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_POINTER:
+            r.get(value.ptr);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_IP_ADDRESS:
+            r.get_ip_address(value.ipaddr);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_OBJECT_ID:
+            r.get(value.oid);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_OBJECT_LIST:
+            r.get_list(value.objlist, countOnly);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_UINT8_LIST:
+            r.get_list(value.u8list, countOnly);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_INT8_LIST:
+            r.get_list(value.s8list, countOnly);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_UINT16_LIST:
+            r.get_list(value.u16list, countOnly);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_INT16_LIST:
+            r.get_list(value.s16list, countOnly);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_UINT32_LIST:
+            r.get_list(value.u32list, countOnly);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_INT32_LIST:
+            r.get_list(value.s32list, countOnly);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_UINT32_RANGE:
+            r.get(value.u32range);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_INT32_RANGE:
+            r.get(value.s32range);
+            break;
+
+        case SAI_ATTR_VALUE_TYPE_VLAN_LIST:
+            r.get_list(value.vlanlist, countOnly);
+            break;
+
+        default:
+            sai_deserialize_attr_value(r.get_string(), meta, attr, countOnly);
+            break;
+    }
+}
+
+std::string sai_serialize_binary_attr_list(
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list,
+        _In_ bool countOnly)
+{
+    SWSS_LOG_ENTER();
+
+    BinaryWriter w;
+
+    w.put(attr_count);
+
+    for (uint32_t idx = 0; idx < attr_count; ++idx)
+    {
+        const sai_attribute_t &attr = attr_list[idx];
+
+        auto meta = sai_metadata_get_attr_metadata(object_type, attr.id);
+
+        if (meta == NULL)
+        {
+            SWSS_LOG_THROW("failed to find metadata for object type %d and attr id %d", object_type, attr.id);
+        }
+
+        w.put(attr.id);
+
+        serialize_binary_attr_value(w, *meta, attr, countOnly);
+    }
+
+    return armor(w.m_data);
+}
+
+void sai_deserialize_binary_attr_list(
+        _In_ const std::string &s,
+        _In_ sai_object_type_t object_type,
+        _Out_ std::vector<sai_attribute_t> &attr_list,
+        _In_ bool countOnly)
+{
+    SWSS_LOG_ENTER();
+
+    std::string data = unarmor(s);
+
+    BinaryReader r(data);
+
+    uint32_t attr_count;
+
+    r.get(attr_count);
+
+    attr_list.reserve(attr_list.size() + attr_count);
+
+    for (uint32_t idx = 0; idx < attr_count; ++idx)
+    {
+        sai_attribute_t attr;
+
+        memset(&attr, 0, sizeof(sai_attribute_t));
+
+        r.get(attr.id);
+
+        auto meta = sai_metadata_get_attr_metadata(object_type, attr.id);
+
+        if (meta == NULL)
+        {
+            SWSS_LOG_THROW("failed to find metadata for object type %d and attr id %d", object_type, attr.id);
+        }
+
+        deserialize_binary_attr_value(r, *meta, attr, countOnly);
+
+        attr_list.push_back(attr);
+    }
+
+    if (!r.end())
+    {
+        SWSS_LOG_THROW("trailing data in binary attribute list of %s", sai_serialize_object_type(object_type).c_str());
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef __SAI_SERIALIZE_BINARY__
+#define __SAI_SERIALIZE_BINARY__
+
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "sai.h"
+}
+
+/*
+ * Compact binary encoding of object keys and attribute lists exchanged
+ * between sairedis and syncd, instead of the json keys and text values
+ * used in ASIC view.
+ *
+ * Values are stored in host byte order, both ends run on the same host.
+ * Attribute values without pointers and plain lists are stored as is, the
+ * other ones (qos maps, tunnel maps, acl fields and actions) are stored in
+ * their text form.
+ *
+ * Producer tables send values as json, so encoded data is armored in
+ * base64 and prefixed with the '#' marker and the format version, which
+ * can't start a text key or value.
+ */
+
+#define SAI_SERIALIZE_BINARY_VERSION 1
+
+/*
+ * Field name of the binary attribute list in a message values, instead of
+ * an attribute id per field.
+ */
+#define SAI_SERIALIZE_BINARY_ATTR_LIST "SAI_BINARY_ATTR_LIST"
+
+bool sai_is_binary_serialized(
+        _In_ const std::string &s);
+
+std::string sai_serialize_binary_object_meta_key(
+        _In_ const sai_object_meta_key_t &meta_key);
+
+void sai_deserialize_binary_object_meta_key(
+        _In_ const std::string &s,
+        _Out_ sai_object_meta_key_t &meta_key);
+
+std::string sai_serialize_binary_attr_list(
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list,
+        _In_ bool countOnly);
+
+/*
+ * Lists are allocated, attributes must be released with
+ * sai_deserialize_free_attribute_value.
+ */
+void sai_deserialize_binary_attr_list(
+        _In_ const std::string &s,
+        _In_ sai_object_type_t object_type,
+        _Out_ std::vector<sai_attribute_t> &attr_list,
+        _In_ bool countOnly);
+
+#endif // __SAI_SERIALIZE_BINARY__
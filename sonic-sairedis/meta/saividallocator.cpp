@@ -0,0 +1,49 @@
+#include "saividallocator.h"
+
+#include "swss/logger.h"
+
+SaiVidAllocator::SaiVidAllocator(
+        _In_ const std::string &counter,
+        _In_ uint64_t leaseSize):
+    m_counter(counter),
+    m_leaseSize(leaseSize),
+    m_next(1),
+    m_last(0)
+{
+    SWSS_LOG_ENTER();
+
+    if (leaseSize == 0)
+    {
+        SWSS_LOG_THROW("lease size must be positive");
+    }
+}
+
+uint64_t SaiVidAllocator::allocate(
+        _In_ swss::RedisClient &client)
+{
+    SWSS_LOG_ENTER();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_next > m_last)
+    {
+        uint64_t last = (uint64_t)client.incrby(m_counter, (int64_t)m_leaseSize);
+
+        m_next = last - m_leaseSize + 1;
+        m_last = last;
+
+        SWSS_LOG_INFO("leased %s range 0x%lx-0x%lx", m_counter.c_str(), m_next, m_last);
+    }
+
+    return m_next++;
+}
+
+void SaiVidAllocator::reset()
+{
+    SWSS_LOG_ENTER();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_next = 1;
+    m_last = 0;
+}
@@ -0,0 +1,56 @@
+#ifndef __SAI_VID_ALLOCATOR__
+#define __SAI_VID_ALLOCATOR__
+
+#include <string>
+#include <mutex>
+
+#include "swss/redisclient.h"
+#include "sai.h"
+
+/*
+ * Allocates virtual ids from a counter in redis, VIDCOUNTER in ASIC DB.
+ *
+ * Instead of a blocking INCR per object, a range of lease size ids is
+ * leased with a single INCRBY and handed out locally. The counter is the
+ * high water mark of all the ids leased by any process, and is saved with
+ * the DB, so ids are never reused after a restart or warm boot. The unused
+ * part of a lease is simply skipped.
+ */
+class SaiVidAllocator
+{
+    public:
+
+        static const uint64_t DEFAULT_LEASE_SIZE = 0x10000;
+
+        SaiVidAllocator(
+                _In_ const std::string &counter,
+                _In_ uint64_t leaseSize = DEFAULT_LEASE_SIZE);
+
+        uint64_t allocate(
+                _In_ swss::RedisClient &client);
+
+        /*
+         * Drop the current lease, needed when the DB holding the counter
+         * may have been cleared.
+         */
+
+        void reset();
+
+    private:
+
+        std::mutex m_mutex;
+
+        std::string m_counter;
+
+        uint64_t m_leaseSize;
+
+        /*
+         * Next id to hand out and last id of the lease.
+         */
+
+        uint64_t m_next;
+
+        uint64_t m_last;
+};
+
+#endif // __SAI_VID_ALLOCATOR__
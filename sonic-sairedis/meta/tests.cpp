@@ -1,9 +1,15 @@
 #include "sai_meta.h"
 #include "sai_extra.h"
 #include "saiserialize.h"
+#include "saiserializebinary.h"
+#include "saiattributelist.h"
 
 #include <string.h>
 #include <arpa/inet.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
 
 #include <map>
 #include <iterator>
@@ -11,10 +17,9 @@
 #include <memory>
 #include <vector>
 
-class SaiAttrWrapper;
-extern std::unordered_map<std::string,std::unordered_map<sai_attr_id_t,std::shared_ptr<SaiAttrWrapper>>> ObjectAttrHash;
 extern bool is_ipv6_mask_valid(const uint8_t* mask);
-extern bool object_exists(const std::string& key);
+extern bool object_exists(const sai_object_meta_key_t& meta_key);
+extern void create_object(const sai_object_meta_key_t& meta_key);
 extern bool object_reference_exists(sai_object_id_t oid);
 extern void object_reference_inc(sai_object_id_t oid);
 extern void object_reference_dec(sai_object_id_t oid);
@@ -899,15 +904,13 @@ void test_fdb_entry_remove()
 
     sai_object_meta_key_t meta = { .objecttype = SAI_OBJECT_TYPE_FDB_ENTRY, .objectkey = { .key = { .fdb_entry = fdb_entry } } };
 
-    std::string key = sai_serialize_object_meta_key(meta);
-
-    META_ASSERT_TRUE(object_exists(key));
+    META_ASSERT_TRUE(object_exists(meta));
 
     SWSS_LOG_NOTICE("success");
     status = meta_sai_remove_fdb_entry(&fdb_entry, &dummy_success_sai_remove_fdb_entry);
     META_ASSERT_SUCCESS(status);
 
-    META_ASSERT_TRUE(!object_exists(key));
+    META_ASSERT_TRUE(!object_exists(meta));
 }
 
 void test_fdb_entry_set()
@@ -931,8 +934,7 @@ void test_fdb_entry_set()
 
     // TODO we should use CREATE for this
     sai_object_meta_key_t meta_key_fdb = { .objecttype = SAI_OBJECT_TYPE_FDB_ENTRY, .objectkey = { .key = { .fdb_entry = fdb_entry } } };
-    std::string fdb_key = sai_serialize_object_meta_key(meta_key_fdb);
-    ObjectAttrHash[fdb_key] = { };
+    create_object(meta_key_fdb);
 
     SWSS_LOG_NOTICE("attr is null");
     status = meta_sai_set_fdb_entry(&fdb_entry, NULL, &dummy_success_sai_set_fdb_entry);
@@ -1001,8 +1003,7 @@ void test_fdb_entry_get()
 
     // TODO we should use CREATE for this
     sai_object_meta_key_t meta_key_fdb = { .objecttype = SAI_OBJECT_TYPE_FDB_ENTRY, .objectkey = { .key = { .fdb_entry = fdb_entry } } };
-    std::string fdb_key = sai_serialize_object_meta_key(meta_key_fdb);
-    ObjectAttrHash[fdb_key] = { };
+    create_object(meta_key_fdb);
 
     attr.id = SAI_FDB_ENTRY_ATTR_TYPE;
     attr.value.s32 = SAI_FDB_ENTRY_TYPE_STATIC;
@@ -1151,8 +1152,7 @@ void test_neighbor_entry_create()
     sai_object_id_t rif = create_dummy_object_id(SAI_OBJECT_TYPE_ROUTER_INTERFACE,switch_id);
     object_reference_insert(rif);
     sai_object_meta_key_t meta_key_rif = { .objecttype = SAI_OBJECT_TYPE_ROUTER_INTERFACE, .objectkey = { .key = { .object_id = rif } } };
-    std::string rif_key = sai_serialize_object_meta_key(meta_key_rif);
-    ObjectAttrHash[rif_key] = { };
+    create_object(meta_key_rif);
 
     neighbor_entry.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     neighbor_entry.ip_address.addr.ip4 = htonl(0x0a00000f);
@@ -1254,8 +1254,7 @@ void test_neighbor_entry_remove()
     sai_object_id_t rif = create_dummy_object_id(SAI_OBJECT_TYPE_ROUTER_INTERFACE,switch_id);
     object_reference_insert(rif);
     sai_object_meta_key_t meta_key_rif = { .objecttype = SAI_OBJECT_TYPE_ROUTER_INTERFACE, .objectkey = { .key = { .object_id = rif } } };
-    std::string rif_key = sai_serialize_object_meta_key(meta_key_rif);
-    ObjectAttrHash[rif_key] = { };
+    create_object(meta_key_rif);
 
     neighbor_entry.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     neighbor_entry.ip_address.addr.ip4 = htonl(0x0a00000f);
@@ -1304,15 +1303,13 @@ void test_neighbor_entry_remove()
 
     sai_object_meta_key_t meta = { .objecttype = SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, .objectkey = { .key = { .neighbor_entry = neighbor_entry } } };
 
-    std::string key = sai_serialize_object_meta_key(meta);
-
-    META_ASSERT_TRUE(object_exists(key));
+    META_ASSERT_TRUE(object_exists(meta));
 
     SWSS_LOG_NOTICE("success");
     status = meta_sai_remove_neighbor_entry(&neighbor_entry, &dummy_success_sai_remove_neighbor_entry);
     META_ASSERT_SUCCESS(status);
 
-    META_ASSERT_TRUE(!object_exists(key));
+    META_ASSERT_TRUE(!object_exists(meta));
 }
 
 void test_neighbor_entry_set()
@@ -1346,8 +1343,7 @@ void test_neighbor_entry_set()
     sai_object_id_t rif = create_dummy_object_id(SAI_OBJECT_TYPE_ROUTER_INTERFACE,switch_id);
     object_reference_insert(rif);
     sai_object_meta_key_t meta_key_rif = { .objecttype = SAI_OBJECT_TYPE_ROUTER_INTERFACE, .objectkey = { .key = { .object_id = rif } } };
-    std::string rif_key = sai_serialize_object_meta_key(meta_key_rif);
-    ObjectAttrHash[rif_key] = { };
+    create_object(meta_key_rif);
 
     neighbor_entry.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     neighbor_entry.ip_address.addr.ip4 = htonl(0x0a00000f);
@@ -1427,8 +1423,7 @@ void test_neighbor_entry_get()
     sai_object_id_t rif = create_dummy_object_id(SAI_OBJECT_TYPE_ROUTER_INTERFACE,switch_id);
     object_reference_insert(rif);
     sai_object_meta_key_t meta_key_rif = { .objecttype = SAI_OBJECT_TYPE_ROUTER_INTERFACE, .objectkey = { .key = { .object_id = rif } } };
-    std::string rif_key = sai_serialize_object_meta_key(meta_key_rif);
-    ObjectAttrHash[rif_key] = { };
+    create_object(meta_key_rif);
 
     neighbor_entry.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     neighbor_entry.ip_address.addr.ip4 = htonl(0x0a00000f);
@@ -1528,8 +1523,7 @@ void test_neighbor_entry_flow()
     sai_object_id_t rif = create_dummy_object_id(SAI_OBJECT_TYPE_ROUTER_INTERFACE,switch_id);
     object_reference_insert(rif);
     sai_object_meta_key_t meta_key_rif = { .objecttype = SAI_OBJECT_TYPE_ROUTER_INTERFACE, .objectkey = { .key = { .object_id = rif } } };
-    std::string rif_key = sai_serialize_object_meta_key(meta_key_rif);
-    ObjectAttrHash[rif_key] = { };
+    create_object(meta_key_rif);
 
     neighbor_entry.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     neighbor_entry.ip_address.addr.ip4 = htonl(0x0a00000f);
@@ -1603,8 +1597,7 @@ void test_vlan_create()
     sai_object_id_t stp = create_dummy_object_id(SAI_OBJECT_TYPE_STP,switch_id);
     object_reference_insert(stp);
     sai_object_meta_key_t meta_key_stp = { .objecttype = SAI_OBJECT_TYPE_STP, .objectkey = { .key = { .object_id = stp } } };
-    std::string stp_key = sai_serialize_object_meta_key(meta_key_stp);
-    ObjectAttrHash[stp_key] = { };
+    create_object(meta_key_stp);
 
     SWSS_LOG_NOTICE("create tests");
 
@@ -1653,8 +1646,7 @@ void test_vlan_remove()
     sai_object_id_t stp = create_dummy_object_id(SAI_OBJECT_TYPE_STP,switch_id);
     object_reference_insert(stp);
     sai_object_meta_key_t meta_key_stp = { .objecttype = SAI_OBJECT_TYPE_STP, .objectkey = { .key = { .object_id = stp } } };
-    std::string stp_key = sai_serialize_object_meta_key(meta_key_stp);
-    ObjectAttrHash[stp_key] = { };
+    create_object(meta_key_stp);
 
     SWSS_LOG_NOTICE("create");
 
@@ -1716,8 +1708,7 @@ void test_vlan_set()
     sai_object_id_t stp = create_dummy_object_id(SAI_OBJECT_TYPE_STP,switch_id);
     object_reference_insert(stp);
     sai_object_meta_key_t meta_key_stp = { .objecttype = SAI_OBJECT_TYPE_STP, .objectkey = { .key = { .object_id = stp } } };
-    std::string stp_key = sai_serialize_object_meta_key(meta_key_stp);
-    ObjectAttrHash[stp_key] = { };
+    create_object(meta_key_stp);
 
     SWSS_LOG_NOTICE("create");
 
@@ -1825,8 +1816,7 @@ void test_vlan_get()
     sai_object_id_t stp = create_dummy_object_id(SAI_OBJECT_TYPE_STP,switch_id);
     object_reference_insert(stp);
     sai_object_meta_key_t meta_key_stp = { .objecttype = SAI_OBJECT_TYPE_STP, .objectkey = { .key = { .object_id = stp } } };
-    std::string stp_key = sai_serialize_object_meta_key(meta_key_stp);
-    ObjectAttrHash[stp_key] = { };
+    create_object(meta_key_stp);
 
     SWSS_LOG_NOTICE("create");
 
@@ -1954,8 +1944,7 @@ void test_vlan_flow()
     sai_object_id_t stp = create_dummy_object_id(SAI_OBJECT_TYPE_STP,switch_id);
     object_reference_insert(stp);
     sai_object_meta_key_t meta_key_stp = { .objecttype = SAI_OBJECT_TYPE_STP, .objectkey = { .key = { .object_id = stp } } };
-    std::string stp_key = sai_serialize_object_meta_key(meta_key_stp);
-    ObjectAttrHash[stp_key] = { };
+    create_object(meta_key_stp);
 
     SWSS_LOG_NOTICE("create");
 
@@ -2080,14 +2069,12 @@ void test_route_entry_create()
     sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER,switch_id);
     object_reference_insert(vr);
     sai_object_meta_key_t meta_key_vr = { .objecttype = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .objectkey = { .key = { .object_id = vr } } };
-    std::string vr_key = sai_serialize_object_meta_key(meta_key_vr);
-    ObjectAttrHash[vr_key] = { };
+    create_object(meta_key_vr);
 
     sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP,switch_id);
     object_reference_insert(hop);
     sai_object_meta_key_t meta_key_hop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP, .objectkey = { .key = { .object_id = hop } } };
-    std::string hop_key = sai_serialize_object_meta_key(meta_key_hop);
-    ObjectAttrHash[hop_key] = { };
+    create_object(meta_key_hop);
 
     route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     route_entry.destination.addr.ip4 = htonl(0x0a00000f);
@@ -2212,14 +2199,12 @@ void test_route_entry_remove()
     sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER,switch_id);
     object_reference_insert(vr);
     sai_object_meta_key_t meta_key_vr = { .objecttype = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .objectkey = { .key = { .object_id = vr } } };
-    std::string vr_key = sai_serialize_object_meta_key(meta_key_vr);
-    ObjectAttrHash[vr_key] = { };
+    create_object(meta_key_vr);
 
     sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP,switch_id);
     object_reference_insert(hop);
     sai_object_meta_key_t meta_key_hop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP, .objectkey = { .key = { .object_id = hop } } };
-    std::string hop_key = sai_serialize_object_meta_key(meta_key_hop);
-    ObjectAttrHash[hop_key] = { };
+    create_object(meta_key_hop);
 
     route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     route_entry.destination.addr.ip4 = htonl(0x0a00000f);
@@ -2284,15 +2269,13 @@ void test_route_entry_remove()
 
     sai_object_meta_key_t meta = { .objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY, .objectkey = { .key = { .route_entry = route_entry } } };
 
-    std::string key = sai_serialize_object_meta_key(meta);
-
-    META_ASSERT_TRUE(object_exists(key));
+    META_ASSERT_TRUE(object_exists(meta));
 
     SWSS_LOG_NOTICE("success");
     status = meta_sai_remove_route_entry(&route_entry, &dummy_success_sai_remove_route_entry);
     META_ASSERT_SUCCESS(status);
 
-    META_ASSERT_TRUE(!object_exists(key));
+    META_ASSERT_TRUE(!object_exists(meta));
 
     route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     route_entry.destination.addr.ip4 = htonl(0x0a00000f);
@@ -2320,14 +2303,12 @@ void test_route_entry_set()
     sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER,switch_id);
     object_reference_insert(vr);
     sai_object_meta_key_t meta_key_vr = { .objecttype = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .objectkey = { .key = { .object_id = vr } } };
-    std::string vr_key = sai_serialize_object_meta_key(meta_key_vr);
-    ObjectAttrHash[vr_key] = { };
+    create_object(meta_key_vr);
 
     sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP,switch_id);
     object_reference_insert(hop);
     sai_object_meta_key_t meta_key_hop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP, .objectkey = { .key = { .object_id = hop } } };
-    std::string hop_key = sai_serialize_object_meta_key(meta_key_hop);
-    ObjectAttrHash[hop_key] = { };
+    create_object(meta_key_hop);
 
     route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     route_entry.destination.addr.ip4 = htonl(0x0a00000f);
@@ -2427,14 +2408,12 @@ void test_route_entry_get()
     sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER,switch_id);
     object_reference_insert(vr);
     sai_object_meta_key_t meta_key_vr = { .objecttype = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .objectkey = { .key = { .object_id = vr } } };
-    std::string vr_key = sai_serialize_object_meta_key(meta_key_vr);
-    ObjectAttrHash[vr_key] = { };
+    create_object(meta_key_vr);
 
     sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP,switch_id);
     object_reference_insert(hop);
     sai_object_meta_key_t meta_key_hop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP, .objectkey = { .key = { .object_id = hop } } };
-    std::string hop_key = sai_serialize_object_meta_key(meta_key_hop);
-    ObjectAttrHash[hop_key] = { };
+    create_object(meta_key_hop);
 
     route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     route_entry.destination.addr.ip4 = htonl(0x0a00000f);
@@ -2531,14 +2510,12 @@ void test_route_entry_flow()
     sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER,switch_id);
     object_reference_insert(vr);
     sai_object_meta_key_t meta_key_vr = { .objecttype = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .objectkey = { .key = { .object_id = vr } } };
-    std::string vr_key = sai_serialize_object_meta_key(meta_key_vr);
-    ObjectAttrHash[vr_key] = { };
+    create_object(meta_key_vr);
 
     sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP,switch_id);
     object_reference_insert(hop);
     sai_object_meta_key_t meta_key_hop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP, .objectkey = { .key = { .object_id = hop } } };
-    std::string hop_key = sai_serialize_object_meta_key(meta_key_hop);
-    ObjectAttrHash[hop_key] = { };
+    create_object(meta_key_hop);
 
     route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
     route_entry.destination.addr.ip4 = htonl(0x0a00000f);
@@ -2668,6 +2645,141 @@ void test_route_entry_flow()
 
 // SERIALIZATION TYPES TESTS
 
+size_t get_resident_memory()
+{
+    SWSS_LOG_ENTER();
+
+    std::ifstream statm("/proc/self/statm");
+
+    size_t size = 0;
+    size_t resident = 0;
+
+    statm >> size >> resident;
+
+    return resident * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+void test_route_entry_perf()
+{
+    SWSS_LOG_ENTER();
+
+    clear_local();
+    meta_init_db();
+
+    /*
+     * Validation time per call and meta DB memory on full route table, every
+     * route goes through create, set, get and remove validation.
+     */
+
+    const uint32_t count = 500000;
+
+    sai_object_id_t switch_id = create_switch();
+
+    // TODO we should use create
+    sai_object_id_t vr = create_dummy_object_id(SAI_OBJECT_TYPE_VIRTUAL_ROUTER,switch_id);
+    object_reference_insert(vr);
+    sai_object_meta_key_t meta_key_vr = { .objecttype = SAI_OBJECT_TYPE_VIRTUAL_ROUTER, .objectkey = { .key = { .object_id = vr } } };
+    create_object(meta_key_vr);
+
+    sai_object_id_t hop = create_dummy_object_id(SAI_OBJECT_TYPE_NEXT_HOP,switch_id);
+    object_reference_insert(hop);
+    sai_object_meta_key_t meta_key_hop = { .objecttype = SAI_OBJECT_TYPE_NEXT_HOP, .objectkey = { .key = { .object_id = hop } } };
+    create_object(meta_key_hop);
+
+    sai_route_entry_t route_entry;
+
+    memset(&route_entry, 0, sizeof(route_entry));
+
+    route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    route_entry.destination.mask.ip4 = htonl(0xffffff00);
+    route_entry.vr_id = vr;
+    route_entry.switch_id = switch_id;
+
+    sai_attribute_t list[2] = { };
+
+    list[0].id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+    list[0].value.oid = hop;
+
+    list[1].id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+    list[1].value.s32 = SAI_PACKET_ACTION_FORWARD;
+
+    sai_attribute_t attr;
+
+    /*
+     * Debug logs of each call would dominate time spent in validation.
+     */
+
+    swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_NOTICE);
+
+    size_t memory = get_resident_memory();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        route_entry.destination.addr.ip4 = htonl(0x10000000 + (i << 8));
+
+        sai_status_t status = meta_sai_create_route_entry(&route_entry, 2, list, &dummy_success_sai_create_route_entry);
+        META_ASSERT_SUCCESS(status);
+    }
+
+    double create = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    memory = get_resident_memory() - memory;
+
+    start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        route_entry.destination.addr.ip4 = htonl(0x10000000 + (i << 8));
+
+        attr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+        attr.value.s32 = SAI_PACKET_ACTION_DROP;
+
+        sai_status_t status = meta_sai_set_route_entry(&route_entry, &attr, &dummy_success_sai_set_route_entry);
+        META_ASSERT_SUCCESS(status);
+    }
+
+    double set = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        route_entry.destination.addr.ip4 = htonl(0x10000000 + (i << 8));
+
+        attr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+
+        sai_status_t status = meta_sai_get_route_entry(&route_entry, 1, &attr, &dummy_success_sai_get_route_entry);
+        META_ASSERT_SUCCESS(status);
+    }
+
+    double get = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        route_entry.destination.addr.ip4 = htonl(0x10000000 + (i << 8));
+
+        sai_status_t status = meta_sai_remove_route_entry(&route_entry, &dummy_success_sai_remove_route_entry);
+        META_ASSERT_SUCCESS(status);
+    }
+
+    double remove = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_DEBUG);
+
+    META_ASSERT_TRUE(object_reference_count(hop) == 0);
+
+    std::cout << "meta db: " << count << " routes, per call "
+        << create * 1e6 / count << " us create, "
+        << set * 1e6 / count << " us set, "
+        << get * 1e6 / count << " us get, "
+        << remove * 1e6 / count << " us remove, "
+        << memory / count << " bytes per route" << std::endl;
+}
+
 void test_serialization_type_vlan_list()
 {
     SWSS_LOG_ENTER();
@@ -2765,8 +2877,7 @@ void test_serialization_type_char()
     sai_object_id_t rif = create_dummy_object_id(SAI_OBJECT_TYPE_PORT,switch_id);
     object_reference_insert(rif);
     sai_object_meta_key_t meta_key_rif = { .objecttype = SAI_OBJECT_TYPE_ROUTER_INTERFACE, .objectkey = { .key = { .object_id = rif } } };
-    std::string rif_key = sai_serialize_object_meta_key(meta_key_rif);
-    ObjectAttrHash[rif_key] = { };
+    create_object(meta_key_rif);
 
     sai_attribute_t attr, attr2, attr3;
 
@@ -2958,8 +3069,7 @@ sai_object_id_t insert_dummy_object(
     sai_object_id_t oid = create_dummy_object_id(ot,switch_id);
     object_reference_insert(oid);
     sai_object_meta_key_t meta_key_oid = { .objecttype = ot, .objectkey = { .key = { .object_id = oid } } };
-    std::string oid_key = sai_serialize_object_meta_key(meta_key_oid);
-    ObjectAttrHash[oid_key] = { };
+    create_object(meta_key_oid);
 
     return oid;
 }
@@ -4065,6 +4175,255 @@ void test_serialize_tunnel_map()
     ASSERT_TRUE(l.value.vni_id, 44);
 }
 
+void test_serialize_binary()
+{
+    SWSS_LOG_ENTER();
+
+    clear_local();
+    meta_init_db();
+
+    sai_object_meta_key_t meta_key;
+    sai_object_meta_key_t meta_key2;
+
+    memset(&meta_key, 0, sizeof(meta_key));
+    memset(&meta_key2, 0, sizeof(meta_key2));
+
+    meta_key.objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY;
+
+    sai_route_entry_t &route_entry = meta_key.objectkey.key.route_entry;
+
+    route_entry.switch_id = 0x21000000000000;
+    route_entry.vr_id = 0x3000000000022;
+    route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV6;
+
+    inet_pton(AF_INET6, "2001:db8::1", route_entry.destination.addr.ip6);
+    memset(route_entry.destination.mask.ip6, 0xff, 8);
+
+    std::string s = sai_serialize_binary_object_meta_key(meta_key);
+
+    ASSERT_TRUE(sai_is_binary_serialized(s), true);
+    ASSERT_TRUE(sai_is_binary_serialized(sai_serialize_object_meta_key(meta_key)), false);
+
+    sai_deserialize_binary_object_meta_key(s, meta_key2);
+
+    ASSERT_TRUE(sai_serialize_object_meta_key(meta_key2), sai_serialize_object_meta_key(meta_key));
+
+    meta_key.objecttype = SAI_OBJECT_TYPE_PORT;
+    meta_key.objectkey.key.object_id = 0x1000000000001;
+
+    sai_deserialize_binary_object_meta_key(sai_serialize_binary_object_meta_key(meta_key), meta_key2);
+
+    ASSERT_TRUE(sai_serialize_object_meta_key(meta_key2), sai_serialize_object_meta_key(meta_key));
+
+    // attributes, with a list and a list sent only with its count
+
+    sai_object_id_t list[] = { 1, 0x42, 0x77 };
+
+    sai_attribute_t attrs[3];
+
+    attrs[0].id = SAI_SWITCH_ATTR_PORT_LIST;
+    attrs[0].value.objlist.count = 3;
+    attrs[0].value.objlist.list = list;
+
+    attrs[1].id = SAI_SWITCH_ATTR_SRC_MAC_ADDRESS;
+    memcpy(attrs[1].value.mac, "\x00\x01\x02\x03\x04\x05", 6);
+
+    attrs[2].id = SAI_SWITCH_ATTR_PORT_LIST;
+    attrs[2].value.objlist.count = 8;
+    attrs[2].value.objlist.list = NULL;
+
+    s = sai_serialize_binary_attr_list(SAI_OBJECT_TYPE_SWITCH, 3, attrs, false);
+
+    SaiAttributeList binary(SAI_OBJECT_TYPE_SWITCH, s, false);
+
+    auto expected = SaiAttributeList::serialize_attr_list(SAI_OBJECT_TYPE_SWITCH, 3, attrs, false);
+    auto actual = SaiAttributeList::serialize_attr_list(SAI_OBJECT_TYPE_SWITCH, binary.get_attr_count(), binary.get_attr_list(), false);
+
+    ASSERT_TRUE(actual.size(), expected.size());
+
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        ASSERT_TRUE(fvField(actual[i]), fvField(expected[i]));
+        ASSERT_TRUE(fvValue(actual[i]), fvValue(expected[i]));
+    }
+
+    s = sai_serialize_binary_attr_list(SAI_OBJECT_TYPE_SWITCH, 1, attrs, true);
+
+    SaiAttributeList counts(SAI_OBJECT_TYPE_SWITCH, s, true);
+
+    ASSERT_TRUE(counts.get_attr_list()[0].value.objlist.count, 3);
+    ASSERT_TRUE(counts.get_attr_list()[0].value.objlist.list, (sai_object_id_t*)NULL);
+}
+
+void test_serialize_binary_list_count()
+{
+    SWSS_LOG_ENTER();
+
+    clear_local();
+    meta_init_db();
+
+    sai_object_id_t list[] = { 0x42 };
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_SWITCH_ATTR_PORT_LIST;
+    attr.value.objlist.count = 1;
+    attr.value.objlist.list = list;
+
+    std::string s = sai_serialize_binary_attr_list(SAI_OBJECT_TYPE_SWITCH, 1, &attr, false);
+
+    /*
+     * Bytes 9..11 are the upper bytes of the list count, the last one is
+     * raised so the count claims far more items than the data holds.
+     */
+
+    ASSERT_TRUE(s.substr(14, 4), "AAAA");
+
+    s.replace(14, 4, "AAAQ");
+
+    try
+    {
+        SaiAttributeList binary(SAI_OBJECT_TYPE_SWITCH, s, false);
+        ASSERT_FAIL("list count larger than data failed to throw exception");
+    }
+    catch (const std::runtime_error& e)
+    {
+        // ok
+    }
+}
+
+void test_serialize_binary_perf()
+{
+    SWSS_LOG_ENTER();
+
+    clear_local();
+    meta_init_db();
+
+    /*
+     * Route entries with a next hop, the way they go to syncd, in text and
+     * in binary encoding.
+     */
+
+    const uint32_t count = 1000000;
+
+    sai_object_meta_key_t meta_key;
+
+    memset(&meta_key, 0, sizeof(meta_key));
+
+    meta_key.objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY;
+
+    sai_route_entry_t &route_entry = meta_key.objectkey.key.route_entry;
+
+    route_entry.switch_id = 0x21000000000000;
+    route_entry.vr_id = 0x3000000000022;
+    route_entry.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+    route_entry.destination.mask.ip4 = htonl(0xffffff00);
+
+    sai_attribute_t attrs[2];
+
+    attrs[0].id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+    attrs[0].value.s32 = SAI_PACKET_ACTION_FORWARD;
+
+    attrs[1].id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+
+    std::vector<std::string> keys;
+    std::vector<std::vector<swss::FieldValueTuple>> values;
+
+    keys.reserve(count);
+    values.reserve(count);
+
+    size_t size = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        route_entry.destination.addr.ip4 = htonl(0x0a000000 | i << 8);
+        attrs[1].value.oid = 0x4000000000000 | (i % 1000);
+
+        keys.push_back(sai_serialize_object_meta_key(meta_key));
+        values.push_back(SaiAttributeList::serialize_attr_list(SAI_OBJECT_TYPE_ROUTE_ENTRY, 2, attrs, false));
+
+        size += keys.back().size();
+
+        for (const auto &fv: values.back())
+        {
+            size += fvField(fv).size() + fvValue(fv).size();
+        }
+    }
+
+    double serialize = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        sai_object_meta_key_t key;
+        sai_deserialize_object_meta_key(keys[i], key);
+
+        SaiAttributeList list(SAI_OBJECT_TYPE_ROUTE_ENTRY, values[i], false);
+    }
+
+    double deserialize = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "text:   " << serialize << " s serialize, " << deserialize << " s deserialize, "
+        << size / count << " bytes per route" << std::endl;
+
+    std::vector<std::string> binary_keys;
+    std::vector<std::string> binary_values;
+
+    binary_keys.reserve(count);
+    binary_values.reserve(count);
+
+    size = 0;
+
+    start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        route_entry.destination.addr.ip4 = htonl(0x0a000000 | i << 8);
+        attrs[1].value.oid = 0x4000000000000 | (i % 1000);
+
+        binary_keys.push_back(sai_serialize_binary_object_meta_key(meta_key));
+        binary_values.push_back(sai_serialize_binary_attr_list(SAI_OBJECT_TYPE_ROUTE_ENTRY, 2, attrs, false));
+
+        size += binary_keys.back().size() + binary_values.back().size();
+    }
+
+    serialize = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        sai_object_meta_key_t key;
+        sai_deserialize_binary_object_meta_key(binary_keys[i], key);
+
+        SaiAttributeList list(SAI_OBJECT_TYPE_ROUTE_ENTRY, binary_values[i], false);
+    }
+
+    deserialize = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "binary: " << serialize << " s serialize, " << deserialize << " s deserialize, "
+        << size / count << " bytes per route" << std::endl;
+
+    // both encodings give the same routes
+
+    for (uint32_t i = 0; i < count; i += count / 100)
+    {
+        sai_object_meta_key_t key;
+        sai_deserialize_binary_object_meta_key(binary_keys[i], key);
+
+        ASSERT_TRUE(sai_serialize_object_meta_key(key), keys[i]);
+
+        SaiAttributeList list(SAI_OBJECT_TYPE_ROUTE_ENTRY, binary_values[i], false);
+
+        auto text = SaiAttributeList::serialize_attr_list(SAI_OBJECT_TYPE_ROUTE_ENTRY, list.get_attr_count(), list.get_attr_list(), false);
+
+        ASSERT_TRUE(fvValue(text[1]), fvValue(values[i][1]));
+    }
+}
+
 template<typename T>
 void deserialize_number(
         _In_ const std::string& s,
@@ -4150,7 +4509,7 @@ void test_numbers()
     ASSERT_TRUE(u,   0x12345678);
 }
 
-int main()
+int main(int argc, char **argv)
 {
     swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_DEBUG);
 
@@ -4171,6 +4530,8 @@ int main()
     test_serialize_acl_action();
     test_serialize_qos_map();
     test_serialize_tunnel_map();
+    test_serialize_binary();
+    test_serialize_binary_list_count();
 
     // attributes tests
 
@@ -4217,5 +4578,15 @@ int main()
 
     test_priority_group();
 
+    /*
+     * Benchmarks are not part of the test run, "tests perf" runs them.
+     */
+
+    if (argc > 1 && std::string(argv[1]) == "perf")
+    {
+        test_route_entry_perf();
+        test_serialize_binary_perf();
+    }
+
     std::cout << "SUCCESS" << std::endl;
 }
@@ -12,7 +12,15 @@ extern "C" {
 #include "swss/tokenize.h"
 #include "sairedis.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <set>
 #include <stdexcept>
 #include <sstream>
 #include <string>
@@ -705,6 +713,39 @@ sai_status_t handle_generic(
     }
 }
 
+sai_status_t handle_object(
+        _In_ sai_object_type_t object_type,
+        _In_ const std::string &str_object_id,
+        _In_ sai_common_api_t api,
+        _In_ uint32_t attr_count,
+        _In_ sai_attribute_t *attr_list)
+{
+    SWSS_LOG_ENTER();
+
+    switch (object_type)
+    {
+        case SAI_OBJECT_TYPE_FDB_ENTRY:
+            return handle_fdb(str_object_id, api, attr_count, attr_list);
+
+        case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+            return handle_neighbor(str_object_id, api, attr_count, attr_list);
+
+        case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+            return handle_route(str_object_id, api, attr_count, attr_list);
+
+        default:
+
+            if (sai_metadata_get_object_type_info(object_type)->isnonobjectid)
+            {
+                SWSS_LOG_THROW("object %s:%s is non object id, but not handled, FIXME",
+                        sai_serialize_object_type(object_type).c_str(),
+                        str_object_id.c_str());
+            }
+
+            return handle_generic(object_type, str_object_id, api, attr_count, attr_list);
+    }
+}
+
 void handle_get_response(
         sai_object_type_t object_type,
         uint32_t get_attr_count,
@@ -880,16 +921,45 @@ sai_status_t handle_bulk_route(
 
     statuses.resize(recorded_statuses.size());
 
-    if (api == (sai_common_api_t)SAI_COMMON_API_BULK_SET)
+    /*
+     * TODO: since SDK don't support bulk route api yet, we just use our
+     * implementation, and later on we can switch to SDK api.
+     *
+     * TODO: we need to get operation type from recording, currently is not
+     * serialized and it is hard coded here.
+     */
+
+    sai_status_t status;
+
+    if (api == (sai_common_api_t)SAI_COMMON_API_BULK_CREATE)
     {
-        /*
-         * TODO: since SDK don't support bulk route api yet, we just use our
-         * implementation, and later on we can switch to SDK api.
-         *
-         * TODO: we need to get operation type from recording, currently is not
-         * serialized and it is hard coded here.
-         */
+        std::vector<uint32_t> attr_counts;
+        std::vector<const sai_attribute_t*> attr_lists;
+
+        for (const auto &a: attributes)
+        {
+            attr_counts.push_back(a->get_attr_count());
+            attr_lists.push_back(a->get_attr_list());
+        }
 
+        status = sai_bulk_create_route_entry(
+                (uint32_t)routes.size(),
+                routes.data(),
+                attr_counts.data(),
+                attr_lists.data(),
+                SAI_BULK_OP_TYPE_INGORE_ERROR, // TODO we need to get that from recording
+                statuses.data());
+    }
+    else if (api == (sai_common_api_t)SAI_COMMON_API_BULK_REMOVE)
+    {
+        status = sai_bulk_remove_route_entry(
+                (uint32_t)routes.size(),
+                routes.data(),
+                SAI_BULK_OP_TYPE_INGORE_ERROR, // TODO we need to get that from recording
+                statuses.data());
+    }
+    else if (api == (sai_common_api_t)SAI_COMMON_API_BULK_SET)
+    {
         std::vector<sai_attribute_t> attrs;
 
         for (const auto &a: attributes)
@@ -901,44 +971,108 @@ sai_status_t handle_bulk_route(
             attrs.push_back(a->get_attr_list()[0]);
         }
 
-        sai_status_t status = sai_bulk_set_route_entry_attribute(
+        status = sai_bulk_set_route_entry_attribute(
                 (uint32_t)routes.size(),
                 routes.data(),
                 attrs.data(),
                 SAI_BULK_OP_TYPE_INGORE_ERROR, // TODO we need to get that from recording
                 statuses.data());
+    }
+    else
+    {
+        SWSS_LOG_THROW("api %d is not supported in bulk route", api);
+    }
 
-        if (status != SAI_STATUS_SUCCESS)
+    if (status != SAI_STATUS_SUCCESS && status != SAI_STATUS_FAILURE)
+    {
+        /*
+         * Entire API failes, so no need to compare statuses.
+         */
+
+        return status;
+    }
+
+    for (size_t i = 0; i < statuses.size(); ++i)
+    {
+        if (statuses[i] != recorded_statuses[i])
         {
             /*
-             * Entire API failes, so no need to compare statuses.
+             * If recorded statuses are different than received, throw
+             * excetion since data don't match.
              */
 
-            return status;
+            SWSS_LOG_THROW("recorded status is %s but returned is %s on %s",
+                    sai_serialize_status(recorded_statuses[i]).c_str(),
+                    sai_serialize_status(statuses[i]).c_str(),
+                    object_ids[i].c_str());
         }
+    }
 
-        for (size_t i = 0; i < statuses.size(); ++i)
-        {
-            if (statuses[i] != recorded_statuses[i])
-            {
-                /*
-                 * If recorded statuses are different than received, throw
-                 * excetion since data don't match.
-                 */
-
-                SWSS_LOG_THROW("recorded status is %s but returned is %s on %s",
-                        sai_serialize_status(recorded_statuses[i]).c_str(),
-                        sai_serialize_status(statuses[i]).c_str(),
-                        object_ids[i].c_str());
-            }
-        }
+    return SAI_STATUS_SUCCESS;
+}
 
-        return status;
+sai_status_t handle_bulk_generic(
+        _In_ sai_object_type_t object_type,
+        _In_ const std::vector<std::string> &object_ids,
+        _In_ sai_common_api_t api,
+        _In_ const std::vector<std::shared_ptr<SaiAttributeList>> &attributes,
+        _In_ const std::vector<sai_status_t> &recorded_statuses)
+{
+    SWSS_LOG_ENTER();
+
+    sai_common_api_t single_api;
+
+    switch (api)
+    {
+        case (sai_common_api_t)SAI_COMMON_API_BULK_CREATE:
+            single_api = SAI_COMMON_API_CREATE;
+            break;
+
+        case (sai_common_api_t)SAI_COMMON_API_BULK_REMOVE:
+            single_api = SAI_COMMON_API_REMOVE;
+            break;
+
+        case (sai_common_api_t)SAI_COMMON_API_BULK_SET:
+            single_api = SAI_COMMON_API_SET;
+            break;
+
+        default:
+            SWSS_LOG_THROW("api %d is not supported in bulk %s", api,
+                    sai_serialize_object_type(object_type).c_str());
     }
-    else
+
+    /*
+     * Objects are replayed one by one, since object ids are created by
+     * sairedis and have to be matched with recorded ones, objects which
+     * failed when recorded are skipped.
+     */
+
+    for (size_t i = 0; i < object_ids.size(); ++i)
     {
-        SWSS_LOG_THROW("api %d is not supported in bulk route", api);
+        if (recorded_statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            continue;
+        }
+
+        sai_status_t status = handle_generic(
+                object_type,
+                object_ids[i],
+                single_api,
+                attributes[i]->get_attr_count(),
+                attributes[i]->get_attr_list());
+
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("recorded status is %s but returned is %s on %s",
+                    sai_serialize_status(recorded_statuses[i]).c_str(),
+                    sai_serialize_status(status).c_str(),
+                    object_ids[i].c_str());
+
+            return status;
+        }
     }
+
+    return SAI_STATUS_SUCCESS;
 }
 
 void processBulk(
@@ -952,15 +1086,6 @@ void processBulk(
         return;
     }
 
-    if (api != (sai_common_api_t)SAI_COMMON_API_BULK_SET)
-    {
-        SWSS_LOG_THROW("bulk common api %d is not supported yet, FIXME", api);
-    }
-
-    /*
-     * Here we know we have bulk SET api
-     */
-
     // timestamp|action|objecttype||objectid|attrid=value|...|status||objectid||objectid|attrid=value|...|status||...
     auto fields = tokenize(line, "||");
 
@@ -1040,6 +1165,12 @@ void processBulk(
             status = handle_bulk_route(object_ids, api, attributes, statuses);
             break;
 
+        case SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER:
+        case SAI_OBJECT_TYPE_ACL_ENTRY:
+        case SAI_OBJECT_TYPE_ACL_COUNTER:
+            status = handle_bulk_generic(object_type, object_ids, api, attributes, statuses);
+            break;
+
         default:
 
             SWSS_LOG_THROW("bulk op for %s is not supported yet, FIXME",
@@ -1052,6 +1183,619 @@ void processBulk(
     }
 }
 
+/*
+ * Performance replay, selected by --performance.
+ *
+ * Whole recording is parsed before replay starts, so parsing is not part of
+ * measured time. Consecutive creates, sets and removes of the same object
+ * type are executed as one bulk call where sairedis has bulk API, and writes
+ * are pipelined to redis. Replay is synchronized with syncd only at
+ * checkpoints: gets (their responses are verified as in normal replay),
+ * notify syncd and end of recording, where a get on the switch waits until
+ * syncd executed everything. Sleeps are not replayed.
+ *
+ * Time of every call is reported per object type, for pipelined writes this
+ * is the time sairedis took to queue them. Total time includes the final
+ * checkpoint, so total throughput is end to end through syncd and vendor
+ * SAI/vslib.
+ */
+
+bool g_performance = false;
+
+#define PERFORMANCE_MAX_BULK_SIZE 1024
+
+typedef struct _replay_operation_t
+{
+    char op;
+
+    sai_object_type_t object_type;
+
+    std::string str_object_id;
+
+    std::shared_ptr<SaiAttributeList> attributes;
+
+    /*
+     * Number of objects in operation, more than 1 only for recorded bulk
+     * operations.
+     */
+
+    size_t objects;
+
+    /*
+     * Recorded line, only kept for operations which are replayed from text
+     * (notify syncd, get responses and recorded bulk operations).
+     */
+
+    std::string line;
+
+} replay_operation_t;
+
+typedef struct _replay_stats_t
+{
+    size_t objects;
+
+    /*
+     * Duration of each call in microseconds, bulk call is counted once.
+     */
+
+    std::vector<uint64_t> latencies;
+
+} replay_stats_t;
+
+std::map<sai_object_type_t, replay_stats_t> g_replayStats;
+
+void replay_stats_add(
+        _In_ sai_object_type_t object_type,
+        _In_ size_t objects,
+        _In_ const std::chrono::steady_clock::time_point &start)
+{
+    SWSS_LOG_ENTER();
+
+    auto usec = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    replay_stats_t &stats = g_replayStats[object_type];
+
+    stats.objects += objects;
+    stats.latencies.push_back((uint64_t)usec);
+}
+
+uint64_t replay_stats_percentile(
+        _In_ const std::vector<uint64_t> &sorted,
+        _In_ double percentile)
+{
+    SWSS_LOG_ENTER();
+
+    // nearest rank
+    size_t rank = (size_t)std::ceil(percentile / 100.0 * (double)sorted.size());
+
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+void replay_stats_print(
+        _In_ double parse_sec,
+        _In_ double replay_sec)
+{
+    SWSS_LOG_ENTER();
+
+    size_t total = 0;
+
+    std::cout << std::left << std::setw(45) << "object type" << std::right
+        << std::setw(10) << "objects"
+        << std::setw(10) << "calls"
+        << std::setw(12) << "objects/s"
+        << std::setw(10) << "p50 us"
+        << std::setw(10) << "p90 us"
+        << std::setw(10) << "p99 us"
+        << std::setw(10) << "max us" << std::endl;
+
+    for (auto &kvp: g_replayStats)
+    {
+        replay_stats_t &stats = kvp.second;
+
+        std::sort(stats.latencies.begin(), stats.latencies.end());
+
+        uint64_t usec = 0;
+
+        for (auto latency: stats.latencies)
+        {
+            usec += latency;
+        }
+
+        double rate = usec ? (double)stats.objects * 1000000.0 / (double)usec : 0;
+
+        std::cout << std::left << std::setw(45) << sai_serialize_object_type(kvp.first) << std::right
+            << std::setw(10) << stats.objects
+            << std::setw(10) << stats.latencies.size()
+            << std::setw(12) << (uint64_t)rate
+            << std::setw(10) << replay_stats_percentile(stats.latencies, 50)
+            << std::setw(10) << replay_stats_percentile(stats.latencies, 90)
+            << std::setw(10) << replay_stats_percentile(stats.latencies, 99)
+            << std::setw(10) << stats.latencies.back() << std::endl;
+
+        total += stats.objects;
+    }
+
+    std::cout << "replayed " << total << " objects in " << replay_sec << " sec, "
+        << (uint64_t)(replay_sec > 0 ? (double)total / replay_sec : 0) << " objects/s"
+        << " (parsing took " << parse_sec << " sec)" << std::endl;
+}
+
+void parse_recording(
+        _In_ std::ifstream &infile,
+        _Out_ std::vector<replay_operation_t> &operations)
+{
+    SWSS_LOG_ENTER();
+
+    std::string line;
+
+    while (std::getline(infile, line))
+    {
+        auto p = line.find_first_of("|");
+
+        if (p == std::string::npos || p + 1 >= line.size())
+        {
+            continue;
+        }
+
+        replay_operation_t operation;
+
+        operation.op = line[p+1];
+        operation.object_type = SAI_OBJECT_TYPE_NULL;
+        operation.objects = 1;
+
+        switch (operation.op)
+        {
+            case '#':
+            case 'n':
+                continue; // skip comment and notification
+
+            case 'c':
+            case 'r':
+            case 's':
+            case 'g':
+
+                {
+                    // timestamp|action|objecttype:objectid|attrid=value,...
+                    auto fields = swss::tokenize(line, '|');
+
+                    // objecttype:objectid (object id may contain ':')
+                    auto start = fields[2].find_first_of(":");
+
+                    operation.object_type = deserialize_object_type(fields[2].substr(0, start));
+                    operation.str_object_id = fields[2].substr(start + 1);
+
+                    operation.attributes = std::make_shared<SaiAttributeList>(operation.object_type, get_values(fields), false);
+                }
+
+                break;
+
+            case 'C':
+            case 'R':
+            case 'S':
+
+                {
+                    // timestamp|action|objecttype||objectid|attrid=value|...|status||...
+                    auto first = line.substr(0, line.find("||"));
+
+                    operation.object_type = deserialize_object_type(swss::tokenize(first, '|').at(2));
+
+                    operation.objects = 0;
+
+                    for (size_t pos = line.find("||"); pos != std::string::npos; pos = line.find("||", pos + 2))
+                    {
+                        operation.objects++;
+                    }
+
+                    operation.line = line;
+                }
+
+                break;
+
+            case 'a':
+            case 'A':
+            case 'G':
+                operation.line = line;
+                break;
+
+            case '@':
+                break;
+
+            default:
+                SWSS_LOG_THROW("unknown op %c on line %s", operation.op, line.c_str());
+        }
+
+        operations.push_back(std::move(operation));
+    }
+}
+
+sai_common_api_t replay_api(
+        _In_ char op)
+{
+    SWSS_LOG_ENTER();
+
+    switch (op)
+    {
+        case 'c': return SAI_COMMON_API_CREATE;
+        case 'r': return SAI_COMMON_API_REMOVE;
+        case 's': return SAI_COMMON_API_SET;
+        case 'g': return SAI_COMMON_API_GET;
+        case 'C': return (sai_common_api_t)SAI_COMMON_API_BULK_CREATE;
+        case 'R': return (sai_common_api_t)SAI_COMMON_API_BULK_REMOVE;
+        case 'S': return (sai_common_api_t)SAI_COMMON_API_BULK_SET;
+
+        default:
+            SWSS_LOG_THROW("op %c is not an api", op);
+    }
+}
+
+bool replay_bulk_supported(
+        _In_ char op,
+        _In_ sai_object_type_t object_type)
+{
+    SWSS_LOG_ENTER();
+
+    switch (object_type)
+    {
+        case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+            return op == 'c' || op == 'r' || op == 's';
+
+        case SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER:
+            return op == 'c' || op == 'r';
+
+        default:
+            return false;
+    }
+}
+
+sai_status_t handle_bulk_next_hop_group_member(
+        _In_ const std::vector<std::string> &object_ids,
+        _In_ sai_common_api_t api,
+        _In_ const std::vector<std::shared_ptr<SaiAttributeList>> &attributes)
+{
+    SWSS_LOG_ENTER();
+
+    uint32_t object_count = (uint32_t)object_ids.size();
+
+    std::vector<sai_object_id_t> local_ids(object_count);
+    std::vector<sai_object_id_t> object_id(object_count);
+    std::vector<sai_status_t> statuses(object_count);
+
+    for (uint32_t i = 0; i < object_count; ++i)
+    {
+        sai_deserialize_object_id(object_ids[i], local_ids[i]);
+    }
+
+    sai_status_t status;
+
+    if (api == SAI_COMMON_API_CREATE)
+    {
+        sai_object_id_t switch_id = translate_local_to_redis(sai_switch_id_query(local_ids[0]));
+
+        std::vector<uint32_t> attr_counts;
+        std::vector<const sai_attribute_t*> attr_lists;
+
+        for (const auto &a: attributes)
+        {
+            attr_counts.push_back(a->get_attr_count());
+            attr_lists.push_back(a->get_attr_list());
+        }
+
+        status = redis_bulk_object_create_next_hop_group_members(
+                switch_id,
+                object_count,
+                attr_counts.data(),
+                attr_lists.data(),
+                SAI_BULK_OP_TYPE_INGORE_ERROR,
+                object_id.data(),
+                statuses.data());
+    }
+    else if (api == SAI_COMMON_API_REMOVE)
+    {
+        for (uint32_t i = 0; i < object_count; ++i)
+        {
+            object_id[i] = translate_local_to_redis(local_ids[i]);
+        }
+
+        status = redis_bulk_object_remove_next_hop_group_members(
+                object_count,
+                object_id.data(),
+                SAI_BULK_OP_TYPE_INGORE_ERROR,
+                statuses.data());
+    }
+    else
+    {
+        SWSS_LOG_THROW("api %d is not supported in bulk next hop group member", api);
+    }
+
+    if (status != SAI_STATUS_SUCCESS && status != SAI_STATUS_FAILURE)
+    {
+        return status;
+    }
+
+    for (uint32_t i = 0; i < object_count; ++i)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("failed to execute %s on %s",
+                    sai_serialize_status(statuses[i]).c_str(),
+                    object_ids[i].c_str());
+
+            return statuses[i];
+        }
+
+        if (api == SAI_COMMON_API_CREATE)
+        {
+            match_redis_with_rec(object_id[i], local_ids[i]);
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+void replay_flush()
+{
+    SWSS_LOG_ENTER();
+
+    sai_attribute_t attr;
+
+    attr.id = SAI_REDIS_SWITCH_ATTR_FLUSH;
+    attr.value.booldata = true;
+
+    EXIT_ON_ERROR(sai_metadata_sai_switch_api->set_switch_attribute(SAI_NULL_OBJECT_ID, &attr));
+}
+
+/*
+ * Waits until syncd executed all operations sent so far, get is answered by
+ * syncd only after everything queued before it.
+ */
+void replay_checkpoint()
+{
+    SWSS_LOG_ENTER();
+
+    replay_flush();
+
+    for (const auto &kvp: local_to_redis)
+    {
+        if (sai_object_type_query(kvp.second) != SAI_OBJECT_TYPE_SWITCH)
+        {
+            continue;
+        }
+
+        sai_attribute_t attr;
+
+        attr.id = SAI_SWITCH_ATTR_PORT_NUMBER;
+
+        EXIT_ON_ERROR(sai_metadata_sai_switch_api->get_switch_attribute(kvp.second, 1, &attr));
+
+        return;
+    }
+
+    SWSS_LOG_WARN("no switch was created, nothing to wait for");
+}
+
+/*
+ * Executes consecutive operations starting at index as one bulk call, returns
+ * number of executed operations.
+ */
+size_t replay_bulk(
+        _In_ std::vector<replay_operation_t> &operations,
+        _In_ size_t index)
+{
+    SWSS_LOG_ENTER();
+
+    const replay_operation_t &first = operations[index];
+
+    std::vector<std::string> object_ids;
+    std::vector<std::shared_ptr<SaiAttributeList>> attributes;
+    std::set<std::string> unique;
+
+    /*
+     * Same object twice in one bulk could be executed in different order
+     * than recorded, so bulk ends there.
+     */
+
+    for (size_t idx = index; idx < operations.size() && object_ids.size() < PERFORMANCE_MAX_BULK_SIZE; ++idx)
+    {
+        replay_operation_t &operation = operations[idx];
+
+        if (operation.op != first.op ||
+                operation.object_type != first.object_type ||
+                !unique.insert(operation.str_object_id).second)
+        {
+            break;
+        }
+
+        translate_local_to_redis(
+                operation.object_type,
+                operation.attributes->get_attr_count(),
+                operation.attributes->get_attr_list());
+
+        object_ids.push_back(operation.str_object_id);
+        attributes.push_back(operation.attributes);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    sai_status_t status;
+
+    if (first.object_type == SAI_OBJECT_TYPE_ROUTE_ENTRY)
+    {
+        sai_common_api_t api;
+
+        switch (first.op)
+        {
+            case 'c': api = (sai_common_api_t)SAI_COMMON_API_BULK_CREATE; break;
+            case 'r': api = (sai_common_api_t)SAI_COMMON_API_BULK_REMOVE; break;
+            default:  api = (sai_common_api_t)SAI_COMMON_API_BULK_SET; break;
+        }
+
+        std::vector<sai_status_t> statuses(object_ids.size(), SAI_STATUS_SUCCESS);
+
+        status = handle_bulk_route(object_ids, api, attributes, statuses);
+    }
+    else
+    {
+        status = handle_bulk_next_hop_group_member(object_ids, replay_api(first.op), attributes);
+    }
+
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_THROW("failed to execute bulk api: %c %s: %s",
+                first.op,
+                sai_serialize_object_type(first.object_type).c_str(),
+                sai_serialize_status(status).c_str());
+    }
+
+    replay_stats_add(first.object_type, object_ids.size(), start);
+
+    // release memory of replayed operations
+    for (size_t idx = index; idx < index + object_ids.size(); ++idx)
+    {
+        operations[idx].attributes = nullptr;
+    }
+
+    return object_ids.size();
+}
+
+int replay_performance(
+        _In_ std::ifstream &infile,
+        _In_ const char *filename)
+{
+    SWSS_LOG_ENTER();
+
+    auto parse_start = std::chrono::steady_clock::now();
+
+    std::vector<replay_operation_t> operations;
+
+    parse_recording(infile, operations);
+
+    auto replay_start = std::chrono::steady_clock::now();
+
+    SWSS_LOG_NOTICE("parsed %zu operations from %s", operations.size(), filename);
+
+    for (size_t idx = 0; idx < operations.size(); ++idx)
+    {
+        replay_operation_t &operation = operations[idx];
+
+        switch (operation.op)
+        {
+            case 'a':
+
+                if (idx + 1 >= operations.size() || operations[idx + 1].op != 'A')
+                {
+                    SWSS_LOG_THROW("missing response for: %s", operation.line.c_str());
+                }
+
+                // checkpoint, syncd executes all pending operations before view changes
+
+                replay_flush();
+
+                performNotifySyncd(operation.line, operations[++idx].line);
+
+                continue;
+
+            case '@':
+                continue; // sleeps are not replayed
+
+            case 'A':
+            case 'G':
+                SWSS_LOG_THROW("response without request: %s", operation.line.c_str());
+
+            case 'C':
+            case 'R':
+            case 'S':
+
+                {
+                    auto start = std::chrono::steady_clock::now();
+
+                    processBulk(replay_api(operation.op), operation.line);
+
+                    replay_stats_add(operation.object_type, operation.objects, start);
+                }
+
+                continue;
+
+            default:
+                break;
+        }
+
+        if (operation.op != 'g' && replay_bulk_supported(operation.op, operation.object_type))
+        {
+            idx += replay_bulk(operations, idx) - 1;
+            continue;
+        }
+
+        sai_common_api_t api = replay_api(operation.op);
+
+        sai_attribute_t *attr_list = operation.attributes->get_attr_list();
+
+        uint32_t attr_count = operation.attributes->get_attr_count();
+
+        if (api != SAI_COMMON_API_GET)
+        {
+            translate_local_to_redis(operation.object_type, attr_count, attr_list);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        sai_status_t status = handle_object(operation.object_type, operation.str_object_id, api, attr_count, attr_list);
+
+        replay_stats_add(operation.object_type, 1, start);
+
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_THROW("failed to execute api: %c %s:%s: %s",
+                    operation.op,
+                    sai_serialize_object_type(operation.object_type).c_str(),
+                    operation.str_object_id.c_str(),
+                    sai_serialize_status(status).c_str());
+        }
+
+        if (api == SAI_COMMON_API_GET)
+        {
+            // checkpoint, get waits for syncd, response is verified
+
+            if (idx + 1 >= operations.size() || operations[idx + 1].op != 'G')
+            {
+                SWSS_LOG_THROW("missing get response for %s:%s",
+                        sai_serialize_object_type(operation.object_type).c_str(),
+                        operation.str_object_id.c_str());
+            }
+
+            const std::string &response = operations[++idx].line;
+
+            try
+            {
+                handle_get_response(operation.object_type, attr_count, attr_list, response);
+            }
+            catch (const std::exception &e)
+            {
+                SWSS_LOG_NOTICE("get: %s:%s",
+                        sai_serialize_object_type(operation.object_type).c_str(),
+                        operation.str_object_id.c_str());
+                SWSS_LOG_NOTICE("resp: %s", response.c_str());
+
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        // release memory of replayed operation
+        operation.attributes = nullptr;
+    }
+
+    replay_checkpoint();
+
+    auto end = std::chrono::steady_clock::now();
+
+    replay_stats_print(
+            std::chrono::duration<double>(replay_start - parse_start).count(),
+            std::chrono::duration<double>(end - replay_start).count());
+
+    SWSS_LOG_NOTICE("finished replaying %s with SUCCESS", filename);
+
+    return 0;
+}
+
 int replay(int argc, char **argv)
 {
     //swss::Logger::getInstance().setMinPrio(swss::Logger::SWSS_DEBUG);
@@ -1077,6 +1821,11 @@ int replay(int argc, char **argv)
         return -1;
     }
 
+    if (g_performance)
+    {
+        return replay_performance(infile, filename);
+    }
+
     std::string line;
 
     while (std::getline(infile, line))
@@ -1120,6 +1869,12 @@ int replay(int argc, char **argv)
             case 's':
                 api = SAI_COMMON_API_SET;
                 break;
+            case 'C':
+                processBulk((sai_common_api_t)SAI_COMMON_API_BULK_CREATE, line);
+                continue;
+            case 'R':
+                processBulk((sai_common_api_t)SAI_COMMON_API_BULK_REMOVE, line);
+                continue;
             case 'S':
                 processBulk((sai_common_api_t)SAI_COMMON_API_BULK_SET, line);
                 continue;
@@ -1160,36 +1915,7 @@ int replay(int argc, char **argv)
             translate_local_to_redis(object_type, attr_count, attr_list);
         }
 
-        sai_status_t status;
-
-        auto info = sai_metadata_get_object_type_info(object_type);
-
-        switch (object_type)
-        {
-            case SAI_OBJECT_TYPE_FDB_ENTRY:
-                status = handle_fdb(str_object_id, api, attr_count, attr_list);
-                break;
-
-            case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
-                status = handle_neighbor(str_object_id, api, attr_count, attr_list);
-                break;
-
-            case SAI_OBJECT_TYPE_ROUTE_ENTRY:
-                status = handle_route(str_object_id, api, attr_count, attr_list);
-                break;
-
-            default:
-
-                if (info->isnonobjectid)
-                {
-                    SWSS_LOG_THROW("object %s:%s is non object id, but not handled, FIXME",
-                            sai_serialize_object_type(object_type).c_str(),
-                            str_object_id.c_str());
-                }
-
-                status = handle_generic(object_type, str_object_id, api, attr_count, attr_list);
-                break;
-        }
+        sai_status_t status = handle_object(object_type, str_object_id, api, attr_count, attr_list);
 
         if (status != SAI_STATUS_SUCCESS)
         {
@@ -1237,6 +1963,9 @@ void printUsage()
     std::cout << "        Enable syslog debug messages" << std::endl << std::endl;
     std::cout << "    -u --useTempView:" << std::endl;
     std::cout << "        Enable temporary view between init and apply" << std::endl << std::endl;
+    std::cout << "    -p --performance:" << std::endl;
+    std::cout << "        Parse whole file first, group operations into bulk calls, pipeline" << std::endl;
+    std::cout << "        writes, verify only at gets and notify syncd and report timings" << std::endl << std::endl;
     std::cout << "    -h --help:" << std::endl;
     std::cout << "        Print out this message" << std::endl << std::endl;
 }
@@ -1255,10 +1984,11 @@ void handleCmdLine(int argc, char **argv)
             { "help",             no_argument,       0, 'h' },
             { "skipNotifySyncd",  no_argument,       0, 'C' },
             { "enableDebug",      no_argument,       0, 'd' },
+            { "performance",      no_argument,       0, 'p' },
             { 0,                  0,                 0,  0  }
         };
 
-        const char* const optstring = "hCdu";
+        const char* const optstring = "hCdup";
 
         int option_index;
 
@@ -1281,6 +2011,10 @@ void handleCmdLine(int argc, char **argv)
                 g_notifySyncd = false;
                 break;
 
+            case 'p':
+                g_performance = true;
+                break;
+
             case 'h':
                 printUsage();
                 exit(EXIT_SUCCESS);
@@ -1382,6 +2116,14 @@ int main(int argc, char **argv)
 
     EXIT_ON_ERROR(sai_metadata_sai_switch_api->set_switch_attribute(switch_id, &attr));
 
+    if (g_performance)
+    {
+        attr.id = SAI_REDIS_SWITCH_ATTR_USE_PIPELINE;
+        attr.value.booldata = true;
+
+        EXIT_ON_ERROR(sai_metadata_sai_switch_api->set_switch_attribute(switch_id, &attr));
+    }
+
     int exitcode = replay(argc, argv);
 
     sai_api_uninitialize();
@@ -1,12 +1,16 @@
 #include "syncd.h"
 #include "syncd_saiswitch.h"
 #include "sairedis.h"
-#include "syncd_pfc_watchdog.h"
+#include "syncd_flex_counter.h"
 #include "swss/tokenize.h"
+#include "swss/redisapi.h"
+#include "meta/saiserializebinary.h"
 #include <limits.h>
 
 #include <iostream>
 #include <map>
+#include <list>
+#include <chrono>
 
 /**
  * @brief Global mutex for thread synchronization
@@ -22,8 +26,33 @@
  */
 std::mutex g_mutex;
 
+std::shared_ptr<swss::DBConnector>          g_dbAsic;
 std::shared_ptr<swss::RedisClient>          g_redisClient;
 std::shared_ptr<swss::ProducerTable>        getResponse;
+
+/*
+ * Get responses are tagged with the request id of the get being served, and
+ * are encoded in binary when the get was.
+ */
+std::string g_getResponseOp = "getresponse";
+bool g_getResponseBinary = false;
+
+/*
+ * Bulk operation statuses are only sent when sairedis waits for them, with
+ * the request id the operation was tagged with.
+ */
+std::string g_bulkResponseOp;
+
+/*
+ * Whether the last notify offered the binary encoding version of syncd.
+ */
+bool g_notifyBinaryEncoding = false;
+
+/*
+ * Virtual ids of the objects discovered on the switch are leased from
+ * VIDCOUNTER in ranges, like the ones sairedis creates.
+ */
+SaiVidAllocator g_vidAllocator(VIDCOUNTER);
 std::shared_ptr<swss::NotificationProducer> notifications;
 
 /*
@@ -292,7 +321,7 @@ sai_object_id_t redis_create_virtual_object_id(
         SWSS_LOG_THROW("this function should not be used to create VID for switch id");
     }
 
-    uint64_t virtual_id = g_redisClient->incr(VIDCOUNTER);
+    uint64_t virtual_id = g_vidAllocator.allocate(*g_redisClient);
 
     int switch_index =  redis_get_switch_id_index(switch_id);
 
@@ -331,129 +360,135 @@ void remove_rid_and_vid_from_local(
 }
 
 /*
- * This method will create VID for actual RID retrived from device when doing
- * GET api and snooping while in init view mode.
- *
- * This function should not be used to create VID for SWITCH object type.
+ * Loads entire VIDTORID map from redis to local db, so translations of known
+ * objects will not need to query redis at all.
  */
-sai_object_id_t translate_rid_to_vid(
-        _In_ sai_object_id_t rid,
-        _In_ sai_object_id_t switch_vid)
+void redis_load_rid_and_vid_to_local()
 {
     SWSS_LOG_ENTER();
 
-    /*
-     * NOTE: switch_vid here is Virtual ID of switch for which we need
-     * create VID for given RID.
-     */
-
-    if (rid == SAI_NULL_OBJECT_ID)
-    {
-        SWSS_LOG_DEBUG("translated RID null to VID null");
+    SWSS_LOG_TIMER("load rid and vid map");
 
-        return SAI_NULL_OBJECT_ID;
-    }
+    local_rid_to_vid.clear();
+    local_vid_to_rid.clear();
 
-    auto it = local_rid_to_vid.find(rid);
+    auto map = g_redisClient->hgetall(VIDTORID);
 
-    if (it != local_rid_to_vid.end())
+    for (auto &kv: map)
     {
-        return it->second;
-    }
+        sai_object_id_t vid;
+        sai_object_id_t rid;
 
-    sai_object_id_t vid;
+        sai_deserialize_object_id(kv.first, vid);
+        sai_deserialize_object_id(kv.second, rid);
 
-    std::string str_rid = sai_serialize_object_id(rid);
-
-    auto pvid = g_redisClient->hget(RIDTOVID, str_rid);
-
-    if (pvid != NULL)
-    {
-        /*
-         * Object exists.
-         */
+        save_rid_and_vid_to_local(rid, vid);
+    }
 
-        std::string str_vid = *pvid;
+    SWSS_LOG_NOTICE("loaded %zu rid and vid pairs", local_vid_to_rid.size());
+}
 
-        sai_deserialize_object_id(str_vid, vid);
+/*
+ * RIDTOVID and VIDTORID entries of each pair are changed by single lua script,
+ * so other processes will never see only one direction of the map.
+ *
+ * KEYS are RIDTOVID and VIDTORID, ARGV are RID and VID pairs.
+ */
+const std::string g_ridAndVidSetScript =
+    "for i = 1, #ARGV, 2 do "
+    "redis.call('HSET', KEYS[1], ARGV[i], ARGV[i + 1]) "
+    "redis.call('HSET', KEYS[2], ARGV[i + 1], ARGV[i]) "
+    "end";
+
+const std::string g_ridAndVidDelScript =
+    "for i = 1, #ARGV, 2 do "
+    "redis.call('HDEL', KEYS[1], ARGV[i]) "
+    "redis.call('HDEL', KEYS[2], ARGV[i + 1]) "
+    "end";
+
+void redis_run_rid_and_vid_script(
+        _In_ const std::string &sha,
+        _In_ const std::vector<std::pair<sai_object_id_t, sai_object_id_t>> &rid_and_vid)
+{
+    SWSS_LOG_ENTER();
 
-        SWSS_LOG_DEBUG("translated RID 0x%lx to VID 0x%lx", rid, vid);
+    std::vector<std::string> args = { "EVALSHA", sha, "2", RIDTOVID, VIDTORID };
 
-        return vid;
+    for (auto &p: rid_and_vid)
+    {
+        args.push_back(sai_serialize_object_id(p.first));
+        args.push_back(sai_serialize_object_id(p.second));
     }
 
-    SWSS_LOG_DEBUG("spotted new RID 0x%lx", rid);
+    std::vector<const char*> argv;
 
-    sai_object_type_t object_type = sai_object_type_query(rid);
-
-    if (object_type == SAI_OBJECT_TYPE_NULL)
+    for (auto &arg: args)
     {
-        SWSS_LOG_THROW("sai_object_type_query returned NULL type for RID 0x%lx", rid);
+        argv.push_back(arg.c_str());
     }
 
-    if (object_type == SAI_OBJECT_TYPE_SWITCH)
-    {
-        /*
-         * Switch ID should be already inside local db or redis db when we
-         * created switch, so we should never get here.
-         */
+    swss::RedisCommand command;
 
-        SWSS_LOG_THROW("RID 0x%lx is switch object, but not in local or redis db, bug!", rid);
-    }
-
-    vid = redis_create_virtual_object_id(switch_vid, object_type);
+    command.formatArgv((int)argv.size(), argv.data(), NULL);
 
-    SWSS_LOG_DEBUG("translated RID 0x%lx to VID 0x%lx", rid, vid);
+    swss::RedisReply r(g_dbAsic.get(), command, REDIS_REPLY_NIL);
+}
 
-    std::string str_vid = sai_serialize_object_id(vid);
+/*
+ * To support multiple switches vid/rid map must be per switch.
+ */
+void redis_save_rid_and_vid(
+        _In_ const std::vector<std::pair<sai_object_id_t, sai_object_id_t>> &rid_and_vid)
+{
+    SWSS_LOG_ENTER();
 
-    /*
-     * TODO: This must be ATOMIC.
-     *
-     * TODO: To support multiple swiches we need this map per switch;
-     */
+    if (rid_and_vid.empty())
+    {
+        return;
+    }
 
-    g_redisClient->hset(RIDTOVID, str_rid, str_vid);
-    g_redisClient->hset(VIDTORID, str_vid, str_rid);
+    static std::string sha = swss::loadRedisScript(g_dbAsic.get(), g_ridAndVidSetScript);
 
-    save_rid_and_vid_to_local(rid, vid);
+    redis_run_rid_and_vid_script(sha, rid_and_vid);
 
-    return vid;
+    for (auto &p: rid_and_vid)
+    {
+        save_rid_and_vid_to_local(p.first, p.second);
+    }
 }
 
-void translate_list_rid_to_vid(
-        _In_ sai_object_list_t &element,
-        _In_ sai_object_id_t switch_id)
+void redis_remove_rid_and_vid(
+        _In_ const std::vector<std::pair<sai_object_id_t, sai_object_id_t>> &rid_and_vid)
 {
     SWSS_LOG_ENTER();
 
-    for (uint32_t i = 0; i < element.count; i++)
+    if (rid_and_vid.empty())
+    {
+        return;
+    }
+
+    static std::string sha = swss::loadRedisScript(g_dbAsic.get(), g_ridAndVidDelScript);
+
+    redis_run_rid_and_vid_script(sha, rid_and_vid);
+
+    for (auto &p: rid_and_vid)
     {
-        element.list[i] = translate_rid_to_vid(element.list[i], switch_id);
+        remove_rid_and_vid_from_local(p.first, p.second);
     }
 }
 
 /*
- * This method is required to translate RID to VIDs when we are doing snoop for
- * new ID's in init view mode, on in apply view mode when we are executing GET
- * api, and new object RIDs were spotted the we will create new VIDs for those
- * objects and we will put them to redis db.
+ * Collects pointers to all object ids inside attribute list, so they can be
+ * translated all at once.
  */
-void translate_rid_to_vid_list(
+void collect_attr_list_oids(
         _In_ sai_object_type_t object_type,
-        _In_ sai_object_id_t switch_id,
         _In_ uint32_t attr_count,
-        _In_ sai_attribute_t *attr_list)
+        _In_ sai_attribute_t *attr_list,
+        _Out_ std::vector<sai_object_id_t*> &oids)
 {
     SWSS_LOG_ENTER();
 
-    /*
-     * We receive real id's here, if they are new then create new VIDs for them
-     * and put in db, if entry exists in db, use it.
-     *
-     * NOTE: switch_id is VID of switch on which those RIDs are probided.
-     */
-
     for (uint32_t i = 0; i < attr_count; i++)
     {
         sai_attribute_t &attr = attr_list[i];
@@ -471,34 +506,36 @@ void translate_rid_to_vid_list(
          * way via sai metadata utils to get that.
          */
 
+        sai_object_list_t *objlist = NULL;
+
         switch (meta->attrvaluetype)
         {
             case SAI_ATTR_VALUE_TYPE_OBJECT_ID:
-                attr.value.oid = translate_rid_to_vid(attr.value.oid, switch_id);
+                oids.push_back(&attr.value.oid);
                 break;
 
             case SAI_ATTR_VALUE_TYPE_OBJECT_LIST:
-                translate_list_rid_to_vid(attr.value.objlist, switch_id);
+                objlist = &attr.value.objlist;
                 break;
 
             case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_ID:
                 if (attr.value.aclfield.enable)
-                    attr.value.aclfield.data.oid = translate_rid_to_vid(attr.value.aclfield.data.oid, switch_id);
+                    oids.push_back(&attr.value.aclfield.data.oid);
                 break;
 
             case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
                 if (attr.value.aclfield.enable)
-                    translate_list_rid_to_vid(attr.value.aclfield.data.objlist, switch_id);
+                    objlist = &attr.value.aclfield.data.objlist;
                 break;
 
             case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_ID:
                 if (attr.value.aclaction.enable)
-                    attr.value.aclaction.parameter.oid = translate_rid_to_vid(attr.value.aclaction.parameter.oid, switch_id);
+                    oids.push_back(&attr.value.aclaction.parameter.oid);
                 break;
 
             case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
                 if (attr.value.aclaction.enable)
-                    translate_list_rid_to_vid(attr.value.aclaction.parameter.objlist, switch_id);
+                    objlist = &attr.value.aclaction.parameter.objlist;
                 break;
 
             default:
@@ -515,209 +552,371 @@ void translate_rid_to_vid_list(
 
                 break;
         }
+
+        if (objlist != NULL)
+        {
+            for (uint32_t j = 0; j < objlist->count; j++)
+            {
+                oids.push_back(&objlist->list[j]);
+            }
+        }
     }
 }
 
 /*
- * NOTE: We could have in metadata utils option to execute function on each
- * object on oid like this.  Problem is that we can't then add extra
- * parameters.
+ * This method will create VIDs for actual RIDs retrived from device when doing
+ * GET api and snooping while in init view mode.
+ *
+ * RIDs missing in local db are queried from redis with single HMGET, and all
+ * new VIDs are saved to redis at once.
+ *
+ * This function should not be used to create VID for SWITCH object type.
  */
-
-sai_object_id_t translate_vid_to_rid(
-        _In_ sai_object_id_t vid)
+void translate_rid_to_vid_oids(
+        _In_ sai_object_id_t switch_vid,
+        _In_ const std::vector<sai_object_id_t*> &oids)
 {
-
     SWSS_LOG_ENTER();
 
-    if (vid == SAI_NULL_OBJECT_ID)
-    {
-        SWSS_LOG_DEBUG("translated VID null to RID null");
-
-        return SAI_NULL_OBJECT_ID;
-    }
+    /*
+     * NOTE: switch_vid here is Virtual ID of switch for which we need
+     * create VID for given RID.
+     */
 
-    auto it = local_vid_to_rid.find(vid);
+    std::vector<sai_object_id_t*> missing;
+    std::vector<std::string> str_rids;
 
-    if (it != local_vid_to_rid.end())
+    for (auto poid: oids)
     {
-        return it->second;
-    }
-
-    std::string str_vid = sai_serialize_object_id(vid);
-
-    std::string str_rid;
+        if (*poid == SAI_NULL_OBJECT_ID)
+        {
+            continue;
+        }
 
-    auto prid = g_redisClient->hget(VIDTORID, str_vid);
+        auto it = local_rid_to_vid.find(*poid);
 
-    if (prid == NULL)
-    {
-        if (isInitViewMode())
+        if (it != local_rid_to_vid.end())
         {
-            /*
-             * If user created object that is object id, then it should not
-             * query attributes of this object in init view mode, because he
-             * knows all attributes passed to that object.
-             *
-             * NOTE: This may be a problem for some objects in init view mode.
-             * We will need to revisit this after checking with real SAI
-             * implementation.  Problem here may be that user will create some
-             * object and actually will need to to query some of it's values,
-             * like buffer limitations etc, mostly probably this will happen on
-             * SWITCH object.
-             */
-
-            SWSS_LOG_THROW("can't get RID in init view mode - don't query created objects");
+            *poid = it->second;
+            continue;
         }
 
-        SWSS_LOG_THROW("unable to get RID for VID: 0x%lx", vid);
+        missing.push_back(poid);
+        str_rids.push_back(sai_serialize_object_id(*poid));
     }
 
-    str_rid = *prid;
-
-    sai_object_id_t rid;
-
-    sai_deserialize_object_id(str_rid, rid);
-
-    /*
-     * We got this RID from redis db, so put it also to local db so it will be
-     * faster to retrive it late on.
-     */
-
-    local_vid_to_rid[vid] = rid;
-
-    SWSS_LOG_DEBUG("translated VID 0x%lx to RID 0x%lx", vid, rid);
-
-    return rid;
-}
-
-void translate_list_vid_to_rid(
-        _In_ sai_object_list_t &element)
-{
-    for (uint32_t i = 0; i < element.count; i++)
+    if (missing.empty())
     {
-        element.list[i] = translate_vid_to_rid(element.list[i]);
+        return;
     }
-}
 
-void translate_vid_to_rid_list(
-        _In_ sai_object_type_t object_type,
-        _In_ uint32_t attr_count,
-        _In_ sai_attribute_t *attr_list)
-{
-    SWSS_LOG_ENTER();
+    auto pvids = g_redisClient->hmget(RIDTOVID, str_rids);
 
-    /*
-     * All id's received from sairedis should be virtual, so lets translate
-     * them to real id's before we execute actual api.
-     */
+    std::vector<std::pair<sai_object_id_t, sai_object_id_t>> created;
 
-    for (uint32_t i = 0; i < attr_count; i++)
+    for (size_t i = 0; i < missing.size(); i++)
     {
-        sai_attribute_t &attr = attr_list[i];
+        sai_object_id_t rid = *missing[i];
 
-        auto meta = sai_metadata_get_attr_metadata(object_type, attr.id);
+        /*
+         * Same new RID can be present multiple times on the list.
+         */
 
-        if (meta == NULL)
+        auto it = local_rid_to_vid.find(rid);
+
+        if (it != local_rid_to_vid.end())
         {
-            SWSS_LOG_THROW("unable to get metadata for object type %x, attribute %d", object_type, attr.id);
+            *missing[i] = it->second;
+            continue;
         }
 
-        switch (meta->attrvaluetype)
+        sai_object_id_t vid;
+
+        if (pvids[i] != NULL)
         {
-            case SAI_ATTR_VALUE_TYPE_OBJECT_ID:
-                attr.value.oid = translate_vid_to_rid(attr.value.oid);
-                break;
+            /*
+             * Object exists.
+             */
 
-            case SAI_ATTR_VALUE_TYPE_OBJECT_LIST:
-                translate_list_vid_to_rid(attr.value.objlist);
-                break;
+            sai_deserialize_object_id(*pvids[i], vid);
 
-            case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_ID:
-                if (attr.value.aclfield.enable)
-                    attr.value.aclfield.data.oid = translate_vid_to_rid(attr.value.aclfield.data.oid);
-                break;
+            SWSS_LOG_DEBUG("translated RID 0x%lx to VID 0x%lx", rid, vid);
 
-            case SAI_ATTR_VALUE_TYPE_ACL_FIELD_DATA_OBJECT_LIST:
-                if (attr.value.aclfield.enable)
-                    translate_list_vid_to_rid(attr.value.aclfield.data.objlist);
-                break;
+            save_rid_and_vid_to_local(rid, vid);
 
-            case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_ID:
-                if (attr.value.aclaction.enable)
-                    attr.value.aclaction.parameter.oid = translate_vid_to_rid(attr.value.aclaction.parameter.oid);
-                break;
+            *missing[i] = vid;
+            continue;
+        }
 
-            case SAI_ATTR_VALUE_TYPE_ACL_ACTION_DATA_OBJECT_LIST:
-                if (attr.value.aclaction.enable)
-                    translate_list_vid_to_rid(attr.value.aclaction.parameter.objlist);
-                break;
+        SWSS_LOG_DEBUG("spotted new RID 0x%lx", rid);
 
-            default:
+        sai_object_type_t object_type = sai_object_type_query(rid);
 
-                /*
-                 * If in futre new attribute with object id will be added this
-                 * will make sure that we will need to add handler here.
-                 */
+        if (object_type == SAI_OBJECT_TYPE_NULL)
+        {
+            SWSS_LOG_THROW("sai_object_type_query returned NULL type for RID 0x%lx", rid);
+        }
 
-                if (meta->isoidattribute)
-                {
-                    SWSS_LOG_THROW("attribute %s is object id, but not processed, FIXME", meta->attridname);
-                }
+        if (object_type == SAI_OBJECT_TYPE_SWITCH)
+        {
+            /*
+             * Switch ID should be already inside local db or redis db when we
+             * created switch, so we should never get here.
+             */
 
-                break;
+            SWSS_LOG_THROW("RID 0x%lx is switch object, but not in local or redis db, bug!", rid);
         }
-    }
-}
 
-void snoop_get_attr(
-        _In_ sai_object_type_t object_type,
-        _In_ const std::string &str_object_id,
-        _In_ const std::string &attr_id,
-        _In_ const std::string &attr_value)
-{
-    SWSS_LOG_ENTER();
+        vid = redis_create_virtual_object_id(switch_vid, object_type);
 
-    /*
-     * Note: str_object_type + ":" + str_object_id is meta_key we can us that
-     * here later on.
-     */
+        SWSS_LOG_DEBUG("translated RID 0x%lx to VID 0x%lx", rid, vid);
 
-    std::string str_object_type = sai_serialize_object_type(object_type);
+        save_rid_and_vid_to_local(rid, vid);
 
-    std::string key = TEMP_PREFIX + (ASIC_STATE_TABLE + (":" + str_object_type + ":" + str_object_id));
+        created.push_back(std::make_pair(rid, vid));
 
-    SWSS_LOG_DEBUG("%s", key.c_str());
+        *missing[i] = vid;
+    }
 
+    /*
+     * TODO: To support multiple swiches we need this map per switch;
+     */
 
-    g_redisClient->hset(key, attr_id, attr_value);
+    redis_save_rid_and_vid(created);
 }
 
-void snoop_get_oid(
-        _In_ sai_object_id_t vid)
+sai_object_id_t translate_rid_to_vid(
+        _In_ sai_object_id_t rid,
+        _In_ sai_object_id_t switch_vid)
 {
     SWSS_LOG_ENTER();
 
-    if (vid == SAI_NULL_OBJECT_ID)
+    if (rid == SAI_NULL_OBJECT_ID)
     {
-        /*
-         * If snooped ois is NULL then we don't need take any action.
-         */
+        SWSS_LOG_DEBUG("translated RID null to VID null");
 
-        return;
+        return SAI_NULL_OBJECT_ID;
     }
 
-    /*
-     * We need use redis version of object type query here since we are
-     * operating on VID value, and syncd is compiled agains real SAI
-     * implementation which has diffrent function sai_object_type_query.
-     */
+    auto it = local_rid_to_vid.find(rid);
 
-    sai_object_type_t object_type = redis_sai_object_type_query(vid);
+    if (it != local_rid_to_vid.end())
+    {
+        return it->second;
+    }
 
-    std::string str_vid = sai_serialize_object_id(vid);
+    sai_object_id_t vid = rid;
 
-    snoop_get_attr(object_type, str_vid, "NULL", "NULL");
+    translate_rid_to_vid_oids(switch_vid, { &vid });
+
+    return vid;
+}
+
+/*
+ * This method is required to translate RID to VIDs when we are doing snoop for
+ * new ID's in init view mode, on in apply view mode when we are executing GET
+ * api, and new object RIDs were spotted the we will create new VIDs for those
+ * objects and we will put them to redis db.
+ */
+void translate_rid_to_vid_list(
+        _In_ sai_object_type_t object_type,
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _In_ sai_attribute_t *attr_list)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * We receive real id's here, if they are new then create new VIDs for them
+     * and put in db, if entry exists in db, use it.
+     *
+     * NOTE: switch_id is VID of switch on which those RIDs are probided.
+     */
+
+    std::vector<sai_object_id_t*> oids;
+
+    collect_attr_list_oids(object_type, attr_count, attr_list, oids);
+
+    translate_rid_to_vid_oids(switch_id, oids);
+}
+
+/*
+ * NOTE: We could have in metadata utils option to execute function on each
+ * object on oid like this.  Problem is that we can't then add extra
+ * parameters.
+ */
+
+void translate_vid_to_rid_oids(
+        _In_ const std::vector<sai_object_id_t*> &oids)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<sai_object_id_t*> missing;
+    std::vector<std::string> str_vids;
+
+    for (auto poid: oids)
+    {
+        if (*poid == SAI_NULL_OBJECT_ID)
+        {
+            continue;
+        }
+
+        auto it = local_vid_to_rid.find(*poid);
+
+        if (it != local_vid_to_rid.end())
+        {
+            *poid = it->second;
+            continue;
+        }
+
+        missing.push_back(poid);
+        str_vids.push_back(sai_serialize_object_id(*poid));
+    }
+
+    if (missing.empty())
+    {
+        return;
+    }
+
+    auto prids = g_redisClient->hmget(VIDTORID, str_vids);
+
+    for (size_t i = 0; i < missing.size(); i++)
+    {
+        sai_object_id_t vid = *missing[i];
+
+        if (prids[i] == NULL)
+        {
+            if (isInitViewMode())
+            {
+                /*
+                 * If user created object that is object id, then it should not
+                 * query attributes of this object in init view mode, because he
+                 * knows all attributes passed to that object.
+                 *
+                 * NOTE: This may be a problem for some objects in init view mode.
+                 * We will need to revisit this after checking with real SAI
+                 * implementation.  Problem here may be that user will create some
+                 * object and actually will need to to query some of it's values,
+                 * like buffer limitations etc, mostly probably this will happen on
+                 * SWITCH object.
+                 */
+
+                SWSS_LOG_THROW("can't get RID in init view mode - don't query created objects");
+            }
+
+            SWSS_LOG_THROW("unable to get RID for VID: 0x%lx", vid);
+        }
+
+        sai_object_id_t rid;
+
+        sai_deserialize_object_id(*prids[i], rid);
+
+        /*
+         * We got this RID from redis db, so put it also to local db so it will be
+         * faster to retrive it late on.
+         */
+
+        save_rid_and_vid_to_local(rid, vid);
+
+        SWSS_LOG_DEBUG("translated VID 0x%lx to RID 0x%lx", vid, rid);
+
+        *missing[i] = rid;
+    }
+}
+
+sai_object_id_t translate_vid_to_rid(
+        _In_ sai_object_id_t vid)
+{
+    SWSS_LOG_ENTER();
+
+    if (vid == SAI_NULL_OBJECT_ID)
+    {
+        SWSS_LOG_DEBUG("translated VID null to RID null");
+
+        return SAI_NULL_OBJECT_ID;
+    }
+
+    auto it = local_vid_to_rid.find(vid);
+
+    if (it != local_vid_to_rid.end())
+    {
+        return it->second;
+    }
+
+    sai_object_id_t rid = vid;
+
+    translate_vid_to_rid_oids({ &rid });
+
+    return rid;
+}
+
+void translate_vid_to_rid_list(
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t attr_count,
+        _In_ sai_attribute_t *attr_list)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * All id's received from sairedis should be virtual, so lets translate
+     * them to real id's before we execute actual api.
+     */
+
+    std::vector<sai_object_id_t*> oids;
+
+    collect_attr_list_oids(object_type, attr_count, attr_list, oids);
+
+    translate_vid_to_rid_oids(oids);
+}
+
+void snoop_get_attr(
+        _In_ sai_object_type_t object_type,
+        _In_ const std::string &str_object_id,
+        _In_ const std::string &attr_id,
+        _In_ const std::string &attr_value)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Note: str_object_type + ":" + str_object_id is meta_key we can us that
+     * here later on.
+     */
+
+    std::string str_object_type = sai_serialize_object_type(object_type);
+
+    std::string key = TEMP_PREFIX + (ASIC_STATE_TABLE + (":" + str_object_type + ":" + str_object_id));
+
+    SWSS_LOG_DEBUG("%s", key.c_str());
+
+
+    g_redisClient->hset(key, attr_id, attr_value);
+}
+
+void snoop_get_oid(
+        _In_ sai_object_id_t vid)
+{
+    SWSS_LOG_ENTER();
+
+    if (vid == SAI_NULL_OBJECT_ID)
+    {
+        /*
+         * If snooped ois is NULL then we don't need take any action.
+         */
+
+        return;
+    }
+
+    /*
+     * We need use redis version of object type query here since we are
+     * operating on VID value, and syncd is compiled agains real SAI
+     * implementation which has diffrent function sai_object_type_query.
+     */
+
+    sai_object_type_t object_type = redis_sai_object_type_query(vid);
+
+    std::string str_vid = sai_serialize_object_id(vid);
+
+    snoop_get_attr(object_type, str_vid, "NULL", "NULL");
 }
 
 void snoop_get_oid_list(
@@ -859,6 +1058,25 @@ void snoop_get_response(
     }
 }
 
+std::vector<swss::FieldValueTuple> serialize_get_response(
+        _In_ sai_object_type_t object_type,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list,
+        _In_ bool countOnly)
+{
+    SWSS_LOG_ENTER();
+
+    if (g_getResponseBinary)
+    {
+        return {
+            swss::FieldValueTuple(SAI_SERIALIZE_BINARY_ATTR_LIST,
+                    sai_serialize_binary_attr_list(object_type, attr_count, attr_list, countOnly))
+        };
+    }
+
+    return SaiAttributeList::serialize_attr_list(object_type, attr_count, attr_list, countOnly);
+}
+
 void internal_syncd_get_send(
         _In_ sai_object_type_t object_type,
         _In_ const std::string &str_object_id,
@@ -879,7 +1097,7 @@ void internal_syncd_get_send(
          * Normal serialization + translate RID to VID.
          */
 
-        entry = SaiAttributeList::serialize_attr_list(
+        entry = serialize_get_response(
                 object_type,
                 attr_count,
                 attr_list,
@@ -913,7 +1131,7 @@ void internal_syncd_get_send(
          * serialize only count, and will need to support that on the receiver.
          */
 
-        entry = SaiAttributeList::serialize_attr_list(
+        entry = serialize_get_response(
                 object_type,
                 attr_count,
                 attr_list,
@@ -941,7 +1159,7 @@ void internal_syncd_get_send(
      * response will not put any data to table, only queue is used.
      */
 
-    getResponse->set(str_status, entry, "getresponse");
+    getResponse->set(str_status, entry, g_getResponseOp);
 
     SWSS_LOG_INFO("response for GET api was send");
 }
@@ -1050,6 +1268,8 @@ void on_switch_create(
 
     switches[switch_vid] = std::make_shared<SaiSwitch>(switch_vid, switch_rid);
 
+    addPortCounters(*switches[switch_vid]);
+
     startDiagShell();
 }
 
@@ -1207,24 +1427,11 @@ sai_status_t handle_generic(
                      * need to save virtual id's to redis db.
                      */
 
-                    std::string str_vid = sai_serialize_object_id(object_id);
-                    std::string str_rid = sai_serialize_object_id(real_object_id);
-
-                    /*
-                     * TODO: This must be ATOMIC.
-                     *
-                     * To support multiple switches vid/rid map must be per switch.
-                     */
-
-                    {
-
-                        g_redisClient->hset(VIDTORID, str_vid, str_rid);
-                        g_redisClient->hset(RIDTOVID, str_rid, str_vid);
-
-                        save_rid_and_vid_to_local(real_object_id, object_id);
-                    }
+                    redis_save_rid_and_vid({ std::make_pair(real_object_id, object_id) });
 
-                    SWSS_LOG_INFO("saved VID %s to RID %s", str_vid.c_str(), str_rid.c_str());
+                    SWSS_LOG_INFO("saved VID %s to RID %s",
+                            sai_serialize_object_id(object_id).c_str(),
+                            sai_serialize_object_id(real_object_id).c_str());
 
                     if (object_type == SAI_OBJECT_TYPE_SWITCH)
                     {
@@ -1246,20 +1453,7 @@ sai_status_t handle_generic(
 
                 if (status == SAI_STATUS_SUCCESS)
                 {
-                    std::string str_vid = sai_serialize_object_id(object_id);
-                    std::string str_rid = sai_serialize_object_id(rid);
-
-                    /*
-                     * TODO: This must be ATOMIC.
-                     */
-
-                    {
-
-                        g_redisClient->hdel(VIDTORID, str_vid);
-                        g_redisClient->hdel(RIDTOVID, str_rid);
-
-                        remove_rid_and_vid_from_local(rid, object_id);
-                    }
+                    redis_remove_rid_and_vid({ std::make_pair(rid, object_id) });
 
                     if (object_type == SAI_OBJECT_TYPE_SWITCH)
                     {
@@ -1397,6 +1591,11 @@ void sendNotifyResponse(
 
     std::vector<swss::FieldValueTuple> entry;
 
+    if (g_notifyBinaryEncoding)
+    {
+        entry.emplace_back(SYNCD_BINARY_ENCODING, std::to_string(SAI_SERIALIZE_BINARY_VERSION));
+    }
+
     SWSS_LOG_NOTICE("sending response: %s", str_status.c_str());
 
     getResponse->set(str_status, entry, "notify");
@@ -1540,12 +1739,10 @@ sai_status_t notifySyncd(
         {
             /*
              * We succesfully applied new view, VID mapping could change, so we
-             * need to clear local db, and all new VIDs will be queried using
-             * redis.
+             * need to reload local db from redis.
              */
 
-            local_rid_to_vid.clear();
-            local_vid_to_rid.clear();
+            redis_load_rid_and_vid_to_local();
         }
         else
         {
@@ -1652,22 +1849,15 @@ void on_switch_create_in_init_view(
 
         SWSS_LOG_NOTICE("created real switch VID %s to RID %s in init view mode", str_vid.c_str(), str_rid.c_str());
 
-        /*
-         * TODO: This must be ATOMIC.
-         *
-         * To support multiple switches vid/rid map must be per switch.
-         */
-
-        g_redisClient->hset(VIDTORID, str_vid, str_rid);
-        g_redisClient->hset(RIDTOVID, str_rid, str_vid);
-
-        save_rid_and_vid_to_local(switch_rid, switch_vid);
+        redis_save_rid_and_vid({ std::make_pair(switch_rid, switch_vid) });
 
         /*
          * Make switch initialization and get all default data.
          */
 
         switches[switch_vid] = std::make_shared<SaiSwitch>(switch_vid, switch_rid);
+
+        addPortCounters(*switches[switch_vid]);
     }
     else if (switches.size() == 1)
     {
@@ -1937,187 +2127,588 @@ sai_object_id_t extractSwitchVid(
             sai_deserialize_fdb_entry(str_object_id, fdb_entry);
             return fdb_entry.switch_id;
 
-        case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
-            sai_deserialize_neighbor_entry(str_object_id, neighbor_entry);
-            return neighbor_entry.switch_id;
+        case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+            sai_deserialize_neighbor_entry(str_object_id, neighbor_entry);
+            return neighbor_entry.switch_id;
+
+        case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+            sai_deserialize_route_entry(str_object_id, route_entry);
+            return route_entry.switch_id;
+
+        default:
+
+            if (info->isnonobjectid)
+            {
+                SWSS_LOG_THROW("passing non object id %s as generic object", info->objecttypename);
+            }
+
+            sai_deserialize_object_id(str_object_id, oid);
+
+            return redis_sai_switch_id_query(oid);
+    }
+}
+
+void handle_bulk_route(
+        _In_ const std::vector<std::string> &object_ids,
+        _In_ sai_common_api_t api,
+        _In_ const std::vector<std::shared_ptr<SaiAttributeList>> &attributes,
+        _Out_ std::vector<sai_status_t> &statuses)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Since we don't have asic support yet for bulk route api, just execute
+     * one by one, every route is executed even if previous one failed.
+     */
+
+    sai_object_meta_key_t meta_key;
+
+    meta_key.objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY;
+
+    for (size_t idx = 0; idx < object_ids.size(); ++idx)
+    {
+        auto &list = attributes[idx];
+
+        sai_attribute_t *attr_list = list->get_attr_list();
+        uint32_t attr_count = list->get_attr_count();
+
+        sai_deserialize_route_entry(object_ids[idx], meta_key.objectkey.key.route_entry);
+
+        statuses[idx] = handle_non_object_id(meta_key, api, attr_count, attr_list);
+    }
+}
+
+void handle_bulk_next_hop_group_member(
+        _In_ const std::vector<std::string> &object_ids,
+        _In_ sai_common_api_t api,
+        _In_ const std::vector<std::shared_ptr<SaiAttributeList>> &attributes,
+        _Out_ std::vector<sai_status_t> &statuses)
+{
+    SWSS_LOG_ENTER();
+
+    uint32_t object_count = (uint32_t)object_ids.size();
+
+    std::vector<sai_object_id_t> vids(object_count);
+
+    for (uint32_t idx = 0; idx < object_count; ++idx)
+    {
+        sai_deserialize_object_id(object_ids[idx], vids[idx]);
+    }
+
+    std::vector<sai_object_id_t> rids(object_count, SAI_NULL_OBJECT_ID);
+
+    sai_status_t status = SAI_STATUS_NOT_IMPLEMENTED;
+
+    /*
+     * Use vendor bulk api when it's provided, otherwise execute one by one.
+     */
+
+    if (api == SAI_COMMON_API_CREATE &&
+            sai_metadata_sai_next_hop_group_api->create_next_hop_group_members != NULL)
+    {
+        sai_object_id_t switch_rid = translate_vid_to_rid(redis_sai_switch_id_query(vids[0]));
+
+        std::vector<uint32_t> attr_counts;
+        std::vector<const sai_attribute_t*> attr_lists;
+
+        for (const auto &list: attributes)
+        {
+            attr_counts.push_back(list->get_attr_count());
+            attr_lists.push_back(list->get_attr_list());
+        }
+
+        status = sai_metadata_sai_next_hop_group_api->create_next_hop_group_members(
+                switch_rid,
+                object_count,
+                attr_counts.data(),
+                attr_lists.data(),
+                SAI_BULK_OP_TYPE_INGORE_ERROR,
+                rids.data(),
+                statuses.data());
+
+        if (status != SAI_STATUS_NOT_IMPLEMENTED)
+        {
+            std::vector<std::pair<sai_object_id_t, sai_object_id_t>> created;
+
+            for (uint32_t idx = 0; idx < object_count; ++idx)
+            {
+                if (statuses[idx] != SAI_STATUS_SUCCESS)
+                {
+                    continue;
+                }
+
+                created.push_back(std::make_pair(rids[idx], vids[idx]));
+            }
+
+            redis_save_rid_and_vid(created);
+
+            return;
+        }
+    }
+    else if (api == SAI_COMMON_API_REMOVE &&
+            sai_metadata_sai_next_hop_group_api->remove_next_hop_group_members != NULL)
+    {
+        for (uint32_t idx = 0; idx < object_count; ++idx)
+        {
+            rids[idx] = translate_vid_to_rid(vids[idx]);
+        }
+
+        status = sai_metadata_sai_next_hop_group_api->remove_next_hop_group_members(
+                object_count,
+                rids.data(),
+                SAI_BULK_OP_TYPE_INGORE_ERROR,
+                statuses.data());
+
+        if (status != SAI_STATUS_NOT_IMPLEMENTED)
+        {
+            std::vector<std::pair<sai_object_id_t, sai_object_id_t>> removed;
+
+            for (uint32_t idx = 0; idx < object_count; ++idx)
+            {
+                if (statuses[idx] != SAI_STATUS_SUCCESS)
+                {
+                    continue;
+                }
+
+                removed.push_back(std::make_pair(rids[idx], vids[idx]));
+            }
+
+            redis_remove_rid_and_vid(removed);
+
+            return;
+        }
+    }
+
+    for (uint32_t idx = 0; idx < object_count; ++idx)
+    {
+        auto &list = attributes[idx];
+
+        statuses[idx] = handle_generic(
+                SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER,
+                object_ids[idx],
+                api,
+                list->get_attr_count(),
+                list->get_attr_list());
+    }
+}
+
+void handle_bulk_generic(
+        _In_ sai_object_type_t object_type,
+        _In_ const std::vector<std::string> &object_ids,
+        _In_ sai_common_api_t api,
+        _In_ const std::vector<std::shared_ptr<SaiAttributeList>> &attributes,
+        _Out_ std::vector<sai_status_t> &statuses)
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * SAI has no bulk api for those objects, execute one by one, every
+     * object is executed even if previous one failed.
+     */
+
+    for (size_t idx = 0; idx < object_ids.size(); ++idx)
+    {
+        auto &list = attributes[idx];
+
+        statuses[idx] = handle_generic(
+                object_type,
+                object_ids[idx],
+                api,
+                list->get_attr_count(),
+                list->get_attr_list());
+    }
+}
+
+void sendBulkResponse(
+        _In_ sai_status_t status,
+        _In_ const std::vector<std::string> &object_ids,
+        _In_ const std::vector<sai_status_t> &statuses)
+{
+    SWSS_LOG_ENTER();
+
+    if (g_bulkResponseOp.empty())
+    {
+        // nobody waits for it
+        return;
+    }
+
+    std::vector<swss::FieldValueTuple> entry;
+
+    for (size_t idx = 0; idx < object_ids.size(); ++idx)
+    {
+        entry.emplace_back(object_ids[idx], sai_serialize_status(statuses[idx]));
+    }
+
+    std::string str_status = sai_serialize_status(status);
+
+    SWSS_LOG_INFO("sending response for bulk api with status: %s", str_status.c_str());
+
+    /*
+     * Statuses are in the same order as objects in the request.
+     */
+
+    getResponse->set(str_status, entry, g_bulkResponseOp);
+}
+
+sai_status_t processBulkEvent(
+        _In_ sai_common_api_t api,
+        _In_ const swss::KeyOpFieldsValuesTuple &kco)
+{
+    SWSS_LOG_ENTER();
+
+    const std::string &key = kfvKey(kco);
+
+    std::string str_object_type = key.substr(0, key.find(":"));
+
+    sai_object_type_t object_type;
+    sai_deserialize_object_type(str_object_type, object_type);
+
+    const std::vector<swss::FieldValueTuple> &values = kfvFieldsValues(kco);
+
+    // key = str_object_id
+    // val = attrid=attrval|...
+
+    std::vector<std::string> object_ids;
+
+    std::vector<std::shared_ptr<SaiAttributeList>> attributes;
+
+    for (const auto &fvt: values)
+    {
+        std::string str_object_id = fvField(fvt);
+        std::string joined = fvValue(fvt);
+
+        // decode values, remove has no attributes
+
+        auto v = swss::tokenize(joined, '|');
+
+        object_ids.push_back(str_object_id);
+
+        std::vector<swss::FieldValueTuple> entries; // attributes per object id
+
+        for (size_t i = 0; i < v.size(); ++i)
+        {
+            const std::string item = v.at(i);
+
+            auto start = item.find_first_of("=");
+
+            auto field = item.substr(0, start);
+            auto value = item.substr(start + 1);
+
+            swss::FieldValueTuple entry(field, value);
+
+            entries.push_back(entry);
+        }
+
+        // since now we converted this to proper list, we can extract attributes
+
+        std::shared_ptr<SaiAttributeList> list =
+            std::make_shared<SaiAttributeList>(object_type, entries, false);
+
+        attributes.push_back(list);
+    }
+
+    SWSS_LOG_NOTICE("bulk %s execute with %zu items",
+            str_object_type.c_str(),
+            object_ids.size());
+
+    /*
+     * Objects are executed with the single object api.
+     */
+
+    sai_common_api_t single_api;
+
+    switch (api)
+    {
+        case (sai_common_api_t)SAI_COMMON_API_BULK_CREATE:
+            single_api = SAI_COMMON_API_CREATE;
+            break;
+
+        case (sai_common_api_t)SAI_COMMON_API_BULK_REMOVE:
+            single_api = SAI_COMMON_API_REMOVE;
+            break;
+
+        case (sai_common_api_t)SAI_COMMON_API_BULK_SET:
+            single_api = SAI_COMMON_API_SET;
+            break;
+
+        default:
+            SWSS_LOG_ERROR("bulk api %d is not supported", api);
+            exit_and_notify(EXIT_FAILURE);
+    }
+
+    std::vector<sai_status_t> statuses(object_ids.size(), SAI_STATUS_NOT_EXECUTED);
+
+    if (isInitViewMode())
+    {
+        for (size_t idx = 0; idx < object_ids.size(); ++idx)
+        {
+            auto &list = attributes[idx];
+
+            statuses[idx] = processEventInInitViewMode(
+                    object_type,
+                    object_ids[idx],
+                    single_api,
+                    list->get_attr_count(),
+                    list->get_attr_list());
+        }
+
+        sendBulkResponse(SAI_STATUS_SUCCESS, object_ids, statuses);
+
+        return SAI_STATUS_SUCCESS;
+    }
+
+    // translate attributes for all objects
+
+    for (auto &list: attributes)
+    {
+        sai_attribute_t *attr_list = list->get_attr_list();
+        uint32_t attr_count = list->get_attr_count();
+
+        translate_vid_to_rid_list(object_type, attr_count, attr_list);
+    }
+
+    switch (object_type)
+    {
+        case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+            handle_bulk_route(object_ids, single_api, attributes, statuses);
+            break;
+
+        case SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER:
+            handle_bulk_next_hop_group_member(object_ids, single_api, attributes, statuses);
+            break;
+
+        case SAI_OBJECT_TYPE_ACL_ENTRY:
+        case SAI_OBJECT_TYPE_ACL_COUNTER:
+            handle_bulk_generic(object_type, object_ids, single_api, attributes, statuses);
+            break;
+
+        default:
+            SWSS_LOG_ERROR("bulk api for %s is not supported yet, FIXME",
+                    sai_serialize_object_type(object_type).c_str());
+            exit_and_notify(EXIT_FAILURE);
+    }
+
+    sai_status_t status = SAI_STATUS_SUCCESS;
+
+    for (size_t idx = 0; idx < object_ids.size(); ++idx)
+    {
+        if (statuses[idx] == SAI_STATUS_SUCCESS)
+        {
+            continue;
+        }
+
+        SWSS_LOG_ERROR("bulk %s failed on %s: %s",
+                sai_serialize_common_api(single_api).c_str(),
+                object_ids[idx].c_str(),
+                sai_serialize_status(statuses[idx]).c_str());
+
+        status = SAI_STATUS_FAILURE;
+
+        if (single_api == SAI_COMMON_API_CREATE)
+        {
+            /*
+             * Object was already put to ASIC view by the consumer, but it
+             * doesn't exist, sairedis reverts it in metadata as well.
+             */
+
+            g_redisClient->del(ASIC_STATE_TABLE + (":" + str_object_type + ":" + object_ids[idx]));
+        }
+
+        /*
+         * Failed set and remove are retried by the caller, ASIC view gets in
+         * sync when the retry succeeds.
+         */
+    }
+
+    sendBulkResponse(status, object_ids, statuses);
+
+    return status;
+}
+
+/*
+ * Gets come on their own queue, tagged "get:<request_id>:<sequence>" where
+ * sequence is the number of ASIC_STATE operations sairedis has written since
+ * the last notify that the get must see. A get whose operations were not
+ * yet processed is deferred until they are.
+ */
 
-        case SAI_OBJECT_TYPE_ROUTE_ENTRY:
-            sai_deserialize_route_entry(str_object_id, route_entry);
-            return route_entry.switch_id;
+struct DeferredGet
+{
+    std::string request_id;
+    uint64_t sequence;
+    std::chrono::steady_clock::time_point deadline;
+    swss::KeyOpFieldsValuesTuple kco;
+};
 
-        default:
+uint64_t g_asicStateSequence = 0;
 
-            if (info->isnonobjectid)
-            {
-                SWSS_LOG_THROW("passing non object id %s as generic object", info->objecttypename);
-            }
+std::list<DeferredGet> g_deferredGets;
 
-            sai_deserialize_object_id(str_object_id, oid);
+/*
+ * How long deferred gets wait for ASIC_STATE before they fail, same as
+ * sairedis waits for the get response.
+ */
 
-            return redis_sai_switch_id_query(oid);
-    }
-}
+#define DEFERRED_GET_TIMEOUT_MS (6*60*1000)
 
-sai_status_t handle_bulk_route(
-        _In_ const std::vector<std::string> &object_ids,
-        _In_ sai_common_api_t api,
-        _In_ const std::vector<std::shared_ptr<SaiAttributeList>> &attributes)
+sai_status_t processSingleEvent(
+        _In_ swss::KeyOpFieldsValuesTuple &kco);
+
+void decodeBinaryGet(
+        _Inout_ swss::KeyOpFieldsValuesTuple &kco)
 {
     SWSS_LOG_ENTER();
 
     /*
-     * Since we don't have asic support yet for bulk api, just execute one by
-     * one.
+     * Only the key is converted to text, the attribute list stays binary and
+     * is decoded straight into attributes by processSingleEvent.
      */
 
-    for (size_t idx = 0; idx < object_ids.size(); ++idx)
-    {
-        sai_status_t status = SAI_STATUS_FAILURE;
+    sai_object_meta_key_t meta_key;
 
-        auto &list = attributes[idx];
+    sai_deserialize_binary_object_meta_key(kfvKey(kco), meta_key);
 
-        sai_attribute_t *attr_list = list->get_attr_list();
-        uint32_t attr_count = list->get_attr_count();
+    const auto &values = kfvFieldsValues(kco);
 
-        if (api == (sai_common_api_t)SAI_COMMON_API_BULK_SET)
-        {
-            sai_object_meta_key_t meta_key;
+    if (values.size() != 1 || fvField(values[0]) != SAI_SERIALIZE_BINARY_ATTR_LIST)
+    {
+        SWSS_LOG_THROW("binary get of %s has no binary attribute list",
+                sai_serialize_object_meta_key(meta_key).c_str());
+    }
 
-            meta_key.objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY;
+    kfvKey(kco) = sai_serialize_object_meta_key(meta_key);
+}
 
-            sai_deserialize_route_entry(object_ids[idx], meta_key.objectkey.key.route_entry);
+void processGet(
+        _In_ DeferredGet &get)
+{
+    SWSS_LOG_ENTER();
 
-            status = handle_non_object_id(meta_key, SAI_COMMON_API_SET, attr_count, attr_list);
-        }
-        else if (api == (sai_common_api_t)SAI_COMMON_API_BULK_CREATE)
-        {
-            sai_object_meta_key_t meta_key;
+    kfvOp(get.kco) = "get";
 
-            meta_key.objecttype = SAI_OBJECT_TYPE_ROUTE_ENTRY;
+    g_getResponseBinary = sai_is_binary_serialized(kfvKey(get.kco));
 
-            sai_deserialize_route_entry(object_ids[idx], meta_key.objectkey.key.route_entry);
+    if (g_getResponseBinary)
+    {
+        decodeBinaryGet(get.kco);
+    }
 
-            status = handle_non_object_id(meta_key, SAI_COMMON_API_CREATE, attr_count, attr_list);
-        }
-        else
-        {
-            SWSS_LOG_ERROR("api %d is not supported in bulk route", api);
-            exit_and_notify(EXIT_FAILURE);
-        }
+    g_getResponseOp = "getresponse:" + get.request_id;
 
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            return status;
-        }
-    }
+    processSingleEvent(get.kco);
 
-    return SAI_STATUS_SUCCESS;
+    g_getResponseOp = "getresponse";
+    g_getResponseBinary = false;
 }
 
-
-sai_status_t processBulkEvent(
-        _In_ sai_common_api_t api,
-        _In_ const swss::KeyOpFieldsValuesTuple &kco)
+void processDeferredGets(
+        _In_ bool all)
 {
     SWSS_LOG_ENTER();
 
-    const std::string &key = kfvKey(kco);
-
-    std::string str_object_type = key.substr(0, key.find(":"));
+    for (auto it = g_deferredGets.begin(); it != g_deferredGets.end(); )
+    {
+        if (!all && it->sequence > g_asicStateSequence)
+        {
+            ++it;
+            continue;
+        }
 
-    sai_object_type_t object_type;
-    sai_deserialize_object_type(str_object_type, object_type);
+        processGet(*it);
 
-    const std::vector<swss::FieldValueTuple> &values = kfvFieldsValues(kco);
+        it = g_deferredGets.erase(it);
+    }
+}
 
-    // key = str_object_id
-    // val = attrid=attrval|...
+/*
+ * Milliseconds until the oldest deferred get expires, gets are deferred in
+ * arrival order so it is the first one.
+ */
 
-    std::vector<std::string> object_ids;
+unsigned int getDeferredGetsTimeout()
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
 
-    std::vector<std::shared_ptr<SaiAttributeList>> attributes;
+    SWSS_LOG_ENTER();
 
-    for (const auto &fvt: values)
+    if (g_deferredGets.empty())
     {
-        std::string str_object_id = fvField(fvt);
-        std::string joined = fvValue(fvt);
-
-        // decode values
+        return std::numeric_limits<unsigned int>::max();
+    }
 
-        auto v = swss::tokenize(joined, '|');
+    auto left = g_deferredGets.front().deadline - std::chrono::steady_clock::now();
 
-        object_ids.push_back(str_object_id);
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(left).count();
 
-        std::vector<swss::FieldValueTuple> entries; // attributes per object id
+    return ms > 0 ? (unsigned int)ms : 0;
+}
 
-        for (size_t i = 0; i < v.size(); ++i)
-        {
-            const std::string item = v.at(i);
+void processExpiredDeferredGets()
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
 
-            auto start = item.find_first_of("=");
+    SWSS_LOG_ENTER();
 
-            auto field = item.substr(0, start);
-            auto value = item.substr(start + 1);
+    /*
+     * Operations the get waits for never came, it fails rather than being
+     * served on a state it must not see.
+     */
 
-            swss::FieldValueTuple entry(field, value);
+    auto now = std::chrono::steady_clock::now();
 
-            entries.push_back(entry);
-        }
+    while (!g_deferredGets.empty() && g_deferredGets.front().deadline <= now)
+    {
+        const DeferredGet &get = g_deferredGets.front();
 
-        // since now we converted this to proper list, we can extract attributes
+        SWSS_LOG_ERROR("get %s timed out waiting for sequence %lu, processed %lu",
+                kfvKey(get.kco).c_str(),
+                get.sequence,
+                g_asicStateSequence);
 
-        std::shared_ptr<SaiAttributeList> list =
-            std::make_shared<SaiAttributeList>(object_type, entries, false);
+        getResponse->set(sai_serialize_status(SAI_STATUS_FAILURE), {}, "getresponse:" + get.request_id);
 
-        attributes.push_back(list);
+        g_deferredGets.pop_front();
     }
+}
 
-    SWSS_LOG_NOTICE("bulk %s execute with %zu items",
-            str_object_type.c_str(),
-            object_ids.size());
+void processGetRequest(
+        _In_ swss::ConsumerTable &consumer)
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
 
-    if (isInitViewMode())
-    {
-        SWSS_LOG_ERROR("bulk api is not supported in init view mode", api);
-        exit_and_notify(EXIT_FAILURE);
-    }
+    SWSS_LOG_ENTER();
 
-    if (api != SAI_COMMON_API_BULK_GET)
-    {
-        // translate attributes for all objects
+    DeferredGet get;
 
-        for (auto &list: attributes)
-        {
-            sai_attribute_t *attr_list = list->get_attr_list();
-            uint32_t attr_count = list->get_attr_count();
+    consumer.pop(get.kco);
 
-            translate_vid_to_rid_list(object_type, attr_count, attr_list);
-        }
-    }
+    const std::string &op = kfvOp(get.kco);
 
-    sai_status_t status;
+    auto tokens = swss::tokenize(op, ':');
 
-    switch (object_type)
+    if (tokens.size() != 3 || tokens[0] != "get")
     {
-        case SAI_OBJECT_TYPE_ROUTE_ENTRY:
-            status = handle_bulk_route(object_ids, api, attributes);
-            break;
-
-        default:
-            SWSS_LOG_ERROR("bulk api for %s is not supported yet, FIXME",
-                    sai_serialize_object_type(object_type).c_str());
-            exit_and_notify(EXIT_FAILURE);
+        SWSS_LOG_ERROR("invalid get request op: %s, key: %s", op.c_str(), kfvKey(get.kco).c_str());
+        return;
     }
 
-    if (status != SAI_STATUS_SUCCESS)
+    get.request_id = tokens[1];
+    get.sequence = std::stoull(tokens[2]);
+
+    if (get.sequence > g_asicStateSequence)
     {
-        SWSS_LOG_ERROR("failed to execute bulk api: %s",
-                sai_serialize_status(status).c_str());
+        SWSS_LOG_INFO("deferring get %s until sequence %lu, processed %lu",
+                kfvKey(get.kco).c_str(),
+                get.sequence,
+                g_asicStateSequence);
 
-        exit_and_notify(EXIT_FAILURE);
+        get.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(DEFERRED_GET_TIMEOUT_MS);
+
+        g_deferredGets.push_back(std::move(get));
+        return;
     }
 
-    return status;
+    processGet(get);
 }
 
 sai_status_t processEvent(
@@ -2144,8 +2735,58 @@ sai_status_t processEvent(
         consumer.pop(kco);
     }
 
+    bool notify = (kfvOp(kco) == "notify");
+
+    if (notify)
+    {
+        /*
+         * Gets sent before the notify were sent after all the operations
+         * they follow, serve them on the current view.
+         */
+
+        processDeferredGets(true);
+    }
+
+    g_asicStateSequence++;
+
+    sai_status_t status = processSingleEvent(kco);
+
+    if (notify)
+    {
+        /*
+         * Sairedis starts counting again when it gets the notify response.
+         */
+
+        g_asicStateSequence = 0;
+    }
+    else
+    {
+        processDeferredGets(false);
+    }
+
+    return status;
+}
+
+sai_status_t processSingleEvent(
+        _In_ swss::KeyOpFieldsValuesTuple &kco)
+{
+    SWSS_LOG_ENTER();
+
     const std::string &key = kfvKey(kco);
-    const std::string &op = kfvOp(kco);
+    std::string op = kfvOp(kco);
+
+    /*
+     * Bulk operations sairedis waits for are tagged "<op>:<request_id>".
+     */
+
+    g_bulkResponseOp.clear();
+
+    if (op.compare(0, 4, "bulk") == 0 && op.find(':') != std::string::npos)
+    {
+        g_bulkResponseOp = "bulkresponse" + op.substr(op.find(':'));
+
+        op = op.substr(0, op.find(':'));
+    }
 
     /*
      * TODO: Key is serialized meta_key, we could use deserialize
@@ -2183,8 +2824,22 @@ sai_status_t processEvent(
     {
         return processBulkEvent((sai_common_api_t)SAI_COMMON_API_BULK_CREATE, kco);
     }
+    else if (op == "bulkremove")
+    {
+        return processBulkEvent((sai_common_api_t)SAI_COMMON_API_BULK_REMOVE, kco);
+    }
     else if (op == "notify")
     {
+        g_notifyBinaryEncoding = false;
+
+        for (const auto &fv: kfvFieldsValues(kco))
+        {
+            if (fvField(fv) == SYNCD_BINARY_ENCODING && fvValue(fv) == std::to_string(SAI_SERIALIZE_BINARY_VERSION))
+            {
+                g_notifyBinaryEncoding = true;
+            }
+        }
+
         return notifySyncd(key);
     }
     else
@@ -2211,15 +2866,19 @@ sai_status_t processEvent(
         SWSS_LOG_DEBUG("attr: %s: %s", fvField(v).c_str(), fvValue(v).c_str());
     }
 
-    SaiAttributeList list(object_type, values, false);
+    bool binary = values.size() == 1 && fvField(values[0]) == SAI_SERIALIZE_BINARY_ATTR_LIST;
+
+    std::shared_ptr<SaiAttributeList> list = binary
+        ? std::make_shared<SaiAttributeList>(object_type, fvValue(values[0]), false)
+        : std::make_shared<SaiAttributeList>(object_type, values, false);
 
     /*
      * Attribute list can't be const since we will use it to translate VID to
      * RID inplace.
      */
 
-    sai_attribute_t *attr_list = list.get_attr_list();
-    uint32_t attr_count = list.get_attr_count();
+    sai_attribute_t *attr_list = list->get_attr_list();
+    uint32_t attr_count = list->get_attr_count();
 
     /*
      * NOTE: This check pointers must be executed before init view mode, since
@@ -2345,7 +3004,7 @@ sai_status_t processEvent(
     return status;
 }
 
-void processPfcWdEvent(
+void processFlexCounterEvent(
         _In_ swss::ConsumerStateTable &consumer)
 {
     std::lock_guard<std::mutex> lock(g_mutex);
@@ -2358,8 +3017,40 @@ void processPfcWdEvent(
     const auto &key = kfvKey(kco);
     const auto &op = kfvOp(kco);
 
+    /*
+     * Key is <group>:<object vid>.
+     */
+
+    std::size_t delimiter = key.find_first_of(":");
+
+    if (delimiter == std::string::npos)
+    {
+        SWSS_LOG_ERROR("Failed to parse the key %s", key.c_str());
+        return;
+    }
+
+    const auto groupName = key.substr(0, delimiter);
+    const auto strVid = key.substr(delimiter + 1);
+
     sai_object_id_t vid = SAI_NULL_OBJECT_ID;
-    sai_deserialize_object_id(key, vid);
+    sai_deserialize_object_id(strVid, vid);
+
+    if (op == DEL_COMMAND)
+    {
+        /*
+         * Object could be already removed, so its RID is not needed.
+         */
+
+        FlexCounter::removeCounter(vid, groupName);
+        return;
+    }
+
+    if (op != SET_COMMAND)
+    {
+        SWSS_LOG_ERROR("Unknown operation %s on flex counter %s", op.c_str(), key.c_str());
+        return;
+    }
+
     sai_object_id_t rid = translate_vid_to_rid(vid);
     sai_object_type_t objectType = sai_object_type_query(rid);
 
@@ -2369,56 +3060,70 @@ void processPfcWdEvent(
         const auto field = fvField(valuePair);
         const auto value = fvValue(valuePair);
 
-        if (op == DEL_COMMAND)
+        auto idStrings = swss::tokenize(value, ',');
+
+        if (objectType == SAI_OBJECT_TYPE_PORT && field == PORT_COUNTER_ID_LIST)
         {
-            if (objectType == SAI_OBJECT_TYPE_PORT)
+            std::vector<sai_port_stat_t> portCounterIds;
+            for (const auto &str : idStrings)
             {
-                PfcWatchdog::removePort(vid);
+                sai_port_stat_t stat;
+                sai_deserialize_port_stat(str, stat);
+                portCounterIds.push_back(stat);
             }
-            else if (objectType == SAI_OBJECT_TYPE_QUEUE)
-            {
-                PfcWatchdog::removeQueue(vid);
-            }
-            else
+            FlexCounter::setPortCounterList(vid, rid, groupName, portCounterIds);
+        }
+        else if (objectType == SAI_OBJECT_TYPE_QUEUE && field == QUEUE_COUNTER_ID_LIST)
+        {
+            std::vector<sai_queue_stat_t> queueCounterIds;
+            for (const auto &str : idStrings)
             {
-                SWSS_LOG_ERROR("Object type for removal not supported");
+                sai_queue_stat_t stat;
+                sai_deserialize_queue_stat(str, stat);
+                queueCounterIds.push_back(stat);
             }
+            FlexCounter::setQueueCounterList(vid, rid, groupName, queueCounterIds);
         }
-        else if (op == SET_COMMAND)
+        else if (objectType == SAI_OBJECT_TYPE_INGRESS_PRIORITY_GROUP && field == PG_COUNTER_ID_LIST)
         {
-            auto idStrings  = swss::tokenize(value, ',');
-
-            if (objectType == SAI_OBJECT_TYPE_PORT && field == PFC_WD_PORT_COUNTER_ID_LIST)
+            std::vector<sai_ingress_priority_group_stat_t> pgCounterIds;
+            for (const auto &str : idStrings)
             {
-                std::vector<sai_port_stat_t> portCounterIds;
-                for (const auto &str : idStrings)
-                {
-                    sai_port_stat_t stat;
-                    sai_deserialize_port_stat(str, stat);
-                    portCounterIds.push_back(stat);
-                }
-                PfcWatchdog::setPortCounterList(vid, rid, portCounterIds);
+                sai_ingress_priority_group_stat_t stat;
+                sai_deserialize_ingress_priority_group_stat(str, stat);
+                pgCounterIds.push_back(stat);
             }
-            else if (objectType == SAI_OBJECT_TYPE_QUEUE && field == PFC_WD_QUEUE_COUNTER_ID_LIST)
+            FlexCounter::setPriorityGroupCounterList(vid, rid, groupName, pgCounterIds);
+        }
+        else if (objectType == SAI_OBJECT_TYPE_ACL_COUNTER && field == ACL_COUNTER_ATTR_ID_LIST)
+        {
+            std::vector<sai_attr_id_t> aclCounterIds;
+            for (const auto &str : idStrings)
             {
-                std::vector<sai_queue_stat_t> queueCounterIds;
-                for (const auto &str : idStrings)
+                const sai_attr_metadata_t *meta = NULL;
+                sai_deserialize_attr_id(str, &meta);
+
+                if (meta->objecttype != SAI_OBJECT_TYPE_ACL_COUNTER ||
+                        meta->attrvaluetype != SAI_ATTR_VALUE_TYPE_UINT64)
                 {
-                    sai_queue_stat_t stat;
-                    sai_deserialize_queue_stat(str, stat);
-                    queueCounterIds.push_back(stat);
+                    SWSS_LOG_ERROR("Attribute %s is not acl counter value", str.c_str());
+                    continue;
                 }
-                PfcWatchdog::setQueueCounterList(vid, rid, queueCounterIds);
-            }
-            else
-            {
-                SWSS_LOG_ERROR("Object type not supported");
+
+                aclCounterIds.push_back(meta->attrid);
             }
+            FlexCounter::setAclCounterAttrList(vid, rid, groupName, aclCounterIds);
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Object type %s and field %s not supported",
+                    sai_serialize_object_type(objectType).c_str(),
+                    field.c_str());
         }
     }
 }
 
-void processPfcWdPluginEvent(
+void processFlexCounterGroupEvent(
         _In_ swss::ConsumerStateTable &consumer)
 {
     std::lock_guard<std::mutex> lock(g_mutex);
@@ -2428,12 +3133,12 @@ void processPfcWdPluginEvent(
     swss::KeyOpFieldsValuesTuple kco;
     consumer.pop(kco);
 
-    const auto &key = kfvKey(kco);
+    const auto &groupName = kfvKey(kco);
     const auto &op = kfvOp(kco);
 
     if (op == DEL_COMMAND)
     {
-        PfcWatchdog::removeCounterPlugin(key);
+        FlexCounter::removeCounterPlugins(groupName);
         return;
     }
 
@@ -2443,22 +3148,52 @@ void processPfcWdPluginEvent(
         const auto field = fvField(valuePair);
         const auto value = fvValue(valuePair);
 
-        if (field != SAI_OBJECT_TYPE)
+        if (field == POLL_INTERVAL_FIELD)
         {
-            continue;
-        }
+            /*
+             * Value comes from another process, a bad one is logged and
+             * ignored rather than ending syncd.
+             */
+
+            size_t pos = 0;
+            unsigned long pollInterval = 0;
+
+            try
+            {
+                pollInterval = std::stoul(value, &pos);
+            }
+            catch (const std::exception &)
+            {
+                pos = 0;
+            }
+
+            if (pos == 0 || pos != value.size() || value[0] == '-' || pollInterval > UINT32_MAX)
+            {
+                SWSS_LOG_ERROR("Invalid poll interval '%s' of flex counter group %s", value.c_str(), groupName.c_str());
+                continue;
+            }
 
-        if (value == sai_serialize_object_type(SAI_OBJECT_TYPE_PORT))
+            FlexCounter::setPollInterval(static_cast<uint32_t>(pollInterval), groupName);
+        }
+        else if (field == PORT_PLUGIN_FIELD)
         {
-            PfcWatchdog::addPortCounterPlugin(key);
+            auto shaStrings = swss::tokenize(value, ',');
+
+            FlexCounter::setPortCounterPlugins(
+                    std::set<std::string>(shaStrings.begin(), shaStrings.end()),
+                    groupName);
         }
-        else if (value == sai_serialize_object_type(SAI_OBJECT_TYPE_QUEUE))
+        else if (field == QUEUE_PLUGIN_FIELD)
         {
-            PfcWatchdog::addQueueCounterPlugin(key);
+            auto shaStrings = swss::tokenize(value, ',');
+
+            FlexCounter::setQueueCounterPlugins(
+                    std::set<std::string>(shaStrings.begin(), shaStrings.end()),
+                    groupName);
         }
         else
         {
-            SWSS_LOG_ERROR("Plugin for %s is not supported", value.c_str());
+            SWSS_LOG_ERROR("Field %s is not supported in flex counter group %s", field.c_str(), groupName.c_str());
         }
     }
 }
@@ -2950,6 +3685,13 @@ void onSyncdStart(bool warmStart)
      */
 
     hardReinit();
+
+    /*
+     * Hard reinit recreated VID and RID maps in redis, from now on all known
+     * objects are translated using local db.
+     */
+
+    redis_load_rid_and_vid_to_local();
 }
 
 void sai_meta_log_syncd(
@@ -3036,14 +3778,16 @@ int main(int argc, char **argv)
 
     std::shared_ptr<swss::DBConnector> dbAsic = std::make_shared<swss::DBConnector>(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
     std::shared_ptr<swss::DBConnector> dbNtf = std::make_shared<swss::DBConnector>(ASIC_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
-    std::shared_ptr<swss::DBConnector> dbPfcWatchdog = std::make_shared<swss::DBConnector>(PFC_WD_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
+    std::shared_ptr<swss::DBConnector> dbFlexCounter = std::make_shared<swss::DBConnector>(FLEX_COUNTER_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
 
+    g_dbAsic = dbAsic;
     g_redisClient = std::make_shared<swss::RedisClient>(dbAsic.get());
 
     std::shared_ptr<swss::ConsumerTable> asicState = std::make_shared<swss::ConsumerTable>(dbAsic.get(), ASIC_STATE_TABLE);
+    std::shared_ptr<swss::ConsumerTable> getRequest = std::make_shared<swss::ConsumerTable>(dbAsic.get(), GET_REQUEST_TABLE);
     std::shared_ptr<swss::NotificationConsumer> restartQuery = std::make_shared<swss::NotificationConsumer>(dbAsic.get(), "RESTARTQUERY");
-    std::shared_ptr<swss::ConsumerStateTable> pfcWdState = std::make_shared<swss::ConsumerStateTable>(dbPfcWatchdog.get(), PFC_WD_STATE_TABLE);
-    std::shared_ptr<swss::ConsumerStateTable> pfcWdPlugin = std::make_shared<swss::ConsumerStateTable>(dbPfcWatchdog.get(), PLUGIN_TABLE);
+    std::shared_ptr<swss::ConsumerStateTable> flexCounter = std::make_shared<swss::ConsumerStateTable>(dbFlexCounter.get(), FLEX_COUNTER_TABLE);
+    std::shared_ptr<swss::ConsumerStateTable> flexCounterGroup = std::make_shared<swss::ConsumerStateTable>(dbFlexCounter.get(), FLEX_COUNTER_GROUP_TABLE);
 
     /*
      * At the end we cant use producer consumer concept since if one proces
@@ -3051,7 +3795,7 @@ int main(int argc, char **argv)
      * response queue will also trigger another "response".
      */
 
-    getResponse  = std::make_shared<swss::ProducerTable>(dbAsic.get(), "GETRESPONSE");
+    getResponse  = std::make_shared<swss::ProducerTable>(dbAsic.get(), GET_RESPONSE_TABLE);
     notifications = std::make_shared<swss::NotificationProducer>(dbNtf.get(), "NOTIFICATIONS");
 
     g_veryFirstRun = isVeryFirstRun();
@@ -3126,9 +3870,9 @@ int main(int argc, char **argv)
 
         if (options.disableCountersThread == false)
         {
-            SWSS_LOG_NOTICE("starting counters thread");
+            SWSS_LOG_NOTICE("starting port counters");
 
-            startCountersThread(options.countersThreadIntervalInSeconds);
+            startPortCounters(options.countersThreadIntervalInSeconds);
         }
 
         startNotificationsProcessingThread();
@@ -3139,8 +3883,16 @@ int main(int argc, char **argv)
 
         s.addSelectable(asicState.get());
         s.addSelectable(restartQuery.get());
-        s.addSelectable(pfcWdState.get());
-        s.addSelectable(pfcWdPlugin.get());
+
+        /*
+         * Gets are served before pending ASIC_STATE operations they don't
+         * depend on.
+         */
+
+        getRequest->setPri(1);
+        s.addSelectable(getRequest.get());
+        s.addSelectable(flexCounter.get());
+        s.addSelectable(flexCounterGroup.get());
 
         SWSS_LOG_NOTICE("starting main loop");
 
@@ -3150,7 +3902,19 @@ int main(int argc, char **argv)
 
             int fd;
 
-            int result = s.select(&sel, &fd);
+            /*
+             * Deferred gets expire on their own deadline, other events don't
+             * push it back.
+             */
+
+            int result = s.select(&sel, &fd, getDeferredGetsTimeout());
+
+            processExpiredDeferredGets();
+
+            if (result == swss::Select::TIMEOUT)
+            {
+                continue;
+            }
 
             if (sel == restartQuery.get())
             {
@@ -3165,13 +3929,17 @@ int main(int argc, char **argv)
                 warmRestartHint = handleRestartQuery(*restartQuery);
                 break;
             }
-            else if (sel == pfcWdState.get())
+            else if (sel == flexCounter.get())
+            {
+                processFlexCounterEvent(*(swss::ConsumerStateTable*)sel);
+            }
+            else if (sel == flexCounterGroup.get())
             {
-                processPfcWdEvent(*(swss::ConsumerStateTable*)sel);
+                processFlexCounterGroupEvent(*(swss::ConsumerStateTable*)sel);
             }
-            else if (sel == pfcWdPlugin.get())
+            else if (sel == getRequest.get())
             {
-                processPfcWdPluginEvent(*(swss::ConsumerStateTable*)sel);
+                processGetRequest(*(swss::ConsumerTable*)sel);
             }
             else if (result == swss::Select::OBJECT)
             {
@@ -3186,7 +3954,7 @@ int main(int argc, char **argv)
         exit_and_notify(EXIT_FAILURE);
     }
 
-    endCountersThread();
+    endPortCounters();
 
     if (warmRestartHint)
     {
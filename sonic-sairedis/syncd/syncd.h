@@ -27,6 +27,7 @@ extern "C" {
 
 #include "meta/saiserialize.h"
 #include "meta/saiattributelist.h"
+#include "meta/saividallocator.h"
 #include "swss/redisclient.h"
 #include "swss/dbconnector.h"
 #include "swss/producertable.h"
@@ -96,9 +97,11 @@ void translate_rid_to_vid_list(
         _In_ uint32_t attr_count,
         _In_ sai_attribute_t *attr_list);
 
-void endCountersThread();
-void startCountersThread(
+void endPortCounters();
+void startPortCounters(
         _In_ int intervalInSeconds);
+void addPortCounters(
+        _In_ const SaiSwitch &sw);
 
 sai_status_t syncdApplyView();
 void check_notifications_pointers(
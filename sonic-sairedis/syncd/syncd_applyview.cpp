@@ -5,6 +5,7 @@
 #include "swss/dbconnector.h"
 
 #include <algorithm>
+#include <chrono>
 #include <list>
 
 /*
@@ -901,6 +902,233 @@ class AsicView
             return list;
         }
 
+        /**
+         * @brief Gets attributes signature of given object.
+         *
+         * Signature is built from all attributes sorted by attribute id. For
+         * object id attributes RIDs are used instead of VIDs, since temporary
+         * and current VIDs are different for the same RID. Two objects with
+         * equal signature (each computed in it's own view) have all
+         * attributes equal in sense of hasEqualAttribute.
+         *
+         * @param[in] obj Object which signature will be computed.
+         * @param[out] signature Computed signature.
+         *
+         * @return False when some VID on attributes don't have RID yet (object
+         * will be created later on), signature is not valid then.
+         */
+        bool getAttributesSignature(
+                _In_ const std::shared_ptr<const SaiObj> &obj,
+                _Out_ std::string &signature) const
+        {
+            SWSS_LOG_ENTER();
+
+            std::vector<std::shared_ptr<const SaiAttr>> attrs;
+
+            for (const auto &p: obj->getAllAttributes())
+            {
+                attrs.push_back(p.second);
+            }
+
+            std::sort(attrs.begin(), attrs.end(),
+                    [](const std::shared_ptr<const SaiAttr> &a, const std::shared_ptr<const SaiAttr> &b)
+                    { return a->getAttrMetadata()->attrid < b->getAttrMetadata()->attrid; });
+
+            signature.clear();
+
+            for (const auto &attr: attrs)
+            {
+                signature += attr->getStrAttrId();
+                signature += "=";
+
+                if (!attr->isObjectIdAttr())
+                {
+                    signature += attr->getStrAttrValue();
+                    signature += "|";
+                    continue;
+                }
+
+                for (const auto &vid: attr->getOidListFromAttribute())
+                {
+                    sai_object_id_t rid = SAI_NULL_OBJECT_ID;
+
+                    if (vid != SAI_NULL_OBJECT_ID)
+                    {
+                        auto it = vidToRid.find(vid);
+
+                        if (it == vidToRid.end())
+                        {
+                            return false;
+                        }
+
+                        rid = it->second;
+                    }
+
+                    signature += sai_serialize_object_id(rid);
+                    signature += ",";
+                }
+
+                signature += "|";
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Gets not processed objects with given attributes signature.
+         *
+         * Index for object type is built on first use. Only not processed
+         * objects are candidates here, and their attributes are not modified
+         * during view transition, so index don't need to be updated, only
+         * object status is checked on lookup.
+         *
+         * @param object_type Object type to be used as filter.
+         * @param signature Attributes signature.
+         *
+         * @return List of objects with requested object type, signature and
+         * marked as not processed.
+         */
+        std::vector<std::shared_ptr<SaiObj>> getNotProcessedObjectsByAttributesSignature(
+                _In_ sai_object_type_t object_type,
+                _In_ const std::string &signature) const
+        {
+            SWSS_LOG_ENTER();
+
+            auto indexIt = m_signatureIndex.find(object_type);
+
+            if (indexIt == m_signatureIndex.end())
+            {
+                auto &index = m_signatureIndex[object_type];
+
+                for (const auto &obj: getNotProcessedObjectsByObjectType(object_type))
+                {
+                    std::string objSignature;
+
+                    if (getAttributesSignature(obj, objSignature))
+                    {
+                        index[objSignature].push_back(obj);
+                    }
+                }
+
+                indexIt = m_signatureIndex.find(object_type);
+            }
+
+            std::vector<std::shared_ptr<SaiObj>> list;
+
+            auto it = indexIt->second.find(signature);
+
+            if (it == indexIt->second.end())
+            {
+                return list;
+            }
+
+            for (const auto &obj: it->second)
+            {
+                if (obj->getObjectStatus() == SAI_OBJECT_STATUS_NOT_PROCESSED)
+                {
+                    list.push_back(obj);
+                }
+            }
+
+            return list;
+        }
+
+        /**
+         * @brief Gets objects which given attribute points to given VID.
+         *
+         * Index for object type and attribute is built on first use and it's
+         * dropped after any ASIC operation on this view.
+         *
+         * @param object_type Object type to be used as filter.
+         * @param attr_id Object id attribute to be checked.
+         * @param vid Virtual ID that attribute must point to.
+         *
+         * @return List of objects using given VID on given attribute.
+         */
+        const std::vector<std::shared_ptr<const SaiObj>>& getObjectsUsingVid(
+                _In_ sai_object_type_t object_type,
+                _In_ sai_attr_id_t attr_id,
+                _In_ sai_object_id_t vid) const
+        {
+            SWSS_LOG_ENTER();
+
+            invalidateCachesOnAsicOperation();
+
+            auto key = std::make_pair(object_type, attr_id);
+
+            auto indexIt = m_usageIndex.find(key);
+
+            if (indexIt == m_usageIndex.end())
+            {
+                auto &index = m_usageIndex[key];
+
+                for (const auto &m: getObjectsByObjectType(object_type))
+                {
+                    if (!m->hasAttr(attr_id))
+                    {
+                        continue;
+                    }
+
+                    const auto &attr = m->getSaiAttr(attr_id);
+
+                    if (attr->getAttrMetadata()->attrvaluetype != SAI_ATTR_VALUE_TYPE_OBJECT_ID)
+                    {
+                        SWSS_LOG_THROW("attribute %s is not oid attribute, or not oid attr, bug!",
+                                attr->getAttrMetadata()->attridname);
+                    }
+
+                    index[attr->getSaiAttr()->value.oid].push_back(m);
+                }
+
+                indexIt = m_usageIndex.find(key);
+            }
+
+            static const std::vector<std::shared_ptr<const SaiObj>> empty;
+
+            auto it = indexIt->second.find(vid);
+
+            return (it == indexIt->second.end()) ? empty : it->second;
+        }
+
+        /**
+         * @brief Gets cached dependency tree count of given object.
+         *
+         * Cache is dropped after any ASIC operation on this view.
+         *
+         * @param[in] obj Object to be checked.
+         * @param[out] count Cached count.
+         *
+         * @return True if count was found in cache.
+         */
+        bool getCachedDependencyTreeCount(
+                _In_ const std::shared_ptr<const SaiObj> &obj,
+                _Out_ int &count) const
+        {
+            SWSS_LOG_ENTER();
+
+            invalidateCachesOnAsicOperation();
+
+            auto it = m_dependencyTreeCount.find(obj.get());
+
+            if (it == m_dependencyTreeCount.end())
+            {
+                return false;
+            }
+
+            count = it->second;
+
+            return true;
+        }
+
+        void setCachedDependencyTreeCount(
+                _In_ const std::shared_ptr<const SaiObj> &obj,
+                _In_ int count) const
+        {
+            SWSS_LOG_ENTER();
+
+            m_dependencyTreeCount[obj.get()] = count;
+        }
+
         /**
          * @brief Create dummy existing object
          *
@@ -1458,6 +1686,42 @@ class AsicView
          */
         std::map<sai_object_id_t, int> m_vidToAsicOperationId;
 
+        /*
+         * Lookup caches used when searching for best match, they are only
+         * valid for given asic operation id, see invalidateCachesOnAsicOperation.
+         */
+
+        mutable std::map<sai_object_type_t, std::unordered_map<std::string, std::vector<std::shared_ptr<SaiObj>>>> m_signatureIndex;
+
+        mutable std::map<std::pair<sai_object_type_t, sai_attr_id_t>,
+                std::unordered_map<sai_object_id_t, std::vector<std::shared_ptr<const SaiObj>>>> m_usageIndex;
+
+        mutable std::unordered_map<const SaiObj*, int> m_dependencyTreeCount;
+
+        mutable int m_cacheAsicOperationId = 0;
+
+        /**
+         * @brief Drops usage index and dependency counts.
+         *
+         * Each asic operation on view can change references between objects,
+         * so cached values are not valid any more. Signature index stays since
+         * it only holds not processed objects which are not modified.
+         */
+        void invalidateCachesOnAsicOperation() const
+        {
+            SWSS_LOG_ENTER();
+
+            if (m_cacheAsicOperationId == m_asicOperationId)
+            {
+                return;
+            }
+
+            m_usageIndex.clear();
+            m_dependencyTreeCount.clear();
+
+            m_cacheAsicOperationId = m_asicOperationId;
+        }
+
         void populateAttributes(
                 _In_ std::shared_ptr<SaiObj> &obj,
                 _In_ const swss::TableMap &map)
@@ -2032,30 +2296,12 @@ std::vector<std::shared_ptr<const SaiObj>> findUsageCount(
 {
     SWSS_LOG_ENTER();
 
-    std::vector<std::shared_ptr<const SaiObj>> filtered;
-
-    const auto &members = view.getObjectsByObjectType(object_type);
-
-    for (auto &m: members)
-    {
-        if (m->hasAttr(attr_id))
-        {
-            const auto &attr = m->getSaiAttr(attr_id);
-
-            if (attr->getAttrMetadata()->attrvaluetype != SAI_ATTR_VALUE_TYPE_OBJECT_ID)
-            {
-                SWSS_LOG_THROW("attribute %s is not oid attribute, or not oid attr, bug!",
-                        attr->getAttrMetadata()->attridname);
-            }
-
-            if (attr->getSaiAttr()->value.oid == obj->getVid())
-            {
-                filtered.push_back(m);
-            }
-        }
-    }
+    /*
+     * View keeps reverse index of attribute values, so we don't need to
+     * iterate via all objects of given type for every usage lookup.
+     */
 
-    return filtered;
+    return view.getObjectsUsingVid(object_type, attr_id, obj->getVid());
 }
 
 int findAllChildsInDependencyTreeCount(
@@ -2073,6 +2319,16 @@ int findAllChildsInDependencyTreeCount(
         return count;
     }
 
+    /*
+     * The same subtrees are counted for every candidate of every object, so
+     * count is cached in view until next asic operation changes references.
+     */
+
+    if (view.getCachedDependencyTreeCount(obj, count))
+    {
+        return count;
+    }
+
     for (int idx = 0; info->revgraphmembers[idx] != NULL; ++idx)
     {
         auto &member = info->revgraphmembers[idx];
@@ -2145,6 +2401,8 @@ int findAllChildsInDependencyTreeCount(
         }
     }
 
+    view.setCachedDependencyTreeCount(obj, count);
+
     return count;
 }
 
@@ -2285,6 +2543,49 @@ std::shared_ptr<SaiObj> findCurrentBestMatchForGenericObject(
 
     sai_object_type_t object_type = temporaryObj->getObjectType();
 
+    /*
+     * In most cases current view contains object with exactly the same
+     * attributes as temporary object, so first try hash lookup by attributes
+     * signature. Such object has all attributes equal, so no other candidate
+     * can have more equal attributes, and we only need to pick between objects
+     * with the same signature.
+     */
+
+    std::string signature;
+
+    if (temporaryView.getAttributesSignature(temporaryObj, signature))
+    {
+        const auto sameObjects = currentView.getNotProcessedObjectsByAttributesSignature(object_type, signature);
+
+        if (sameObjects.size() == 1)
+        {
+            SWSS_LOG_INFO("found best match for %s by attributes signature",
+                    temporaryObj->str_object_id.c_str());
+
+            return sameObjects.at(0);
+        }
+
+        if (sameObjects.size() > 1)
+        {
+            std::vector<sai_object_compare_info_t> candidateObjects;
+
+            for (const auto &currentObj: sameObjects)
+            {
+                candidateObjects.push_back({ temporaryObj->getAllAttributes().size(), currentObj });
+            }
+
+            SWSS_LOG_INFO("multiple candidates found (%zu) for %s by attributes signature, will use heuristic",
+                    candidateObjects.size(),
+                    temporaryObj->str_object_id.c_str());
+
+            return findCurrentBestMatchForGenericObjectUsingHeuristic(
+                    currentView,
+                    temporaryView,
+                    temporaryObj,
+                    candidateObjects);
+        }
+    }
+
     const auto notProcessedObjects = currentView.getNotProcessedObjectsByObjectType(object_type);
 
     const auto attrs = temporaryObj->getAllAttributes();
@@ -2293,7 +2594,8 @@ std::shared_ptr<SaiObj> findCurrentBestMatchForGenericObject(
      * Complexity here is O((n^2)*m) since we iterate via all not processed
      * objects, then we iterate through all present attributes.  N is squared
      * since for given object type we iterate via entire list for each object,
-     * this can be optimized a little bit inside AsicView class.
+     * this is why we do signature lookup first and scan only when temporary
+     * object don't have identical object in current view.
      */
 
     SWSS_LOG_INFO("not processed objects for %s: %zu, attrs: %zu",
@@ -2847,6 +3149,24 @@ std::shared_ptr<SaiObj> findCurrentBestMatchForSwitch(
             currentSwitchObj->getObjectStatus());
 }
 
+/**
+ * @brief Best match lookup statistics for single object type.
+ *
+ * Collected during view transition and logged when it ends, so we can see
+ * which object types take most of comparison logic time.
+ */
+typedef struct _best_match_stats_t
+{
+    size_t count;
+
+    size_t matched;
+
+    uint64_t usec;
+
+} best_match_stats_t;
+
+std::map<sai_object_type_t, best_match_stats_t> bestMatchStats;
+
 std::shared_ptr<SaiObj> findCurrentBestMatch(
         _In_ const AsicView &currentView,
         _In_ const AsicView &temporaryView,
@@ -4463,8 +4783,16 @@ void processObjectForViewTransition(
      * can try to find current best match.
      */
 
+    auto start = std::chrono::steady_clock::now();
+
     std::shared_ptr<SaiObj> currentBestMatch = findCurrentBestMatch(currentView, temporaryView, temporaryObj);
 
+    auto &stats = bestMatchStats[temporaryObj->getObjectType()];
+
+    stats.count++;
+    stats.matched += (currentBestMatch != nullptr);
+    stats.usec += (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
     /*
      * So there will be interesting problem, when we don't find best matching
      * object, but actual object will exist, and it will have the same KEY
@@ -4735,6 +5063,8 @@ void applyViewTransition(
 
     SWSS_LOG_TIMER("comparison logic");
 
+    bestMatchStats.clear();
+
     checkSwitch(current, temp);
 
     checkMatchedPorts(temp);
@@ -4901,6 +5231,15 @@ void applyViewTransition(
         }
     }
 
+    for (const auto &p: bestMatchStats)
+    {
+        SWSS_LOG_NOTICE("best match %s: %zu objects, %zu matched, %.3f ms",
+                sai_serialize_object_type(p.first).c_str(),
+                p.second.count,
+                p.second.matched,
+                (double)p.second.usec / 1000.0);
+    }
+
     /*
      * Check statuses will make sure that there are no objects with removed
      * status.
@@ -1,86 +1,77 @@
 #include "syncd.h"
+#include "syncd_flex_counter.h"
 
-#include <condition_variable>
-#include <sstream>
+/*
+ * Ports of every switch are polled with all their supported counters in this
+ * flex counter group, at the interval given on the command line.
+ */
 
-static volatile bool  g_runCountersThread = false;
-static std::shared_ptr<std::thread> g_countersThread = NULL;
+#define PORT_COUNTERS_FLEX_COUNTER_GROUP "SYNCD_PORT_STAT_COUNTER"
 
-static std::mutex mtx_sleep;
-static std::condition_variable cv_sleep;
+static bool g_portCountersEnabled = false;
 
-void collectCountersThread(
-        _In_ int intervalInSeconds)
+void addPortCounters(
+        _In_ const SaiSwitch &sw)
 {
     SWSS_LOG_ENTER();
 
-    SWSS_LOG_NOTICE("starting counters thread");
-
-    swss::DBConnector db(COUNTERS_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
-    swss::Table countersTable(&db, "COUNTERS");
-
-    while (g_runCountersThread)
+    if (!g_portCountersEnabled)
     {
-        /*
-         * NOTE: We know that at most we can have 1 switch
-         * so we can use "COUNTERS" table, but for multiple
-         * switches we need to do this per switch
-         */
-
-        for (auto sw: switches)
-        {
-            std::lock_guard<std::mutex> lock(g_mutex);
-
-            /*
-             * Collect counters should be under mutex since configuration can
-             * change and we don't want that during counters collection.
-             */
-
-            sw.second->collectCounters(countersTable);
-        }
-
-        std::unique_lock<std::mutex> lk(mtx_sleep);
-
-        cv_sleep.wait_for(lk, std::chrono::seconds(intervalInSeconds));
+        return;
     }
+
+    sw.setPortCounters(PORT_COUNTERS_FLEX_COUNTER_GROUP);
 }
 
-void startCountersThread(
+void startPortCounters(
         _In_ int intervalInSeconds)
 {
+    std::lock_guard<std::mutex> lock(g_mutex);
+
     SWSS_LOG_ENTER();
 
-    if (g_runCountersThread)
+    if (g_portCountersEnabled)
     {
-        SWSS_LOG_WARN("counter thread is already running");
+        SWSS_LOG_WARN("port counters are already polled");
         return;
     }
 
-    g_runCountersThread = true;
+    g_portCountersEnabled = true;
+
+    FlexCounter::setPollInterval(static_cast<uint32_t>(intervalInSeconds) * 1000, PORT_COUNTERS_FLEX_COUNTER_GROUP);
+
+    /*
+     * Switches created later are added by addPortCounters.
+     */
 
-    g_countersThread = std::make_shared<std::thread>(collectCountersThread, intervalInSeconds);
+    for (const auto &sw: switches)
+    {
+        addPortCounters(*sw.second);
+    }
 }
 
-void endCountersThread()
+void endPortCounters()
 {
+    std::lock_guard<std::mutex> lock(g_mutex);
+
     SWSS_LOG_ENTER();
 
-    if (!g_runCountersThread)
+    if (!g_portCountersEnabled)
     {
-        SWSS_LOG_WARN("counter thread is not running");
+        SWSS_LOG_WARN("port counters are not polled");
         return;
     }
 
-    g_runCountersThread = false;
+    g_portCountersEnabled = false;
 
-    cv_sleep.notify_all();
+    /*
+     * Group thread ends when its last counter is removed.
+     */
 
-    if (g_countersThread != NULL)
+    for (const auto &sw: switches)
     {
-        SWSS_LOG_INFO("counters thread join");
-
-        g_countersThread->join();
+        sw.second->removePortCounters(PORT_COUNTERS_FLEX_COUNTER_GROUP);
     }
 
-    SWSS_LOG_INFO("counters thread ended");
+    SWSS_LOG_INFO("port counters polling ended");
 }
@@ -0,0 +1,687 @@
+#include "syncd_flex_counter.h"
+#include "syncd.h"
+#include "swss/redisapi.h"
+
+/*
+ * Poll interval of groups which were not configured in FLEX_COUNTER_GROUP_TABLE.
+ */
+#define FLEX_COUNTER_DEFAULT_POLL_MSECS 1000
+
+FlexCounter::PortCounterIds::PortCounterIds(
+        _In_ sai_object_id_t port,
+        _In_ const std::vector<sai_port_stat_t> &portIds):
+    portId(port), portCounterIds(portIds)
+{
+}
+
+FlexCounter::QueueCounterIds::QueueCounterIds(
+        _In_ sai_object_id_t queue,
+        _In_ const std::vector<sai_queue_stat_t> &queueIds):
+    queueId(queue), queueCounterIds(queueIds)
+{
+}
+
+FlexCounter::PriorityGroupCounterIds::PriorityGroupCounterIds(
+        _In_ sai_object_id_t priorityGroup,
+        _In_ const std::vector<sai_ingress_priority_group_stat_t> &priorityGroupIds):
+    priorityGroupId(priorityGroup), priorityGroupCounterIds(priorityGroupIds)
+{
+}
+
+FlexCounter::AclCounterAttrIds::AclCounterAttrIds(
+        _In_ sai_object_id_t aclCounter,
+        _In_ const std::vector<sai_attr_id_t> &aclCounterIds):
+    aclCounterId(aclCounter), aclCounterAttrIds(aclCounterIds)
+{
+}
+
+void FlexCounter::setPortCounterList(
+        _In_ sai_object_id_t portVid,
+        _In_ sai_object_id_t portId,
+        _In_ const std::string &instanceId,
+        _In_ const std::vector<sai_port_stat_t> &counterIds)
+{
+    SWSS_LOG_ENTER();
+
+    FlexCounter &fc = getInstance(instanceId);
+
+    {
+        std::lock_guard<std::mutex> lock(fc.m_mtx);
+
+        fc.m_portCounterIdsMap[portVid] = std::make_shared<PortCounterIds>(portId, counterIds);
+    }
+
+    // Start flex counter thread in case it was not running due to empty counter IDs map
+    fc.checkFlexCounterThread();
+}
+
+void FlexCounter::setQueueCounterList(
+        _In_ sai_object_id_t queueVid,
+        _In_ sai_object_id_t queueId,
+        _In_ const std::string &instanceId,
+        _In_ const std::vector<sai_queue_stat_t> &counterIds)
+{
+    SWSS_LOG_ENTER();
+
+    FlexCounter &fc = getInstance(instanceId);
+
+    {
+        std::lock_guard<std::mutex> lock(fc.m_mtx);
+
+        fc.m_queueCounterIdsMap[queueVid] = std::make_shared<QueueCounterIds>(queueId, counterIds);
+    }
+
+    // Start flex counter thread in case it was not running due to empty counter IDs map
+    fc.checkFlexCounterThread();
+}
+
+void FlexCounter::setPriorityGroupCounterList(
+        _In_ sai_object_id_t priorityGroupVid,
+        _In_ sai_object_id_t priorityGroupId,
+        _In_ const std::string &instanceId,
+        _In_ const std::vector<sai_ingress_priority_group_stat_t> &counterIds)
+{
+    SWSS_LOG_ENTER();
+
+    FlexCounter &fc = getInstance(instanceId);
+
+    {
+        std::lock_guard<std::mutex> lock(fc.m_mtx);
+
+        fc.m_priorityGroupCounterIdsMap[priorityGroupVid] =
+            std::make_shared<PriorityGroupCounterIds>(priorityGroupId, counterIds);
+    }
+
+    // Start flex counter thread in case it was not running due to empty counter IDs map
+    fc.checkFlexCounterThread();
+}
+
+void FlexCounter::setAclCounterAttrList(
+        _In_ sai_object_id_t aclCounterVid,
+        _In_ sai_object_id_t aclCounterId,
+        _In_ const std::string &instanceId,
+        _In_ const std::vector<sai_attr_id_t> &attrIds)
+{
+    SWSS_LOG_ENTER();
+
+    FlexCounter &fc = getInstance(instanceId);
+
+    {
+        std::lock_guard<std::mutex> lock(fc.m_mtx);
+
+        fc.m_aclCounterAttrIdsMap[aclCounterVid] = std::make_shared<AclCounterAttrIds>(aclCounterId, attrIds);
+    }
+
+    // Start flex counter thread in case it was not running due to empty counter IDs map
+    fc.checkFlexCounterThread();
+}
+
+void FlexCounter::removeCounter(
+        _In_ sai_object_id_t vid,
+        _In_ const std::string &instanceId)
+{
+    SWSS_LOG_ENTER();
+
+    FlexCounter &fc = getInstance(instanceId);
+
+    size_t removed = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(fc.m_mtx);
+
+        removed += fc.m_portCounterIdsMap.erase(vid);
+        removed += fc.m_queueCounterIdsMap.erase(vid);
+        removed += fc.m_priorityGroupCounterIdsMap.erase(vid);
+        removed += fc.m_aclCounterAttrIdsMap.erase(vid);
+
+        if (removed != 0)
+        {
+            fc.m_removedVids.push_back(vid);
+        }
+    }
+
+    if (removed == 0)
+    {
+        SWSS_LOG_ERROR("Trying to remove nonexisting counter Ids 0x%lx from %s", vid, instanceId.c_str());
+        return;
+    }
+
+    // Stop flex counter thread if counter IDs maps are empty
+    fc.checkFlexCounterThread();
+}
+
+void FlexCounter::setPollInterval(
+        _In_ uint32_t pollInterval,
+        _In_ const std::string &instanceId)
+{
+    SWSS_LOG_ENTER();
+
+    if (pollInterval == 0)
+    {
+        SWSS_LOG_ERROR("Poll interval of %s must be positive", instanceId.c_str());
+        return;
+    }
+
+    FlexCounter &fc = getInstance(instanceId);
+
+    fc.m_pollInterval = pollInterval;
+
+    SWSS_LOG_NOTICE("Poll interval of %s set to %u ms", instanceId.c_str(), pollInterval);
+}
+
+void FlexCounter::setPortCounterPlugins(
+        _In_ const std::set<std::string> &shas,
+        _In_ const std::string &instanceId)
+{
+    SWSS_LOG_ENTER();
+
+    FlexCounter &fc = getInstance(instanceId);
+
+    std::lock_guard<std::mutex> lock(fc.m_mtx);
+
+    fc.m_portPlugins = shas;
+
+    for (const auto &sha: shas)
+    {
+        SWSS_LOG_NOTICE("Port counters plugin %s registered in %s", sha.c_str(), instanceId.c_str());
+    }
+}
+
+void FlexCounter::setQueueCounterPlugins(
+        _In_ const std::set<std::string> &shas,
+        _In_ const std::string &instanceId)
+{
+    SWSS_LOG_ENTER();
+
+    FlexCounter &fc = getInstance(instanceId);
+
+    std::lock_guard<std::mutex> lock(fc.m_mtx);
+
+    fc.m_queuePlugins = shas;
+
+    for (const auto &sha: shas)
+    {
+        SWSS_LOG_NOTICE("Queue counters plugin %s registered in %s", sha.c_str(), instanceId.c_str());
+    }
+}
+
+void FlexCounter::removeCounterPlugins(
+        _In_ const std::string &instanceId)
+{
+    SWSS_LOG_ENTER();
+
+    FlexCounter &fc = getInstance(instanceId);
+
+    std::lock_guard<std::mutex> lock(fc.m_mtx);
+
+    fc.m_queuePlugins.clear();
+    fc.m_portPlugins.clear();
+}
+
+FlexCounter::~FlexCounter(void)
+{
+    endFlexCounterThread();
+}
+
+FlexCounter::FlexCounter(
+        _In_ const std::string &instanceId):
+    m_instanceId(instanceId),
+    m_pollInterval(FLEX_COUNTER_DEFAULT_POLL_MSECS)
+{
+}
+
+FlexCounter& FlexCounter::getInstance(
+        _In_ const std::string &instanceId)
+{
+    /*
+     * Groups are created and configured only by the main thread.
+     */
+
+    static std::map<std::string, std::shared_ptr<FlexCounter>> flexCounters;
+
+    auto it = flexCounters.find(instanceId);
+
+    if (it == flexCounters.end())
+    {
+        auto fc = std::shared_ptr<FlexCounter>(new FlexCounter(instanceId));
+
+        it = flexCounters.emplace(instanceId, fc).first;
+    }
+
+    return *it->second;
+}
+
+bool FlexCounter::isEmpty(void)
+{
+    std::lock_guard<std::mutex> lock(m_mtx);
+
+    return m_portCounterIdsMap.empty() &&
+        m_queueCounterIdsMap.empty() &&
+        m_priorityGroupCounterIdsMap.empty() &&
+        m_aclCounterAttrIdsMap.empty();
+}
+
+/*
+ * Serializes counter values of the object to a pipelined HMSET.
+ */
+static void pushCounters(
+        _In_ swss::RedisPipeline &pipeline,
+        _In_ swss::TableBase &countersTable,
+        _In_ sai_object_id_t vid,
+        _In_ const std::vector<swss::FieldValueTuple> &values)
+{
+    SWSS_LOG_ENTER();
+
+    if (values.empty())
+    {
+        return;
+    }
+
+    swss::RedisCommand hmset;
+
+    hmset.formatHMSET(countersTable.getKeyName(sai_serialize_object_id(vid)), values);
+
+    pipeline.push(hmset, REDIS_REPLY_NIL);
+}
+
+/*
+ * SAI calls of the polling thread are serialized with the main thread by
+ * g_mutex. Main thread may hold it while it ends this thread, so it is only
+ * waited for while the thread keeps running.
+ */
+bool FlexCounter::lockSaiApi(
+        _In_ std::unique_lock<std::mutex> &lock)
+{
+    SWSS_LOG_ENTER();
+
+    while (!lock.try_lock())
+    {
+        if (!m_runFlexCounterThread)
+        {
+            return false;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return true;
+}
+
+/*
+ * Deletes counters of removed objects in the same pipeline the polls write
+ * them to, after any write of an earlier poll.
+ */
+void FlexCounter::deleteRemovedCounters(
+        _In_ swss::RedisPipeline &pipeline)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<sai_object_id_t> removedVids;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+
+        removedVids.swap(m_removedVids);
+    }
+
+    swss::TableBase countersTable(COUNTERS_TABLE);
+
+    for (const auto &vid: removedVids)
+    {
+        swss::RedisCommand del;
+
+        del.format("DEL %s", countersTable.getKeyName(sai_serialize_object_id(vid)).c_str());
+
+        pipeline.push(del, REDIS_REPLY_INTEGER);
+    }
+}
+
+void FlexCounter::collectCounters(
+        _In_ swss::RedisPipeline &pipeline)
+{
+    SWSS_LOG_ENTER();
+
+    PortCounterIdsMap portCounterIdsMap;
+    QueueCounterIdsMap queueCounterIdsMap;
+    PriorityGroupCounterIdsMap priorityGroupCounterIdsMap;
+    AclCounterAttrIdsMap aclCounterAttrIdsMap;
+
+    /*
+     * Removed objects are deleted before the snapshot is taken, an object
+     * removed and added again is written by this poll.
+     */
+
+    deleteRemovedCounters(pipeline);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+
+        portCounterIdsMap = m_portCounterIdsMap;
+        queueCounterIdsMap = m_queueCounterIdsMap;
+        priorityGroupCounterIdsMap = m_priorityGroupCounterIdsMap;
+        aclCounterAttrIdsMap = m_aclCounterAttrIdsMap;
+    }
+
+    swss::TableBase countersTable(COUNTERS_TABLE);
+
+    std::unique_lock<std::mutex> saiLock(g_mutex, std::defer_lock);
+
+    // Collect stats for every registered port
+    for (const auto &kv: portCounterIdsMap)
+    {
+        const auto &portVid = kv.first;
+        const auto &portId = kv.second->portId;
+        const auto &portCounterIds = kv.second->portCounterIds;
+
+        std::vector<uint64_t> portStats(portCounterIds.size());
+
+        // Get port stats
+        if (!lockSaiApi(saiLock))
+        {
+            return;
+        }
+
+        sai_status_t status = sai_metadata_sai_port_api->get_port_stats(
+                portId,
+                static_cast<uint32_t>(portCounterIds.size()),
+                portCounterIds.data(),
+                portStats.data());
+
+        saiLock.unlock();
+
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to get stats of port 0x%lx: %d", portId, status);
+            continue;
+        }
+
+        // Push all counter values to a single vector
+        std::vector<swss::FieldValueTuple> values;
+
+        for (size_t i = 0; i != portCounterIds.size(); i++)
+        {
+            const std::string &counterName = sai_serialize_port_stat(portCounterIds[i]);
+            values.emplace_back(counterName, std::to_string(portStats[i]));
+        }
+
+        pushCounters(pipeline, countersTable, portVid, values);
+    }
+
+    // Collect stats for every registered queue
+    for (const auto &kv: queueCounterIdsMap)
+    {
+        const auto &queueVid = kv.first;
+        const auto &queueId = kv.second->queueId;
+        const auto &queueCounterIds = kv.second->queueCounterIds;
+
+        std::vector<uint64_t> queueStats(queueCounterIds.size());
+
+        // Get queue stats
+        if (!lockSaiApi(saiLock))
+        {
+            return;
+        }
+
+        sai_status_t status = sai_metadata_sai_queue_api->get_queue_stats(
+                queueId,
+                static_cast<uint32_t>(queueCounterIds.size()),
+                queueCounterIds.data(),
+                queueStats.data());
+
+        saiLock.unlock();
+
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to get stats of queue 0x%lx: %d", queueVid, status);
+            continue;
+        }
+
+        // Push all counter values to a single vector
+        std::vector<swss::FieldValueTuple> values;
+
+        for (size_t i = 0; i != queueCounterIds.size(); i++)
+        {
+            const std::string &counterName = sai_serialize_queue_stat(queueCounterIds[i]);
+            values.emplace_back(counterName, std::to_string(queueStats[i]));
+        }
+
+        pushCounters(pipeline, countersTable, queueVid, values);
+    }
+
+    // Collect stats for every registered priority group
+    for (const auto &kv: priorityGroupCounterIdsMap)
+    {
+        const auto &priorityGroupVid = kv.first;
+        const auto &priorityGroupId = kv.second->priorityGroupId;
+        const auto &priorityGroupCounterIds = kv.second->priorityGroupCounterIds;
+
+        std::vector<uint64_t> priorityGroupStats(priorityGroupCounterIds.size());
+
+        // Get priority group stats
+        if (!lockSaiApi(saiLock))
+        {
+            return;
+        }
+
+        sai_status_t status = sai_metadata_sai_buffer_api->get_ingress_priority_group_stats(
+                priorityGroupId,
+                static_cast<uint32_t>(priorityGroupCounterIds.size()),
+                priorityGroupCounterIds.data(),
+                priorityGroupStats.data());
+
+        saiLock.unlock();
+
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to get stats of priority group 0x%lx: %d", priorityGroupVid, status);
+            continue;
+        }
+
+        // Push all counter values to a single vector
+        std::vector<swss::FieldValueTuple> values;
+
+        for (size_t i = 0; i != priorityGroupCounterIds.size(); i++)
+        {
+            const std::string &counterName = sai_serialize_ingress_priority_group_stat(priorityGroupCounterIds[i]);
+            values.emplace_back(counterName, std::to_string(priorityGroupStats[i]));
+        }
+
+        pushCounters(pipeline, countersTable, priorityGroupVid, values);
+    }
+
+    // Collect counter attributes for every registered acl counter
+    for (const auto &kv: aclCounterAttrIdsMap)
+    {
+        const auto &aclCounterVid = kv.first;
+        const auto &aclCounterId = kv.second->aclCounterId;
+        const auto &aclCounterAttrIds = kv.second->aclCounterAttrIds;
+
+        std::vector<sai_attribute_t> attrs(aclCounterAttrIds.size());
+
+        for (size_t i = 0; i != aclCounterAttrIds.size(); i++)
+        {
+            attrs[i].id = aclCounterAttrIds[i];
+        }
+
+        // Get acl counter attributes
+        if (!lockSaiApi(saiLock))
+        {
+            return;
+        }
+
+        sai_status_t status = sai_metadata_sai_acl_api->get_acl_counter_attribute(
+                aclCounterId,
+                static_cast<uint32_t>(attrs.size()),
+                attrs.data());
+
+        saiLock.unlock();
+
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to get attributes of acl counter 0x%lx: %d", aclCounterVid, status);
+            continue;
+        }
+
+        // Push all counter values to a single vector
+        std::vector<swss::FieldValueTuple> values;
+
+        for (const auto &attr: attrs)
+        {
+            auto meta = sai_metadata_get_attr_metadata(SAI_OBJECT_TYPE_ACL_COUNTER, attr.id);
+
+            values.emplace_back(meta->attridname, std::to_string(attr.value.u64));
+        }
+
+        pushCounters(pipeline, countersTable, aclCounterVid, values);
+    }
+
+    // Write all counters of this poll to DB
+    pipeline.flush();
+}
+
+void FlexCounter::runPlugins(
+        _In_ swss::DBConnector& db)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<std::string> portList;
+    std::vector<std::string> queueList;
+    std::set<std::string> portPlugins;
+    std::set<std::string> queuePlugins;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+
+        if (!m_portPlugins.empty())
+        {
+            portList.reserve(m_portCounterIdsMap.size());
+            for (const auto& kv : m_portCounterIdsMap)
+            {
+                portList.push_back(sai_serialize_object_id(kv.first));
+            }
+        }
+
+        if (!m_queuePlugins.empty())
+        {
+            queueList.reserve(m_queueCounterIdsMap.size());
+            for (const auto& kv : m_queueCounterIdsMap)
+            {
+                queueList.push_back(sai_serialize_object_id(kv.first));
+            }
+        }
+
+        portPlugins = m_portPlugins;
+        queuePlugins = m_queuePlugins;
+    }
+
+    const std::vector<std::string> argv =
+    {
+        std::to_string(COUNTERS_DB),
+        COUNTERS_TABLE,
+        std::to_string(m_pollInterval * 1000)
+    };
+
+    for (const auto& sha : portPlugins)
+    {
+        runRedisScript(db, sha, portList, argv);
+    }
+
+    for (const auto& sha : queuePlugins)
+    {
+        runRedisScript(db, sha, queueList, argv);
+    }
+}
+
+void FlexCounter::flexCounterThread(void)
+{
+    SWSS_LOG_ENTER();
+
+    swss::DBConnector db(COUNTERS_DB, swss::DBConnector::DEFAULT_UNIXSOCKET, 0);
+    swss::RedisPipeline pipeline(&db);
+
+    while (m_runFlexCounterThread)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        collectCounters(pipeline);
+        runPlugins(db);
+
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        auto interval = std::chrono::milliseconds(m_pollInterval.load());
+
+        if (elapsed > interval)
+        {
+            SWSS_LOG_WARN("Poll of %s took longer than its interval of %u ms", m_instanceId.c_str(), m_pollInterval.load());
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lk(m_mtxSleep);
+        m_cvSleep.wait_for(lk, interval - elapsed, [this]() { return !m_runFlexCounterThread; });
+    }
+
+    /*
+     * Thread ends once the last object of the group was removed, its
+     * counters are deleted here.
+     */
+
+    deleteRemovedCounters(pipeline);
+
+    pipeline.flush();
+}
+
+void FlexCounter::startFlexCounterThread(void)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_runFlexCounterThread.load() == true)
+    {
+        return;
+    }
+
+    m_runFlexCounterThread = true;
+
+    m_flexCounterThread = std::make_shared<std::thread>(&FlexCounter::flexCounterThread, this);
+
+    SWSS_LOG_INFO("Flex counter thread %s started", m_instanceId.c_str());
+}
+
+void FlexCounter::endFlexCounterThread(void)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_runFlexCounterThread.load() == false)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(m_mtxSleep);
+
+        m_runFlexCounterThread = false;
+    }
+
+    m_cvSleep.notify_all();
+
+    if (m_flexCounterThread != nullptr)
+    {
+        SWSS_LOG_INFO("Wait for flex counter thread %s to end", m_instanceId.c_str());
+
+        m_flexCounterThread->join();
+    }
+
+    SWSS_LOG_INFO("Flex counter thread %s ended", m_instanceId.c_str());
+}
+
+void FlexCounter::checkFlexCounterThread(void)
+{
+    SWSS_LOG_ENTER();
+
+    if (isEmpty())
+    {
+        endFlexCounterThread();
+    }
+    else
+    {
+        startFlexCounterThread();
+    }
+}
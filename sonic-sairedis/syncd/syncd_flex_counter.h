@@ -0,0 +1,167 @@
+#ifndef FLEX_COUNTER_H
+#define FLEX_COUNTER_H
+
+extern "C" {
+#include "sai.h"
+}
+
+#include <atomic>
+#include <vector>
+#include <set>
+#include <map>
+#include <condition_variable>
+#include "swss/table.h"
+#include "swss/redispipeline.h"
+
+/*
+ * Polls counters of the objects registered in FLEX_COUNTER_TABLE and writes
+ * them to COUNTERS table.
+ *
+ * Objects are registered in groups (PFC_WD, QUEUE_STAT_COUNTER, ...), each
+ * group is polled by its own thread at its own interval and runs its own lua
+ * plugins after each poll, as configured in FLEX_COUNTER_GROUP_TABLE.
+ */
+class FlexCounter
+{
+    public:
+        static void setPortCounterList(
+                _In_ sai_object_id_t portVid,
+                _In_ sai_object_id_t portId,
+                _In_ const std::string &instanceId,
+                _In_ const std::vector<sai_port_stat_t> &counterIds);
+        static void setQueueCounterList(
+                _In_ sai_object_id_t queueVid,
+                _In_ sai_object_id_t queueId,
+                _In_ const std::string &instanceId,
+                _In_ const std::vector<sai_queue_stat_t> &counterIds);
+        static void setPriorityGroupCounterList(
+                _In_ sai_object_id_t priorityGroupVid,
+                _In_ sai_object_id_t priorityGroupId,
+                _In_ const std::string &instanceId,
+                _In_ const std::vector<sai_ingress_priority_group_stat_t> &counterIds);
+        static void setAclCounterAttrList(
+                _In_ sai_object_id_t aclCounterVid,
+                _In_ sai_object_id_t aclCounterId,
+                _In_ const std::string &instanceId,
+                _In_ const std::vector<sai_attr_id_t> &attrIds);
+        static void removeCounter(
+                _In_ sai_object_id_t vid,
+                _In_ const std::string &instanceId);
+
+        static void setPollInterval(
+                _In_ uint32_t pollInterval,
+                _In_ const std::string &instanceId);
+        static void setPortCounterPlugins(
+                _In_ const std::set<std::string> &shas,
+                _In_ const std::string &instanceId);
+        static void setQueueCounterPlugins(
+                _In_ const std::set<std::string> &shas,
+                _In_ const std::string &instanceId);
+        static void removeCounterPlugins(
+                _In_ const std::string &instanceId);
+
+        FlexCounter(
+                _In_ const FlexCounter&) = delete;
+        ~FlexCounter(void);
+
+    private:
+        struct QueueCounterIds
+        {
+            QueueCounterIds(
+                    _In_ sai_object_id_t queue,
+                    _In_ const std::vector<sai_queue_stat_t> &queueIds);
+
+            sai_object_id_t queueId;
+            std::vector<sai_queue_stat_t> queueCounterIds;
+        };
+
+        struct PortCounterIds
+        {
+            PortCounterIds(
+                    _In_ sai_object_id_t port,
+                    _In_ const std::vector<sai_port_stat_t> &portIds);
+
+            sai_object_id_t portId;
+            std::vector<sai_port_stat_t> portCounterIds;
+        };
+
+        struct PriorityGroupCounterIds
+        {
+            PriorityGroupCounterIds(
+                    _In_ sai_object_id_t priorityGroup,
+                    _In_ const std::vector<sai_ingress_priority_group_stat_t> &priorityGroupIds);
+
+            sai_object_id_t priorityGroupId;
+            std::vector<sai_ingress_priority_group_stat_t> priorityGroupCounterIds;
+        };
+
+        struct AclCounterAttrIds
+        {
+            AclCounterAttrIds(
+                    _In_ sai_object_id_t aclCounter,
+                    _In_ const std::vector<sai_attr_id_t> &aclCounterIds);
+
+            sai_object_id_t aclCounterId;
+            std::vector<sai_attr_id_t> aclCounterAttrIds;
+        };
+
+        /*
+         * Entries are never changed in place, they are replaced, so the
+         * polling thread can keep using its copy of the maps.
+         */
+
+        // Key is a Virtual ID
+        typedef std::map<sai_object_id_t, std::shared_ptr<const PortCounterIds>> PortCounterIdsMap;
+        typedef std::map<sai_object_id_t, std::shared_ptr<const QueueCounterIds>> QueueCounterIdsMap;
+        typedef std::map<sai_object_id_t, std::shared_ptr<const PriorityGroupCounterIds>> PriorityGroupCounterIdsMap;
+        typedef std::map<sai_object_id_t, std::shared_ptr<const AclCounterAttrIds>> AclCounterAttrIdsMap;
+
+        FlexCounter(
+                _In_ const std::string &instanceId);
+        static FlexCounter& getInstance(
+                _In_ const std::string &instanceId);
+        bool isEmpty(void);
+        bool lockSaiApi(
+                _In_ std::unique_lock<std::mutex> &lock);
+        void deleteRemovedCounters(
+                _In_ swss::RedisPipeline &pipeline);
+        void collectCounters(
+                _In_ swss::RedisPipeline &pipeline);
+        void runPlugins(
+                _In_ swss::DBConnector& db);
+        void flexCounterThread(void);
+        void startFlexCounterThread(void);
+        void endFlexCounterThread(void);
+        void checkFlexCounterThread(void);
+
+        PortCounterIdsMap m_portCounterIdsMap;
+        QueueCounterIdsMap m_queueCounterIdsMap;
+        PriorityGroupCounterIdsMap m_priorityGroupCounterIdsMap;
+        AclCounterAttrIdsMap m_aclCounterAttrIdsMap;
+
+        // Plugins
+        std::set<std::string> m_queuePlugins;
+        std::set<std::string> m_portPlugins;
+
+        /*
+         * Objects removed since the last poll, their counters are deleted by
+         * the polling thread so that no poll writes them back.
+         */
+        std::vector<sai_object_id_t> m_removedVids;
+
+        /*
+         * Guards maps, plugins and removed objects, polling thread holds it
+         * only while it copies them, not while counters are read and written.
+         */
+        std::mutex m_mtx;
+
+        std::string m_instanceId;
+        std::atomic<uint32_t> m_pollInterval;
+
+        std::atomic_bool m_runFlexCounterThread = { false };
+        std::shared_ptr<std::thread> m_flexCounterThread = nullptr;
+        std::mutex m_mtxSleep;
+        std::condition_variable m_cvSleep;
+};
+
+#endif
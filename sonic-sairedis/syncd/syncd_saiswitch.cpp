@@ -1,5 +1,6 @@
 #include "syncd.h"
 #include "syncd_saiswitch.h"
+#include "syncd_flex_counter.h"
 #include "sairedis.h"
 
 #include <string>
@@ -545,8 +546,8 @@ std::vector<sai_port_stat_t> SaiSwitch::saiGetSupportedCounters() const
     return supportedCounters;
 }
 
-void SaiSwitch::collectCounters(
-        _In_ swss::Table &countersTable) const
+void SaiSwitch::setPortCounters(
+        _In_ const std::string &instanceId) const
 {
     SWSS_LOG_ENTER();
 
@@ -559,46 +560,27 @@ void SaiSwitch::collectCounters(
         return;
     }
 
-    uint32_t countersSize = (uint32_t)m_supported_counters.size();
-
-    std::vector<uint64_t> counters;
-
-    counters.resize(countersSize);
-
-    auto ports = saiGetPortList();
-
-    for (auto &port_rid: ports)
+    for (auto &port_rid: saiGetPortList())
     {
-        sai_status_t status = sai_metadata_sai_port_api->get_port_stats(
-                port_rid,
-                countersSize,
-                m_supported_counters.data(),
-                counters.data());
-
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            SWSS_LOG_ERROR("failed to collect counters for port RID %s: %s",
-                    sai_serialize_object_id(port_rid).c_str(),
-                    sai_serialize_status(status).c_str());
-            continue;
-        }
-
         sai_object_id_t vid = translate_rid_to_vid(port_rid, m_switch_vid);
 
-        std::string strPortId = sai_serialize_object_id(vid);
-        std::vector<swss::FieldValueTuple> values;
-
-        for (size_t idx = 0; idx < counters.size(); idx++)
-        {
-            const std::string &field = sai_serialize_port_stat(m_supported_counters[idx]);
-            const std::string &value = std::to_string(counters[idx]);
+        FlexCounter::setPortCounterList(vid, port_rid, instanceId, m_supported_counters);
+    }
+}
 
-            swss::FieldValueTuple fvt(field, value);
+void SaiSwitch::removePortCounters(
+        _In_ const std::string &instanceId) const
+{
+    SWSS_LOG_ENTER();
 
-            values.push_back(fvt);
-        }
+    if (m_supported_counters.size() == 0)
+    {
+        return;
+    }
 
-        countersTable.set(strPortId, values, "");
+    for (auto &port_rid: saiGetPortList())
+    {
+        FlexCounter::removeCounter(translate_rid_to_vid(port_rid, m_switch_vid), instanceId);
     }
 }
 
@@ -70,15 +70,23 @@ class SaiSwitch
                 _In_ sai_object_id_t rid) const;
 
         /**
-         * @brief Collect switch counters.
+         * @brief Set port counters.
          *
-         * Collects supported counters from each port and put them to specified
-         * table.
+         * Registers each port with its supported counters in specified flex
+         * counter group, which polls them to COUNTERS table.
          *
-         * @param countersTable Counters table to be used.
+         * @param instanceId Flex counter group to be used.
          */
-        void collectCounters(
-                _In_ swss::Table &countersTable) const;
+        void setPortCounters(
+                _In_ const std::string &instanceId) const;
+
+        /**
+         * @brief Remove port counters.
+         *
+         * @param instanceId Flex counter group ports were registered in.
+         */
+        void removePortCounters(
+                _In_ const std::string &instanceId) const;
 
         /*
          * Redis Static Methods.
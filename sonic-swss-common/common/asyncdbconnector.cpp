@@ -0,0 +1,466 @@
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdexcept>
+#include <system_error>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+
+#include "common/asyncdbconnector.h"
+#include "common/redisreply.h"
+#include "common/logger.h"
+
+using namespace std;
+
+namespace swss {
+
+AsyncDBConnector::AsyncDBConnector(DBConnector *db, int pri) :
+    Selectable(pri),
+    m_db(db->getDB()),
+    m_connectionType(db->getContext()->connection_type),
+    m_port(0),
+    m_ctx(NULL),
+    m_epoll(-1),
+    m_timer(-1),
+    m_reconnectInterval(RECONNECT_MIN_INTERVAL),
+    m_writable(false),
+    m_unsent(0),
+    m_obufPos(0)
+{
+    if (m_connectionType == REDIS_CONN_TCP)
+    {
+        m_host = db->getContext()->tcp.host;
+        m_port = db->getContext()->tcp.port;
+    }
+    else
+    {
+        m_path = db->getContext()->unix_sock.path;
+    }
+
+    m_epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epoll == -1)
+        throw system_error(errno, system_category(), "failed to create epoll file descriptor");
+
+    m_timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (m_timer == -1)
+    {
+        int err = errno;
+        close(m_epoll);
+        throw system_error(err, system_category(), "failed to create timer file descriptor");
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = m_timer;
+
+    if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_timer, &ev) == -1 || !connect())
+    {
+        close(m_timer);
+        close(m_epoll);
+        throw system_error(make_error_code(errc::address_not_available),
+                           "Unable to connect to redis");
+    }
+}
+
+AsyncDBConnector::~AsyncDBConnector()
+{
+    for (auto &completion : m_completions)
+        freeReplyObject(completion.reply);
+
+    if (m_ctx)
+        redisFree(m_ctx);
+
+    close(m_timer);
+    close(m_epoll);
+}
+
+void AsyncDBConnector::command(const RedisCommand &command, Callback callback)
+{
+    enqueue(string(command.c_str(), command.length()), callback);
+}
+
+void AsyncDBConnector::command(const string &command, Callback callback)
+{
+    RedisCommand cmd;
+    cmd.format(command.c_str());
+
+    AsyncDBConnector::command(cmd, callback);
+}
+
+AsyncDBConnector::Callback AsyncDBConnector::logErrors(const string &what)
+{
+    return [what](redisReply *reply)
+    {
+        if (reply == NULL)
+            SWSS_LOG_WARN("%s: connection lost before the reply", what.c_str());
+        else if (reply->type == REDIS_REPLY_ERROR)
+            SWSS_LOG_ERROR("%s: %s", what.c_str(), reply->str);
+    };
+}
+
+void AsyncDBConnector::subscribe(const string &channel, MessageCallback callback)
+{
+    m_subscriptions[make_pair("SUBSCRIBE", channel)] = callback;
+
+    RedisCommand cmd;
+    cmd.format("SUBSCRIBE %s", channel.c_str());
+    enqueue(string(cmd.c_str(), cmd.length()), Callback(), true);
+}
+
+void AsyncDBConnector::psubscribe(const string &pattern, MessageCallback callback)
+{
+    m_subscriptions[make_pair("PSUBSCRIBE", pattern)] = callback;
+
+    RedisCommand cmd;
+    cmd.format("PSUBSCRIBE %s", pattern.c_str());
+    enqueue(string(cmd.c_str(), cmd.length()), Callback(), true);
+}
+
+void AsyncDBConnector::flush()
+{
+    if (m_ctx)
+        write();
+}
+
+void AsyncDBConnector::processReplies()
+{
+    while (!m_completions.empty())
+    {
+        Completion completion = m_completions.front();
+        m_completions.pop_front();
+
+        // Construct an object to use its dtor, so that resource is released
+        RedisReply r(completion.reply);
+
+        if (completion.callback)
+            completion.callback(completion.reply);
+    }
+}
+
+void AsyncDBConnector::addFd(fd_set *fd)
+{
+    FD_SET(m_epoll, fd);
+}
+
+bool AsyncDBConnector::isMe(fd_set *fd)
+{
+    return FD_ISSET(m_epoll, fd);
+}
+
+int AsyncDBConnector::getFd()
+{
+    return m_epoll;
+}
+
+int AsyncDBConnector::readCache()
+{
+    return m_completions.empty() ? Selectable::NODATA : Selectable::DATA;
+}
+
+void AsyncDBConnector::readMe()
+{
+    struct epoll_event events[2];
+
+    int n = epoll_wait(m_epoll, events, 2, 0);
+
+    for (int i = 0; i < n; i++)
+    {
+        if (events[i].data.fd == m_timer)
+        {
+            uint64_t expirations;
+            (void)::read(m_timer, &expirations, sizeof(expirations));
+
+            if (!m_ctx && !connect())
+                armReconnect();
+
+            continue;
+        }
+
+        if (!m_ctx || events[i].data.fd != m_ctx->fd)
+            continue;
+
+        if (events[i].events & EPOLLOUT)
+            write();
+
+        if (m_ctx && (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)))
+            read();
+    }
+}
+
+bool AsyncDBConnector::connect()
+{
+    SWSS_LOG_ENTER();
+
+    redisContext *ctx;
+
+    if (m_connectionType == REDIS_CONN_TCP)
+        ctx = redisConnectNonBlock(m_host.c_str(), m_port);
+    else
+        ctx = redisConnectUnixNonBlock(m_path.c_str());
+
+    if (ctx == NULL)
+        return false;
+
+    if (ctx->err)
+    {
+        SWSS_LOG_ERROR("failed to connect to redis DB %d: %s", m_db, ctx->errstr);
+        redisFree(ctx);
+        return false;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = ctx->fd;
+
+    if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, ctx->fd, &ev) == -1)
+    {
+        SWSS_LOG_ERROR("failed to add redis fd to epoll: %s", strerror(errno));
+        redisFree(ctx);
+        return false;
+    }
+
+    m_ctx = ctx;
+    m_writable = false;
+    m_reconnectInterval = RECONNECT_MIN_INTERVAL;
+
+    /* Restore the session ahead of the commands which are not sent yet */
+    auto check = [this](redisReply *reply)
+    {
+        if (reply && reply->type == REDIS_REPLY_ERROR)
+            SWSS_LOG_ERROR("failed to restore redis DB %d session: %s", m_db, reply->str);
+    };
+
+    deque<Request> requests;
+    RedisCommand select;
+    select.format("SELECT %d", m_db);
+    requests.push_back({ string(select.c_str(), select.length()), check, 0, true });
+
+    for (const auto &subscription : m_subscriptions)
+    {
+        RedisCommand cmd;
+        cmd.format("%s %s", subscription.first.first.c_str(), subscription.first.second.c_str());
+        requests.push_back({ string(cmd.c_str(), cmd.length()), check, 0, true });
+    }
+
+    for (auto &request : m_requests)
+        requests.push_back(move(request));
+
+    m_requests.swap(requests);
+    m_obuf.clear();
+    m_obufPos = 0;
+
+    for (auto &request : m_requests)
+    {
+        m_obuf += request.command;
+        request.end = m_obuf.size();
+    }
+    m_unsent = m_requests.size();
+
+    write();
+
+    return m_ctx != NULL;
+}
+
+void AsyncDBConnector::disconnect()
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_ERROR("lost connection to redis DB %d: %s, reconnecting", m_db, m_ctx->errstr);
+
+    (void)epoll_ctl(m_epoll, EPOLL_CTL_DEL, m_ctx->fd, NULL);
+    redisFree(m_ctx);
+    m_ctx = NULL;
+
+    /* The commands written may have been executed, report them lost */
+    size_t sent = m_requests.size() - m_unsent;
+    for (size_t i = 0; i < sent; i++)
+    {
+        m_completions.push_back({ m_requests.front().callback, NULL });
+        m_requests.pop_front();
+    }
+
+    /* The session is restored on connect */
+    for (auto it = m_requests.begin(); it != m_requests.end();)
+    {
+        if (it->session)
+            it = m_requests.erase(it);
+        else
+            it++;
+    }
+
+    m_unsent = m_requests.size();
+    m_obuf.clear();
+    m_obufPos = 0;
+
+    armReconnect();
+}
+
+void AsyncDBConnector::armReconnect()
+{
+    struct itimerspec spec;
+    memset(&spec, 0, sizeof(spec));
+    spec.it_value.tv_sec = m_reconnectInterval / 1000;
+    spec.it_value.tv_nsec = (m_reconnectInterval % 1000) * 1000000L;
+
+    if (timerfd_settime(m_timer, 0, &spec, NULL) == -1)
+        SWSS_LOG_ERROR("failed to arm redis reconnect timer: %s", strerror(errno));
+
+    m_reconnectInterval *= 2;
+    if (m_reconnectInterval > RECONNECT_MAX_INTERVAL)
+        m_reconnectInterval = RECONNECT_MAX_INTERVAL;
+}
+
+void AsyncDBConnector::enqueue(string command, Callback callback, bool session)
+{
+    if (!session && !m_subscriptions.empty())
+        throw logic_error("only subscriptions are allowed on a subscribed connection");
+
+    m_requests.push_back({ move(command), callback, 0, session });
+    m_unsent++;
+
+    /* Sent on connect */
+    if (!m_ctx)
+        return;
+
+    m_obuf += m_requests.back().command;
+    m_requests.back().end = m_obuf.size();
+
+    updateEvents();
+}
+
+void AsyncDBConnector::write()
+{
+    while (m_obufPos < m_obuf.size())
+    {
+        ssize_t n = ::send(m_ctx->fd, m_obuf.data() + m_obufPos, m_obuf.size() - m_obufPos, MSG_NOSIGNAL);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+
+            snprintf(m_ctx->errstr, sizeof(m_ctx->errstr), "%s", strerror(errno));
+            disconnect();
+            return;
+        }
+
+        m_obufPos += (size_t)n;
+    }
+
+    while (m_unsent > 0 && m_requests[m_requests.size() - m_unsent].end <= m_obufPos)
+        m_unsent--;
+
+    if (m_obufPos == m_obuf.size())
+    {
+        m_obuf.clear();
+        m_obufPos = 0;
+    }
+
+    updateEvents();
+}
+
+void AsyncDBConnector::read()
+{
+    if (redisBufferRead(m_ctx) != REDIS_OK)
+    {
+        disconnect();
+        return;
+    }
+
+    while (true)
+    {
+        redisReply *reply = NULL;
+
+        if (redisGetReplyFromReader(m_ctx, (void**)&reply) != REDIS_OK)
+        {
+            disconnect();
+            return;
+        }
+
+        if (reply == NULL)
+            break;
+
+        if (dispatchMessage(reply))
+            continue;
+
+        if (m_requests.size() == m_unsent)
+        {
+            SWSS_LOG_ERROR("unexpected reply from redis DB %d", m_db);
+            freeReplyObject(reply);
+            continue;
+        }
+
+        m_completions.push_back({ m_requests.front().callback, reply });
+        m_requests.pop_front();
+    }
+}
+
+/* Wait for the socket to be writable only while there is data to write */
+void AsyncDBConnector::updateEvents()
+{
+    bool writable = m_obufPos < m_obuf.size();
+    if (writable == m_writable)
+        return;
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = writable ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+    ev.data.fd = m_ctx->fd;
+
+    if (epoll_ctl(m_epoll, EPOLL_CTL_MOD, m_ctx->fd, &ev) == -1)
+    {
+        SWSS_LOG_ERROR("failed to update redis fd events: %s", strerror(errno));
+        return;
+    }
+
+    m_writable = writable;
+}
+
+/* Queue the published messages, they are not replies to a command */
+bool AsyncDBConnector::dispatchMessage(redisReply *reply)
+{
+    if (m_subscriptions.empty() || reply->type != REDIS_REPLY_ARRAY || reply->elements < 3 ||
+        reply->element[0]->type != REDIS_REPLY_STRING)
+    {
+        return false;
+    }
+
+    string kind = reply->element[0]->str;
+    pair<string, string> subscription;
+    string channel, message;
+
+    if (kind == "message" && reply->elements == 3)
+    {
+        subscription = make_pair("SUBSCRIBE", reply->element[1]->str);
+        channel = reply->element[1]->str;
+        message.assign(reply->element[2]->str, reply->element[2]->len);
+    }
+    else if (kind == "pmessage" && reply->elements == 4)
+    {
+        subscription = make_pair("PSUBSCRIBE", reply->element[1]->str);
+        channel = reply->element[2]->str;
+        message.assign(reply->element[3]->str, reply->element[3]->len);
+    }
+    else
+    {
+        return false;
+    }
+
+    freeReplyObject(reply);
+
+    auto it = m_subscriptions.find(subscription);
+    if (it == m_subscriptions.end())
+        return true;
+
+    MessageCallback callback = it->second;
+    m_completions.push_back({ [callback, channel, message](redisReply *) { callback(channel, message); }, NULL });
+
+    return true;
+}
+
+}
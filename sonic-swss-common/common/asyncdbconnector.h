@@ -0,0 +1,132 @@
+#ifndef __ASYNCDBCONNECTOR__
+#define __ASYNCDBCONNECTOR__
+
+#include <string>
+#include <deque>
+#include <map>
+#include <functional>
+
+#include <hiredis/hiredis.h>
+
+#include "dbconnector.h"
+#include "rediscommand.h"
+#include "selectable.h"
+
+namespace swss {
+
+/*
+ * Non blocking connection to a redis DB, driven by Select.
+ *
+ * Commands are buffered and written together the next time Select returns,
+ * or on flush(), and any number of them can be in flight. Replies are
+ * matched to the commands in order and handed to their callbacks by
+ * processReplies(), which the owner calls when Select returns this object.
+ *
+ * When the connection is lost it is reestablished in the background, the
+ * DB is selected again and the channels are subscribed again. Commands not
+ * yet written are sent on the new connection. Commands written but not
+ * answered may or may not have been executed, their callbacks get a NULL
+ * reply.
+ */
+class AsyncDBConnector : public Selectable
+{
+public:
+    /* The reply is owned by the connector, NULL if the connection was lost */
+    typedef std::function<void(redisReply *reply)> Callback;
+    typedef std::function<void(const std::string &channel, const std::string &message)> MessageCallback;
+
+    /* Delay of the first reconnect attempt, doubled up to the maximum */
+    const static unsigned int RECONNECT_MIN_INTERVAL = 100;
+    const static unsigned int RECONNECT_MAX_INTERVAL = 5000;
+
+    /* Open a new connection to the server and DB of db */
+    AsyncDBConnector(DBConnector *db, int pri = 0);
+    virtual ~AsyncDBConnector();
+
+    /* Queue a command, callback is called with its reply */
+    void command(const RedisCommand &command, Callback callback = Callback());
+    void command(const std::string &command, Callback callback = Callback());
+
+    /*
+     * Subscribe to a channel, or a pattern for psubscribe. Once subscribed
+     * the connection only accepts more subscriptions.
+     */
+    void subscribe(const std::string &channel, MessageCallback callback);
+    void psubscribe(const std::string &pattern, MessageCallback callback);
+
+    /* Write the queued commands now instead of when Select next returns */
+    void flush();
+
+    /* Call the callbacks of the replies received so far */
+    void processReplies();
+
+    bool isConnected() const { return m_ctx != NULL; }
+
+    /* Commands sent or queued and not yet answered */
+    size_t inflight() const { return m_requests.size(); }
+
+    /* Callback which only logs a failed or lost command, what names it */
+    static Callback logErrors(const std::string &what);
+
+    virtual void addFd(fd_set *fd);
+    virtual bool isMe(fd_set *fd);
+    virtual int getFd();
+    virtual int readCache();
+    virtual void readMe();
+
+private:
+    AsyncDBConnector(const AsyncDBConnector &other);
+    AsyncDBConnector& operator = (const AsyncDBConnector &other);
+
+    struct Request
+    {
+        std::string command;
+        Callback callback;
+        size_t end;             /* offset in m_obuf past the command */
+        bool session;           /* SELECT or SUBSCRIBE, issued on connect */
+    };
+
+    struct Completion
+    {
+        Callback callback;
+        redisReply *reply;
+    };
+
+    bool connect();
+    void disconnect();
+    void armReconnect();
+    void enqueue(std::string command, Callback callback, bool session = false);
+    void write();
+    void read();
+    void updateEvents();
+    bool dispatchMessage(redisReply *reply);
+
+    int m_db;
+    int m_connectionType;
+    std::string m_host;
+    int m_port;
+    std::string m_path;
+
+    redisContext *m_ctx;
+
+    /* Select waits on m_epoll, which stays the same across reconnects */
+    int m_epoll;
+    int m_timer;
+    unsigned int m_reconnectInterval;
+    bool m_writable;
+
+    /* Commands waiting for a reply, the last m_unsent are not fully written */
+    std::deque<Request> m_requests;
+    size_t m_unsent;
+    std::string m_obuf;
+    size_t m_obufPos;
+
+    std::deque<Completion> m_completions;
+
+    /* SUBSCRIBE or PSUBSCRIBE command, channel or pattern, callback */
+    std::map<std::pair<std::string, std::string>, MessageCallback> m_subscriptions;
+};
+
+}
+
+#endif // __ASYNCDBCONNECTOR__
@@ -0,0 +1,13 @@
+redis.call('SET', KEYS[3], '1')
+local keys = redis.call('SMEMBERS', KEYS[1])
+local n = table.getn(keys)
+for i = 1, n do
+   local key = keys[i]
+   if redis.call('EXISTS', KEYS[4] .. key) == 0 then
+      local values = redis.call('HGETALL', KEYS[2] .. key)
+      for j = 1, table.getn(values), 2 do
+         redis.call('HSET', KEYS[4] .. key, values[j], values[j + 1])
+      end
+   end
+end
+return n
@@ -0,0 +1,16 @@
+local ret = {}
+local keys = redis.call('SPOP', KEYS[1], ARGV[1])
+local n = table.getn(keys)
+for i = 1, n do
+   local key = keys[i]
+   local deleted = redis.call('SREM', KEYS[3], key)
+   local values
+   if deleted == 1 then
+      values = redis.call('HGETALL', KEYS[2] .. key)
+   else
+      values = redis.call('HGETALL', KEYS[4] .. key)
+   end
+   redis.call('DEL', KEYS[4] .. key)
+   table.insert(ret, {key, deleted, values})
+end
+return ret
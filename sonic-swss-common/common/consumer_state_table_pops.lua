@@ -3,6 +3,8 @@ local keys = redis.call('SPOP', KEYS[1], ARGV[1])
 local n = table.getn(keys)
 for i = 1, n do
    local key = keys[i]
+   redis.call('SREM', KEYS[3], key)
+   redis.call('DEL', KEYS[4] .. key)
    local values = redis.call('HGETALL', KEYS[2] .. key)
    table.insert(ret, {key, values})
 end
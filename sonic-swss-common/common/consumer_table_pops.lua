@@ -25,7 +25,10 @@ for i = n, 1, -1 do
    end
    table.insert(rets, ret)
 
-   if op == 'bulkset' or op == 'bulkcreate' then
+-- ops may be tagged with a request id as op:id
+   local name = op:match('^[^:]*')
+
+   if name == 'bulkset' or name == 'bulkcreate' then
 
 -- key is "OBJECT_TYPE:num", extract object type from key
        key = key:sub(1, string.find(key, ':') - 1)
@@ -48,7 +51,19 @@ for i = n, 1, -1 do
            st = st + 2
        end
 
-   elseif op ~= 'get' and op ~= 'getresponse' and op ~= 'notify' then
+   elseif name == 'bulkremove' then
+
+-- key is "OBJECT_TYPE:num", fields are the object ids to remove
+       key = key:sub(1, string.find(key, ':') - 1)
+
+       local len = #ret
+       local st = 3
+       while st <= len do
+           redis.call('DEL', KEYS[4] .. ':' .. key .. ':' .. ret[st])
+           st = st + 2
+       end
+
+   elseif name ~= 'get' and name ~= 'getresponse' and name ~= 'bulkresponse' and name ~= 'notify' then
        local keyname = KEYS[4] .. ':' .. key
        if key == '' then
            keyname = KEYS[4]
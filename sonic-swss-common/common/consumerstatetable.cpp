@@ -16,6 +16,7 @@ ConsumerStateTable::ConsumerStateTable(DBConnector *db, std::string tableName, i
     , RedisTransactioner(db)
     , TableName_KeySet(tableName)
     , POP_BATCH_SIZE(popBatchSize)
+    , m_deltaMode(false)
 {
     for (;;)
     {
@@ -51,18 +52,56 @@ void ConsumerStateTable::pop(KeyOpFieldsValuesTuple &kco, std::string prefix)
     m_buffer.pop_front();
 }
 
+void ConsumerStateTable::setDeltaMode(bool deltaMode)
+{
+    m_deltaMode = deltaMode;
+
+    if (!m_deltaMode)
+    {
+        return;
+    }
+
+    /*
+     * Producers only record deltas once the table is marked, keys which are
+     * pending from before get their whole hash as delta so nothing is lost.
+     * The mark stays, other consumers of the table may still pop deltas.
+     */
+    static std::string luaScript = loadLuaScript("consumer_state_table_delta_enable.lua");
+
+    static std::string sha = loadRedisScript(m_db, luaScript);
+
+    RedisCommand command;
+    command.format(
+        "EVALSHA %s 4 %s %s: %s %s",
+        sha.c_str(),
+        getKeySetName().c_str(),
+        getTableName().c_str(),
+        getDeltaEnabledName().c_str(),
+        getDeltaKeyPrefix().c_str());
+
+    RedisReply r(m_db, command, REDIS_REPLY_INTEGER);
+}
+
 void ConsumerStateTable::pops(std::deque<KeyOpFieldsValuesTuple> &vkco, std::string /*prefix*/)
 {
+    if (m_deltaMode)
+    {
+        popsDelta(vkco);
+        return;
+    }
+
     static std::string luaScript = loadLuaScript("consumer_state_table_pops.lua");
 
     static std::string sha = loadRedisScript(m_db, luaScript);
 
     RedisCommand command;
     command.format(
-        "EVALSHA %s 2 %s %s: %d ''",
+        "EVALSHA %s 4 %s %s: %s %s %d ''",
         sha.c_str(),
         getKeySetName().c_str(),
         getTableName().c_str(),
+        getDelKeySetName().c_str(),
+        getDeltaKeyPrefix().c_str(),
         POP_BATCH_SIZE);
 
     RedisReply r(m_db, command);
@@ -87,17 +126,17 @@ void ConsumerStateTable::pops(std::deque<KeyOpFieldsValuesTuple> &vkco, std::str
         auto& ctx = ctx0->element[ie];
         assert(ctx->elements == 2);
         assert(ctx->element[0]->type == REDIS_REPLY_STRING);
-        std::string key = ctx->element[0]->str;
-        kfvKey(kco) = key;
+        kfvKey(kco).assign(ctx->element[0]->str, ctx->element[0]->len);
 
         assert(ctx->element[1]->type == REDIS_REPLY_ARRAY);
         auto ctx1 = ctx->element[1];
+        values.reserve(ctx1->elements / 2);
         for (size_t i = 0; i < ctx1->elements / 2; i++)
         {
-            FieldValueTuple e;
-            fvField(e) = ctx1->element[i * 2]->str;
-            fvValue(e) = ctx1->element[i * 2 + 1]->str;
-            values.push_back(e);
+            auto field = ctx1->element[i * 2];
+            auto value = ctx1->element[i * 2 + 1];
+            values.emplace_back(std::string(field->str, field->len),
+                                std::string(value->str, value->len));
         }
 
         // if there is no field-value pair, the key is already deleted
@@ -112,4 +151,65 @@ void ConsumerStateTable::pops(std::deque<KeyOpFieldsValuesTuple> &vkco, std::str
     }
 }
 
+void ConsumerStateTable::popsDelta(std::deque<KeyOpFieldsValuesTuple> &vkco)
+{
+    static std::string luaScript = loadLuaScript("consumer_state_table_delta_pops.lua");
+
+    static std::string sha = loadRedisScript(m_db, luaScript);
+
+    RedisCommand command;
+    command.format(
+        "EVALSHA %s 4 %s %s: %s %s %d ''",
+        sha.c_str(),
+        getKeySetName().c_str(),
+        getTableName().c_str(),
+        getDelKeySetName().c_str(),
+        getDeltaKeyPrefix().c_str(),
+        POP_BATCH_SIZE);
+
+    RedisReply r(m_db, command);
+    auto ctx0 = r.getContext();
+    vkco.clear();
+
+    // if the set is empty, return an empty kco object
+    if (ctx0->type == REDIS_REPLY_NIL)
+    {
+        return;
+    }
+
+    assert(ctx0->type == REDIS_REPLY_ARRAY);
+    size_t n = ctx0->elements;
+    for (size_t ie = 0; ie < n; ie++)
+    {
+        auto& ctx = ctx0->element[ie];
+        assert(ctx->elements == 3);
+        assert(ctx->element[0]->type == REDIS_REPLY_STRING);
+        assert(ctx->element[1]->type == REDIS_REPLY_INTEGER);
+        assert(ctx->element[2]->type == REDIS_REPLY_ARRAY);
+
+        std::string key = ctx->element[0]->str;
+
+        // the key was deleted since it was last popped, emit the tombstone first
+        if (ctx->element[1]->integer)
+        {
+            vkco.emplace_back(key, DEL_COMMAND, std::vector<FieldValueTuple>());
+        }
+
+        // whole hash set after the delete, or fields changed since the last pop
+        auto ctx1 = ctx->element[2];
+        if (ctx1->elements == 0)
+        {
+            continue;
+        }
+
+        vkco.emplace_back(key, SET_COMMAND, std::vector<FieldValueTuple>());
+        auto& values = kfvFieldsValues(vkco.back());
+        values.reserve(ctx1->elements / 2);
+        for (size_t i = 0; i < ctx1->elements / 2; i++)
+        {
+            values.emplace_back(ctx1->element[i * 2]->str, ctx1->element[i * 2 + 1]->str);
+        }
+    }
+}
+
 }
@@ -22,8 +22,22 @@ public:
     /* Get multiple pop elements */
     void pops(std::deque<KeyOpFieldsValuesTuple> &vkco, std::string prefix = EMPTY_PREFIX);
 
+    /*
+     * In delta mode a SET only carries the fields changed since the key was
+     * last popped, and a delete is returned as an explicit DEL tombstone that
+     * may be followed by a SET carrying all fields of the key. Keys set again
+     * with the very same values are not returned at all, so use pops() rather
+     * than pop(). Producers record deltas only once some consumer of the
+     * table enabled delta mode.
+     */
+    void setDeltaMode(bool deltaMode);
+    bool isDeltaMode() const { return m_deltaMode; }
+
 private:
     std::deque<KeyOpFieldsValuesTuple> m_buffer;
+    bool m_deltaMode;
+
+    void popsDelta(std::deque<KeyOpFieldsValuesTuple> &vkco);
 };
 
 }
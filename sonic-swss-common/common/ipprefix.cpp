@@ -55,6 +55,16 @@ IpPrefix::IpPrefix(uint32_t ipPrefix, int mask)
     }
 }
 
+IpPrefix::IpPrefix(const IpAddress &ip, int mask)
+{
+    m_ip = ip;
+    m_mask = mask;
+    if (!isValid())
+    {
+        throw std::invalid_argument("Invalid IpPrefix from address and mask");
+    }
+}
+
 bool IpPrefix::isValid()
 {
     if (m_mask < 0) return false;
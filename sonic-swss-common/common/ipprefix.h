@@ -13,6 +13,7 @@ public:
     IpPrefix() {}
     IpPrefix(const std::string &ipPrefixStr);
     IpPrefix(uint32_t addr, int mask);
+    IpPrefix(const IpAddress &ip, int mask);
 
     inline bool isV4() const
     {
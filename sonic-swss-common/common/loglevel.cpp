@@ -60,7 +60,9 @@ bool validateSaiLoglevel(std::string prioStr)
 
 bool filterOutKeysets(const std::string& key)
 {
-    return key.find("_KEY_SET") != std::string::npos;
+    return key.find("_KEY_SET") != std::string::npos
+        || key.find("_DEL_SET") != std::string::npos
+        || key.find("_DELTA") != std::string::npos;
 }
 
 bool filterOutSaiKeys(const std::string& key)
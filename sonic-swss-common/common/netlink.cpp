@@ -81,6 +81,11 @@ bool NetLink::isMe(fd_set *fd)
     return FD_ISSET(nl_socket_get_fd(m_socket), fd);
 }
 
+int NetLink::getFd()
+{
+    return nl_socket_get_fd(m_socket);
+}
+
 int NetLink::readCache()
 {
     return NODATA;
@@ -17,6 +17,7 @@ public:
 
     virtual void addFd(fd_set *fd);
     virtual bool isMe(fd_set *fd);
+    virtual int getFd();
     virtual int readCache();
     virtual void readMe();
 
@@ -140,6 +140,11 @@ bool swss::NotificationConsumer::isMe(fd_set *fd)
     return FD_ISSET(m_subscribe->getContext()->fd, fd);
 }
 
+int swss::NotificationConsumer::getFd()
+{
+    return m_subscribe->getContext()->fd;
+}
+
 void swss::NotificationConsumer::pop(std::string &op, std::string &data, std::vector<FieldValueTuple> &values)
 {
     SWSS_LOG_ENTER();
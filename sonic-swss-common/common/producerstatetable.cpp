@@ -1,4 +1,5 @@
 #include <stdlib.h>
+#include <stdio.h>
 #include <tuple>
 #include <sstream>
 #include <algorithm>
@@ -12,6 +13,9 @@ using namespace std;
 
 namespace swss {
 
+/* Enough room for the decimal representation of a size_t */
+static const size_t COUNT_ARG_MAX_LEN = 21;
+
 ProducerStateTable::ProducerStateTable(DBConnector *db, string tableName)
     : ProducerStateTable(new RedisPipeline(db, 1), tableName, false)
 {
@@ -25,18 +29,52 @@ ProducerStateTable::ProducerStateTable(RedisPipeline *pipeline, string tableName
     , m_pipeowned(false)
     , m_pipe(pipeline)
 {
+    /*
+     * KEYS: channel, key set, deleted key set, delta enabled key, then the
+     *       table key and the delta key of every entry
+     * ARGV: message, then for every entry: key, number of fields, fields and values
+     *
+     * Only the fields whose value actually changed are written. When the
+     * table has a delta consumer they are also recorded in the delta hash so
+     * it may pop just the changes. One message is published per entry,
+     * consumers count the messages to know how many pops are pending.
+     */
     string luaSet =
-        "redis.call('SADD', KEYS[2], ARGV[2])\n"
-        "for i = 0, #KEYS - 3 do\n"
-        "    redis.call('HSET', KEYS[3 + i], ARGV[3 + i * 2], ARGV[4 + i * 2])\n"
-        "end\n"
-        "redis.call('PUBLISH', KEYS[1], ARGV[1])\n";
+        "local delta = redis.call('EXISTS', KEYS[4]) == 1\n"
+        "local idx = 2\n"
+        "for i = 5, #KEYS, 2 do\n"
+        "    redis.call('SADD', KEYS[2], ARGV[idx])\n"
+        "    local n = tonumber(ARGV[idx + 1])\n"
+        "    for j = 0, n - 1 do\n"
+        "        local field = ARGV[idx + 2 + j * 2]\n"
+        "        local value = ARGV[idx + 3 + j * 2]\n"
+        "        if redis.call('HGET', KEYS[i], field) ~= value then\n"
+        "            redis.call('HSET', KEYS[i], field, value)\n"
+        "            if delta then\n"
+        "                redis.call('HSET', KEYS[i + 1], field, value)\n"
+        "            end\n"
+        "        end\n"
+        "    end\n"
+        "    redis.call('PUBLISH', KEYS[1], ARGV[1])\n"
+        "    idx = idx + 2 + n * 2\n"
+        "end\n";
     m_shaSet = m_pipe->loadRedisScript(luaSet);
 
+    /*
+     * KEYS: channel, key set, deleted key set, delta enabled key, then the
+     *       table key and the delta key of every entry
+     * ARGV: message, then the key of every entry
+     */
     string luaDel =
-        "redis.call('SADD', KEYS[2], ARGV[2])\n"
-        "redis.call('DEL', KEYS[3])\n"
-        "redis.call('PUBLISH', KEYS[1], ARGV[1])\n";
+        "local idx = 2\n"
+        "for i = 5, #KEYS, 2 do\n"
+        "    redis.call('SADD', KEYS[2], ARGV[idx])\n"
+        "    redis.call('SADD', KEYS[3], ARGV[idx])\n"
+        "    redis.call('DEL', KEYS[i])\n"
+        "    redis.call('DEL', KEYS[i + 1])\n"
+        "    redis.call('PUBLISH', KEYS[1], ARGV[1])\n"
+        "    idx = idx + 1\n"
+        "end\n";
     m_shaDel = m_pipe->loadRedisScript(luaDel);
 }
 
@@ -56,64 +94,151 @@ void ProducerStateTable::setBuffered(bool buffered)
 void ProducerStateTable::set(string key, vector<FieldValueTuple> &values,
                  string op /*= SET_COMMAND*/, string prefix)
 {
-    // Assembly redis command args into a string vector
-    vector<string> args;
-    args.push_back("EVALSHA");
-    args.push_back(m_shaSet);
-    args.push_back(to_string(values.size() + 2));
-    args.push_back(getChannelName());
-    args.push_back(getKeySetName());
+    const string channel = getChannelName();
+    const string keySet = getKeySetName();
+    const string delKeySet = getDelKeySetName();
+
+    const string deltaEnabled = getDeltaEnabledName();
+
+    beginArgs(12 + values.size() * 2, keyNamesLength(key) + COUNT_ARG_MAX_LEN);
 
-    args.insert(args.end(), values.size(), getKeyName(key));
+    appendArg("EVALSHA", 7);
+    appendArg(m_shaSet);
+    appendArg("6", 1);
+    appendArg(channel);
+    appendArg(keySet);
+    appendArg(delKeySet);
+    appendArg(deltaEnabled);
+    appendKeyNameArgs(key);
 
-    args.push_back("G");
-    args.push_back(key);
-    for (auto& iv: values)
+    appendArg("G", 1);
+    appendArg(key);
+    appendCountArg(values.size());
+    for (const auto& iv: values)
     {
-        args.push_back(fvField(iv));
-        args.push_back(fvValue(iv));
+        appendArg(fvField(iv));
+        appendArg(fvValue(iv));
     }
 
-    // Transform data structure
-    vector<const char *> args1;
-    transform(args.begin(), args.end(), back_inserter(args1), [](const string s) { return s.c_str(); } );
+    invokeArgs();
+}
 
-    // Invoke redis command
-    RedisCommand command;
-    command.formatArgv((int)args1.size(), &args1[0], NULL);
-    m_pipe->push(command, REDIS_REPLY_NIL);
-    if (!m_buffered)
+void ProducerStateTable::del(string key, string op /*= DEL_COMMAND*/, string prefix)
+{
+    const string channel = getChannelName();
+    const string keySet = getKeySetName();
+    const string delKeySet = getDelKeySetName();
+
+    const string deltaEnabled = getDeltaEnabledName();
+
+    beginArgs(11, keyNamesLength(key));
+
+    appendArg("EVALSHA", 7);
+    appendArg(m_shaDel);
+    appendArg("6", 1);
+    appendArg(channel);
+    appendArg(keySet);
+    appendArg(delKeySet);
+    appendArg(deltaEnabled);
+    appendKeyNameArgs(key);
+    appendArg("G", 1);
+    appendArg(key);
+
+    invokeArgs();
+}
+
+void ProducerStateTable::set(const vector<KeyOpFieldsValuesTuple> &values)
+{
+    if (values.empty())
     {
-        m_pipe->flush();
+        return;
+    }
+
+    const string channel = getChannelName();
+    const string keySet = getKeySetName();
+    const string delKeySet = getDelKeySetName();
+
+    const string deltaEnabled = getDeltaEnabledName();
+
+    size_t argc = 8;
+    size_t arenaSize = COUNT_ARG_MAX_LEN;
+    for (const auto& kfv: values)
+    {
+        argc += 4 + kfvFieldsValues(kfv).size() * 2;
+        arenaSize += keyNamesLength(kfvKey(kfv)) + COUNT_ARG_MAX_LEN;
+    }
+
+    beginArgs(argc, arenaSize);
+
+    appendArg("EVALSHA", 7);
+    appendArg(m_shaSet);
+    appendCountArg(values.size() * 2 + 4);
+    appendArg(channel);
+    appendArg(keySet);
+    appendArg(delKeySet);
+    appendArg(deltaEnabled);
+    for (const auto& kfv: values)
+    {
+        appendKeyNameArgs(kfvKey(kfv));
+    }
+
+    appendArg("G", 1);
+    for (const auto& kfv: values)
+    {
+        const auto& fvs = kfvFieldsValues(kfv);
+
+        appendArg(kfvKey(kfv));
+        appendCountArg(fvs.size());
+        for (const auto& fv: fvs)
+        {
+            appendArg(fvField(fv));
+            appendArg(fvValue(fv));
+        }
     }
+
+    invokeArgs();
 }
 
-void ProducerStateTable::del(string key, string op /*= DEL_COMMAND*/, string prefix)
+void ProducerStateTable::del(const vector<string> &keys)
 {
-    // Assembly redis command args into a string vector
-    vector<string> args;
-    args.push_back("EVALSHA");
-    args.push_back(m_shaDel);
-    args.push_back("3");
-    args.push_back(getChannelName());
-    args.push_back(getKeySetName());
-    args.push_back(getKeyName(key));
-    args.push_back("G");
-    args.push_back(key);
-    args.push_back("''");
-
-    // Transform data structure
-    vector<const char *> args1;
-    transform(args.begin(), args.end(), back_inserter(args1), [](const string s) { return s.c_str(); } );
-
-    // Invoke redis command
-    RedisCommand command;
-    command.formatArgv((int)args1.size(), &args1[0], NULL);
-    m_pipe->push(command, REDIS_REPLY_NIL);
-    if (!m_buffered)
+    if (keys.empty())
     {
-        m_pipe->flush();
+        return;
+    }
+
+    const string channel = getChannelName();
+    const string keySet = getKeySetName();
+    const string delKeySet = getDelKeySetName();
+
+    const string deltaEnabled = getDeltaEnabledName();
+
+    size_t arenaSize = COUNT_ARG_MAX_LEN;
+    for (const auto& key: keys)
+    {
+        arenaSize += keyNamesLength(key);
     }
+
+    beginArgs(8 + keys.size() * 3, arenaSize);
+
+    appendArg("EVALSHA", 7);
+    appendArg(m_shaDel);
+    appendCountArg(keys.size() * 2 + 4);
+    appendArg(channel);
+    appendArg(keySet);
+    appendArg(delKeySet);
+    appendArg(deltaEnabled);
+    for (const auto& key: keys)
+    {
+        appendKeyNameArgs(key);
+    }
+
+    appendArg("G", 1);
+    for (const auto& key: keys)
+    {
+        appendArg(key);
+    }
+
+    invokeArgs();
 }
 
 void ProducerStateTable::flush()
@@ -121,4 +246,85 @@ void ProducerStateTable::flush()
     m_pipe->flush();
 }
 
+size_t ProducerStateTable::keyNamesLength(const string &key)
+{
+    size_t len = getDeltaKeyPrefix().length() + key.length();
+
+    if (key.empty())
+    {
+        return len + getTableName().length();
+    }
+
+    return len + getTableName().length() + getTableNameSeparator().length() + key.length();
+}
+
+void ProducerStateTable::beginArgs(size_t argc, size_t arenaSize)
+{
+    m_argv.clear();
+    m_argvlen.clear();
+    m_argv.reserve(argc);
+    m_argvlen.reserve(argc);
+
+    // The arena must never reallocate while arguments are pointing into it
+    m_arena.clear();
+    m_arena.reserve(arenaSize);
+}
+
+void ProducerStateTable::appendArg(const string &arg)
+{
+    appendArg(arg.data(), arg.length());
+}
+
+void ProducerStateTable::appendArg(const char *arg, size_t len)
+{
+    m_argv.push_back(arg);
+    m_argvlen.push_back(len);
+}
+
+void ProducerStateTable::appendKeyNameArgs(const string &key)
+{
+    size_t offset = m_arena.length();
+
+    m_arena += getTableName();
+    if (!key.empty())
+    {
+        m_arena += getTableNameSeparator();
+        m_arena += key;
+    }
+
+    size_t deltaOffset = m_arena.length();
+
+    m_arena += getDeltaKeyPrefix();
+    m_arena += key;
+
+    assert(m_arena.length() <= m_arena.capacity());
+
+    appendArg(m_arena.data() + offset, deltaOffset - offset);
+    appendArg(m_arena.data() + deltaOffset, m_arena.length() - deltaOffset);
+}
+
+void ProducerStateTable::appendCountArg(size_t count)
+{
+    char buf[COUNT_ARG_MAX_LEN];
+    int len = snprintf(buf, sizeof(buf), "%zu", count);
+    size_t offset = m_arena.length();
+
+    m_arena.append(buf, (size_t)len);
+
+    assert(m_arena.length() <= m_arena.capacity());
+
+    appendArg(m_arena.data() + offset, (size_t)len);
+}
+
+void ProducerStateTable::invokeArgs()
+{
+    RedisCommand command;
+    command.formatArgv((int)m_argv.size(), m_argv.data(), m_argvlen.data());
+    m_pipe->push(command, REDIS_REPLY_NIL);
+    if (!m_buffered)
+    {
+        m_pipe->flush();
+    }
+}
+
 }
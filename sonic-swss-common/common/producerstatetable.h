@@ -24,6 +24,15 @@ public:
                      std::string op = DEL_COMMAND,
                      std::string prefix = EMPTY_PREFIX);
 
+    /*
+     * Batched set() and del(), the whole batch is sent as a single EVALSHA
+     * command. The op of each tuple is ignored, the caller is responsible
+     * to bound the batch size since redis is blocked while the script runs.
+     */
+    void set(const std::vector<KeyOpFieldsValuesTuple> &values);
+
+    void del(const std::vector<std::string> &keys);
+
     void flush();
 
 private:
@@ -32,6 +41,23 @@ private:
     RedisPipeline *m_pipe;
     std::string m_shaSet;
     std::string m_shaDel;
+
+    /*
+     * Scratch storage reused by every command, arguments point directly into
+     * the caller's strings and only table key names and counters are
+     * materialized in the arena.
+     */
+    std::vector<const char *> m_argv;
+    std::vector<size_t> m_argvlen;
+    std::string m_arena;
+
+    size_t keyNamesLength(const std::string &key);
+    void beginArgs(size_t argc, size_t arenaSize);
+    void appendArg(const std::string &arg);
+    void appendArg(const char *arg, size_t len);
+    void appendKeyNameArgs(const std::string &key);
+    void appendCountArg(size_t count);
+    void invokeArgs();
 };
 
 }
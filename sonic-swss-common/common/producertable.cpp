@@ -18,6 +18,12 @@ ProducerTable::ProducerTable(DBConnector *db, string tableName)
     m_pipeowned = true;
 }
 
+static const string luaEnque =
+    "redis.call('LPUSH', KEYS[1], ARGV[1]);"
+    "redis.call('LPUSH', KEYS[2], ARGV[2]);"
+    "redis.call('LPUSH', KEYS[3], ARGV[3]);"
+    "redis.call('PUBLISH', KEYS[4], ARGV[4]);";
+
 ProducerTable::ProducerTable(RedisPipeline *pipeline, string tableName, bool buffered)
     : TableBase(tableName)
     , TableName_KeyValueOpQueues(tableName)
@@ -25,15 +31,20 @@ ProducerTable::ProducerTable(RedisPipeline *pipeline, string tableName, bool buf
     , m_pipeowned(false)
     , m_pipe(pipeline)
 {
-    string luaEnque =
-        "redis.call('LPUSH', KEYS[1], ARGV[1]);"
-        "redis.call('LPUSH', KEYS[2], ARGV[2]);"
-        "redis.call('LPUSH', KEYS[3], ARGV[3]);"
-        "redis.call('PUBLISH', KEYS[4], ARGV[4]);";
-
     m_shaEnque = m_pipe->loadRedisScript(luaEnque);
 }
 
+ProducerTable::ProducerTable(DBConnector *db, AsyncDBConnector *async, string tableName)
+    : TableBase(tableName)
+    , TableName_KeyValueOpQueues(tableName)
+    , m_buffered(false)
+    , m_pipeowned(false)
+    , m_pipe(NULL)
+    , m_async(async)
+{
+    m_shaEnque = loadRedisScript(db, luaEnque);
+}
+
 ProducerTable::ProducerTable(DBConnector *db, string tableName, string dumpFile)
     : ProducerTable(db, tableName)
 {
@@ -74,6 +85,12 @@ void ProducerTable::enqueueDbChange(string key, string value, string op, string
         op.c_str(),
         "G");
 
+    if (m_async)
+    {
+        m_async->command(command, AsyncDBConnector::logErrors("enqueue " + getKeyName(key)));
+        return;
+    }
+
     m_pipe->push(command, REDIS_REPLY_NIL);
 }
 
@@ -99,7 +116,7 @@ void ProducerTable::set(string key, vector<FieldValueTuple> &values, string op,
     // Only buffer continuous "set/set" or "del" operations
     if (!m_buffered || (op != "set" && op != "bulkset" ))
     {
-        m_pipe->flush();
+        flush();
     }
 }
 
@@ -122,12 +139,18 @@ void ProducerTable::del(string key, string op, string prefix)
     enqueueDbChange(key, "{}", "D" + op, prefix);
     if (!m_buffered)
     {
-        m_pipe->flush();
+        flush();
     }
 }
 
 void ProducerTable::flush()
 {
+    if (m_async)
+    {
+        m_async->flush();
+        return;
+    }
+
     m_pipe->flush();
 }
 
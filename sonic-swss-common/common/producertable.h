@@ -11,6 +11,7 @@
 #include "table.h"
 #include "redisselect.h"
 #include "redispipeline.h"
+#include "asyncdbconnector.h"
 
 namespace swss {
 
@@ -20,6 +21,11 @@ public:
     ProducerTable(DBConnector *db, std::string tableName);
     ProducerTable(RedisPipeline *pipeline, std::string tableName, bool buffered = false);
     ProducerTable(DBConnector *db, std::string tableName, std::string dumpFile);
+    /*
+     * Changes are queued on async and do not wait for redis, errors are only
+     * logged. db is used to load the script.
+     */
+    ProducerTable(DBConnector *db, AsyncDBConnector *async, std::string tableName);
     virtual ~ProducerTable();
 
     void setBuffered(bool buffered);
@@ -47,6 +53,7 @@ private:
     bool m_buffered;
     bool m_pipeowned;
     RedisPipeline *m_pipe;
+    AsyncDBConnector *m_async = NULL;
     std::string m_shaEnque;
 
     void enqueueDbChange(std::string key, std::string value, std::string op, std::string prefix);
@@ -0,0 +1,88 @@
+#include <iostream>
+#include <fstream>
+#include <functional>
+#include <unistd.h>
+#include "recorder.h"
+
+using namespace swss;
+
+[[ noreturn ]] void usage(std::string program, int status, std::string message)
+{
+    if (message.size() != 0)
+    {
+        std::cout << message << std::endl << std::endl;
+    }
+
+    std::cout << "Usage: " << program << " [OPTIONS] BINARY_RECORDING" << std::endl
+              << "Convert binary SONiC recording (sairedis.rec.bin, swss.rec.bin) to text recording." << std::endl << std::endl
+              << "Options:" << std::endl
+              << "\t -h\tprint this message" << std::endl
+              << "\t -o\toutput file, default is standard output" << std::endl << std::endl
+              << "Examples:" << std::endl
+              << "\t" << program << " -o sairedis.rec sairedis.rec.bin" << std::endl
+              << "\t" << program << " swss.rec.bin | grep ROUTE_TABLE" << std::endl;
+
+    exit(status);
+}
+
+int main(int argc, char **argv)
+{
+    int opt;
+    std::string output;
+    auto exitWithUsage = std::bind(usage, argv[0], std::placeholders::_1, std::placeholders::_2);
+
+    while ((opt = getopt (argc, argv, "o:h")) != -1)
+    {
+        switch(opt)
+        {
+            case 'o':
+                output = optarg;
+                break;
+            case 'h':
+                exitWithUsage(EXIT_SUCCESS, "");
+                break;
+            default:
+                exitWithUsage(EXIT_FAILURE, "Invalid option");
+        }
+    }
+
+    if (optind + 1 != argc)
+    {
+        exitWithUsage(EXIT_FAILURE, "Exactly one input file is required");
+    }
+
+    std::ifstream in(argv[optind], std::ifstream::in | std::ifstream::binary);
+
+    if (!in.is_open())
+    {
+        std::cerr << "Failed to open " << argv[optind] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    bool converted;
+
+    if (output.empty())
+    {
+        converted = Recorder::convertToText(in, std::cout);
+    }
+    else
+    {
+        std::ofstream out(output, std::ofstream::out | std::ofstream::trunc);
+
+        if (!out.is_open())
+        {
+            std::cerr << "Failed to open " << output << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        converted = Recorder::convertToText(in, out);
+    }
+
+    if (!converted)
+    {
+        std::cerr << "Failed to convert " << argv[optind] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,397 @@
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <chrono>
+#include <iostream>
+
+#include "common/logger.h"
+#include "common/recorder.h"
+
+using namespace std;
+
+namespace swss {
+
+const char Recorder::BINARY_MAGIC[8] = { 'S', 'W', 'S', 'S', 'R', 'E', 'C', '1' };
+
+/* Binary record header, followed by length bytes of line */
+struct BinaryRecordHeader
+{
+    int64_t sec;
+    uint32_t usec;
+    uint32_t length;
+};
+
+Recorder::Recorder(size_t capacity) :
+    m_head(0),
+    m_tail(0),
+    m_open(false),
+    m_running(false),
+    m_rotate(false),
+    m_sleeping(false),
+    m_written(0),
+    m_format(TEXT),
+    m_prefixSec(-1)
+{
+    size_t size = 1;
+
+    while (size < capacity)
+    {
+        size <<= 1;
+    }
+
+    m_ring.resize(size);
+    m_mask = size - 1;
+}
+
+Recorder::~Recorder()
+{
+    close();
+}
+
+bool Recorder::open(const string &file, Format format)
+{
+    close();
+
+    lock_guard<mutex> lock(m_producerMutex);
+
+    m_file = file;
+    m_format = format;
+
+    if (!openFile())
+    {
+        return false;
+    }
+
+    m_rotate = false;
+    m_running = true;
+    m_thread = thread(&Recorder::writerThread, this);
+    m_open = true;
+
+    return true;
+}
+
+void Recorder::close()
+{
+    lock_guard<mutex> lock(m_producerMutex);
+
+    if (!m_open)
+    {
+        return;
+    }
+
+    m_open = false;
+
+    /* Writer thread drains the ring before it exits */
+    m_running = false;
+    wakeWriter();
+    m_thread.join();
+
+    m_ofs.close();
+}
+
+bool Recorder::isOpen() const
+{
+    return m_open;
+}
+
+const string& Recorder::getFile() const
+{
+    return m_file;
+}
+
+Recorder::Format Recorder::getFormat() const
+{
+    return m_format;
+}
+
+void Recorder::record(const string &line)
+{
+    lock_guard<mutex> lock(m_producerMutex);
+
+    if (!m_open)
+    {
+        return;
+    }
+
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+
+    size_t head = m_head.load(memory_order_relaxed);
+
+    while (head - m_tail.load(memory_order_acquire) > m_mask)
+    {
+        wakeWriter();
+        this_thread::yield();
+    }
+
+    Entry &entry = m_ring[head & m_mask];
+
+    entry.tv = tv;
+    entry.line = line;
+
+    m_head.store(head + 1);
+
+    if (m_sleeping.load())
+    {
+        wakeWriter();
+    }
+}
+
+void Recorder::rotate()
+{
+    m_rotate = true;
+}
+
+void Recorder::flush()
+{
+    if (!m_open)
+    {
+        return;
+    }
+
+    size_t head = m_head.load();
+
+    wakeWriter();
+
+    unique_lock<mutex> lock(m_mutex);
+
+    m_cvWritten.wait(lock, [&]{ return m_written.load() >= head || !m_running; });
+}
+
+string Recorder::formatTimestamp(const struct timeval &tv)
+{
+    char buffer[64];
+    struct tm tm;
+
+    size_t size = strftime(buffer, 32, "%Y-%m-%d.%T.", localtime_r(&tv.tv_sec, &tm));
+
+    snprintf(&buffer[size], 32, "%06ld", (long)tv.tv_usec);
+
+    return string(buffer);
+}
+
+bool Recorder::convertToText(istream &in, ostream &out)
+{
+    char magic[sizeof(BINARY_MAGIC)];
+
+    if (!in.read(magic, sizeof(magic)) || memcmp(magic, BINARY_MAGIC, sizeof(magic)) != 0)
+    {
+        SWSS_LOG_ERROR("input is not a binary recording");
+        return false;
+    }
+
+    BinaryRecordHeader header;
+    string line;
+
+    while (in.read((char*)&header, sizeof(header)))
+    {
+        line.resize(header.length);
+
+        if (header.length && !in.read(&line[0], header.length))
+        {
+            SWSS_LOG_ERROR("truncated record at offset %lld", (long long)in.tellg());
+            return false;
+        }
+
+        struct timeval tv;
+
+        tv.tv_sec = (time_t)header.sec;
+        tv.tv_usec = (suseconds_t)header.usec;
+
+        out << formatTimestamp(tv) << "|" << line << "\n";
+    }
+
+    if (in.gcount() != 0)
+    {
+        SWSS_LOG_ERROR("truncated record header at end of input");
+        return false;
+    }
+
+    out.flush();
+
+    return true;
+}
+
+bool Recorder::openFile()
+{
+    bool empty = true;
+
+    struct stat st;
+
+    if (stat(m_file.c_str(), &st) == 0)
+    {
+        empty = st.st_size == 0;
+    }
+
+    auto mode = ofstream::out | ofstream::app;
+
+    if (m_format == BINARY)
+    {
+        mode |= ofstream::binary;
+    }
+
+    m_ofs.open(m_file, mode);
+
+    if (!m_ofs.is_open())
+    {
+        SWSS_LOG_ERROR("failed to open recording file %s: %s", m_file.c_str(), strerror(errno));
+        return false;
+    }
+
+    if (m_format == BINARY && empty)
+    {
+        m_ofs.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    }
+
+    return true;
+}
+
+void Recorder::reopenFile()
+{
+    m_ofs.close();
+
+    /*
+     * On log rotate we will use the same file name, we are assuming that
+     * logrotate deamon move filename to filename.1 and we will create new
+     * empty file here.
+     */
+
+    if (!openFile())
+    {
+        return;
+    }
+
+    Entry entry;
+
+    gettimeofday(&entry.tv, NULL);
+    entry.line = "#|logrotate on: " + m_file;
+
+    writeEntry(entry);
+
+    m_ofs.flush();
+}
+
+void Recorder::writeEntry(const Entry &entry)
+{
+    if (!m_ofs.is_open())
+    {
+        return;
+    }
+
+    if (m_format == BINARY)
+    {
+        BinaryRecordHeader header;
+
+        header.sec = (int64_t)entry.tv.tv_sec;
+        header.usec = (uint32_t)entry.tv.tv_usec;
+        header.length = (uint32_t)entry.line.size();
+
+        m_ofs.write((const char*)&header, sizeof(header));
+        m_ofs.write(entry.line.data(), (streamsize)entry.line.size());
+
+        return;
+    }
+
+    /* Date and time only change once a second, microseconds are formatted here */
+
+    if (entry.tv.tv_sec != m_prefixSec)
+    {
+        char buffer[32];
+        struct tm tm;
+
+        size_t size = strftime(buffer, sizeof(buffer), "%Y-%m-%d.%T.", localtime_r(&entry.tv.tv_sec, &tm));
+
+        m_prefix.assign(buffer, size);
+        m_prefixSec = entry.tv.tv_sec;
+    }
+
+    char usec[8];
+
+    snprintf(usec, sizeof(usec), "%06ld", (long)entry.tv.tv_usec);
+
+    m_ofs << m_prefix << usec << "|" << entry.line << "\n";
+}
+
+void Recorder::wakeWriter()
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    m_cvWork.notify_one();
+}
+
+void Recorder::writerThread()
+{
+    while (true)
+    {
+        /* Records queued after rotate request go to the new file */
+
+        if (m_rotate.exchange(false))
+        {
+            reopenFile();
+        }
+
+        size_t tail = m_tail.load(memory_order_relaxed);
+        size_t head = m_head.load(memory_order_acquire);
+
+        bool idle = tail == head;
+
+        if (!idle)
+        {
+            for (; tail != head; ++tail)
+            {
+                Entry &entry = m_ring[tail & m_mask];
+
+                writeEntry(entry);
+
+                /* Keep capacity so producer can reuse it */
+                entry.line.clear();
+
+                m_tail.store(tail + 1, memory_order_release);
+            }
+
+            /* One flush for the whole batch */
+            m_ofs.flush();
+
+            m_written.store(head);
+
+            lock_guard<mutex> lock(m_mutex);
+
+            m_cvWritten.notify_all();
+        }
+
+        if (!idle)
+        {
+            continue;
+        }
+
+        if (!m_running)
+        {
+            break;
+        }
+
+        /*
+         * Producer checks m_sleeping after publishing head, so either it
+         * sees the flag and notifies, or we see the new head below. Rotate
+         * requested from signal handler can't notify, it is picked up by
+         * the timeout.
+         */
+
+        m_sleeping.store(true);
+
+        {
+            unique_lock<mutex> lock(m_mutex);
+
+            m_cvWork.wait_for(lock, chrono::seconds(1), [this]{
+                    return m_head.load() != m_tail.load(memory_order_relaxed) || !m_running || m_rotate;
+                    });
+        }
+
+        m_sleeping.store(false);
+    }
+
+    lock_guard<mutex> lock(m_mutex);
+
+    m_cvWritten.notify_all();
+}
+
+}
@@ -0,0 +1,123 @@
+#ifndef __RECORDER__
+#define __RECORDER__
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <fstream>
+#include <condition_variable>
+#include <sys/time.h>
+
+namespace swss {
+
+/*
+ * Asynchronous recording file (sairedis.rec, swss.rec, ...).
+ *
+ * Callers only take a timestamp and copy the line into a ring buffer, a
+ * background thread formats timestamps, writes every pending record and
+ * flushes the file once per batch.
+ *
+ * Text format is "YYYY-MM-DD.HH:MM:SS.uuuuuu|line" per line. Binary format is
+ * a file header followed by records of int64 seconds, uint32 microseconds,
+ * uint32 length and the line itself, all in host byte order; convertToText
+ * turns it back into text format.
+ */
+class Recorder
+{
+public:
+    enum Format
+    {
+        TEXT,
+        BINARY
+    };
+
+    static const size_t DEFAULT_CAPACITY = 16384;
+
+    /* Capacity is rounded up to a power of two */
+    Recorder(size_t capacity = DEFAULT_CAPACITY);
+    ~Recorder();
+
+    /* Opens file in append mode and starts writer thread */
+    bool open(const std::string &file, Format format = TEXT);
+
+    /* Writes all pending records, stops writer thread and closes file */
+    void close();
+
+    bool isOpen() const;
+    const std::string& getFile() const;
+    Format getFormat() const;
+
+    /*
+     * Queues line with current timestamp, blocks only when ring is full.
+     * Ignored when recorder is not open.
+     */
+    void record(const std::string &line);
+
+    /*
+     * Requests reopening file with the same name after logrotate moved it.
+     * Only sets a flag, so it can be called from a signal handler.
+     */
+    void rotate();
+
+    /* Blocks until all records queued so far are written to file */
+    void flush();
+
+    static std::string formatTimestamp(const struct timeval &tv);
+
+    /* Converts binary recording to text recording */
+    static bool convertToText(std::istream &in, std::ostream &out);
+
+    static const char BINARY_MAGIC[8];
+
+private:
+    Recorder(const Recorder &other);
+    Recorder& operator = (const Recorder &other);
+
+    struct Entry
+    {
+        struct timeval tv;
+        std::string line;
+    };
+
+    bool openFile();
+    void reopenFile();
+    void writeEntry(const Entry &entry);
+    void writerThread();
+    void wakeWriter();
+
+    std::vector<Entry> m_ring;
+    size_t m_mask;
+
+    /* m_head is advanced by producer, m_tail by writer thread */
+    std::atomic<size_t> m_head;
+    std::atomic<size_t> m_tail;
+
+    /* Serializes producers so ring itself has single producer */
+    std::mutex m_producerMutex;
+
+    std::atomic<bool> m_open;
+    std::atomic<bool> m_running;
+    std::atomic<bool> m_rotate;
+    std::atomic<bool> m_sleeping;
+    std::atomic<size_t> m_written;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cvWork;
+    std::condition_variable m_cvWritten;
+
+    std::thread m_thread;
+
+    std::string m_file;
+    Format m_format;
+    std::ofstream m_ofs;
+
+    /* Formatted "YYYY-MM-DD.HH:MM:SS." for m_prefixSec */
+    time_t m_prefixSec;
+    std::string m_prefix;
+};
+
+}
+
+#endif // __RECORDER__
@@ -80,6 +80,14 @@ int64_t RedisClient::incr(string key)
     return r.getContext()->integer;
 }
 
+int64_t RedisClient::incrby(string key, int64_t increment)
+{
+    RedisCommand sincrby;
+    sincrby.format("INCRBY %s %lld", key.c_str(), (long long)increment);
+    RedisReply r(m_db, sincrby, REDIS_REPLY_INTEGER);
+    return r.getContext()->integer;
+}
+
 int64_t RedisClient::decr(string key)
 {
     RedisCommand sdecr;
@@ -131,6 +139,36 @@ shared_ptr<string> RedisClient::hget(string key, string field)
     throw runtime_error("HGET failed, unexpected reply type, memory exception");
 }
 
+vector<shared_ptr<string>> RedisClient::hmget(string key, vector<string> fields)
+{
+    vector<shared_ptr<string>> values;
+
+    if (fields.empty())
+        return values;
+
+    vector<const char *> args = { "HMGET", key.c_str() };
+    for (const auto &field : fields)
+        args.push_back(field.c_str());
+
+    RedisCommand shmget;
+    shmget.formatArgv((int)args.size(), args.data(), NULL);
+    RedisReply r(m_db, shmget, REDIS_REPLY_ARRAY);
+
+    auto ctx = r.getContext();
+
+    for (size_t i = 0; i < ctx->elements; i++)
+    {
+        auto element = ctx->element[i];
+
+        if (element->type == REDIS_REPLY_NIL)
+            values.push_back(shared_ptr<string>(NULL));
+        else
+            values.push_back(make_shared<string>(element->str, element->len));
+    }
+
+    return values;
+}
+
 int64_t RedisClient::rpush(string list, string item)
 {
     RedisCommand srpush;
@@ -52,6 +52,8 @@ class RedisClient
 
         int64_t incr(std::string key);
 
+        int64_t incrby(std::string key, int64_t increment);
+
         int64_t decr(std::string key);
 
         int64_t rpush(std::string list, std::string item);
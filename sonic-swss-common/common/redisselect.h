@@ -59,6 +59,11 @@ public:
         return FD_ISSET(m_subscribe->getContext()->fd, fd);
     }
 
+    int getFd()
+    {
+        return m_subscribe->getContext()->fd;
+    }
+
     /* Create a new redisContext, SELECT DB and SUBSCRIBE */
     void subscribe(DBConnector* db, std::string channelName)
     {
@@ -10,7 +10,7 @@ namespace swss {
 #define COUNTERS_DB     2
 #define LOGLEVEL_DB     3
 #define CONFIG_DB       4
-#define PFC_WD_DB       5
+#define FLEX_COUNTER_DB 5
 #define STATE_DB        6
 
 /***** APPLICATION DATABASE *****/
@@ -55,18 +55,27 @@ namespace swss {
 #define COUNTERS_QUEUE_NAME_MAP         "COUNTERS_QUEUE_NAME_MAP"
 #define COUNTERS_QUEUE_PORT_MAP         "COUNTERS_QUEUE_PORT_MAP"
 #define COUNTERS_QUEUE_INDEX_MAP        "COUNTERS_QUEUE_INDEX_MAP"
+#define COUNTERS_ACL_COUNTER_RULE_MAP   "COUNTERS_ACL_COUNTER_RULE_MAP"
+#define COUNTERS_ORCH_STATS_TABLE       "COUNTERS_ORCH_STATS"
+#define COUNTERS_FPMSYNCD_STATS_TABLE   "COUNTERS_FPMSYNCD_STATS"
 
 #define DAEMON_TABLE_NAME "DAEMON_TABLE"
 #define DAEMON_LOGLEVEL "LOGLEVEL"
 
-/***** PFC WATCHDOG DATABASE *****/
+/***** FLEX COUNTER DATABASE *****/
 
-#define PFC_WD_STATE_TABLE "PFC_WD_STATE_TABLE"
-#define PFC_WD_PORT_COUNTER_ID_LIST "PORT_COUNTER_ID_LIST"
-#define PFC_WD_QUEUE_COUNTER_ID_LIST "QUEUE_COUNTER_ID_LIST"
-#define PFC_WD_QUEUE_ATTR_ID_LIST "QUEUE_ATTR_ID_LIST" 
-#define PLUGIN_TABLE "PLUGIN_TABLE"
-#define SAI_OBJECT_TYPE "SAI_OBJECT_TYPE"
+/* Keys are <group>:<object vid> */
+#define FLEX_COUNTER_TABLE              "FLEX_COUNTER_TABLE"
+#define PORT_COUNTER_ID_LIST            "PORT_COUNTER_ID_LIST"
+#define QUEUE_COUNTER_ID_LIST           "QUEUE_COUNTER_ID_LIST"
+#define PG_COUNTER_ID_LIST              "PG_COUNTER_ID_LIST"
+#define ACL_COUNTER_ATTR_ID_LIST        "ACL_COUNTER_ATTR_ID_LIST"
+
+/* Keys are <group> */
+#define FLEX_COUNTER_GROUP_TABLE        "FLEX_COUNTER_GROUP_TABLE"
+#define POLL_INTERVAL_FIELD             "POLL_INTERVAL"
+#define PORT_PLUGIN_FIELD               "PORT_PLUGIN_LIST"
+#define QUEUE_PLUGIN_FIELD              "QUEUE_PLUGIN_LIST"
 
 /***** STATE DATABASE *****/
 
@@ -3,26 +3,83 @@
 #include "common/select.h"
 #include <algorithm>
 #include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdexcept>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <sys/epoll.h>
 
 using namespace std;
 
 namespace swss {
 
+Select::Select() :
+    m_events(1),
+    m_round(0)
+{
+    m_epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (m_epoll_fd == -1)
+    {
+        SWSS_LOG_ERROR("failed to create epoll file descriptor, errno: %s", strerror(errno));
+
+        throw std::runtime_error("failed to create epoll file descriptor");
+    }
+}
+
+Select::~Select()
+{
+    (void)::close(m_epoll_fd);
+}
+
 void Select::addSelectable(Selectable *selectable)
 {
-    if(find(m_objects.begin(), m_objects.end(), selectable) != m_objects.end())
+    if (m_objectFds.find(selectable) != m_objectFds.end())
     {
         SWSS_LOG_WARN("Selectable is already added to the list, ignoring.");
         return;
     }
-    m_objects.push_back(selectable);
+
+    int fd = selectable->getFd();
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+
+    if (::epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &ev) == -1)
+    {
+        SWSS_LOG_ERROR("failed to add fd %d to epoll, errno: %s", fd, strerror(errno));
+
+        throw std::runtime_error("failed to add fd to epoll");
+    }
+
+    m_objects[fd] = selectable;
+    m_objectFds[selectable] = fd;
+    m_events.resize(m_objects.size() + m_fds.size());
+
+    /* The object may have been created with data already pending */
+    m_cached.insert(selectable);
 }
 
 void Select::removeSelectable(Selectable *c)
 {
-    m_objects.erase(remove(m_objects.begin(), m_objects.end(), c), m_objects.end());
+    auto it = m_objectFds.find(c);
+    if (it == m_objectFds.end())
+    {
+        return;
+    }
+
+    int fd = it->second;
+
+    /* The fd may already be closed by the owner, nothing to do in that case */
+    (void)::epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+
+    m_objects.erase(fd);
+    m_objectFds.erase(it);
+    m_cached.erase(c);
+    m_ready.erase(c);
 }
 
 void Select::addSelectables(vector<Selectable *> selectables)
@@ -35,75 +92,163 @@ void Select::addSelectables(vector<Selectable *> selectables)
 
 void Select::addFd(int fd)
 {
-    m_fds.push_back(fd);
+    if (m_fds.find(fd) != m_fds.end())
+    {
+        return;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+
+    if (::epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &ev) == -1)
+    {
+        SWSS_LOG_ERROR("failed to add fd %d to epoll, errno: %s", fd, strerror(errno));
+
+        throw std::runtime_error("failed to add fd to epoll");
+    }
+
+    m_fds.insert(fd);
+    m_events.resize(m_objects.size() + m_fds.size());
 }
 
-int Select::select(Selectable **c, int *fd, unsigned int timeout)
+int Select::poll(unsigned int timeout)
 {
     SWSS_LOG_ENTER();
 
-    struct timeval t = {0, (suseconds_t)(timeout)*1000};
-    struct timeval *pTimeout = NULL;
-    fd_set fs;
-    int err;
-
-    FD_ZERO(&fs);
-    *c = NULL;
-    *fd = 0;
-    if (timeout != numeric_limits<unsigned int>::max())
-        pTimeout = &t;
-
-    /* Checking caching from reader */
-    for (Selectable *i : m_objects)
+    /* Checking caching from reader, only objects which were read from can have one */
+    for (auto it = m_cached.begin(); it != m_cached.end(); )
     {
-        err = i->readCache();
+        Selectable *i = *it;
+        int err = i->readCache();
 
         if (err == Selectable::ERROR)
             return Select::ERROR;
-        else if (err == Selectable::DATA) {
-            *c = i;
-            return Select::OBJECT;
+        else if (err == Selectable::DATA)
+        {
+            m_ready.insert(i);
+            it++;
+        }
+        else
+        {
+            /* else, timeout = no data */
+            it = m_cached.erase(it);
         }
-        /* else, timeout = no data */
-
-        i->addFd(&fs);
     }
 
-    for (int fdn : m_fds)
-    {
-        FD_SET(fdn, &fs);
-    }
+    /* Don't block if there is cached data, but still collect ready sockets */
+    int ms_timeout;
+    if (!m_ready.empty())
+        ms_timeout = 0;
+    else if (timeout > (unsigned int)numeric_limits<int>::max())
+        ms_timeout = -1;
+    else
+        ms_timeout = (int)timeout;
 
+    int ret;
     do
     {
-        err = ::select(FD_SETSIZE, &fs, NULL, NULL, pTimeout);
+        ret = ::epoll_wait(m_epoll_fd, m_events.data(), (int)m_events.size(), ms_timeout);
     }
-    while(err == -1 && errno == EINTR); // Retry the select if the process was interrupted by a signal
+    while(ret == -1 && errno == EINTR); // Retry the select if the process was interrupted by a signal
 
-    if (err < 0)
+    if (ret < 0)
         return Select::ERROR;
-    if (err == 0)
-        return Select::TIMEOUT;
 
-    /* Check other consumer-table */
-    for (Selectable *i : m_objects)
-        if (i->isMe(&fs))
-        {
-            i->readMe();
-            *c = i;
-            return Select::OBJECT;
-        }
+    for (int n = 0; n < ret; n++)
+    {
+        int fd = m_events[n].data.fd;
 
-    /* Check other FDs */
-    for (int f : m_fds)
-        if (FD_ISSET(f, &fs))
+        auto it = m_objects.find(fd);
+        if (it == m_objects.end())
         {
-            *fd = f;
-            return Select::FD;
+            if (m_fds.find(fd) != m_fds.end())
+                m_readyFds.push_back(fd);
+            continue;
         }
 
-    /* Shouldn't reach here */
-    return Select::ERROR;
+        /* Cached data is returned first, the socket will still be ready next time */
+        Selectable *i = it->second;
+        if (m_ready.find(i) != m_ready.end())
+            continue;
+
+        i->readMe();
+        m_ready.insert(i);
+    }
+
+    if (m_ready.empty() && m_readyFds.empty())
+        return Select::TIMEOUT;
+
+    return Select::OBJECT;
+}
+
+void Select::served(Selectable *selectable)
+{
+    selectable->m_lastServed = ++m_round;
+
+    /* Reading from the socket may have buffered more messages */
+    m_cached.insert(selectable);
+}
+
+int Select::select(Selectable **c, int *fd, unsigned int timeout)
+{
+    SWSS_LOG_ENTER();
+
+    *c = NULL;
+    *fd = 0;
+
+    if (m_ready.empty() && m_readyFds.empty())
+    {
+        int ret = poll(timeout);
+        if (ret != Select::OBJECT)
+            return ret;
+    }
+
+    if (!m_ready.empty())
+    {
+        Selectable *i = *m_ready.begin();
+        m_ready.erase(m_ready.begin());
+        served(i);
+
+        *c = i;
+        return Select::OBJECT;
+    }
+
+    *fd = m_readyFds.front();
+    m_readyFds.erase(m_readyFds.begin());
+    return Select::FD;
+}
+
+int Select::select(vector<Selectable *> &selectables, vector<int> &fds, unsigned int timeout)
+{
+    SWSS_LOG_ENTER();
+
+    selectables.clear();
+    fds.clear();
+
+    if (m_ready.empty() && m_readyFds.empty())
+    {
+        int ret = poll(timeout);
+        if (ret != Select::OBJECT)
+            return ret;
+    }
+
+    for (Selectable *i : m_ready)
+    {
+        selectables.push_back(i);
+    }
+    m_ready.clear();
+
+    /* Update the order only once the set is emptied */
+    for (Selectable *i : selectables)
+    {
+        served(i);
+    }
+
+    fds.swap(m_readyFds);
+
+    return selectables.empty() ? Select::FD : Select::OBJECT;
 }
 
 };
@@ -3,8 +3,11 @@
 
 #include <string>
 #include <vector>
+#include <set>
+#include <unordered_map>
 #include <limits>
 #include <hiredis/hiredis.h>
+#include <sys/epoll.h>
 #include "selectable.h"
 
 namespace swss {
@@ -12,6 +15,9 @@ namespace swss {
 class Select
 {
 public:
+    Select();
+    ~Select();
+
     /* Add object for select */
     void addSelectable(Selectable *selectable);
     void removeSelectable(Selectable *selectable);
@@ -23,6 +29,11 @@ public:
     /*
      * Wait until data will arrived, returns the object on which select()
      * was signaled.
+     *
+     * When several objects are ready at once they are returned by the
+     * following calls without waiting again, highest priority first and in
+     * round robin order among objects of the same priority, so a busy object
+     * cannot starve the ones registered after it.
      */
     enum {
         OBJECT = 0,
@@ -32,9 +43,47 @@ public:
     };
     int select(Selectable **c, int *fd, unsigned int timeout = std::numeric_limits<unsigned int>::max());
 
+    /*
+     * Same as above but returns every ready object and file descriptor at
+     * once, objects are ordered the same way. Returns OBJECT if at least one
+     * object is ready, FD if only file descriptors are.
+     */
+    int select(std::vector<Selectable *> &selectables, std::vector<int> &fds,
+               unsigned int timeout = std::numeric_limits<unsigned int>::max());
+
 private:
-    std::vector<Selectable * > m_objects;
-    std::vector<int> m_fds;
+    struct ServeOrder
+    {
+        bool operator()(const Selectable *a, const Selectable *b) const
+        {
+            if (a->m_priority != b->m_priority)
+                return a->m_priority > b->m_priority;
+            if (a->m_lastServed != b->m_lastServed)
+                return a->m_lastServed < b->m_lastServed;
+            return a < b;
+        }
+    };
+
+    Select(const Select &other);
+    Select& operator = (const Select &other);
+
+    int poll(unsigned int timeout);
+    void served(Selectable *selectable);
+
+    int m_epoll_fd;
+    std::unordered_map<int, Selectable *> m_objects;
+    std::unordered_map<Selectable *, int> m_objectFds;
+    std::set<int> m_fds;
+    std::vector<struct epoll_event> m_events;
+
+    /* Objects which may hold data read ahead from their socket */
+    std::set<Selectable *> m_cached;
+
+    /* Ready objects and file descriptors not returned yet */
+    std::set<Selectable *, ServeOrder> m_ready;
+    std::vector<int> m_readyFds;
+
+    uint64_t m_round;
 };
 
 }
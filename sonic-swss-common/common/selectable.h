@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include <limits>
+#include <stdint.h>
 #include <hiredis/hiredis.h>
 
 namespace swss {
@@ -11,6 +12,9 @@ namespace swss {
 class Selectable
 {
 public:
+    /* Higher priority objects are served first when several are ready */
+    Selectable(int pri = 0) : m_priority(pri), m_lastServed(0) {}
+
     virtual ~Selectable() {};
 
     enum {
@@ -23,11 +27,24 @@ public:
     virtual void addFd(fd_set *fd) = 0;
     virtual bool isMe(fd_set *fd) = 0;
 
+    /* Return the file descriptor to wait on */
+    virtual int getFd() = 0;
+
     /* Read and empty socket caching (if exists) */
     virtual int readCache() = 0;
 
     /* Read a message from the socket */
     virtual void readMe() = 0;
+
+    int getPri() const { return m_priority; }
+    void setPri(int pri) { m_priority = pri; }
+
+private:
+    friend class Select;
+
+    int m_priority;
+    /* Round at which Select last returned this object, for round robin */
+    uint64_t m_lastServed;
 };
 
 }
@@ -69,6 +69,11 @@ bool SelectableEvent::isMe(fd_set *fd)
     return FD_ISSET(m_efd, fd);
 }
 
+int SelectableEvent::getFd()
+{
+    return m_efd;
+}
+
 void SelectableEvent::notify()
 {
     SWSS_LOG_ENTER();
@@ -1,7 +1,9 @@
 #include <hiredis/hiredis.h>
 #include <system_error>
+#include <unordered_set>
 
 #include "common/table.h"
+#include "common/asyncdbconnector.h"
 #include "common/logger.h"
 #include "common/redisreply.h"
 #include "common/rediscommand.h"
@@ -13,7 +15,12 @@ using namespace swss;
 using json = nlohmann::json;
 
 Table::Table(DBConnector *db, string tableName, string tableSeparator)
-    : RedisTransactioner(db), TableBase(tableName, tableSeparator)
+    : Table(db, NULL, tableName, tableSeparator)
+{
+}
+
+Table::Table(DBConnector *db, AsyncDBConnector *async, string tableName, string tableSeparator)
+    : RedisTransactioner(db), TableBase(tableName, tableSeparator), m_async(async)
 {
 }
 
@@ -49,6 +56,12 @@ void Table::set(string key, vector<FieldValueTuple> &values,
     RedisCommand cmd;
     cmd.formatHMSET(getKeyName(key), values);
 
+    if (m_async)
+    {
+        m_async->command(cmd, AsyncDBConnector::logErrors("HMSET " + getKeyName(key)));
+        return;
+    }
+
     RedisReply r(m_db, cmd, REDIS_REPLY_STATUS);
 
     r.checkStatusOK();
@@ -56,39 +69,130 @@ void Table::set(string key, vector<FieldValueTuple> &values,
 
 void Table::del(string key, string /* op */, string /*prefix*/)
 {
+    if (m_async)
+    {
+        RedisCommand cmd;
+        cmd.format("DEL %s", getKeyName(key).c_str());
+        m_async->command(cmd, AsyncDBConnector::logErrors("DEL " + getKeyName(key)));
+        return;
+    }
+
     RedisReply r(m_db, string("DEL ") + getKeyName(key), REDIS_REPLY_INTEGER);
 }
 
 void TableEntryEnumerable::getTableContent(vector<KeyOpFieldsValuesTuple> &tuples)
+{
+    tuples.clear();
+
+    getTableContent([&tuples](const string &key, vector<FieldValueTuple> &values)
+    {
+        tuples.emplace_back(key, "", move(values));
+    });
+}
+
+void TableEntryEnumerable::getTableContent(EntryCallback callback)
 {
     vector<string> keys;
     getTableKeys(keys);
 
-    tuples.clear();
-
-    for (auto key: keys)
+    for (const auto &key: keys)
     {
         vector<FieldValueTuple> values;
-        string op = "";
 
         get(key, values);
-        tuples.push_back(make_tuple(key, op, values));
+        callback(key, values);
+    }
+}
+
+void Table::scan(function<void(vector<string> &keys)> callback)
+{
+    string prefix = getTableName() + getTableNameSeparator();
+    string cursor = "0";
+
+    /* SCAN may return a key more than once */
+    unordered_set<string> seen;
+
+    do
+    {
+        RedisCommand scan;
+        scan.format("SCAN %s MATCH %s* COUNT %d",
+                cursor.c_str(), prefix.c_str(), DEFAULT_SCAN_BATCH_SIZE);
+
+        RedisReply r(m_db, scan, REDIS_REPLY_ARRAY);
+        redisReply *batch = r.getChild(1);
+        cursor = r.getChild(0)->str;
+
+        vector<string> keys;
+        keys.reserve(batch->elements);
+
+        for (size_t i = 0; i < batch->elements; i++)
+        {
+            redisReply *key = batch->element[i];
+            if (seen.emplace(key->str + prefix.length(), key->len - prefix.length()).second)
+                keys.emplace_back(key->str + prefix.length(), key->len - prefix.length());
+        }
+
+        if (!keys.empty())
+            callback(keys);
     }
+    while (cursor != "0");
 }
 
 void Table::getTableKeys(vector<string> &keys)
 {
-    string keys_cmd("KEYS " + getTableName() + getTableNameSeparator() + "*");
-    RedisReply r(m_db, keys_cmd, REDIS_REPLY_ARRAY);
-    redisReply *reply = r.getContext();
     keys.clear();
 
-    for (unsigned int i = 0; i < reply->elements; i++)
+    scan([&keys](vector<string> &batch)
     {
-        string key = reply->element[i]->str;
-        auto pos = key.find(getTableNameSeparator());
-        keys.push_back(key.substr(pos+1));
-    }
+        keys.insert(keys.end(), make_move_iterator(batch.begin()), make_move_iterator(batch.end()));
+    });
+}
+
+void Table::getTableContent(EntryCallback callback)
+{
+    scan([this, &callback](vector<string> &keys)
+    {
+        redisContext *ctx = m_db->getContext();
+
+        for (const auto &key: keys)
+        {
+            RedisCommand hgetall;
+            hgetall.format("HGETALL %s", getKeyName(key).c_str());
+            redisAppendFormattedCommand(ctx, hgetall.c_str(), hgetall.length());
+        }
+
+        /* Take all the replies before checking them, not to leave any behind */
+        deque<RedisReply> replies;
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            redisReply *reply = NULL;
+            if (redisGetReply(ctx, (void**)&reply) != REDIS_OK)
+                throw system_error(make_error_code(errc::io_error), ctx->errstr);
+
+            replies.emplace_back(reply);
+        }
+
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            replies[i].checkReplyType(REDIS_REPLY_ARRAY);
+            redisReply *reply = replies[i].getContext();
+
+            /* Deleted since it was scanned */
+            if (reply->elements == 0)
+                continue;
+
+            vector<FieldValueTuple> values;
+            values.reserve(reply->elements / 2);
+
+            for (size_t j = 0; j + 1 < reply->elements; j += 2)
+            {
+                values.emplace_back(string(reply->element[j]->str, reply->element[j]->len),
+                                    string(reply->element[j + 1]->str, reply->element[j + 1]->len));
+            }
+
+            callback(keys[i], values);
+        }
+    });
 }
 
 void Table::dump(TableDump& tableDump)
@@ -99,6 +203,9 @@ void Table::dump(TableDump& tableDump)
     // it can take ~100ms for entire asic dump
     // but it's not intended to be efficient
     // since it will not be used many times
+    //
+    // each script call dumps one SCAN batch only, so that
+    // the DB keeps serving other clients during the dump
 
     static std::string luaScript = loadLuaScript("table_dump.lua");
 
@@ -106,39 +213,48 @@ void Table::dump(TableDump& tableDump)
 
     SWSS_LOG_TIMER("getting");
 
-    RedisCommand command;
-    command.format("EVALSHA %s 1 %s ''",
-            sha.c_str(),
-            getTableName().c_str());
+    size_t tableNameLen = getTableName().length() + getTableNameSeparator().length();
 
-    RedisReply r(m_db, command, REDIS_REPLY_STRING);
+    std::string cursor = "0";
 
-    auto ctx = r.getContext();
-
-    std::string data = ctx->str;
+    do
+    {
+        RedisCommand command;
+        command.format("EVALSHA %s 1 %s %s %s %d",
+                sha.c_str(),
+                getTableName().c_str(),
+                cursor.c_str(),
+                getTableNameSeparator().c_str(),
+                DEFAULT_SCAN_BATCH_SIZE);
 
-    json j = json::parse(data);
+        RedisReply r(m_db, command, REDIS_REPLY_ARRAY);
 
-    size_t tableNameLen = getTableName().length() + 1; // + ":"
+        cursor = r.getChild(0)->str;
 
-    for (json::iterator it = j.begin(); it != j.end(); ++it)
-    {
-        TableMap map;
+        std::string data = r.getChild(1)->str;
 
-        json jj = it.value();
+        json j = json::parse(data);
 
-        for (json::iterator itt = jj.begin(); itt != jj.end(); ++itt)
+        for (json::iterator it = j.begin(); it != j.end(); ++it)
         {
-            if (itt.key() == "NULL")
+            TableMap map;
+
+            json jj = it.value();
+
+            for (json::iterator itt = jj.begin(); itt != jj.end(); ++itt)
             {
-                continue;
-            }
+                if (itt.key() == "NULL")
+                {
+                    continue;
+                }
 
-            map[itt.key()] = itt.value();
-        }
+                map[itt.key()] = itt.value();
+            }
 
-        std::string key = it.key().substr(tableNameLen);
+            std::string key = it.key().substr(tableNameLen);
 
-        tableDump[key] = map;
+            tableDump[key] = map;
+        }
     }
+    while (cursor != "0");
 }
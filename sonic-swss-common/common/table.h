@@ -7,6 +7,7 @@
 #include <tuple>
 #include <map>
 #include <deque>
+#include <functional>
 #include "hiredis/hiredis.h"
 #include "dbconnector.h"
 #include "redisreply.h"
@@ -19,6 +20,8 @@ namespace swss {
 #define DEFAULT_TABLE_NAME_SEPARATOR    ":"
 #define CONFIGDB_TABLE_NAME_SEPARATOR   "|"
 
+class AsyncDBConnector;
+
 typedef std::tuple<std::string, std::string> FieldValueTuple;
 #define fvField std::get<0>
 #define fvValue std::get<1>
@@ -98,6 +101,9 @@ public:
 
 class TableEntryEnumerable {
 public:
+    /* Called with each entry of the table, the values may be moved from */
+    typedef std::function<void(const std::string &key, std::vector<FieldValueTuple> &values)> EntryCallback;
+
     virtual ~TableEntryEnumerable() { }
 
     /* Get all the field-value tuple of the table entry with the key */
@@ -109,11 +115,19 @@ public:
     /* Read the whole table content from the DB directly */
     /* NOTE: Not an atomic function */
     void getTableContent(std::vector<KeyOpFieldsValuesTuple> &tuples);
+
+    /* Same as above, without holding the whole table in memory */
+    virtual void getTableContent(EntryCallback callback);
 };
 
 class Table : public RedisTransactioner, public TableBase, public TableEntryEnumerable {
 public:
     Table(DBConnector *db, std::string tableName, std::string tableSeparator = DEFAULT_TABLE_NAME_SEPARATOR);
+    /*
+     * set() and del() are queued on async and do not wait for redis, errors
+     * are only logged. Reads still go through db.
+     */
+    Table(DBConnector *db, AsyncDBConnector *async, std::string tableName, std::string tableSeparator = DEFAULT_TABLE_NAME_SEPARATOR);
     virtual ~Table() { }
 
     /* Set an entry in the DB directly (op not in use) */
@@ -130,9 +144,25 @@ public:
     /* Returns false if the key doesn't exists */
     virtual bool get(std::string key, std::vector<FieldValueTuple> &values);
 
+    /*
+     * The keys are iterated with SCAN, a batch at a time, so that other
+     * clients of the DB are served in between. COUNT hint of each SCAN.
+     */
+    static constexpr int DEFAULT_SCAN_BATCH_SIZE = 1000;
+
     void getTableKeys(std::vector<std::string> &keys);
 
+    /* The entries of each batch of keys are read with pipelined HGETALLs */
+    using TableEntryEnumerable::getTableContent;
+    void getTableContent(EntryCallback callback);
+
     void dump(TableDump &tableDump);
+
+private:
+    AsyncDBConnector *m_async;
+
+    /* Call callback with each batch of keys in the table */
+    void scan(std::function<void(std::vector<std::string> &keys)> callback);
 };
 
 class TableName_KeyValueOpQueues {
@@ -156,13 +186,28 @@ public:
 class TableName_KeySet {
 private:
     std::string m_key;
+    std::string m_delKey;
+    std::string m_deltaPrefix;
+    std::string m_deltaEnabled;
 public:
     TableName_KeySet(std::string tableName)
         : m_key(tableName + "_KEY_SET")
+        , m_delKey(tableName + "_DEL_SET")
+        , m_deltaPrefix(tableName + "_DELTA" + DEFAULT_TABLE_NAME_SEPARATOR)
+        , m_deltaEnabled(tableName + "_DELTA_ENABLED")
     {
     }
 
     std::string getKeySetName() const { return m_key; }
+
+    /* Keys deleted since they were last popped */
+    std::string getDelKeySetName() const { return m_delKey; }
+
+    /* Fields changed since the key was last popped are kept in a hash named prefix + key */
+    std::string getDeltaKeyPrefix() const { return m_deltaPrefix; }
+
+    /* Exists once a consumer pops deltas, producers only record them then */
+    std::string getDeltaEnabledName() const { return m_deltaEnabled; }
 };
 
 }
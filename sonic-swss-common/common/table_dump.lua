@@ -1,17 +1,19 @@
-local keys = redis.call("keys", KEYS[1] .. ":*")
+-- KEYS[1]: table name, ARGV[1]: SCAN cursor, ARGV[2]: table name separator, ARGV[3]: SCAN count
+-- Returns the next cursor and the entries of the scanned keys
+local scan = redis.call("SCAN", ARGV[1], "MATCH", KEYS[1] .. ARGV[2] .. "*", "COUNT", ARGV[3])
 local res = {}
 
-for i,k in pairs(keys) do
+for i,k in pairs(scan[2]) do
 
-   local skeys = redis.call("HKEYS", k)
+   local fvs = redis.call("HGETALL", k)
    local sres={}
 
-   for j,sk in pairs(skeys) do
-       sres[sk] = redis.call("HGET", k, sk)
+   for j = 1, #fvs, 2 do
+       sres[fvs[j]] = fvs[j + 1]
    end
 
    res[k] = sres
 
 end
 
-return cjson.encode(res)
+return { scan[1], cjson.encode(res) }
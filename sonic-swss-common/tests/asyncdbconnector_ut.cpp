@@ -0,0 +1,146 @@
+#include <string>
+#include <vector>
+#include <chrono>
+#include "gtest/gtest.h"
+#include "common/dbconnector.h"
+#include "common/asyncdbconnector.h"
+#include "common/redisreply.h"
+#include "common/select.h"
+#include "common/table.h"
+#include "common/producertable.h"
+#include "common/consumertable.h"
+
+using namespace std;
+using namespace swss;
+
+#define TEST_VIEW            (7)
+#define NUMBER_OF_COMMANDS   (10000)
+
+/* Run the Select loop of conn until done() or the timeout in ms */
+template<typename Done>
+static bool runUntil(AsyncDBConnector &conn, Done done, int timeout = 5000)
+{
+    Select s;
+    s.addSelectable(&conn);
+
+    auto deadline = chrono::steady_clock::now() + chrono::milliseconds(timeout);
+
+    while (!done())
+    {
+        if (chrono::steady_clock::now() > deadline)
+            return false;
+
+        Selectable *sel;
+        int fd;
+
+        if (s.select(&sel, &fd, 100) == Select::OBJECT)
+            conn.processReplies();
+    }
+
+    return true;
+}
+
+TEST(AsyncDBConnector, pipeline)
+{
+    DBConnector db(TEST_VIEW, "localhost", 6379, 0);
+    AsyncDBConnector conn(&db);
+
+    conn.command("SET async_counter 0");
+
+    /* All the commands are in flight at once, replies come in order */
+    vector<long long> replies;
+    for (int i = 0; i < NUMBER_OF_COMMANDS; i++)
+    {
+        conn.command("INCR async_counter", [&replies](redisReply *reply)
+        {
+            ASSERT_NE(reply, nullptr);
+            ASSERT_EQ(reply->type, REDIS_REPLY_INTEGER);
+            replies.push_back(reply->integer);
+        });
+    }
+
+    EXPECT_GT(conn.inflight(), 0U);
+    ASSERT_TRUE(runUntil(conn, [&]() { return replies.size() == NUMBER_OF_COMMANDS; }));
+
+    for (int i = 0; i < NUMBER_OF_COMMANDS; i++)
+        EXPECT_EQ(replies[i], i + 1);
+
+    EXPECT_EQ(conn.inflight(), 0U);
+
+    /* The blocking connection on the same DB sees the result */
+    RedisReply r(&db, "GET async_counter", REDIS_REPLY_STRING);
+    EXPECT_EQ(string(r.getContext()->str), to_string(NUMBER_OF_COMMANDS));
+}
+
+TEST(AsyncDBConnector, resubscribe)
+{
+    DBConnector db(TEST_VIEW, "localhost", 6379, 0);
+    AsyncDBConnector conn(&db);
+
+    vector<string> messages;
+    conn.subscribe("async_channel", [&messages](const string &channel, const string &message)
+    {
+        EXPECT_EQ(channel, "async_channel");
+        messages.push_back(message);
+    });
+    conn.psubscribe("async_pattern*", [&messages](const string &channel, const string &message)
+    {
+        EXPECT_EQ(channel, "async_pattern1");
+        messages.push_back(message);
+    });
+
+    EXPECT_THROW(conn.command("PING"), logic_error);
+    ASSERT_TRUE(runUntil(conn, [&]() { return conn.inflight() == 0; }));
+
+    RedisReply(&db, "PUBLISH async_channel first", REDIS_REPLY_INTEGER);
+    RedisReply(&db, "PUBLISH async_pattern1 second", REDIS_REPLY_INTEGER);
+    ASSERT_TRUE(runUntil(conn, [&]() { return messages.size() == 2; }));
+    EXPECT_EQ(messages[0], "first");
+    EXPECT_EQ(messages[1], "second");
+
+    /* Drop the connection, the subscriptions come back with it */
+    RedisReply(&db, "CLIENT KILL TYPE pubsub", REDIS_REPLY_INTEGER);
+    ASSERT_TRUE(runUntil(conn, [&]() { return !conn.isConnected(); }));
+    ASSERT_TRUE(runUntil(conn, [&]() { return conn.isConnected() && conn.inflight() == 0; }));
+
+    RedisReply(&db, "PUBLISH async_channel third", REDIS_REPLY_INTEGER);
+    ASSERT_TRUE(runUntil(conn, [&]() { return messages.size() == 3; }));
+    EXPECT_EQ(messages[2], "third");
+}
+
+TEST(AsyncDBConnector, producers)
+{
+    DBConnector db(TEST_VIEW, "localhost", 6379, 0);
+    AsyncDBConnector conn(&db);
+
+    Table table(&db, &conn, "ASYNC_TABLE");
+    ProducerTable producer(&db, &conn, "ASYNC_QUEUE");
+    ConsumerTable consumer(&db, "ASYNC_QUEUE");
+
+    vector<FieldValueTuple> values = { { "field", "value" } };
+
+    /* Writes only go out when the connector runs */
+    table.set("key", values);
+    table.del("gone");
+    producer.set("key", values);
+    producer.del("gone");
+
+    EXPECT_GT(conn.inflight(), 0U);
+    ASSERT_TRUE(runUntil(conn, [&]() { return conn.inflight() == 0; }));
+
+    vector<FieldValueTuple> read;
+    ASSERT_TRUE(table.get("key", read));
+    EXPECT_EQ(read, values);
+
+    std::deque<KeyOpFieldsValuesTuple> entries;
+    consumer.pops(entries);
+    ASSERT_EQ(entries.size(), 2U);
+    EXPECT_EQ(kfvKey(entries[0]), "key");
+    EXPECT_EQ(kfvOp(entries[0]), SET_COMMAND);
+    EXPECT_EQ(kfvFieldsValues(entries[0]), values);
+    EXPECT_EQ(kfvKey(entries[1]), "gone");
+    EXPECT_EQ(kfvOp(entries[1]), DEL_COMMAND);
+
+    table.del("key");
+    ASSERT_TRUE(runUntil(conn, [&]() { return conn.inflight() == 0; }));
+}
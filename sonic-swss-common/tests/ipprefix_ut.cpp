@@ -104,3 +104,15 @@ TEST(IpPrefix, subnet)
     EXPECT_FALSE(prefix1.isAddressInSubnet(ip3));
     EXPECT_FALSE(prefix2.isAddressInSubnet(ip3));
 }
+
+TEST(IpPrefix, address_and_mask)
+{
+    IpPrefix ip1(IpAddress("10.1.2.0"), 24);
+    EXPECT_EQ(ip1, IpPrefix("10.1.2.0/24"));
+
+    IpPrefix ip2(IpAddress("2001:db8::"), 32);
+    EXPECT_EQ(ip2, IpPrefix("2001:db8::/32"));
+
+    EXPECT_THROW(IpPrefix(IpAddress("10.1.2.0"), 33), invalid_argument);
+    EXPECT_THROW(IpPrefix(IpAddress("2001:db8::"), 129), invalid_argument);
+}
@@ -0,0 +1,108 @@
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "common/dbconnector.h"
+#include "common/redispipeline.h"
+#include "common/producerstatetable.h"
+
+using namespace std;
+using namespace swss;
+
+#define TEST_VIEW            (7)
+#define NUMBER_OF_PREFIXES   (100000)
+#define BATCH_SIZE           (128)
+
+static inline string prefix(int i)
+{
+    return to_string(10 + (i >> 16)) + "." + to_string((i >> 8) & 0xff) + "." + to_string(i & 0xff) + ".0/24";
+}
+
+static inline vector<FieldValueTuple> routeFields(int i)
+{
+    vector<FieldValueTuple> fields;
+    fields.push_back(FieldValueTuple("nexthop", "10.0.0.1,10.0.0.3"));
+    fields.push_back(FieldValueTuple("ifname", "Ethernet" + to_string((i % 32) * 4) + ",Ethernet8"));
+    return fields;
+}
+
+static inline void clearDB()
+{
+    DBConnector db(TEST_VIEW, "localhost", 6379, 0);
+    RedisReply r(&db, "FLUSHALL", REDIS_REPLY_STATUS);
+    r.checkStatusOK();
+}
+
+static inline void report(const string& name, int count, chrono::steady_clock::time_point start)
+{
+    auto usec = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    double rate = usec ? (double)count * 1000000.0 / (double)usec : 0;
+
+    cout << name << ": " << count << " prefixes in " << usec / 1000 << " ms, "
+         << (long long)rate << " prefixes/sec" << endl;
+}
+
+/* Benchmark, run with --gtest_also_run_disabled_tests */
+TEST(ProducerStateTable, DISABLED_perf_set_del)
+{
+    clearDB();
+
+    DBConnector db(TEST_VIEW, "localhost", 6379, 0);
+    RedisPipeline pipeline(&db);
+    ProducerStateTable p(&pipeline, "UT_PERF_ROUTE_TABLE", true);
+
+    vector<string> keys;
+    vector<KeyOpFieldsValuesTuple> kfvs;
+    for (int i = 0; i < NUMBER_OF_PREFIXES; i++)
+    {
+        keys.push_back(prefix(i));
+        kfvs.push_back(KeyOpFieldsValuesTuple(keys.back(), SET_COMMAND, routeFields(i)));
+    }
+
+    /* One EVALSHA per prefix */
+    auto start = chrono::steady_clock::now();
+    for (auto& kfv: kfvs)
+    {
+        p.set(kfvKey(kfv), kfvFieldsValues(kfv));
+    }
+    p.flush();
+    report("set", NUMBER_OF_PREFIXES, start);
+
+    start = chrono::steady_clock::now();
+    for (auto& key: keys)
+    {
+        p.del(key);
+    }
+    p.flush();
+    report("del", NUMBER_OF_PREFIXES, start);
+
+    clearDB();
+
+    /* One EVALSHA per batch */
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < kfvs.size(); i += BATCH_SIZE)
+    {
+        size_t end = min(kfvs.size(), i + BATCH_SIZE);
+        vector<KeyOpFieldsValuesTuple> batch(kfvs.begin() + i, kfvs.begin() + end);
+        p.set(batch);
+    }
+    p.flush();
+    report("batched set", NUMBER_OF_PREFIXES, start);
+
+    RedisReply r(&db, "SCARD UT_PERF_ROUTE_TABLE_KEY_SET", REDIS_REPLY_INTEGER);
+    EXPECT_EQ(r.getReply<long long int>(), NUMBER_OF_PREFIXES);
+
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < keys.size(); i += BATCH_SIZE)
+    {
+        size_t end = min(keys.size(), i + BATCH_SIZE);
+        vector<string> batch(keys.begin() + i, keys.begin() + end);
+        p.del(batch);
+    }
+    p.flush();
+    report("batched del", NUMBER_OF_PREFIXES, start);
+
+    RedisReply e(&db, "EXISTS UT_PERF_ROUTE_TABLE:" + prefix(0), REDIS_REPLY_INTEGER);
+    EXPECT_EQ(e.getReply<long long int>(), 0);
+}
@@ -0,0 +1,195 @@
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+#include "common/recorder.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+using namespace swss;
+
+static vector<string> readLines(const string &file)
+{
+    ifstream in(file);
+    vector<string> lines;
+    string line;
+
+    while (getline(in, line))
+    {
+        lines.push_back(line);
+    }
+
+    return lines;
+}
+
+/* Strips "YYYY-MM-DD.HH:MM:SS.uuuuuu|" timestamp */
+static string stripTimestamp(const string &line)
+{
+    EXPECT_EQ(line.size() > 27, true);
+    EXPECT_EQ(line[10], '.');
+    EXPECT_EQ(line[26], '|');
+
+    return line.substr(27);
+}
+
+TEST(Recorder, text)
+{
+    string file = "recorder_ut.rec";
+    unlink(file.c_str());
+
+    Recorder recorder(4);
+    EXPECT_TRUE(recorder.open(file));
+
+    /* More records than ring capacity */
+    for (int i = 0; i < 100; i++)
+    {
+        recorder.record("s|key" + to_string(i) + "|field=value");
+    }
+
+    recorder.flush();
+
+    auto lines = readLines(file);
+    ASSERT_EQ(lines.size(), 100u);
+
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(stripTimestamp(lines[i]), "s|key" + to_string(i) + "|field=value");
+    }
+
+    recorder.close();
+    EXPECT_FALSE(recorder.isOpen());
+
+    /* Ignored when closed */
+    recorder.record("s|closed");
+
+    EXPECT_EQ(readLines(file).size(), 100u);
+
+    unlink(file.c_str());
+}
+
+TEST(Recorder, rotate)
+{
+    string file = "recorder_ut_rotate.rec";
+    string rotated = file + ".1";
+    unlink(file.c_str());
+    unlink(rotated.c_str());
+
+    Recorder recorder;
+    EXPECT_TRUE(recorder.open(file));
+
+    recorder.record("c|before");
+    recorder.flush();
+
+    EXPECT_EQ(rename(file.c_str(), rotated.c_str()), 0);
+
+    recorder.rotate();
+    recorder.record("c|after");
+    recorder.close();
+
+    auto lines = readLines(rotated);
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_EQ(stripTimestamp(lines[0]), "c|before");
+
+    lines = readLines(file);
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(stripTimestamp(lines[0]), "#|logrotate on: " + file);
+    EXPECT_EQ(stripTimestamp(lines[1]), "c|after");
+
+    unlink(file.c_str());
+    unlink(rotated.c_str());
+}
+
+TEST(Recorder, binary)
+{
+    string file = "recorder_ut.rec.bin";
+    unlink(file.c_str());
+
+    Recorder recorder(8);
+
+    /* Two producers, as notification thread records in sairedis */
+    EXPECT_TRUE(recorder.open(file, Recorder::BINARY));
+
+    thread producer([&]{
+        for (int i = 0; i < 1000; i++)
+        {
+            recorder.record("n|thread" + to_string(i));
+        }
+    });
+
+    for (int i = 0; i < 1000; i++)
+    {
+        recorder.record("g|main" + to_string(i) + "|");
+    }
+
+    producer.join();
+    recorder.close();
+
+    /* Reopen appends without second header */
+    EXPECT_TRUE(recorder.open(file, Recorder::BINARY));
+    recorder.record("s|reopen|a=b\nc");
+    recorder.close();
+
+    ifstream in(file, ifstream::binary);
+    stringstream out;
+
+    EXPECT_TRUE(Recorder::convertToText(in, out));
+
+    vector<string> lines;
+    string line;
+
+    while (getline(out, line))
+    {
+        lines.push_back(line);
+    }
+
+    ASSERT_EQ(lines.size(), 2002u);
+
+    int thread = 0, main = 0;
+
+    for (size_t i = 0; i < 2000; i++)
+    {
+        string text = stripTimestamp(lines[i]);
+
+        if (text.compare(0, 8, "n|thread") == 0)
+        {
+            EXPECT_EQ(text, "n|thread" + to_string(thread++));
+        }
+        else
+        {
+            EXPECT_EQ(text, "g|main" + to_string(main++) + "|");
+        }
+    }
+
+    EXPECT_EQ(thread, 1000);
+    EXPECT_EQ(main, 1000);
+
+    EXPECT_EQ(stripTimestamp(lines[2000]), "s|reopen|a=b");
+    EXPECT_EQ(lines[2001], "c");
+
+    unlink(file.c_str());
+}
+
+TEST(Recorder, convertInvalid)
+{
+    stringstream text("2017-01-01.00:00:00.000000|c|key\n");
+    stringstream out;
+
+    EXPECT_FALSE(Recorder::convertToText(text, out));
+
+    string truncated(Recorder::BINARY_MAGIC, sizeof(Recorder::BINARY_MAGIC));
+    truncated += "abc";
+
+    stringstream bin(truncated);
+
+    EXPECT_FALSE(Recorder::convertToText(bin, out));
+}
+
+TEST(Recorder, timestamp)
+{
+    struct timeval tv = { 0, 42 };
+
+    string ts = Recorder::formatTimestamp(tv);
+
+    EXPECT_EQ(ts.size(), 26u);
+    EXPECT_EQ(ts.substr(20), "000042");
+}
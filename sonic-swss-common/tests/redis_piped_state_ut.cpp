@@ -524,3 +524,201 @@ TEST(ConsumerStateTable, async_multitable)
     cout << endl << "Done." << endl;
 }
 
+
+TEST(ConsumerStateTable, async_batched_set_del)
+{
+    clearDB();
+
+    int index = 0;
+    string tableName = "UT_REDIS_THREAD_" + to_string(index);
+    DBConnector db(TEST_VIEW, "localhost", 6379, 0);
+    RedisPipeline pipeline(&db);
+    ProducerStateTable p(&pipeline, tableName, true);
+
+    vector<KeyOpFieldsValuesTuple> kfvs;
+    vector<string> keys;
+    for (int i = 0; i < NUMBER_OF_OPS; i++)
+    {
+        vector<FieldValueTuple> fields;
+        int maxNumOfFields = getMaxFields(i);
+        for (int j = 0; j < maxNumOfFields; j++)
+        {
+            FieldValueTuple t(field(j), value(j));
+            fields.push_back(t);
+        }
+        kfvs.push_back(KeyOpFieldsValuesTuple(key(i), "SET", fields));
+        keys.push_back(key(i));
+    }
+    p.set(kfvs);
+    p.flush();
+
+    ConsumerStateTable c(&db, tableName);
+    Select cs;
+    Selectable *selectcs;
+    int tmpfd;
+    int ret;
+    KeyOpFieldsValuesTuple kco;
+
+    cs.addSelectable(&c);
+    int numberOfKeysSet = 0;
+    while ((ret = cs.select(&selectcs, &tmpfd)) == Select::OBJECT)
+    {
+        c.pop(kco);
+        EXPECT_TRUE(kfvOp(kco) == "SET");
+        numberOfKeysSet++;
+        validateFields(kfvKey(kco), kfvFieldsValues(kco));
+
+        if (numberOfKeysSet == NUMBER_OF_OPS)
+            break;
+    }
+    EXPECT_EQ(numberOfKeysSet, NUMBER_OF_OPS);
+
+    p.del(keys);
+    p.flush();
+
+    int numberOfKeyDeleted = 0;
+    while ((ret = cs.select(&selectcs, &tmpfd)) == Select::OBJECT)
+    {
+        c.pop(kco);
+        EXPECT_TRUE(kfvOp(kco) == "DEL");
+        numberOfKeyDeleted++;
+
+        if (numberOfKeyDeleted == NUMBER_OF_OPS)
+            break;
+    }
+    EXPECT_EQ(numberOfKeyDeleted, NUMBER_OF_OPS);
+
+    /* Nothing should be left behind */
+    ret = cs.select(&selectcs, &tmpfd, 1000);
+    EXPECT_TRUE(ret == Select::TIMEOUT);
+}
+
+TEST(ConsumerStateTable, async_delta_pops)
+{
+    clearDB();
+
+    int index = 0;
+    string tableName = "UT_REDIS_THREAD_" + to_string(index);
+    DBConnector db(TEST_VIEW, "localhost", 6379, 0);
+    RedisPipeline pipeline(&db);
+    ProducerStateTable p(&pipeline, tableName, true);
+    ConsumerStateTable c(&db, tableName);
+    c.setDeltaMode(true);
+    string key = "TheKey";
+    deque<KeyOpFieldsValuesTuple> entries;
+
+    /* New key, every field is a change */
+    {
+        vector<FieldValueTuple> fields = { FieldValueTuple(field(0), value(0)),
+                                           FieldValueTuple(field(1), value(1)) };
+        p.set(key, fields);
+        p.flush();
+
+        c.pops(entries);
+        EXPECT_EQ(entries.size(), 1U);
+        EXPECT_EQ(kfvOp(entries[0]), "SET");
+        EXPECT_EQ(kfvFieldsValues(entries[0]).size(), 2U);
+    }
+
+    /* Only the changed field is popped */
+    {
+        vector<FieldValueTuple> fields = { FieldValueTuple(field(0), value(0)),
+                                           FieldValueTuple(field(1), value(2)) };
+        p.set(key, fields);
+        p.flush();
+
+        c.pops(entries);
+        EXPECT_EQ(entries.size(), 1U);
+        EXPECT_EQ(kfvOp(entries[0]), "SET");
+        auto fvs = kfvFieldsValues(entries[0]);
+        EXPECT_EQ(fvs.size(), 1U);
+        EXPECT_EQ(fvField(fvs[0]), field(1));
+        EXPECT_EQ(fvValue(fvs[0]), value(2));
+    }
+
+    /* Nothing changed, nothing popped */
+    {
+        vector<FieldValueTuple> fields = { FieldValueTuple(field(1), value(2)) };
+        p.set(key, fields);
+        p.flush();
+
+        c.pops(entries);
+        EXPECT_EQ(entries.size(), 0U);
+    }
+
+    /* Delete followed by set pops a tombstone and the new fields */
+    {
+        p.del(key);
+        vector<FieldValueTuple> fields = { FieldValueTuple(field(1), value(2)) };
+        p.set(key, fields);
+        p.flush();
+
+        c.pops(entries);
+        EXPECT_EQ(entries.size(), 2U);
+        EXPECT_EQ(kfvOp(entries[0]), "DEL");
+        EXPECT_EQ(kfvOp(entries[1]), "SET");
+        EXPECT_EQ(kfvFieldsValues(entries[1]).size(), 1U);
+    }
+
+    /* Plain delete */
+    {
+        p.del(key);
+        p.flush();
+
+        c.pops(entries);
+        EXPECT_EQ(entries.size(), 1U);
+        EXPECT_EQ(kfvKey(entries[0]), key);
+        EXPECT_EQ(kfvOp(entries[0]), "DEL");
+        EXPECT_EQ(kfvFieldsValues(entries[0]).size(), 0U);
+    }
+
+    /* The delta bookkeeping is gone once popped */
+    RedisReply r(&db, "EXISTS " + tableName + "_DELTA:" + key, REDIS_REPLY_INTEGER);
+    EXPECT_EQ(r.getReply<long long int>(), 0);
+}
+
+TEST(ConsumerStateTable, async_delta_opt_in)
+{
+    clearDB();
+
+    int index = 0;
+    string tableName = "UT_REDIS_THREAD_" + to_string(index);
+    DBConnector db(TEST_VIEW, "localhost", 6379, 0);
+    RedisPipeline pipeline(&db);
+    ProducerStateTable p(&pipeline, tableName, true);
+    string key = "TheKey";
+    deque<KeyOpFieldsValuesTuple> entries;
+
+    /* No delta consumer, no delta recorded */
+    vector<FieldValueTuple> fields = { FieldValueTuple(field(0), value(0)),
+                                       FieldValueTuple(field(1), value(1)) };
+    p.set(key, fields);
+    p.flush();
+
+    {
+        RedisReply r(&db, "EXISTS " + tableName + "_DELTA:" + key, REDIS_REPLY_INTEGER);
+        EXPECT_EQ(r.getReply<long long int>(), 0);
+    }
+
+    /* Key pending from before the opt-in is popped whole */
+    ConsumerStateTable c(&db, tableName);
+    c.setDeltaMode(true);
+
+    c.pops(entries);
+    EXPECT_EQ(entries.size(), 1U);
+    EXPECT_EQ(kfvOp(entries[0]), "SET");
+    EXPECT_EQ(kfvFieldsValues(entries[0]).size(), 2U);
+
+    /* Delete followed by set of known fields pops the whole new hash */
+    p.del(key);
+    vector<FieldValueTuple> again = { FieldValueTuple(field(0), value(0)),
+                                      FieldValueTuple(field(1), value(1)) };
+    p.set(key, again);
+    p.flush();
+
+    c.pops(entries);
+    EXPECT_EQ(entries.size(), 2U);
+    EXPECT_EQ(kfvOp(entries[0]), "DEL");
+    EXPECT_EQ(kfvOp(entries[1]), "SET");
+    EXPECT_EQ(kfvFieldsValues(entries[1]).size(), 2U);
+}
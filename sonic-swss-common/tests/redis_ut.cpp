@@ -11,6 +11,7 @@
 #include "common/select.h"
 #include "common/selectableevent.h"
 #include "common/table.h"
+#include "common/redisclient.h"
 
 using namespace std;
 using namespace swss;
@@ -480,6 +481,71 @@ TEST(Table, table_separator_test)
     cout << "Done." << endl;
 }
 
+TEST(Table, scan)
+{
+    string tableName = "TABLE_UT_SCAN";
+    DBConnector db(TEST_VIEW, "localhost", 6379, 0);
+    Table t(&db, tableName);
+    Table other(&db, tableName + "_OTHER");
+
+    clearDB();
+
+    /* Several SCAN batches, each key must be seen once */
+    int entries = Table::DEFAULT_SCAN_BATCH_SIZE * 3 + 7;
+    for (int i = 0; i < entries; i++)
+    {
+        vector<FieldValueTuple> values = { { "index", to_string(i) }, { "field", "value" } };
+        t.set(key(i), values);
+    }
+
+    vector<FieldValueTuple> values = { { "field", "value" } };
+    other.set(key(0), values);
+
+    vector<string> keys;
+    t.getTableKeys(keys);
+    EXPECT_EQ(keys.size(), (size_t)entries);
+
+    map<string, int> seen;
+    t.getTableContent([&seen](const string &key, vector<FieldValueTuple> &fvs)
+    {
+        ASSERT_EQ(fvs.size(), (size_t)2);
+        for (auto fv: fvs)
+        {
+            if (fvField(fv) == "index")
+                seen[key] = stoi(fvValue(fv));
+        }
+    });
+
+    ASSERT_EQ(seen.size(), (size_t)entries);
+    for (int i = 0; i < entries; i++)
+        EXPECT_EQ(seen[key(i)], i);
+
+    clearDB();
+}
+
+TEST(RedisClient, hmget)
+{
+    DBConnector db(TEST_VIEW, "localhost", 6379, 0);
+    RedisClient client(&db);
+
+    clearDB();
+
+    client.hset("hmget_hash", "a", "1");
+    client.hset("hmget_hash", "c", "3");
+
+    auto values = client.hmget("hmget_hash", { "a", "b", "c" });
+    ASSERT_EQ(values.size(), (size_t)3);
+    ASSERT_NE(values[0], nullptr);
+    EXPECT_EQ(*values[0], "1");
+    EXPECT_EQ(values[1], nullptr);
+    ASSERT_NE(values[2], nullptr);
+    EXPECT_EQ(*values[2], "3");
+
+    EXPECT_TRUE(client.hmget("hmget_hash", {}).empty());
+
+    clearDB();
+}
+
 TEST(ProducerConsumer, Prefix)
 {
     std::string tableName = "tableName";
@@ -508,3 +574,61 @@ TEST(ProducerConsumer, Prefix)
     EXPECT_EQ(fvField(vs[0]), "f");
     EXPECT_EQ(fvValue(vs[0]), "v");
 }
+
+TEST(ProducerConsumer, TaggedBulkOps)
+{
+    std::string tableName = "ASIC_STATE";
+
+    clearDB();
+
+    DBConnector db(TEST_VIEW, "localhost", 6379, 0);
+    ProducerTable p(&db, tableName);
+    ConsumerTable c(&db, tableName);
+    Table t(&db, tableName);
+
+    KeyOpFieldsValuesTuple kco;
+    std::vector<FieldValueTuple> values;
+
+    /* Bulk ops sairedis waits for carry a request id after the op name */
+    values = { { "oid:0x1", "A=1|B=2" }, { "oid:0x2", "A=3" } };
+    p.set("SAI_OBJECT_TYPE_ROUTE_ENTRY:2", values, "bulkcreate:7");
+    c.pop(kco);
+    EXPECT_EQ(kfvOp(kco), "bulkcreate:7");
+
+    EXPECT_FALSE(t.get("SAI_OBJECT_TYPE_ROUTE_ENTRY:2", values));
+    ASSERT_TRUE(t.get("SAI_OBJECT_TYPE_ROUTE_ENTRY:oid:0x1", values));
+    EXPECT_EQ(values.size(), (size_t)2);
+    ASSERT_TRUE(t.get("SAI_OBJECT_TYPE_ROUTE_ENTRY:oid:0x2", values));
+    ASSERT_EQ(values.size(), (size_t)1);
+    EXPECT_EQ(fvValue(values[0]), "3");
+
+    values = { { "oid:0x2", "A=4" } };
+    p.set("SAI_OBJECT_TYPE_ROUTE_ENTRY:1", values, "bulkset:8");
+    c.pop(kco);
+
+    EXPECT_FALSE(t.get("SAI_OBJECT_TYPE_ROUTE_ENTRY:1", values));
+    ASSERT_TRUE(t.get("SAI_OBJECT_TYPE_ROUTE_ENTRY:oid:0x2", values));
+    ASSERT_EQ(values.size(), (size_t)1);
+    EXPECT_EQ(fvValue(values[0]), "4");
+
+    values = { { "oid:0x1", "" }, { "oid:0x2", "" } };
+    p.set("SAI_OBJECT_TYPE_ROUTE_ENTRY:2", values, "bulkremove:9");
+    c.pop(kco);
+
+    EXPECT_FALSE(t.get("SAI_OBJECT_TYPE_ROUTE_ENTRY:2", values));
+    EXPECT_FALSE(t.get("SAI_OBJECT_TYPE_ROUTE_ENTRY:oid:0x1", values));
+    EXPECT_FALSE(t.get("SAI_OBJECT_TYPE_ROUTE_ENTRY:oid:0x2", values));
+
+    /* Responses are only passed to the consumer */
+    values = { { "oid:0x1", "SAI_STATUS_SUCCESS" } };
+    p.set("SAI_STATUS_SUCCESS", values, "bulkresponse:9");
+    p.set("SAI_STATUS_SUCCESS", values, "getresponse:10");
+    c.pop(kco);
+    EXPECT_EQ(kfvOp(kco), "bulkresponse:9");
+    c.pop(kco);
+    EXPECT_EQ(kfvOp(kco), "getresponse:10");
+
+    EXPECT_FALSE(t.get("SAI_STATUS_SUCCESS", values));
+
+    clearDB();
+}
@@ -0,0 +1,116 @@
+#include <iostream>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <set>
+#include <sys/resource.h>
+#include "gtest/gtest.h"
+#include "common/select.h"
+#include "common/selectableevent.h"
+
+using namespace std;
+using namespace swss;
+
+#define NUMBER_OF_SELECTABLES (2000) // More than FD_SETSIZE
+#define NUMBER_OF_ROUNDS      (10000)
+
+static size_t raiseFdLimit(size_t wanted)
+{
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_NOFILE, &rl) != 0)
+        return 0;
+
+    if (rl.rlim_cur < wanted + 64)
+    {
+        rl.rlim_cur = min<rlim_t>(rl.rlim_max, wanted + 64);
+        setrlimit(RLIMIT_NOFILE, &rl);
+        getrlimit(RLIMIT_NOFILE, &rl);
+    }
+
+    return min<size_t>(wanted, rl.rlim_cur - 64);
+}
+
+TEST(Select, fairness)
+{
+    Select s;
+    SelectableEvent busy, quiet;
+    s.addSelectable(&busy);
+    s.addSelectable(&quiet);
+
+    busy.notify();
+    quiet.notify();
+
+    Selectable *sel;
+    int fd;
+
+    /* Both are ready, each is returned once before the busy one again */
+    set<Selectable *> served;
+    EXPECT_EQ(s.select(&sel, &fd, 1000), Select::OBJECT);
+    served.insert(sel);
+    busy.notify();
+    EXPECT_EQ(s.select(&sel, &fd, 1000), Select::OBJECT);
+    served.insert(sel);
+    EXPECT_EQ(served.size(), 2U);
+
+    EXPECT_EQ(s.select(&sel, &fd, 1000), Select::OBJECT);
+    EXPECT_EQ(sel, &busy);
+    EXPECT_EQ(s.select(&sel, &fd, 100), Select::TIMEOUT);
+
+    /* Higher priority is served first */
+    quiet.setPri(1);
+    busy.notify();
+    quiet.notify();
+    vector<Selectable *> ready;
+    vector<int> fds;
+    EXPECT_EQ(s.select(ready, fds, 1000), Select::OBJECT);
+    EXPECT_EQ(ready.size(), 2U);
+    EXPECT_EQ(ready[0], &quiet);
+    EXPECT_EQ(ready[1], &busy);
+    EXPECT_TRUE(fds.empty());
+}
+
+/* Benchmark, run with --gtest_also_run_disabled_tests */
+TEST(Select, DISABLED_perf_many_selectables)
+{
+    size_t count = raiseFdLimit(NUMBER_OF_SELECTABLES);
+    cout << "Using " << count << " selectables" << endl;
+
+    Select s;
+    vector<unique_ptr<SelectableEvent>> events;
+    for (size_t i = 0; i < count; i++)
+    {
+        events.emplace_back(new SelectableEvent());
+        s.addSelectable(events.back().get());
+    }
+
+    Selectable *sel;
+    int fd;
+
+    /* A single ready object among many idle ones */
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < NUMBER_OF_ROUNDS; i++)
+    {
+        auto& e = events[(size_t)i % count];
+        e->notify();
+        ASSERT_EQ(s.select(&sel, &fd, 1000), Select::OBJECT);
+        ASSERT_EQ(sel, e.get());
+    }
+    auto usec = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    cout << "single ready: " << NUMBER_OF_ROUNDS << " wakeups in " << usec / 1000 << " ms, "
+         << (usec ? (long long)NUMBER_OF_ROUNDS * 1000000 / usec : 0) << " wakeups/sec" << endl;
+
+    /* Every object ready at once, drained in one call */
+    start = chrono::steady_clock::now();
+    vector<Selectable *> ready;
+    vector<int> fds;
+    for (auto& e: events)
+    {
+        e->notify();
+    }
+    ASSERT_EQ(s.select(ready, fds, 1000), Select::OBJECT);
+    usec = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    EXPECT_EQ(ready.size(), count);
+    cout << "all ready: " << ready.size() << " objects in " << usec << " us" << endl;
+
+    EXPECT_EQ(s.select(&sel, &fd, 100), Select::TIMEOUT);
+}
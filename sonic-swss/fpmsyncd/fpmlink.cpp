@@ -2,17 +2,15 @@
 #include <errno.h>
 #include <system_error>
 #include "logger.h"
-#include "netmsg.h"
-#include "netdispatcher.h"
 #include "fpmsyncd/fpmlink.h"
 
 using namespace swss;
 using namespace std;
 
-FpmLink::FpmLink(int port) :
+FpmLink::FpmLink(RouteSync *rsync, int port) :
     MSG_BATCH_SIZE(256),
+    m_routesync(rsync),
     m_bufSize(FPM_MAX_MSG_LEN * MSG_BATCH_SIZE),
-    m_messageBuffer(NULL),
     m_pos(0),
     m_connected(false),
     m_server_up(false)
@@ -56,12 +54,12 @@ FpmLink::FpmLink(int port) :
     }
 
     m_server_up = true;
-    m_messageBuffer = new char[m_bufSize];
+    m_messageBuffer.resize(m_bufSize);
+    m_batch.reserve(MSG_BATCH_SIZE);
 }
 
 FpmLink::~FpmLink()
 {
-    delete m_messageBuffer;
     if (m_connected)
         close(m_connection_socket);
     if (m_server_up)
@@ -91,6 +89,11 @@ bool FpmLink::isMe(fd_set *fd)
     return FD_ISSET(m_connection_socket, fd);
 }
 
+int FpmLink::getFd()
+{
+    return m_connection_socket;
+}
+
 int FpmLink::readCache()
 {
     /* FPM doesn't have any caching */
@@ -104,17 +107,21 @@ void FpmLink::readMe()
     size_t start = 0, left;
     ssize_t read;
 
-    read = ::read(m_connection_socket, m_messageBuffer + m_pos, m_bufSize - m_pos);
+    read = ::read(m_connection_socket, m_messageBuffer.data() + m_pos, m_messageBuffer.size() - m_pos);
     if (read == 0)
         throw FpmConnectionClosedException();
     if (read < 0)
         throw system_error(errno, system_category());
     m_pos+= (uint32_t)read;
 
+    /* A read filling the whole buffer means a burst, read more at a time */
+    bool full = m_pos == m_messageBuffer.size();
+
     /* Check for complete messages */
+    m_batch.clear();
     while (true)
     {
-        hdr = (fpm_msg_hdr_t *)(m_messageBuffer + start);
+        hdr = (fpm_msg_hdr_t *)(m_messageBuffer.data() + start);
         left = m_pos - start;
         if (left < FPM_MSG_HDR_LEN)
             break;
@@ -128,17 +135,30 @@ void FpmLink::readMe()
 
         if (hdr->msg_type == FPM_MSG_TYPE_NETLINK)
         {
-            nl_msg *msg = nlmsg_convert((nlmsghdr *)fpm_msg_data(hdr));
-            if (msg == NULL)
-                throw system_error(make_error_code(errc::bad_message), "Unable to convert nlmsg");
+            nlmsghdr *nl_hdr = (nlmsghdr *)fpm_msg_data(hdr);
+
+            if (!NLMSG_OK(nl_hdr, msg_len - FPM_MSG_HDR_LEN))
+                throw system_error(make_error_code(errc::bad_message), "Malformed netlink message received");
 
-            nlmsg_set_proto(msg, NETLINK_ROUTE);
-            NetDispatcher::getInstance().onNetlinkMessage(msg);
-            nlmsg_free(msg);
+            if (nl_hdr->nlmsg_type == RTM_NEWROUTE || nl_hdr->nlmsg_type == RTM_DELROUTE)
+                m_batch.push_back(nl_hdr);
         }
         start += msg_len;
     }
 
-    memmove(m_messageBuffer, m_messageBuffer + start, m_pos - start);
-    m_pos = m_pos - (uint32_t)start;
+    /* The batch points into the buffer, hand it over before moving the rest */
+    if (!m_batch.empty())
+        m_routesync->onRouteMsgs(m_batch);
+
+    if (start != 0)
+    {
+        memmove(m_messageBuffer.data(), m_messageBuffer.data() + start, m_pos - start);
+        m_pos = m_pos - (uint32_t)start;
+    }
+
+    if (full && m_messageBuffer.size() < m_bufSize * MAX_BUF_GROWTH)
+    {
+        m_messageBuffer.resize(m_messageBuffer.size() * 2);
+        SWSS_LOG_INFO("FPM receive buffer grown to %zu bytes", m_messageBuffer.size());
+    }
 }
@@ -10,16 +10,22 @@
 #include <assert.h>
 #include <unistd.h>
 #include <exception>
+#include <vector>
 
 #include "selectable.h"
 #include "fpm/fpm.h"
+#include "fpmsyncd/routesync.h"
 
 namespace swss {
 
 class FpmLink : public Selectable {
 public:
     const int MSG_BATCH_SIZE;
-    FpmLink(int port = FPM_DEFAULT_PORT);
+    /* The receive buffer grows up to this many times its initial size */
+    static const unsigned int MAX_BUF_GROWTH = 16;
+
+    /* Route messages are handed to rsync straight from the receive buffer */
+    FpmLink(RouteSync *rsync, int port = FPM_DEFAULT_PORT);
     virtual ~FpmLink();
 
     /* Wait for connection (blocking) */
@@ -27,6 +33,7 @@ public:
 
     virtual void addFd(fd_set *fd);
     virtual bool isMe(fd_set *fd);
+    virtual int getFd();
     virtual int readCache();
     virtual void readMe();
 
@@ -36,10 +43,15 @@ public:
     };
 
 private:
+    RouteSync *m_routesync;
+
     unsigned int m_bufSize;
-    char *m_messageBuffer;
+    std::vector<char> m_messageBuffer;
     unsigned int m_pos;
 
+    /* Route messages of the last read, pointing into m_messageBuffer */
+    std::vector<struct nlmsghdr *> m_batch;
+
     bool m_connected;
     bool m_server_up;
     int m_server_socket;
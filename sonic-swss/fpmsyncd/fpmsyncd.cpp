@@ -1,28 +1,31 @@
 #include <iostream>
+#include <chrono>
 #include "logger.h"
 #include "select.h"
-#include "netdispatcher.h"
 #include "fpmsyncd/fpmlink.h"
 #include "fpmsyncd/routesync.h"
 
 using namespace std;
 using namespace swss;
 
+/* Interval of the statistics export to COUNTERS_DB */
+#define STATS_INTERVAL std::chrono::seconds(10)
+
 int main(int argc, char **argv)
 {
     swss::Logger::linkToDbNative("fpmsyncd");
     DBConnector db(APPL_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
     RedisPipeline pipeline(&db);
     RouteSync sync(&pipeline);
-
-    NetDispatcher::getInstance().registerMessageHandler(RTM_NEWROUTE, &sync);
-    NetDispatcher::getInstance().registerMessageHandler(RTM_DELROUTE, &sync);
+    DBConnector countersDb(COUNTERS_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
+    Table statsTable(&countersDb, COUNTERS_FPMSYNCD_STATS_TABLE);
+    auto lastStats = chrono::steady_clock::now();
 
     while (1)
     {
         try
         {
-            FpmLink fpm;
+            FpmLink fpm(&sync);
             Select s;
 
             cout << "Waiting for connection..." << endl;
@@ -35,13 +38,29 @@ int main(int argc, char **argv)
                 Selectable *temps;
                 int tempfd;
                 /* Reading FPM messages forever (and calling "readMe" to read them) */
-                s.select(&temps, &tempfd);
-                pipeline.flush();
-                SWSS_LOG_DEBUG("Pipeline flushed");
+                s.select(&temps, &tempfd, min(sync.getFlushTimeout(), (unsigned int)1000));
+
+                /* Write the routes once they are due, not on every read */
+                if (sync.getFlushTimeout() == 0)
+                {
+                    sync.flush();
+                    pipeline.flush();
+                    SWSS_LOG_DEBUG("Pipeline flushed");
+                }
+
+                auto now = chrono::steady_clock::now();
+                if (now - lastStats >= STATS_INTERVAL)
+                {
+                    sync.dumpStats(statsTable);
+                    lastStats = now;
+                }
             }
         }
         catch (FpmLink::FpmConnectionClosedException &e)
         {
+            /* Don't lose the updates received before the connection dropped */
+            sync.flush();
+            pipeline.flush();
             cout << "Connection lost, reconnecting..." << endl;
         }
         catch (const exception& e)
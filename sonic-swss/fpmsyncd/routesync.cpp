@@ -1,6 +1,6 @@
+#include <limits>
+#include <arpa/inet.h>
 #include <netlink/route/link.h>
-#include <netlink/route/route.h>
-#include <netlink/route/nexthop.h>
 #include "logger.h"
 #include "select.h"
 #include "netmsg.h"
@@ -13,50 +13,135 @@
 using namespace std;
 using namespace swss;
 
+/* Period over which the rate of route updates is measured */
+#define RATE_WINDOW chrono::milliseconds(100)
+
 RouteSync::RouteSync(RedisPipeline *pipeline) :
-    m_routeTable(pipeline, APP_ROUTE_TABLE_NAME, true)
+    m_routeTable(pipeline, APP_ROUTE_TABLE_NAME, true),
+    m_rate(0),
+    m_windowUpdates(0),
+    m_windowStart(chrono::steady_clock::now()),
+    m_received(0),
+    m_coalesced(0),
+    m_flushes(0),
+    m_flushed(0)
 {
     m_nl_sock = nl_socket_alloc();
     nl_connect(m_nl_sock, NETLINK_ROUTE);
     rtnl_link_alloc_cache(m_nl_sock, AF_UNSPEC, &m_link_cache);
 }
 
-void RouteSync::onMsg(int nlmsg_type, struct nl_object *obj)
+/*
+ * Format an address the way nl_addr2str does, with the prefix length only
+ * when it is shorter than the address. A missing address, as in the default
+ * route, is "none" so that the route keeps the key libnl gave it.
+ */
+static void formatAddr(unsigned char family, const void *addr, unsigned int prefixlen, char *buf, size_t size)
 {
-    struct rtnl_route *route_obj = (struct rtnl_route *)obj;
-    struct nl_addr *dip;
+    char str[INET6_ADDRSTRLEN] = {0};
+
+    if (!addr)
+    {
+        if (prefixlen == 0)
+            snprintf(buf, size, "none");
+        else
+            snprintf(buf, size, "none/%u", prefixlen);
+        return;
+    }
+
+    inet_ntop(family, addr, str, sizeof(str));
+
+    if (prefixlen == (family == AF_INET ? 32U : 128U))
+        snprintf(buf, size, "%s", str);
+    else
+        snprintf(buf, size, "%s/%u", str, prefixlen);
+}
+
+void RouteSync::onRouteMsgs(const vector<struct nlmsghdr *> &msgs)
+{
+    updateRate(msgs.size());
+
+    for (auto h : msgs)
+        onRouteMsg(h);
+}
+
+void RouteSync::onRouteMsg(struct nlmsghdr *h)
+{
+    struct rtmsg *rtm = (struct rtmsg *)NLMSG_DATA(h);
+    int len = (int)h->nlmsg_len - (int)NLMSG_LENGTH(sizeof(*rtm));
     char destipprefix[MAX_ADDR_SIZE + 1] = {0};
 
-    dip = rtnl_route_get_dst(route_obj);
-    nl_addr2str(dip, destipprefix, MAX_ADDR_SIZE);
-    SWSS_LOG_DEBUG("Receive new route message dest ip prefix: %s\n", destipprefix);
+    if (len < 0)
+    {
+        SWSS_LOG_ERROR("Truncated route message, length %u\n", h->nlmsg_len);
+        return;
+    }
+
     /* Supports IPv4 or IPv6 address, otherwise return immediately */
-    auto family = rtnl_route_get_family(route_obj);
+    auto family = rtm->rtm_family;
     if (family != AF_INET && family != AF_INET6)
     {
-        SWSS_LOG_INFO("Unknown route family support: %s (object: %s)\n", destipprefix, nl_object_get_type(obj));
+        SWSS_LOG_INFO("Unknown route family support: %d\n", family);
         return;
     }
 
-    if (nlmsg_type == RTM_DELROUTE)
+    size_t addrlen = family == AF_INET ? sizeof(struct in_addr) : sizeof(struct in6_addr);
+    const void *dst = NULL;
+    const void *gateway = NULL;
+    unsigned int oif = 0;
+    bool has_oif = false;
+    struct rtattr *multipath = NULL;
+
+    /* Attributes are read in place, addresses of the wrong size are ignored */
+    for (struct rtattr *rta = RTM_RTA(rtm); RTA_OK(rta, len); rta = RTA_NEXT(rta, len))
+    {
+        switch (rta->rta_type & NLA_TYPE_MASK)
+        {
+            case RTA_DST:
+                if (RTA_PAYLOAD(rta) == addrlen)
+                    dst = RTA_DATA(rta);
+                break;
+            case RTA_GATEWAY:
+                if (RTA_PAYLOAD(rta) == addrlen)
+                    gateway = RTA_DATA(rta);
+                break;
+            case RTA_OIF:
+                if (RTA_PAYLOAD(rta) >= sizeof(oif))
+                {
+                    memcpy(&oif, RTA_DATA(rta), sizeof(oif));
+                    has_oif = true;
+                }
+                break;
+            case RTA_MULTIPATH:
+                multipath = rta;
+                break;
+            default:
+                break;
+        }
+    }
+
+    formatAddr(family, dst, rtm->rtm_dst_len, destipprefix, sizeof(destipprefix));
+    SWSS_LOG_DEBUG("Receive new route message dest ip prefix: %s\n", destipprefix);
+
+    if (h->nlmsg_type == RTM_DELROUTE)
     {
-        m_routeTable.del(destipprefix);
+        delRoute(destipprefix);
         return;
     }
-    else if (nlmsg_type != RTM_NEWROUTE)
+    else if (h->nlmsg_type != RTM_NEWROUTE)
     {
-        SWSS_LOG_INFO("Unknown message-type: %d for %s\n", nlmsg_type, destipprefix);
+        SWSS_LOG_INFO("Unknown message-type: %d for %s\n", h->nlmsg_type, destipprefix);
         return;
     }
 
-    switch (rtnl_route_get_type(route_obj))
+    switch (rtm->rtm_type)
     {
         case RTN_BLACKHOLE:
             {
                 vector<FieldValueTuple> fvVector;
                 FieldValueTuple fv("blackhole", "true");
                 fvVector.push_back(fv);
-                m_routeTable.set(destipprefix, fvVector);
+                setRoute(destipprefix, fvVector);
                 return;
             }
         case RTN_UNICAST:
@@ -75,51 +160,209 @@ void RouteSync::onMsg(int nlmsg_type, struct nl_object *obj)
     /* Geting nexthop lists */
     string nexthops;
     string ifnames;
-
-    struct nl_list_head *nhs = rtnl_route_get_nexthops(route_obj);
-    if (!nhs)
-    {
-        SWSS_LOG_INFO("Nexthop list is empty for %s\n", destipprefix);
-        return;
-    }
-
     char ifname[IFNAMSIZ] = {0};
-    for (int i = 0; i < rtnl_route_get_nnexthops(route_obj); i++)
+
+    auto addNextHop = [&](const void *addr, unsigned int ifindex)
     {
-        struct rtnl_nexthop *nexthop = rtnl_route_nexthop_n(route_obj, i);
-        struct nl_addr *addr = rtnl_route_nh_get_gateway(nexthop);
-        unsigned int ifindex = rtnl_route_nh_get_ifindex(nexthop);
+        if (!ifnames.empty())
+        {
+            nexthops += string(",");
+            ifnames += string(",");
+        }
 
         if (addr != NULL)
         {
             char gwipprefix[MAX_ADDR_SIZE + 1] = {0};
-            nl_addr2str(addr, gwipprefix, MAX_ADDR_SIZE);
+            formatAddr(family, addr, family == AF_INET ? 32 : 128, gwipprefix, sizeof(gwipprefix));
             nexthops += gwipprefix;
         }
 
-        rtnl_link_i2name(m_link_cache, ifindex, ifname, IFNAMSIZ);
-        /* Cannot get ifname. Possibly interfaces get re-created. */
-        if (!strlen(ifname))
-        {
-            rtnl_link_alloc_cache(m_nl_sock, AF_UNSPEC, &m_link_cache);
-            rtnl_link_i2name(m_link_cache, ifindex, ifname, IFNAMSIZ);
-            if (!strlen(ifname))
-                strcpy(ifname, "unknown");
-        }
+        getIfName(ifindex, ifname);
         ifnames += ifname;
+    };
 
-        if (i + 1 < rtnl_route_get_nnexthops(route_obj))
+    if (multipath)
+    {
+        struct rtnexthop *rtnh = (struct rtnexthop *)RTA_DATA(multipath);
+        int nhlen = (int)RTA_PAYLOAD(multipath);
+
+        while (RTNH_OK(rtnh, nhlen))
         {
-            nexthops += string(",");
-            ifnames += string(",");
+            const void *nhgateway = NULL;
+            int attrlen = (int)rtnh->rtnh_len - (int)RTNH_LENGTH(0);
+
+            for (struct rtattr *rta = RTNH_DATA(rtnh); RTA_OK(rta, attrlen); rta = RTA_NEXT(rta, attrlen))
+            {
+                if ((rta->rta_type & NLA_TYPE_MASK) == RTA_GATEWAY && RTA_PAYLOAD(rta) == addrlen)
+                    nhgateway = RTA_DATA(rta);
+            }
+
+            addNextHop(nhgateway, (unsigned int)rtnh->rtnh_ifindex);
+
+            nhlen -= (int)RTNH_ALIGN(rtnh->rtnh_len);
+            rtnh = RTNH_NEXT(rtnh);
         }
     }
+    else if (gateway || has_oif)
+    {
+        addNextHop(gateway, oif);
+    }
+
+    if (ifnames.empty())
+    {
+        SWSS_LOG_INFO("Nexthop list is empty for %s\n", destipprefix);
+        return;
+    }
 
     vector<FieldValueTuple> fvVector;
     FieldValueTuple nh("nexthop", nexthops);
     FieldValueTuple idx("ifname", ifnames);
     fvVector.push_back(nh);
     fvVector.push_back(idx);
-    m_routeTable.set(destipprefix, fvVector);
+    setRoute(destipprefix, fvVector);
     SWSS_LOG_DEBUG("RoutTable set: %s %s %s\n", destipprefix, nexthops.c_str(), ifnames.c_str());
 }
+
+void RouteSync::getIfName(unsigned int ifindex, char *ifname)
+{
+    ifname[0] = 0;
+    rtnl_link_i2name(m_link_cache, (int)ifindex, ifname, IFNAMSIZ);
+    /* Cannot get ifname. Possibly interfaces get re-created. */
+    if (!strlen(ifname))
+    {
+        rtnl_link_alloc_cache(m_nl_sock, AF_UNSPEC, &m_link_cache);
+        rtnl_link_i2name(m_link_cache, (int)ifindex, ifname, IFNAMSIZ);
+        if (!strlen(ifname))
+            strcpy(ifname, "unknown");
+    }
+}
+
+void RouteSync::setRoute(const string &prefix, vector<FieldValueTuple> &values)
+{
+    m_received++;
+
+    auto it = m_pending.find(prefix);
+    if (it == m_pending.end())
+    {
+        if (m_pending.empty())
+            m_deadline = chrono::steady_clock::now() + chrono::milliseconds(getFlushInterval());
+
+        m_pending[prefix] = { false, true, move(values) };
+        return;
+    }
+
+    m_coalesced++;
+    it->second.set = true;
+    it->second.values = move(values);
+}
+
+void RouteSync::delRoute(const string &prefix)
+{
+    m_received++;
+
+    auto it = m_pending.find(prefix);
+    if (it == m_pending.end())
+    {
+        if (m_pending.empty())
+            m_deadline = chrono::steady_clock::now() + chrono::milliseconds(getFlushInterval());
+
+        m_pending[prefix] = { true, false, {} };
+        return;
+    }
+
+    m_coalesced++;
+    it->second.del = true;
+    it->second.set = false;
+    it->second.values.clear();
+}
+
+void RouteSync::updateRate(size_t updates)
+{
+    auto now = chrono::steady_clock::now();
+
+    m_windowUpdates += (unsigned int)updates;
+
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(now - m_windowStart).count();
+    if (elapsed < chrono::duration_cast<chrono::milliseconds>(RATE_WINDOW).count())
+        return;
+
+    /* Smooth the rate over the last windows, an idle period resets it */
+    unsigned int rate = (unsigned int)((uint64_t)m_windowUpdates * 1000 / (uint64_t)elapsed);
+    m_rate = (m_rate + rate) / 2;
+    if (elapsed > 10 * chrono::duration_cast<chrono::milliseconds>(RATE_WINDOW).count())
+        m_rate = rate;
+
+    m_windowUpdates = 0;
+    m_windowStart = now;
+}
+
+unsigned int RouteSync::getFlushInterval() const
+{
+    unsigned int interval = m_rate / FLUSH_RATE_PER_MSEC;
+    return interval < FLUSH_MAX_INTERVAL ? interval : FLUSH_MAX_INTERVAL;
+}
+
+unsigned int RouteSync::getFlushTimeout() const
+{
+    if (m_pending.empty())
+        return numeric_limits<unsigned int>::max();
+
+    if (m_pending.size() >= FLUSH_MAX_PENDING)
+        return 0;
+
+    auto left = chrono::duration_cast<chrono::milliseconds>(m_deadline - chrono::steady_clock::now()).count();
+    return left > 0 ? (unsigned int)left : 0;
+}
+
+void RouteSync::flush()
+{
+    if (m_pending.empty())
+        return;
+
+    m_flushes++;
+
+    while (!m_pending.empty())
+    {
+        vector<string> dels;
+        vector<KeyOpFieldsValuesTuple> sets;
+
+        /* Batches are bounded since redis is blocked while one is applied */
+        auto end = m_pending.begin();
+        for (size_t n = 0; end != m_pending.end() && n < FLUSH_MAX_PENDING; ++end, ++n)
+        {
+            const PendingRoute &route = end->second;
+
+            if (route.del)
+                dels.push_back(end->first);
+            if (route.set)
+                sets.emplace_back(end->first, SET_COMMAND, route.values);
+        }
+
+        /*
+         * Deletes go first, a route both deleted and set is replaced. The
+         * routes stay pending until their batch is written.
+         */
+        if (!dels.empty())
+            m_routeTable.del(dels);
+        if (!sets.empty())
+            m_routeTable.set(sets);
+
+        m_flushed += (uint64_t)distance(m_pending.begin(), end);
+        m_pending.erase(m_pending.begin(), end);
+    }
+}
+
+void RouteSync::dumpStats(Table &table)
+{
+    vector<FieldValueTuple> fvs = {
+        { "received", to_string(m_received) },
+        { "coalesced", to_string(m_coalesced) },
+        { "flushes", to_string(m_flushes) },
+        { "flushed", to_string(m_flushed) },
+        { "pending", to_string(m_pending.size()) },
+        { "update_rate", to_string(m_rate) },
+        { "flush_interval_msec", to_string(getFlushInterval()) },
+    };
+
+    table.set(APP_ROUTE_TABLE_NAME, fvs);
+}
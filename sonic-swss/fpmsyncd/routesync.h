@@ -1,25 +1,80 @@
 #ifndef __ROUTESYNC__
 #define __ROUTESYNC__
 
+#include <vector>
+#include <chrono>
+#include <unordered_map>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "netmsg.h"
 
 namespace swss {
 
-class RouteSync : public NetMsg
+class RouteSync
 {
 public:
     enum { MAX_ADDR_SIZE = 64 };
 
+    /* Pending routes are flushed at once when there are this many */
+    static const size_t FLUSH_MAX_PENDING = 4096;
+    /* Upper bound of the flush deadline, in ms */
+    static const unsigned int FLUSH_MAX_INTERVAL = 50;
+    /* Route updates per second adding 1ms to the flush deadline */
+    static const unsigned int FLUSH_RATE_PER_MSEC = 1000;
+
     RouteSync(RedisPipeline *pipeline);
 
-    virtual void onMsg(int nlmsg_type, struct nl_object *obj);
+    /* Decode a batch of RTM_NEWROUTE/RTM_DELROUTE messages in place */
+    void onRouteMsgs(const std::vector<struct nlmsghdr *> &msgs);
+
+    void onRouteMsg(struct nlmsghdr *h);
+
+    /*
+     * Updates are held per prefix, the last one wins, until flush(). The
+     * deadline is short while updates are rare and grows with their rate,
+     * so that bursts are coalesced without delaying single changes.
+     */
+    unsigned int getFlushTimeout() const;
+    void flush();
+
+    /* Write the update, coalescing and flush counters */
+    void dumpStats(Table &table);
 
 private:
+    struct PendingRoute
+    {
+        bool del;       /* delete the route before setting it */
+        bool set;
+        std::vector<FieldValueTuple> values;
+    };
+
     ProducerStateTable m_routeTable;
     struct nl_cache *m_link_cache;
     struct nl_sock *m_nl_sock;
+
+    std::unordered_map<std::string, PendingRoute> m_pending;
+    std::chrono::steady_clock::time_point m_deadline;
+
+    /* Route updates per second, measured from m_windowStart on */
+    unsigned int m_rate;
+    unsigned int m_windowUpdates;
+    std::chrono::steady_clock::time_point m_windowStart;
+
+    uint64_t m_received;
+    uint64_t m_coalesced;
+    uint64_t m_flushes;
+    uint64_t m_flushed;
+
+    void setRoute(const std::string &prefix, std::vector<FieldValueTuple> &values);
+    void delRoute(const std::string &prefix);
+    void updateRate(size_t updates);
+    unsigned int getFlushInterval() const;
+
+    /* Name of the interface, "unknown" if it doesn't exist */
+    void getIfName(unsigned int ifindex, char *ifname);
 };
 
 }
@@ -5,20 +5,18 @@
 #include "schema.h"
 #include "ipprefix.h"
 #include "converter.h"
+#include "saiserialize.h"
+
+#include <sairedis.h>
 
 using namespace std;
 using namespace swss;
 
-mutex AclOrch::m_countersMutex;
 map<acl_range_properties_t, AclRange*> AclRange::m_ranges;
-condition_variable AclOrch::m_sleepGuard;
 bool AclOrch::m_bCollectCounters = true;
 sai_uint32_t AclRule::m_minPriority = 0;
 sai_uint32_t AclRule::m_maxPriority = 0;
 
-swss::DBConnector AclOrch::m_db(COUNTERS_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
-swss::Table AclOrch::m_countersTable(&m_db, "COUNTERS");
-
 extern sai_acl_api_t*    sai_acl_api;
 extern sai_port_api_t*   sai_port_api;
 extern sai_switch_api_t* sai_switch_api;
@@ -77,6 +75,41 @@ inline string toUpper(const string& str)
     return uppercase;
 }
 
+inline bool isRangeMatch(sai_acl_entry_attr_t attr)
+{
+    return ((sai_acl_range_type_t)attr == SAI_ACL_RANGE_TYPE_L4_SRC_PORT_RANGE) ||
+           ((sai_acl_range_type_t)attr == SAI_ACL_RANGE_TYPE_L4_DST_PORT_RANGE);
+}
+
+inline bool isSameList(const sai_object_list_t &a, const sai_object_list_t &b)
+{
+    return a.count == b.count &&
+           (a.count == 0 || memcmp(a.list, b.list, a.count * sizeof(sai_object_id_t)) == 0);
+}
+
+inline bool isSameValue(sai_acl_entry_attr_t attr, const sai_attribute_value_t &a, const sai_attribute_value_t &b)
+{
+    switch (attr)
+    {
+        // lists hold pointers, compare what they point to
+        case SAI_ACL_ENTRY_ATTR_FIELD_IN_PORTS:
+        case SAI_ACL_ENTRY_ATTR_FIELD_OUT_PORTS:
+        case SAI_ACL_ENTRY_ATTR_FIELD_ACL_RANGE_TYPE:
+            return a.aclfield.enable == b.aclfield.enable &&
+                   isSameList(a.aclfield.data.objlist, b.aclfield.data.objlist);
+
+        case SAI_ACL_ENTRY_ATTR_ACTION_MIRROR_INGRESS:
+        case SAI_ACL_ENTRY_ATTR_ACTION_MIRROR_EGRESS:
+        case SAI_ACL_ENTRY_ATTR_ACTION_REDIRECT_LIST:
+            return a.aclaction.enable == b.aclaction.enable &&
+                   isSameList(a.aclaction.parameter.objlist, b.aclaction.parameter.objlist);
+
+        default:
+            // values are zeroed before they are parsed
+            return memcmp(&a, &b, sizeof(a)) == 0;
+    }
+}
+
 inline string trim(const std::string& str, const std::string& whitespace = " \t")
 {
     const auto strBegin = str.find_first_not_of(whitespace);
@@ -126,6 +159,7 @@ bool AclRule::validateAddMatch(string attr_name, string attr_value)
     SWSS_LOG_ENTER();
 
     sai_attribute_value_t value;
+    memset(&value, 0, sizeof(value));
 
     try
     {
@@ -270,24 +304,79 @@ bool AclRule::create()
 {
     SWSS_LOG_ENTER();
 
-    sai_object_id_t table_oid = m_pAclOrch->getTableById(m_tableId);
-    vector<sai_attribute_t> rule_attrs;
-    sai_object_id_t range_objects[2];
-    sai_object_list_t range_object_list = {0, range_objects};
-
-    sai_attribute_t attr;
     sai_status_t status;
 
-    if (!createCounter())
+    // a deactivated mirror rule kept its counter
+    if (m_counterOid == SAI_NULL_OBJECT_ID)
+    {
+        if (!createCounter())
+        {
+            return false;
+        }
+
+        SWSS_LOG_INFO("Created counter for the rule %s in table %s", m_id.c_str(), m_tableId.c_str());
+    }
+
+    if (!createRanges())
     {
         return false;
     }
 
-    SWSS_LOG_INFO("Created counter for the rule %s in table %s", m_id.c_str(), m_tableId.c_str());
+    vector<sai_attribute_t> rule_attrs = getEntryAttributes();
+
+    status = sai_acl_api->create_acl_entry(&m_ruleOid, gSwitchId, (uint32_t)rule_attrs.size(), rule_attrs.data());
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to create ACL rule");
+        AclRange::remove(m_rangeOids.data(), (int)m_rangeOids.size());
+        m_rangeOids.clear();
+        decreaseNextHopRefCount();
+        return false;
+    }
+
+    AclOrch::addFlexCounter(*this);
+
+    return true;
+}
+
+bool AclRule::createRanges()
+{
+    SWSS_LOG_ENTER();
+
+    m_rangeOids.clear();
+
+    for (auto it : m_matches)
+    {
+        if (!isRangeMatch(it.first))
+        {
+            continue;
+        }
+
+        SWSS_LOG_INFO("Creating range object %u..%u", it.second.u32range.min, it.second.u32range.max);
+
+        AclRange *range = AclRange::create((sai_acl_range_type_t)it.first, it.second.u32range.min, it.second.u32range.max);
+        if (!range)
+        {
+            // release already created range if any
+            AclRange::remove(m_rangeOids.data(), (int)m_rangeOids.size());
+            m_rangeOids.clear();
+            return false;
+        }
+
+        m_rangeOids.push_back(range->getOid());
+    }
+
+    return true;
+}
+
+vector<sai_attribute_t> AclRule::getEntryAttributes()
+{
+    vector<sai_attribute_t> rule_attrs;
+    sai_attribute_t attr;
 
     // store table oid this rule belongs to
     attr.id = SAI_ACL_ENTRY_ATTR_TABLE_ID;
-    attr.value.oid = table_oid;
+    attr.value.oid = m_tableOid;
     rule_attrs.push_back(attr);
 
     attr.id = SAI_ACL_ENTRY_ATTR_PRIORITY;
@@ -304,42 +393,27 @@ bool AclRule::create()
     attr.value.aclaction.enable = true;
     rule_attrs.push_back(attr);
 
-    // store matches
+    // store matches, ranges are added as a list
     for (auto it : m_matches)
     {
-        // collect ranges and add them later as a list
-        if (((sai_acl_range_type_t)it.first == SAI_ACL_RANGE_TYPE_L4_SRC_PORT_RANGE) ||
-            ((sai_acl_range_type_t)it.first == SAI_ACL_RANGE_TYPE_L4_DST_PORT_RANGE))
-        {
-            SWSS_LOG_INFO("Creating range object %u..%u", it.second.u32range.min, it.second.u32range.max);
-
-            AclRange *range = AclRange::create((sai_acl_range_type_t)it.first, it.second.u32range.min, it.second.u32range.max);
-            if (!range)
-            {
-                // release already created range if any
-                AclRange::remove(range_objects, range_object_list.count);
-                return false;
-            }
-            else
-            {
-                range_objects[range_object_list.count++] = range->getOid();
-            }
-        }
-        else
+        if (isRangeMatch(it.first))
         {
-            attr.id = it.first;
-            attr.value = it.second;
-            attr.value.aclfield.enable = true;
-            rule_attrs.push_back(attr);
+            continue;
         }
+
+        attr.id = it.first;
+        attr.value = it.second;
+        attr.value.aclfield.enable = true;
+        rule_attrs.push_back(attr);
     }
 
     // store ranges if any
-    if (range_object_list.count > 0)
+    if (!m_rangeOids.empty())
     {
         attr.id = SAI_ACL_ENTRY_ATTR_FIELD_ACL_RANGE_TYPE;
         attr.value.aclfield.enable = true;
-        attr.value.aclfield.data.objlist = range_object_list;
+        attr.value.aclfield.data.objlist.count = (uint32_t)m_rangeOids.size();
+        attr.value.aclfield.data.objlist.list = m_rangeOids.data();
         rule_attrs.push_back(attr);
     }
 
@@ -351,15 +425,365 @@ bool AclRule::create()
         rule_attrs.push_back(attr);
     }
 
-    status = sai_acl_api->create_acl_entry(&m_ruleOid, gSwitchId, (uint32_t)rule_attrs.size(), rule_attrs.data());
-    if (status != SAI_STATUS_SUCCESS)
+    return rule_attrs;
+}
+
+bool AclRule::updateInPlace(AclRule &installed)
+{
+    SWSS_LOG_ENTER();
+
+    if (!canProgramInBulk() || !installed.canProgramInBulk() ||
+        installed.m_ruleOid == SAI_NULL_OBJECT_ID || m_tableOid != installed.m_tableOid)
     {
-        SWSS_LOG_ERROR("Failed to create ACL rule");
-        AclRange::remove(range_objects, range_object_list.count);
-        decreaseNextHopRefCount();
+        return false;
+    }
+
+    vector<sai_attribute_t> rule_attrs;
+    sai_attribute_t attr;
+
+    if (m_priority != installed.m_priority)
+    {
+        attr.id = SAI_ACL_ENTRY_ATTR_PRIORITY;
+        attr.value.u32 = m_priority;
+        rule_attrs.push_back(attr);
+    }
+
+    for (auto it : m_matches)
+    {
+        auto old = installed.m_matches.find(it.first);
+        if (old != installed.m_matches.end() && isSameValue(it.first, old->second, it.second))
+        {
+            continue;
+        }
+
+        // range objects can't be swapped while the entry references them
+        if (isRangeMatch(it.first))
+        {
+            return false;
+        }
+
+        attr.id = it.first;
+        attr.value = it.second;
+        attr.value.aclfield.enable = true;
+        rule_attrs.push_back(attr);
+    }
+
+    for (auto it : installed.m_matches)
+    {
+        if (m_matches.find(it.first) != m_matches.end())
+        {
+            continue;
+        }
+
+        if (isRangeMatch(it.first))
+        {
+            return false;
+        }
+
+        attr.id = it.first;
+        attr.value = it.second;
+        attr.value.aclfield.enable = false;
+        rule_attrs.push_back(attr);
+    }
+
+    for (auto it : m_actions)
+    {
+        auto old = installed.m_actions.find(it.first);
+        if (old != installed.m_actions.end() && isSameValue(it.first, old->second, it.second))
+        {
+            continue;
+        }
+
+        attr.id = it.first;
+        attr.value = it.second;
+        rule_attrs.push_back(attr);
+    }
+
+    for (auto it : installed.m_actions)
+    {
+        if (m_actions.find(it.first) != m_actions.end())
+        {
+            continue;
+        }
+
+        attr.id = it.first;
+        attr.value = it.second;
+        attr.value.aclaction.enable = false;
+        rule_attrs.push_back(attr);
+    }
+
+    for (const auto &rule_attr : rule_attrs)
+    {
+        sai_status_t status = sai_acl_api->set_acl_entry_attribute(installed.m_ruleOid, &rule_attr);
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to set attribute %u of ACL rule %s in table %s, rv:%d",
+                    rule_attr.id, m_id.c_str(), m_tableId.c_str(), status);
+            return false;
+        }
     }
 
-    return (status == SAI_STATUS_SUCCESS);
+    // entry keeps its counter and the ranges of the same range matches
+    m_ruleOid = installed.m_ruleOid;
+    m_counterOid = installed.m_counterOid;
+    m_rangeOids = installed.m_rangeOids;
+
+    installed.m_ruleOid = SAI_NULL_OBJECT_ID;
+    installed.m_counterOid = SAI_NULL_OBJECT_ID;
+    installed.m_rangeOids.clear();
+
+    // redirect target of this rule is already referenced
+    installed.decreaseNextHopRefCount();
+
+    SWSS_LOG_INFO("Updated %zu attributes of ACL rule %s in table %s",
+            rule_attrs.size(), m_id.c_str(), m_tableId.c_str());
+
+    return true;
+}
+
+/*
+ * All bulk ACL calls go through here, sairedis bulk APIs for ACL objects are
+ * not part of SAI. Create fills oids, remove takes them. Waits for syncd,
+ * statuses are the ones of the SAI calls.
+ */
+static void bulkAclObjects(sai_common_api_t api, sai_object_type_t type, uint32_t count,
+        const uint32_t *attr_counts, const sai_attribute_t *const *attr_lists,
+        sai_object_id_t *oids, sai_status_t *statuses)
+{
+    SWSS_LOG_ENTER();
+
+    sai_bulk_op_type_t mode = SAI_REDIS_BULK_OP_TYPE_WAIT(SAI_BULK_OP_TYPE_INGORE_ERROR);
+
+    if (api == SAI_COMMON_API_CREATE && type == SAI_OBJECT_TYPE_ACL_ENTRY)
+        redis_bulk_object_create_acl_entries(gSwitchId, count, attr_counts, attr_lists, mode, oids, statuses);
+    else if (api == SAI_COMMON_API_CREATE && type == SAI_OBJECT_TYPE_ACL_COUNTER)
+        redis_bulk_object_create_acl_counters(gSwitchId, count, attr_counts, attr_lists, mode, oids, statuses);
+    else if (api == SAI_COMMON_API_REMOVE && type == SAI_OBJECT_TYPE_ACL_ENTRY)
+        redis_bulk_object_remove_acl_entries(count, oids, mode, statuses);
+    else if (api == SAI_COMMON_API_REMOVE && type == SAI_OBJECT_TYPE_ACL_COUNTER)
+        redis_bulk_object_remove_acl_counters(count, oids, mode, statuses);
+    else
+        throw logic_error("Unsupported bulk ACL operation");
+}
+
+vector<bool> AclRule::createInBulk(const vector<shared_ptr<AclRule>> &rules)
+{
+    SWSS_LOG_ENTER();
+
+    uint32_t count = (uint32_t)rules.size();
+    vector<bool> created(count, false);
+
+    if (count == 0)
+    {
+        return created;
+    }
+
+    vector<vector<sai_attribute_t>> attrs(count);
+    vector<uint32_t> attr_counts;
+    vector<const sai_attribute_t *> attr_lists;
+    vector<sai_object_id_t> oids(count, SAI_NULL_OBJECT_ID);
+    vector<sai_status_t> statuses(count, SAI_STATUS_FAILURE);
+
+    // counters first, every entry references its counter
+    for (uint32_t i = 0; i < count; i++)
+    {
+        attrs[i] = rules[i]->getCounterAttributes();
+        attr_counts.push_back((uint32_t)attrs[i].size());
+        attr_lists.push_back(attrs[i].data());
+    }
+
+    bulkAclObjects(SAI_COMMON_API_CREATE, SAI_OBJECT_TYPE_ACL_COUNTER, count,
+            attr_counts.data(), attr_lists.data(), oids.data(), statuses.data());
+
+    vector<uint32_t> pending;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        AclRule &rule = *rules[i];
+
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to create counter for the rule %s in table %s", rule.m_id.c_str(), rule.m_tableId.c_str());
+            continue;
+        }
+
+        rule.m_counterOid = oids[i];
+
+        // ranges are shared with the rules having the same range matches
+        if (!rule.createRanges())
+        {
+            continue;
+        }
+
+        pending.push_back(i);
+    }
+
+    attr_counts.clear();
+    attr_lists.clear();
+
+    for (auto i : pending)
+    {
+        attrs[i] = rules[i]->getEntryAttributes();
+        attr_counts.push_back((uint32_t)attrs[i].size());
+        attr_lists.push_back(attrs[i].data());
+    }
+
+    if (!pending.empty())
+    {
+        oids.assign(pending.size(), SAI_NULL_OBJECT_ID);
+        statuses.assign(pending.size(), SAI_STATUS_FAILURE);
+
+        bulkAclObjects(SAI_COMMON_API_CREATE, SAI_OBJECT_TYPE_ACL_ENTRY, (uint32_t)pending.size(),
+                attr_counts.data(), attr_lists.data(), oids.data(), statuses.data());
+
+        for (size_t j = 0; j < pending.size(); j++)
+        {
+            AclRule &rule = *rules[pending[j]];
+
+            if (statuses[j] != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to create ACL rule %s in table %s, rv:%d", rule.m_id.c_str(), rule.m_tableId.c_str(), statuses[j]);
+                AclRange::remove(rule.m_rangeOids.data(), (int)rule.m_rangeOids.size());
+                rule.m_rangeOids.clear();
+                continue;
+            }
+
+            rule.m_ruleOid = oids[j];
+            created[pending[j]] = true;
+
+            AclOrch::addFlexCounter(rule);
+        }
+    }
+
+    // release what the rules which failed hold
+    vector<sai_object_id_t> counter_oids;
+    vector<uint32_t> counter_rules;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (created[i])
+        {
+            continue;
+        }
+
+        rules[i]->decreaseNextHopRefCount();
+
+        if (rules[i]->m_counterOid != SAI_NULL_OBJECT_ID)
+        {
+            counter_oids.push_back(rules[i]->m_counterOid);
+            counter_rules.push_back(i);
+        }
+    }
+
+    if (!counter_oids.empty())
+    {
+        statuses.assign(counter_oids.size(), SAI_STATUS_FAILURE);
+
+        bulkAclObjects(SAI_COMMON_API_REMOVE, SAI_OBJECT_TYPE_ACL_COUNTER, (uint32_t)counter_oids.size(),
+                NULL, NULL, counter_oids.data(), statuses.data());
+
+        for (size_t j = 0; j < counter_oids.size(); j++)
+        {
+            if (statuses[j] == SAI_STATUS_SUCCESS)
+            {
+                rules[counter_rules[j]]->m_counterOid = SAI_NULL_OBJECT_ID;
+            }
+            else
+            {
+                SWSS_LOG_ERROR("Failed to remove ACL counter %lX, rv:%d", counter_oids[j], statuses[j]);
+            }
+        }
+    }
+
+    return created;
+}
+
+vector<bool> AclRule::removeInBulk(const vector<shared_ptr<AclRule>> &rules)
+{
+    SWSS_LOG_ENTER();
+
+    uint32_t count = (uint32_t)rules.size();
+    vector<bool> removed(count, false);
+
+    vector<sai_object_id_t> oids;
+    vector<uint32_t> indexes;
+    vector<sai_status_t> statuses;
+
+    // entries first, they reference the counters and ranges
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (rules[i]->m_ruleOid != SAI_NULL_OBJECT_ID)
+        {
+            oids.push_back(rules[i]->m_ruleOid);
+            indexes.push_back(i);
+        }
+    }
+
+    if (!oids.empty())
+    {
+        statuses.assign(oids.size(), SAI_STATUS_FAILURE);
+
+        bulkAclObjects(SAI_COMMON_API_REMOVE, SAI_OBJECT_TYPE_ACL_ENTRY, (uint32_t)oids.size(),
+                NULL, NULL, oids.data(), statuses.data());
+
+        for (size_t j = 0; j < oids.size(); j++)
+        {
+            AclRule &rule = *rules[indexes[j]];
+
+            if (statuses[j] != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to delete ACL rule %s, rv:%d", rule.m_id.c_str(), statuses[j]);
+                continue;
+            }
+
+            rule.m_ruleOid = SAI_NULL_OBJECT_ID;
+            rule.decreaseNextHopRefCount();
+            rule.removeRanges();
+            rule.m_rangeOids.clear();
+        }
+    }
+
+    // counters of the removed entries, also the ones left by a previous attempt
+    oids.clear();
+    indexes.clear();
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (rules[i]->m_ruleOid == SAI_NULL_OBJECT_ID && rules[i]->m_counterOid != SAI_NULL_OBJECT_ID)
+        {
+            oids.push_back(rules[i]->m_counterOid);
+            indexes.push_back(i);
+        }
+    }
+
+    if (!oids.empty())
+    {
+        statuses.assign(oids.size(), SAI_STATUS_FAILURE);
+
+        bulkAclObjects(SAI_COMMON_API_REMOVE, SAI_OBJECT_TYPE_ACL_COUNTER, (uint32_t)oids.size(),
+                NULL, NULL, oids.data(), statuses.data());
+
+        for (size_t j = 0; j < oids.size(); j++)
+        {
+            AclRule &rule = *rules[indexes[j]];
+
+            if (statuses[j] != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to remove ACL counter for rule %s in table %s", rule.m_id.c_str(), rule.m_tableId.c_str());
+                continue;
+            }
+
+            AclOrch::removeFlexCounter(rule);
+            rule.m_counterOid = SAI_NULL_OBJECT_ID;
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        removed[i] = rules[i]->m_ruleOid == SAI_NULL_OBJECT_ID && rules[i]->m_counterOid == SAI_NULL_OBJECT_ID;
+    }
+
+    return removed;
 }
 
 void AclRule::decreaseNextHopRefCount()
@@ -395,39 +819,34 @@ void AclRule::decreaseNextHopRefCount()
 bool AclRule::remove()
 {
     SWSS_LOG_ENTER();
-    sai_status_t res;
 
-    if (sai_acl_api->remove_acl_entry(m_ruleOid) != SAI_STATUS_SUCCESS)
+    bool res = removeEntry();
+
+    if (m_ruleOid != SAI_NULL_OBJECT_ID)
     {
-        SWSS_LOG_ERROR("Failed to delete ACL rule");
         return false;
     }
 
-    m_ruleOid = SAI_NULL_OBJECT_ID;
-
-    decreaseNextHopRefCount();
-
-    res = removeRanges();
     res &= removeCounter();
 
     return res;
 }
 
-AclRuleCounters AclRule::getCounters()
+bool AclRule::removeEntry()
 {
     SWSS_LOG_ENTER();
 
-    sai_attribute_t counter_attr[2];
-    counter_attr[0].id = SAI_ACL_COUNTER_ATTR_PACKETS;
-    counter_attr[1].id = SAI_ACL_COUNTER_ATTR_BYTES;
-
-    if (sai_acl_api->get_acl_counter_attribute(m_counterOid, 2, counter_attr) != SAI_STATUS_SUCCESS)
+    if (sai_acl_api->remove_acl_entry(m_ruleOid) != SAI_STATUS_SUCCESS)
     {
-        SWSS_LOG_ERROR("Failed to get counters for %s rule", m_id.c_str());
-        return AclRuleCounters();
+        SWSS_LOG_ERROR("Failed to delete ACL rule");
+        return false;
     }
 
-    return AclRuleCounters(counter_attr[0].value.u64, counter_attr[1].value.u64);
+    m_ruleOid = SAI_NULL_OBJECT_ID;
+
+    decreaseNextHopRefCount();
+
+    return removeRanges();
 }
 
 shared_ptr<AclRule> AclRule::makeShared(acl_table_type_t type, AclOrch *acl, MirrorOrch *mirror, const string& rule, const string& table, const KeyOpFieldsValuesTuple& data)
@@ -471,10 +890,8 @@ shared_ptr<AclRule> AclRule::makeShared(acl_table_type_t type, AclOrch *acl, Mir
     throw runtime_error("Wrong combination of table type and action in rule " + rule);
 }
 
-bool AclRule::createCounter()
+vector<sai_attribute_t> AclRule::getCounterAttributes()
 {
-    SWSS_LOG_ENTER();
-
     sai_attribute_t attr;
     vector<sai_attribute_t> counter_attrs;
 
@@ -490,6 +907,15 @@ bool AclRule::createCounter()
     attr.value.booldata = true;
     counter_attrs.push_back(attr);
 
+    return counter_attrs;
+}
+
+bool AclRule::createCounter()
+{
+    SWSS_LOG_ENTER();
+
+    vector<sai_attribute_t> counter_attrs = getCounterAttributes();
+
     if (sai_acl_api->create_acl_counter(&m_counterOid, gSwitchId, (uint32_t)counter_attrs.size(), counter_attrs.data()) != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to create counter for the rule %s in table %s", m_id.c_str(), m_tableId.c_str());
@@ -502,15 +928,20 @@ bool AclRule::createCounter()
 bool AclRule::removeRanges()
 {
     SWSS_LOG_ENTER();
+
+    bool res = true;
+
     for (auto it : m_matches)
     {
-        if (((sai_acl_range_type_t)it.first == SAI_ACL_RANGE_TYPE_L4_SRC_PORT_RANGE) ||
-            ((sai_acl_range_type_t)it.first == SAI_ACL_RANGE_TYPE_L4_DST_PORT_RANGE))
+        if (isRangeMatch(it.first))
         {
-            return AclRange::remove((sai_acl_range_type_t)it.first, it.second.u32range.min, it.second.u32range.max);
+            res &= AclRange::remove((sai_acl_range_type_t)it.first, it.second.u32range.min, it.second.u32range.max);
         }
     }
-    return true;
+
+    m_rangeOids.clear();
+
+    return res;
 }
 
 bool AclRule::removeCounter()
@@ -529,7 +960,7 @@ bool AclRule::removeCounter()
     }
 
     SWSS_LOG_INFO("Removing record about the counter %lX from the DB", m_counterOid);
-    AclOrch::getCountersTable().del(getTableId() + ":" + getId());
+    AclOrch::removeFlexCounter(*this);
 
     m_counterOid = SAI_NULL_OBJECT_ID;
 
@@ -547,6 +978,7 @@ bool AclRuleL3::validateAddAction(string attr_name, string _attr_value)
 
     string attr_value = toUpper(_attr_value);
     sai_attribute_value_t value;
+    memset(&value, 0, sizeof(value));
 
     if (attr_name != ACTION_PACKET_ACTION)
     {
@@ -604,16 +1036,16 @@ sai_object_id_t AclRuleL3::getRedirectObjectId(const string& redirect_value)
     string target = redirect_value.substr(colon_pos + 1);
 
     // Try to parse physical port and LAG first
-    Port port;
-    if(m_pAclOrch->m_portOrch->getPort(target, port))
+    const Port *port = m_pAclOrch->m_portOrch->findPort(target);
+    if (port != nullptr)
     {
-        if (port.m_type == Port::PHY)
+        if (port->m_type == Port::PHY)
         {
-            return port.m_port_id;
+            return port->m_port_id;
         }
-        else if (port.m_type == Port::LAG)
+        else if (port->m_type == Port::LAG)
         {
-            return port.m_lag_id;
+            return port->m_lag_id;
         }
         else
         {
@@ -797,9 +1229,10 @@ bool AclRuleMirror::create()
 
 bool AclRuleMirror::remove()
 {
+    // only the counter is left while the session is down
     if (!m_state)
     {
-        return true;
+        return removeCounter();
     }
 
     if (!AclRule::remove())
@@ -836,26 +1269,23 @@ void AclRuleMirror::update(SubjectType type, void *cntx)
         SWSS_LOG_INFO("Activating mirroring ACL %s for session %s", m_id.c_str(), m_sessionName.c_str());
         create();
     }
-    else
+    else if (m_state)
     {
-        // Store counters before deactivating ACL rule
-        counters += getCounters();
-
+        // counter is kept, it goes on from its totals when the session is back
         SWSS_LOG_INFO("Deactivating mirroring ACL %s for session %s", m_id.c_str(), m_sessionName.c_str());
-        remove();
-    }
-}
 
-AclRuleCounters AclRuleMirror::getCounters()
-{
-    AclRuleCounters cnt(counters);
+        if (!removeEntry())
+        {
+            return;
+        }
 
-    if (m_state)
-    {
-        cnt += AclRule::getCounters();
-    }
+        if (!m_pMirrorOrch->decreaseRefCount(m_sessionName))
+        {
+            throw runtime_error("Failed to decrease mirror session reference count");
+        }
 
-    return cnt;
+        m_state = false;
+    }
 }
 
 AclRange::AclRange(sai_acl_range_type_t type, sai_object_id_t oid, int min, int max):
@@ -939,18 +1369,27 @@ bool AclRange::remove(sai_object_id_t *oids, int oidsCnt)
 {
     SWSS_LOG_ENTER();
 
-    for (int oidIdx = 0; oidIdx < oidsCnt; oidsCnt++)
+    bool res = true;
+
+    for (int oidIdx = 0; oidIdx < oidsCnt; oidIdx++)
     {
-        for (auto it : m_ranges)
+        auto range_it = m_ranges.begin();
+
+        while (range_it != m_ranges.end() && range_it->second->m_oid != oids[oidIdx])
         {
-            if (it.second->m_oid == oids[oidsCnt])
-            {
-                return it.second->remove();
-            }
+            range_it++;
+        }
+
+        if (range_it == m_ranges.end())
+        {
+            res = false;
+            continue;
         }
+
+        res &= range_it->second->remove();
     }
 
-    return false;
+    return res;
 }
 
 bool AclRange::remove()
@@ -1008,21 +1447,29 @@ AclOrch::AclOrch(DBConnector *db, vector<string> tableNames, PortsOrch *portOrch
         throw "AclOrch initialization failure";
     }
 
-    m_mirrorOrch->attach(this);
+    // unit tests run without mirror sessions
+    if (m_mirrorOrch)
+    {
+        m_mirrorOrch->attach(this);
+    }
 
-    // Should be initialized last to guaranty that object is
-    // initialized before thread start.
-    m_countersThread = thread(AclOrch::collectCountersThread, this);
+    if (m_bCollectCounters)
+    {
+        DBConnector flexCounterDb(FLEX_COUNTER_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
+        ProducerStateTable flexCounterGroupTable(&flexCounterDb, FLEX_COUNTER_GROUP_TABLE);
+
+        vector<FieldValueTuple> fieldValues;
+        fieldValues.emplace_back(POLL_INTERVAL_FIELD, to_string(COUNTERS_READ_INTERVAL * 1000));
+        flexCounterGroupTable.set(ACL_FLEX_COUNTER_GROUP, fieldValues);
+    }
 }
 
 AclOrch::~AclOrch()
 {
-    m_mirrorOrch->detach(this);
-
-    m_bCollectCounters = false;
-    m_sleepGuard.notify_all();
-
-    m_countersThread.join();
+    if (m_mirrorOrch)
+    {
+        m_mirrorOrch->detach(this);
+    }
 }
 
 void AclOrch::update(SubjectType type, void *cntx)
@@ -1034,8 +1481,6 @@ void AclOrch::update(SubjectType type, void *cntx)
         return;
     }
 
-    unique_lock<mutex> lock(m_countersMutex);
-
     for (const auto& table : m_AclTables)
     {
         for (auto& rule : table.second.rules)
@@ -1053,12 +1498,10 @@ void AclOrch::doTask(Consumer &consumer)
 
     if (table_name == APP_ACL_TABLE_NAME)
     {
-        unique_lock<mutex> lock(m_countersMutex);
         doAclTableTask(consumer);
     }
     else if (table_name == APP_ACL_RULE_TABLE_NAME)
     {
-        unique_lock<mutex> lock(m_countersMutex);
         doAclRuleTask(consumer);
     }
     else
@@ -1198,7 +1641,7 @@ void AclOrch::doAclTableTask(Consumer &consumer)
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
+        auto &t = it->second;
         string key = kfvKey(t);
         size_t found = key.find(':');
         string table_id = key.substr(0, found);
@@ -1278,10 +1721,13 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
 
+    /* Rules to create and remove in bulk, their tasks stay in m_toSync until flushed */
+    vector<AclRuleChange> changes;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
+        auto &t = it->second;
         string key = kfvKey(t);
         size_t found = key.find(':');
         string table_id = key.substr(0, found);
@@ -1340,7 +1786,22 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
             // validate and create ACL rule
             if (bAllAttributesOk && newRule->validate())
             {
-                if(addAclRule(newRule, table_id, rule_id))
+                auto &rules = m_AclTables[table_oid].rules;
+                auto ruleIter = rules.find(rule_id);
+                shared_ptr<AclRule> installed = ruleIter != rules.end() ? ruleIter->second : nullptr;
+
+                if (installed && newRule->updateInPlace(*installed))
+                {
+                    ruleIter->second = newRule;
+                    SWSS_LOG_NOTICE("Successfully updated ACL rule %s in table %s", rule_id.c_str(), table_id.c_str());
+                    it = consumer.m_toSync.erase(it);
+                }
+                else if (newRule->canProgramInBulk() && (!installed || installed->canProgramInBulk()))
+                {
+                    changes.push_back({ key, table_oid, installed, newRule });
+                    it++;
+                }
+                else if(addAclRule(newRule, table_id, rule_id))
                     it = consumer.m_toSync.erase(it);
                 else
                     it++;
@@ -1353,7 +1814,26 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
         }
         else if (op == DEL_COMMAND)
         {
-            if(removeAclRule(table_id, rule_id))
+            sai_object_id_t table_oid = getTableById(table_id);
+            shared_ptr<AclRule> installed;
+
+            if (table_oid != SAI_NULL_OBJECT_ID)
+            {
+                auto &rules = m_AclTables[table_oid].rules;
+                auto ruleIter = rules.find(rule_id);
+
+                if (ruleIter != rules.end())
+                {
+                    installed = ruleIter->second;
+                }
+            }
+
+            if (installed && installed->canProgramInBulk())
+            {
+                changes.push_back({ key, table_oid, installed, nullptr });
+                it++;
+            }
+            else if(removeAclRule(table_id, rule_id))
                 it = consumer.m_toSync.erase(it);
             else
                 it++;
@@ -1364,6 +1844,91 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
             SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
         }
     }
+
+    flushAclRules(consumer, changes);
+}
+
+/*
+ * Remove the installed rules of the changes in bulk, then create the new
+ * rules in bulk, freeing table entries before they are needed. A rule is
+ * only created when the rule it replaces was removed. Tasks of failed
+ * changes stay in m_toSync to be retried.
+ */
+void AclOrch::flushAclRules(Consumer &consumer, const vector<AclRuleChange> &changes)
+{
+    SWSS_LOG_ENTER();
+
+    vector<shared_ptr<AclRule>> removes;
+    vector<size_t> removeChanges;
+
+    for (size_t i = 0; i < changes.size(); i++)
+    {
+        if (changes[i].installed)
+        {
+            removes.push_back(changes[i].installed);
+            removeChanges.push_back(i);
+        }
+    }
+
+    vector<bool> ready(changes.size(), true);
+    vector<bool> removed = AclRule::removeInBulk(removes);
+
+    for (size_t j = 0; j < removes.size(); j++)
+    {
+        const AclRuleChange &change = changes[removeChanges[j]];
+
+        if (!removed[j])
+        {
+            ready[removeChanges[j]] = false;
+            continue;
+        }
+
+        m_AclTables[change.tableOid].rules.erase(change.installed->getId());
+        SWSS_LOG_NOTICE("Successfully deleted ACL rule %s", change.installed->getId().c_str());
+
+        if (!change.rule)
+        {
+            consumer.m_toSync.erase(change.key);
+        }
+    }
+
+    vector<shared_ptr<AclRule>> creates;
+    vector<size_t> createChanges;
+
+    for (size_t i = 0; i < changes.size(); i++)
+    {
+        if (!changes[i].rule)
+        {
+            continue;
+        }
+
+        if (!ready[i])
+        {
+            // rule is parsed again when the task is retried
+            changes[i].rule->decreaseNextHopRefCount();
+            continue;
+        }
+
+        creates.push_back(changes[i].rule);
+        createChanges.push_back(i);
+    }
+
+    vector<bool> created = AclRule::createInBulk(creates);
+
+    for (size_t j = 0; j < creates.size(); j++)
+    {
+        const AclRuleChange &change = changes[createChanges[j]];
+
+        if (!created[j])
+        {
+            SWSS_LOG_ERROR("Failed to create rule in table %s", change.rule->getTableId().c_str());
+            continue;
+        }
+
+        m_AclTables[change.tableOid].rules[change.rule->getId()] = change.rule;
+        SWSS_LOG_NOTICE("Successfully created ACL rule %s in table %s", change.rule->getId().c_str(), change.rule->getTableId().c_str());
+        consumer.m_toSync.erase(change.key);
+    }
 }
 
 bool AclOrch::processPorts(string portsList, ports_list_t& out)
@@ -1392,20 +1957,20 @@ bool AclOrch::processPorts(string portsList, ports_list_t& out)
 
     for (const auto& alias : strList)
     {
-        Port port;
-        if (!m_portOrch->getPort(alias, port))
+        const Port *port = m_portOrch->findPort(alias);
+        if (port == nullptr)
         {
             SWSS_LOG_ERROR("Failed to process port. Port %s doesn't exist", alias.c_str());
             return false;
         }
 
-        if (port.m_type != Port::PHY)
+        if (port->m_type != Port::PHY)
         {
-            SWSS_LOG_ERROR("Failed to process port. Incorrect port %s type %d", alias.c_str(), port.m_type);
+            SWSS_LOG_ERROR("Failed to process port. Incorrect port %s type %d", alias.c_str(), port->m_type);
             return false;
         }
 
-        out.push_back(port.m_port_id);
+        out.push_back(port->m_port_id);
     }
 
     return true;
@@ -1552,47 +2117,39 @@ sai_status_t AclOrch::deleteUnbindAclTable(sai_object_id_t table_oid)
     return sai_acl_api->remove_acl_table(table_oid);
 }
 
-void AclOrch::collectCountersThread(AclOrch* pAclOrch)
+void AclOrch::addFlexCounter(AclRule &rule)
 {
     SWSS_LOG_ENTER();
 
-    while(m_bCollectCounters)
+    if (!m_bCollectCounters)
     {
-        unique_lock<mutex> lock(m_countersMutex);
-
-        chrono::duration<double, milli> timeToSleep;
-        auto  updStart = chrono::steady_clock::now();
+        return;
+    }
 
-        for (auto table_it : pAclOrch->m_AclTables)
-        {
-            vector<swss::FieldValueTuple> values;
+    string counterId = sai_serialize_object_id(rule.getCounterOid());
 
-            for (auto rule_it : table_it.second.rules)
-            {
-                AclRuleCounters cnt = rule_it.second->getCounters();
+    vector<FieldValueTuple> fieldValues;
+    fieldValues.emplace_back(ACL_COUNTER_ATTR_ID_LIST, "SAI_ACL_COUNTER_ATTR_PACKETS,SAI_ACL_COUNTER_ATTR_BYTES");
+    getFlexCounterTable().set(string(ACL_FLEX_COUNTER_GROUP) + ":" + counterId, fieldValues);
 
-                swss::FieldValueTuple fvtp("Packets", to_string(cnt.packets));
-                values.push_back(fvtp);
-                swss::FieldValueTuple fvtb("Bytes", to_string(cnt.bytes));
-                values.push_back(fvtb);
+    getCountersClient().hset(COUNTERS_ACL_COUNTER_RULE_MAP, rule.getTableId() + ":" + rule.getId(), counterId);
+}
 
-                AclOrch::getCountersTable().set(table_it.second.id + ":" + rule_it.second->getId(), values, "");
-            }
-            values.clear();
-        }
+void AclOrch::removeFlexCounter(AclRule &rule)
+{
+    SWSS_LOG_ENTER();
 
-        timeToSleep = chrono::seconds(COUNTERS_READ_INTERVAL) - (chrono::steady_clock::now() - updStart);
-        if (timeToSleep > chrono::seconds(0))
-        {
-            SWSS_LOG_DEBUG("ACL counters DB update thread: sleeping %dms", (int)timeToSleep.count());
-            m_sleepGuard.wait_for(lock, timeToSleep);
-        }
-        else
-        {
-            SWSS_LOG_WARN("ACL counters DB update time is greater than the configured update period");
-        }
+    if (!m_bCollectCounters)
+    {
+        return;
     }
 
+    string counterId = sai_serialize_object_id(rule.getCounterOid());
+
+    getFlexCounterTable().del(string(ACL_FLEX_COUNTER_GROUP) + ":" + counterId);
+
+    /* Syncd deletes COUNTERS:<counter oid> once it stopped polling it */
+    getCountersClient().hdel(COUNTERS_ACL_COUNTER_RULE_MAP, rule.getTableId() + ":" + rule.getId());
 }
 
 sai_status_t AclOrch::bindAclTable(sai_object_id_t table_oid, AclTable &aclTable, bool bind)
@@ -1620,6 +2177,7 @@ sai_status_t AclOrch::bindAclTable(sai_object_id_t table_oid, AclTable &aclTable
     {
         for (const auto& portOid : aclTable.ports)
         {
+            /* A copy, binding sets the ACL table group of the port */
             Port port;
             gPortsOrch->getPort(portOid, port);
             assert(port.m_type == Port::PHY);
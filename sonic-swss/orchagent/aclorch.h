@@ -7,15 +7,17 @@
 #include <mutex>
 #include <tuple>
 #include <map>
-#include <condition_variable>
 #include "orch.h"
 #include "portsorch.h"
 #include "mirrororch.h"
 #include "observer.h"
+#include "producerstatetable.h"
+#include "redisclient.h"
 
-// ACL counters update interval in the DB
-// Value is in seconds. Should not be less than 5 seconds
+// ACL counters are polled by syncd in this flex counter group
+// Interval is in seconds. Should not be less than 5 seconds
 // (in worst case update of 1265 counters takes almost 5 sec)
+#define ACL_FLEX_COUNTER_GROUP "ACL_STAT_COUNTER"
 #define COUNTERS_READ_INTERVAL 10
 
 #define TABLE_DESCRIPTION "POLICY_DESC"
@@ -96,31 +98,6 @@ private:
     static map<acl_range_properties_t, AclRange*> m_ranges;
 };
 
-struct AclRuleCounters
-{
-    uint64_t packets;
-    uint64_t bytes;
-
-    AclRuleCounters(uint64_t p = 0, uint64_t b = 0) :
-        packets(p),
-        bytes(b)
-    {
-    }
-
-    AclRuleCounters(const AclRuleCounters& rhs) :
-        packets(rhs.packets),
-        bytes(rhs.bytes)
-    {
-    }
-
-    AclRuleCounters& operator +=(const AclRuleCounters& rhs)
-    {
-        packets += rhs.packets;
-        bytes += rhs.bytes;
-        return *this;
-    }
-};
-
 class AclRule
 {
 public:
@@ -139,7 +116,26 @@ public:
     virtual bool create();
     virtual bool remove();
     virtual void update(SubjectType, void *) = 0;
-    virtual AclRuleCounters getCounters();
+
+    // Whether the rule is created and removed by createInBulk and removeInBulk
+    virtual bool canProgramInBulk()
+    {
+        return true;
+    }
+
+    /*
+     * Take over the ACL entry and counter of the installed rule with the same
+     * id, setting only the entry attributes which differ. Return false when
+     * the installed rule has to be removed and this one created instead.
+     */
+    bool updateInPlace(AclRule &installed);
+
+    // Create or remove rules with one bulk call per object type, return per rule result
+    static vector<bool> createInBulk(const vector<shared_ptr<AclRule>> &rules);
+    static vector<bool> removeInBulk(const vector<shared_ptr<AclRule>> &rules);
+
+    // Release the redirect target referenced when the action was parsed
+    void decreaseNextHopRefCount();
 
     string getId()
     {
@@ -160,11 +156,15 @@ public:
     virtual ~AclRule() {}
 
 protected:
+    // Remove the entry, its ranges and next hop references, not the counter
+    bool removeEntry();
     virtual bool createCounter();
     virtual bool removeCounter();
     virtual bool removeRanges();
 
-    void decreaseNextHopRefCount();
+    bool createRanges();
+    vector<sai_attribute_t> getCounterAttributes();
+    vector<sai_attribute_t> getEntryAttributes();
 
     static sai_uint32_t m_minPriority;
     static sai_uint32_t m_maxPriority;
@@ -178,8 +178,12 @@ protected:
     uint32_t m_priority;
     map <sai_acl_entry_attr_t, sai_attribute_value_t> m_matches;
     map <sai_acl_entry_attr_t, sai_attribute_value_t> m_actions;
+    // range objects of the range matches, referenced by the entry
+    vector<sai_object_id_t> m_rangeOids;
     string m_redirect_target_next_hop;
     string m_redirect_target_next_hop_group;
+
+    friend class AclOrchTest;
 };
 
 class AclRuleL3: public AclRule
@@ -205,15 +209,31 @@ public:
     bool create();
     bool remove();
     void update(SubjectType, void *);
-    AclRuleCounters getCounters();
+
+    // Entry depends on the mirror session state
+    bool canProgramInBulk()
+    {
+        return false;
+    }
 
 protected:
     bool m_state;
     string m_sessionName;
-    AclRuleCounters counters;
     MirrorOrch *m_pMirrorOrch;
 };
 
+/*
+ * Rule change of a doAclRuleTask pass, programmed in bulk by flushAclRules:
+ * installed rule is removed first, then rule is created.
+ */
+struct AclRuleChange
+{
+    string key;                         // task to complete in m_toSync
+    sai_object_id_t tableOid;
+    shared_ptr<AclRule> installed;      // rule to remove, null if none
+    shared_ptr<AclRule> rule;           // rule to create, null for a removal
+};
+
 struct AclTable {
     string id;
     string description;
@@ -246,9 +266,28 @@ public:
 
     sai_object_id_t getTableById(string table_id);
 
-    static swss::Table& getCountersTable()
+    /*
+     * Register the counter of the rule in ACL_FLEX_COUNTER_GROUP and its name
+     * in COUNTERS_ACL_COUNTER_RULE_MAP, syncd writes it to COUNTERS:<counter oid>.
+     */
+    static void addFlexCounter(AclRule &rule);
+    static void removeFlexCounter(AclRule &rule);
+
+    // Connected on first use, the DBs are not needed before rules exist
+    static ProducerStateTable& getFlexCounterTable()
+    {
+        static DBConnector db(FLEX_COUNTER_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
+        static ProducerStateTable flexCounterTable(&db, FLEX_COUNTER_TABLE);
+
+        return flexCounterTable;
+    }
+
+    static RedisClient& getCountersClient()
     {
-        return m_countersTable;
+        static DBConnector db(COUNTERS_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
+        static RedisClient client(&db);
+
+        return client;
     }
 
     // FIXME: Add getters for them? I'd better to add a common directory of orch objects and use it everywhere
@@ -266,8 +305,7 @@ private:
     void doTask(Consumer &consumer);
     void doAclTableTask(Consumer &consumer);
     void doAclRuleTask(Consumer &consumer);
-
-    static void collectCountersThread(AclOrch *pAclOrch);
+    void flushAclRules(Consumer &consumer, const vector<AclRuleChange> &changes);
 
     sai_status_t createBindAclTable(AclTable &aclTable, sai_object_id_t &table_oid);
     sai_status_t bindAclTable(sai_object_id_t table_oid, AclTable &aclTable, bool bind = true);
@@ -282,13 +320,9 @@ private:
     // ACL table OID to multiple ACL table group member
     multimap <sai_object_id_t, sai_object_id_t> m_AclTableGroupMembers;
 
-    static mutex m_countersMutex;
-    static condition_variable m_sleepGuard;
     static bool m_bCollectCounters;
-    static swss::DBConnector m_db;
-    static swss::Table m_countersTable;
 
-    thread m_countersThread;
+    friend class AclOrchTest;
 };
 
 #endif /* SWSS_ACLORCH_H */
@@ -17,11 +17,13 @@ void FdbOrch::update(sai_fdb_event_t type, const sai_fdb_entry_t* entry, sai_obj
     FdbUpdate update;
     update.entry.mac = entry->mac_address;
     update.entry.vlan = entry->vlan_id;
+    update.port = nullptr;
 
     switch (type)
     {
     case SAI_FDB_EVENT_LEARNED:
-        if (!m_portsOrch->getPortByBridgePortId(bridge_port_id, update.port))
+        update.port = m_portsOrch->findPortByBridgePortId(bridge_port_id);
+        if (update.port == nullptr)
         {
             SWSS_LOG_ERROR("Failed to get port by bridge port ID %lu", bridge_port_id);
             return;
@@ -48,7 +50,7 @@ void FdbOrch::update(sai_fdb_event_t type, const sai_fdb_entry_t* entry, sai_obj
     }
 }
 
-bool FdbOrch::getPort(const MacAddress& mac, uint16_t vlan, Port& port)
+const Port* FdbOrch::findPort(const MacAddress& mac, uint16_t vlan)
 {
     SWSS_LOG_ENTER();
 
@@ -64,16 +66,17 @@ bool FdbOrch::getPort(const MacAddress& mac, uint16_t vlan, Port& port)
     {
         SWSS_LOG_ERROR("Failed to get bridge port ID for FDB entry %s, rv:%d",
             mac.to_string().c_str(), status);
-        return false;
+        return nullptr;
     }
 
-    if (!m_portsOrch->getPortByBridgePortId(attr.value.oid, port))
+    const Port *port = m_portsOrch->findPortByBridgePortId(attr.value.oid);
+    if (port == nullptr)
     {
         SWSS_LOG_ERROR("Failed to get port by bridge port ID %lu", attr.value.oid);
-        return false;
+        return nullptr;
     }
 
-    return true;
+    return port;
 }
 
 void FdbOrch::doTask(Consumer& consumer)
@@ -83,7 +86,7 @@ void FdbOrch::doTask(Consumer& consumer)
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
+        auto &t = it->second;
 
         /* format: <VLAN_name>:<MAC_address> */
         vector<string> keys = tokenize(kfvKey(t), ':', 1);
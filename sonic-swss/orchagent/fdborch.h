@@ -19,7 +19,7 @@ struct FdbEntry
 struct FdbUpdate
 {
     FdbEntry entry;
-    Port port;
+    const Port *port;   // learned port, nullptr on removal
     bool add;
 };
 
@@ -34,7 +34,8 @@ public:
     }
 
     void update(sai_fdb_event_t, const sai_fdb_entry_t *, sai_object_id_t);
-    bool getPort(const MacAddress&, uint16_t, Port&);
+    /* Port the MAC is learned on, nullptr if there is none */
+    const Port* findPort(const MacAddress&, uint16_t);
 
 private:
     PortsOrch *m_portsOrch;
@@ -57,7 +57,7 @@ void IntfsOrch::doTask(Consumer &consumer)
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
+        auto &t = it->second;
 
         vector<string> keys = tokenize(kfvKey(t), ':');
         string alias(keys[0]);
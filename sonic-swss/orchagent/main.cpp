@@ -14,6 +14,7 @@ extern "C" {
 
 #include <sairedis.h>
 #include <logger.h>
+#include <recorder.h>
 
 #include "orchdaemon.h"
 #include "saihelper.h"
@@ -39,16 +40,15 @@ int gBatchSize = DEFAULT_BATCH_SIZE;
 
 bool gSairedisRecord = true;
 bool gSwssRecord = true;
-bool gLogRotate = false;
-ofstream gRecordOfs;
-string gRecordFile;
+bool gRecordBinary = false;
+Recorder gRecorder;
 
 /* Global database mutex */
 mutex gDbMutex;
 
 void usage()
 {
-    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-b batch_size] [-m MAC]" << endl;
+    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-f record_format] [-b batch_size] [-m MAC]" << endl;
     cout << "    -h: display this message" << endl;
     cout << "    -r record_type: record orchagent logs with type (default 3)" << endl;
     cout << "                    0: do not record logs" << endl;
@@ -56,6 +56,9 @@ void usage()
     cout << "                    2: record SwSS task sequence as swss.rec" << endl;
     cout << "                    3: enable both above two records" << endl;
     cout << "    -d record_location: set record logs folder location (default .)" << endl;
+    cout << "    -f record_format: record logs format (default text)" << endl;
+    cout << "                    text: timestamped text lines, as read by saiplayer" << endl;
+    cout << "                    binary: compact records to *.rec.bin, convert them with swssrecconvert" << endl;
     cout << "    -b batch_size: set consumer table pop operation batch size (default 128)" << endl;
     cout << "    -m MAC: set switch MAC address" << endl;
 }
@@ -65,7 +68,7 @@ void sighup_handler(int signo)
     /*
      * Don't do any logging since they are using mutexes.
      */
-    gLogRotate = true;
+    gRecorder.rotate();
 
     sai_attribute_t attr;
     attr.id = SAI_REDIS_SWITCH_ATTR_PERFORM_LOG_ROTATE;
@@ -94,7 +97,7 @@ int main(int argc, char **argv)
 
     string record_location = ".";
 
-    while ((opt = getopt(argc, argv, "b:m:r:d:h")) != -1)
+    while ((opt = getopt(argc, argv, "b:m:r:d:f:h")) != -1)
     {
         switch (opt)
         {
@@ -136,6 +139,17 @@ int main(int argc, char **argv)
                 exit(EXIT_FAILURE);
             }
             break;
+        case 'f':
+            if (!strcmp(optarg, "binary"))
+            {
+                gRecordBinary = true;
+            }
+            else if (strcmp(optarg, "text"))
+            {
+                usage();
+                exit(EXIT_FAILURE);
+            }
+            break;
         case 'h':
             usage();
             exit(EXIT_SUCCESS);
@@ -163,11 +177,15 @@ int main(int argc, char **argv)
     /* Disable/enable SwSS recording */
     if (gSwssRecord)
     {
-        gRecordFile = record_location + "/" + "swss.rec";
-        gRecordOfs.open(gRecordFile, std::ofstream::out | std::ofstream::app);
-        if (!gRecordOfs.is_open())
+        string recordFile = record_location + "/" + "swss.rec";
+        if (gRecordBinary)
+        {
+            recordFile += ".bin";
+        }
+
+        if (!gRecorder.open(recordFile, gRecordBinary ? Recorder::BINARY : Recorder::TEXT))
         {
-            SWSS_LOG_ERROR("Failed to open SwSS recording file %s", gRecordFile.c_str());
+            SWSS_LOG_ERROR("Failed to open SwSS recording file %s", recordFile.c_str());
             exit(EXIT_FAILURE);
         }
     }
@@ -329,13 +329,13 @@ bool MirrorOrch::getNeighborInfo(const string& name, MirrorEntry& session, const
     {
         session.neighborInfo.vlanId = session.neighborInfo.port.m_vlan_id;
 
-        Port member;
-        if (!m_fdbOrch->getPort(session.neighborInfo.mac, session.neighborInfo.vlanId, member))
+        const Port *member = m_fdbOrch->findPort(session.neighborInfo.mac, session.neighborInfo.vlanId);
+        if (member == nullptr)
         {
             return false;
         }
 
-        session.neighborInfo.portId = member.m_port_id;
+        session.neighborInfo.portId = member->m_port_id;
         session.neighborInfo.resolved = true;
 
         return true;
@@ -703,9 +703,9 @@ void MirrorOrch::updateFdb(const FdbUpdate& update)
             if (session.status)
             {
                 // update port if changed
-                if (session.neighborInfo.portId != update.port.m_port_id)
+                if (session.neighborInfo.portId != update.port->m_port_id)
                 {
-                    session.neighborInfo.portId = update.port.m_port_id;
+                    session.neighborInfo.portId = update.port->m_port_id;
                     updateSessionDstPort(name, session);
                 }
             }
@@ -714,7 +714,7 @@ void MirrorOrch::updateFdb(const FdbUpdate& update)
                 //activate session
                 session.neighborInfo.resolved = true;
                 session.neighborInfo.mac = update.entry.mac;
-                session.neighborInfo.portId = update.port.m_port_id;
+                session.neighborInfo.portId = update.port->m_port_id;
 
                 activateSession(name, session);
             }
@@ -845,7 +845,7 @@ void MirrorOrch::doTask(Consumer& consumer)
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
+        auto &t = it->second;
 
         string key = kfvKey(t);
         string op = kfvOp(t);
@@ -133,7 +133,7 @@ void NeighOrch::doTask(Consumer &consumer)
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
+        auto &t = it->second;
 
         string key = kfvKey(t);
         size_t found = key.find(':');
@@ -1,12 +1,15 @@
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <mutex>
+#include <chrono>
 #include <sys/time.h>
 
 #include "orch.h"
 #include "portsorch.h"
 #include "tokenize.h"
 #include "logger.h"
+#include "recorder.h"
 
 using namespace swss;
 
@@ -16,20 +19,86 @@ extern mutex gDbMutex;
 extern PortsOrch *gPortsOrch;
 
 extern bool gSwssRecord;
-extern ofstream gRecordOfs;
-extern bool gLogRotate;
-extern string gRecordFile;
-extern string getTimestamp();
+extern Recorder gRecorder;
+
+/* Resolution of the retry timers */
+#define RETRY_TICK_MSEC 10
+/* The wheel covers the longest backoff, every timer is within one turn */
+#define RETRY_WHEEL_SLOTS 128
+/* Backoff doubles with every failed attempt up to 1 sec */
+#define RETRY_MAX_TICKS 100
+
+static uint64_t retryTick()
+{
+    auto now = chrono::steady_clock::now().time_since_epoch();
+    return (uint64_t)chrono::duration_cast<chrono::milliseconds>(now).count() / RETRY_TICK_MSEC;
+}
+
+bool Consumer::addToSync(deque<KeyOpFieldsValuesTuple> &entries)
+{
+    bool first = true;
+
+    while (!entries.empty())
+    {
+        auto &entry = entries.front();
+        const string &key = kfvKey(entry);
+
+        /* If a new task comes or if a DEL task comes, we directly put it into m_toSync map */
+        auto it = m_toSync.find(key);
+        if (it == m_toSync.end())
+        {
+            m_toSync.emplace(key, move(entry));
+        }
+        else if (kfvOp(entry) == DEL_COMMAND)
+        {
+            it->second = move(entry);
+        }
+        else if (m_deltaPops && kfvOp(it->second) == DEL_COMMAND && !first)
+        {
+            /*
+             * A delta SET carries only the changed fields, the object must
+             * be removed before it is created again from them. Let doTask
+             * run the DEL first, if it is still pending then the SET
+             * replaces it.
+             */
+            return false;
+        }
+        else
+        {
+            /* If an old task is still there, we combine the old task with new task */
+            auto &existing_values = kfvFieldsValues(it->second);
+            for (auto &fv : kfvFieldsValues(entry))
+            {
+                auto iu = existing_values.begin();
+                while (iu != existing_values.end() && fvField(*iu) != fvField(fv))
+                    iu++;
+
+                if (iu == existing_values.end())
+                    existing_values.push_back(move(fv));
+                else
+                    fvValue(*iu) = move(fvValue(fv));
+            }
+            kfvOp(it->second) = kfvOp(entry);
+        }
+
+        entries.pop_front();
+        first = false;
+    }
+
+    return true;
+}
 
 Orch::Orch(DBConnector *db, string tableName) :
-    m_db(db)
+    m_db(db),
+    m_retryWheel(RETRY_WHEEL_SLOTS)
 {
     Consumer consumer(new ConsumerStateTable(m_db, tableName, gBatchSize));
     m_consumerMap.insert(ConsumerMapPair(tableName, consumer));
 }
 
 Orch::Orch(DBConnector *db, vector<string> &tableNames) :
-    m_db(db)
+    m_db(db),
+    m_retryWheel(RETRY_WHEEL_SLOTS)
 {
     for(auto it : tableNames)
     {
@@ -44,10 +113,7 @@ Orch::~Orch()
     for(auto &it : m_consumerMap)
         delete it.second.m_consumer;
 
-    if (gRecordOfs.is_open())
-    {
-        gRecordOfs.close();
-    }
+    gRecorder.close();
 }
 
 vector<Selectable *> Orch::getSelectables()
@@ -83,6 +149,8 @@ bool Orch::execute(string tableName)
     }
     Consumer& consumer = consumer_it->second;
 
+    auto start = chrono::steady_clock::now();
+
     std::deque<KeyOpFieldsValuesTuple> entries;
     consumer.m_consumer->pops(entries);
 
@@ -92,55 +160,62 @@ bool Orch::execute(string tableName)
         return true;
     }
 
-    for (auto entry: entries)
-    {
-        string key = kfvKey(entry);
-        string op  = kfvOp(entry);
+    consumer.m_executions++;
+    consumer.m_popped += entries.size();
 
-        /* Record incoming tasks */
-        if (gSwssRecord)
-        {
+    /* Record incoming tasks */
+    if (gSwssRecord)
+    {
+        for (auto &entry : entries)
             recordTuple(consumer, entry);
-        }
+    }
 
-        /* If a new task comes or if a DEL task comes, we directly put it into consumer.m_toSync map */
-        if (consumer.m_toSync.find(key) == consumer.m_toSync.end() || op == DEL_COMMAND)
-        {
-           consumer.m_toSync[key] = entry;
-        }
-        /* If an old task is still there, we combine the old task with new task */
-        else
-        {
-            KeyOpFieldsValuesTuple existing_data = consumer.m_toSync[key];
+    /* A new task for a waiting one retries it right away */
+    if (!consumer.m_waiting.empty())
+    {
+        for (auto &entry : entries)
+            resume(consumer, kfvKey(entry));
+    }
 
-            auto new_values = kfvFieldsValues(entry);
-            auto existing_values = kfvFieldsValues(existing_data);
+    bool added;
+    do
+    {
+        added = consumer.addToSync(entries);
 
+        if (!consumer.m_toSync.empty())
+            doTask(consumer);
+    } while (!added);
 
-            for (auto it : new_values)
-            {
-                string field = fvField(it);
-                string value = fvValue(it);
+    defer(consumer);
+    releaseWoken();
 
-                auto iu = existing_values.begin();
-                while (iu != existing_values.end())
-                {
-                    string ofield = fvField(*iu);
-                    if (field == ofield)
-                        iu = existing_values.erase(iu);
-                    else
-                        iu++;
-                }
-                existing_values.push_back(FieldValueTuple(field, value));
-            }
-            consumer.m_toSync[key] = KeyOpFieldsValuesTuple(key, op, existing_values);
-        }
+    auto latency = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    consumer.m_lastLatency = (uint64_t)latency;
+    consumer.m_maxLatency = max(consumer.m_maxLatency, consumer.m_lastLatency);
+
+    return true;
+}
+
+void Orch::enableDeltaPops(const string &tableName)
+{
+    SWSS_LOG_ENTER();
+
+    auto consumer_it = m_consumerMap.find(tableName);
+    if (consumer_it == m_consumerMap.end())
+    {
+        SWSS_LOG_ERROR("Unrecognized tableName:%s\n", tableName.c_str());
+        return;
     }
 
-    if (!consumer.m_toSync.empty())
-        doTask(consumer);
+    auto table = dynamic_cast<ConsumerStateTable *>(consumer_it->second.m_consumer);
+    if (table == NULL)
+    {
+        SWSS_LOG_ERROR("Table %s is not a state table\n", tableName.c_str());
+        return;
+    }
 
-    return true;
+    table->setDeltaMode(true);
+    consumer_it->second.m_deltaPops = true;
 }
 
 /*
@@ -227,32 +302,265 @@ ref_resolve_status Orch::resolveFieldRefValue(
 
 void Orch::doTask()
 {
+    expireRetryTimers();
+    releaseWoken();
+
+    m_released = false;
+
+    /* Park the released tasks again until the ports are ready, otherwise
+     * the orch would stay due and the daemon would spin on it */
     if (!gPortsOrch->isInitDone())
+    {
+        for (auto &it : m_consumerMap)
+            defer(it.second);
         return;
+    }
 
     for(auto &it : m_consumerMap)
     {
-        if (!it.second.m_toSync.empty())
-            doTask(it.second);
+        Consumer &consumer = it.second;
+
+        if (consumer.m_toSync.empty())
+            continue;
+
+        consumer.m_retries++;
+        doTask(consumer);
+
+        defer(consumer);
+        releaseWoken();
+    }
+}
+
+void Orch::waitFor(Consumer &consumer, const string &key, const string &dependency)
+{
+    consumer.m_waitFor[key] = dependency;
+}
+
+void Orch::wake(const string &dependency)
+{
+    SWSS_LOG_ENTER();
+
+    /* doTask may be iterating m_toSync, or may have declared the dependency
+     * for a task it has not deferred yet. The tasks are released once it
+     * returned. */
+    m_pendingWakes.insert(dependency);
+}
+
+void Orch::releaseWoken()
+{
+    for (const auto &dependency : m_pendingWakes)
+    {
+        auto it = m_waitList.find(dependency);
+        if (it == m_waitList.end())
+            continue;
+
+        for (const auto &ref : it->second)
+            release(ref);
+
+        m_waitList.erase(it);
+    }
+
+    m_pendingWakes.clear();
+}
+
+/* Move the tasks doTask left in m_toSync to the wait list or the retry timer,
+ * so that the next pass only visits the tasks which may complete */
+void Orch::defer(Consumer &consumer)
+{
+    for (auto &it : consumer.m_toSync)
+    {
+        const string &key = it.first;
+
+        auto previous = consumer.m_waiting.find(key);
+        if (previous != consumer.m_waiting.end())
+            forget(consumer, previous);
+
+        WaitingTask &waiting = consumer.m_waiting[key];
+
+        waiting.task = move(it.second);
+        waiting.ticket = ++m_ticket;
+        waiting.expiry = 0;
+
+        auto dependency = consumer.m_waitFor.find(key);
+        if (dependency != consumer.m_waitFor.end())
+        {
+            waiting.dependency = dependency->second;
+            waiting.attempts = 0;
+            m_waitList[waiting.dependency].push_back({ &consumer, key, waiting.ticket, 0 });
+            continue;
+        }
+
+        auto attempts = consumer.m_attempts.find(key);
+        waiting.dependency.clear();
+        waiting.attempts = (attempts == consumer.m_attempts.end() ? 0 : attempts->second) + 1;
+        armRetryTimer(consumer, key, waiting);
     }
+
+    consumer.m_toSync.clear();
+    consumer.m_waitFor.clear();
+    consumer.m_attempts.clear();
 }
 
-void Orch::logfileReopen()
+/* Put the waiting task of key back into m_toSync, unless it has a newer task there */
+void Orch::resume(Consumer &consumer, const string &key)
 {
-    gRecordOfs.close();
+    auto it = consumer.m_waiting.find(key);
+    if (it == consumer.m_waiting.end())
+        return;
 
-    /*
-     * On log rotate we will use the same file name, we are assuming that
-     * logrotate deamon move filename to filename.1 and we will create new
-     * empty file here.
-     */
+    if (consumer.m_toSync.find(key) == consumer.m_toSync.end())
+        consumer.m_toSync.emplace(key, move(it->second.task));
 
-    gRecordOfs.open(gRecordFile);
+    forget(consumer, it);
+}
+
+/* Drop a waiting task with the reference the wait list or the retry timer holds to it */
+void Orch::forget(Consumer &consumer, WaitingMap::iterator it)
+{
+    const WaitingTask &waiting = it->second;
 
-    if (!gRecordOfs.is_open())
+    auto matches = [&](const WaitingRef &ref)
     {
-        SWSS_LOG_ERROR("failed to open gRecordOfs file %s: %s", gRecordFile.c_str(), strerror(errno));
+        return ref.consumer == &consumer && ref.ticket == waiting.ticket;
+    };
+
+    if (!waiting.dependency.empty())
+    {
+        auto refs = m_waitList.find(waiting.dependency);
+        if (refs != m_waitList.end())
+        {
+            auto &list = refs->second;
+            list.erase(remove_if(list.begin(), list.end(), matches), list.end());
+            if (list.empty())
+                m_waitList.erase(refs);
+        }
+    }
+    else
+    {
+        auto &slot = m_retryWheel[waiting.expiry % RETRY_WHEEL_SLOTS];
+        size_t size = slot.size();
+        slot.erase(remove_if(slot.begin(), slot.end(), matches), slot.end());
+        m_retryTimers -= size - slot.size();
+    }
+
+    consumer.m_waiting.erase(it);
+}
+
+/* Put a waiting task back into m_toSync unless a newer task replaced it */
+bool Orch::release(const WaitingRef &ref)
+{
+    Consumer &consumer = *ref.consumer;
+
+    auto it = consumer.m_waiting.find(ref.key);
+    if (it == consumer.m_waiting.end() || it->second.ticket != ref.ticket)
+        return false;
+
+    if (consumer.m_toSync.find(ref.key) == consumer.m_toSync.end())
+    {
+        consumer.m_toSync[ref.key] = move(it->second.task);
+        consumer.m_attempts[ref.key] = it->second.attempts;
+    }
+
+    consumer.m_waiting.erase(it);
+    m_released = true;
+    return true;
+}
+
+void Orch::armRetryTimer(Consumer &consumer, const string &key, WaitingTask &waiting)
+{
+    uint64_t now = retryTick();
+    uint64_t delay = RETRY_MAX_TICKS;
+
+    if (waiting.attempts <= 7)
+        delay = min<uint64_t>(1ULL << (waiting.attempts - 1), RETRY_MAX_TICKS);
+
+    if (m_retryTimers == 0)
+        m_retryTick = now;
+
+    waiting.expiry = now + delay;
+
+    WaitingRef ref = { &consumer, key, waiting.ticket, waiting.expiry };
+    m_retryWheel[ref.expiry % RETRY_WHEEL_SLOTS].push_back(ref);
+    m_retryTimers++;
+}
+
+void Orch::expireRetryTimers()
+{
+    if (m_retryTimers == 0)
         return;
+
+    uint64_t now = retryTick();
+
+    for (size_t n = 0; m_retryTick <= now; m_retryTick++, n++)
+    {
+        /* Every slot has been visited, the remaining ticks are empty */
+        if (n == RETRY_WHEEL_SLOTS)
+        {
+            m_retryTick = now + 1;
+            break;
+        }
+
+        auto &slot = m_retryWheel[m_retryTick % RETRY_WHEEL_SLOTS];
+        if (slot.empty())
+            continue;
+
+        vector<WaitingRef> pending;
+        for (auto &ref : slot)
+        {
+            if (ref.expiry > now)
+            {
+                pending.push_back(ref);
+                continue;
+            }
+
+            release(ref);
+            m_retryTimers--;
+        }
+
+        slot.swap(pending);
+    }
+}
+
+int Orch::getRetryTimeout() const
+{
+    if (m_retryTimers == 0)
+        return -1;
+
+    uint64_t now = retryTick();
+
+    for (uint64_t tick = m_retryTick; tick < m_retryTick + RETRY_WHEEL_SLOTS; tick++)
+    {
+        if (m_retryWheel[tick % RETRY_WHEEL_SLOTS].empty())
+            continue;
+
+        return tick <= now ? 0 : (int)((tick - now) * RETRY_TICK_MSEC);
+    }
+
+    return 0;
+}
+
+bool Orch::isRetryDue() const
+{
+    return m_released || !m_pendingWakes.empty() || getRetryTimeout() == 0;
+}
+
+void Orch::dumpStats(Table &table)
+{
+    for (auto &it : m_consumerMap)
+    {
+        Consumer &consumer = it.second;
+
+        vector<FieldValueTuple> fvs = {
+            { "queue_depth", to_string(consumer.m_toSync.size() + consumer.m_waiting.size()) },
+            { "waiting", to_string(consumer.m_waiting.size()) },
+            { "executions", to_string(consumer.m_executions) },
+            { "retries", to_string(consumer.m_retries) },
+            { "popped", to_string(consumer.m_popped) },
+            { "last_latency_usec", to_string(consumer.m_lastLatency) },
+            { "max_latency_usec", to_string(consumer.m_maxLatency) },
+        };
+
+        table.set(it.first, fvs);
     }
 }
 
@@ -265,14 +573,7 @@ void Orch::recordTuple(Consumer &consumer, KeyOpFieldsValuesTuple &tuple)
         s += "|" + fvField(*i) + ":" + fvValue(*i);
     }
 
-    gRecordOfs << getTimestamp() << "|" << s << endl;
-
-    if (gLogRotate)
-    {
-        gLogRotate = false;
-
-        logfileReopen();
-    }
+    gRecorder.record(s);
 }
 
 ref_resolve_status Orch::resolveFieldRefArray(
@@ -3,6 +3,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 
 extern "C" {
 #include "sai.h"
@@ -42,15 +43,61 @@ typedef map<string, object_map*> type_map;
 typedef pair<string, object_map*> type_map_pair;
 
 typedef map<string, KeyOpFieldsValuesTuple> SyncMap;
+
+/* A task which doTask could not complete, deferred out of m_toSync */
+struct WaitingTask
+{
+    KeyOpFieldsValuesTuple task;
+    string dependency;      /* empty when waiting for the retry timer */
+    uint32_t attempts;      /* consecutive failed attempts, for backoff */
+    uint64_t ticket;        /* identifies the references still valid */
+    uint64_t expiry;        /* retry timer tick */
+};
+typedef map<string, WaitingTask> WaitingMap;
+
 struct Consumer {
     Consumer(TableConsumable* consumer) : m_consumer(consumer)  { }
+
+    /*
+     * Move the popped entries into m_toSync, merging them with the pending
+     * ones. Waiting tasks of the entries must have been resumed first.
+     * With delta pops, returns false when it stopped at a SET of a key
+     * whose DEL is pending, the remaining entries are left in the deque
+     * for after doTask. Otherwise the SET replaces the pending DEL.
+     */
+    bool addToSync(std::deque<KeyOpFieldsValuesTuple> &entries);
+
     TableConsumable* m_consumer;
     /* Store the latest 'golden' status */
     SyncMap m_toSync;
+    /* Tasks waiting for a dependency or for their retry timer */
+    WaitingMap m_waiting;
+    /* Dependencies declared by doTask for the tasks left in m_toSync */
+    map<string, string> m_waitFor;
+    /* Failed attempts of the tasks put back by the retry timer */
+    map<string, uint32_t> m_attempts;
+    /* Pops only the changed fields, see Orch::enableDeltaPops() */
+    bool m_deltaPops = false;
+
+    /* Statistics, exported to COUNTERS_DB by OrchDaemon */
+    uint64_t m_executions = 0;
+    uint64_t m_retries = 0;
+    uint64_t m_popped = 0;
+    uint64_t m_lastLatency = 0;     /* usec */
+    uint64_t m_maxLatency = 0;      /* usec */
 };
 typedef pair<string, Consumer> ConsumerMapPair;
 typedef map<string, Consumer> ConsumerMap;
 
+/* Reference to a waiting task, stale once the task got a new ticket */
+struct WaitingRef
+{
+    Consumer *consumer;
+    string key;
+    uint64_t ticket;
+    uint64_t expiry;        /* retry timer tick */
+};
+
 typedef enum
 {
     success,
@@ -74,18 +121,63 @@ public:
     /* Iterate all consumers in m_consumerMap and run doTask(Consumer) */
     void doTask();
 
+    /* Return true if tasks were woken up or their retry timer expired */
+    bool isRetryDue() const;
+    /* Write the statistics of every consumer, keyed by table name */
+    void dumpStats(Table &table);
+    /* Milliseconds until the next retry timer fires, -1 if none is armed */
+    int getRetryTimeout() const;
+
 protected:
     DBConnector *m_db;
     ConsumerMap m_consumerMap;
 
+    /*
+     * Declare that the task of key, which doTask leaves in m_toSync, can't
+     * complete before dependency is resolved. The task is set aside until
+     * wake(dependency) instead of being retried on every timer.
+     */
+    void waitFor(Consumer &consumer, const string &key, const string &dependency);
+    /*
+     * Put the tasks waiting for dependency back into their m_toSync, once the
+     * running doTask returned
+     */
+    void wake(const string &dependency);
+
     /* Run doTask against a specific consumer */
     virtual void doTask(Consumer &consumer) = 0;
-    void logfileReopen();
+    /*
+     * Pop only the changed fields of the table, for orchs which handle every
+     * field of a SET independently of the others
+     */
+    void enableDeltaPops(const string &tableName);
     void recordTuple(Consumer &consumer, KeyOpFieldsValuesTuple &tuple);
     ref_resolve_status resolveFieldRefValue(type_map&, const string&, KeyOpFieldsValuesTuple&, sai_object_id_t&);
     bool parseIndexRange(const string &input, sai_uint32_t &range_low, sai_uint32_t &range_high);
     bool parseReference(type_map &type_maps, string &ref, string &table_name, string &object_name);
     ref_resolve_status resolveFieldRefArray(type_map&, const string&, KeyOpFieldsValuesTuple&, vector<sai_object_id_t>&);
+
+private:
+    uint64_t m_ticket = 0;
+    /* Dependency, tasks waiting for it */
+    map<string, vector<WaitingRef>> m_waitList;
+    /* Dependencies woken while doTask was running */
+    set<string> m_pendingWakes;
+    /* Woken or expired tasks were put back into m_toSync */
+    bool m_released = false;
+
+    /* Retry timer wheel, one slot per tick */
+    vector<vector<WaitingRef>> m_retryWheel;
+    uint64_t m_retryTick = 0;       /* next tick to expire */
+    size_t m_retryTimers = 0;
+
+    void defer(Consumer &consumer);
+    void releaseWoken();
+    bool release(const WaitingRef &ref);
+    void resume(Consumer &consumer, const string &key);
+    void forget(Consumer &consumer, WaitingMap::iterator it);
+    void armRetryTimer(Consumer &consumer, const string &key, WaitingTask &waiting);
+    void expireRetryTimers();
 };
 
 #endif /* SWSS_ORCH_H */
@@ -1,4 +1,5 @@
 #include <unistd.h>
+#include <chrono>
 #include "orchdaemon.h"
 #include "logger.h"
 #include <sairedis.h>
@@ -12,6 +13,9 @@ using namespace swss;
 /* select() function timeout retry time */
 #define SELECT_TIMEOUT 1000
 
+/* Interval of the orch statistics export to COUNTERS_DB */
+#define STATS_INTERVAL std::chrono::seconds(10)
+
 extern sai_switch_api_t*           sai_switch_api;
 extern sai_object_id_t             gSwitchId;
 
@@ -24,6 +28,10 @@ OrchDaemon::OrchDaemon(DBConnector *applDb) :
         m_applDb(applDb)
 {
     SWSS_LOG_ENTER();
+
+    m_countersDb = new DBConnector(COUNTERS_DB, DBConnector::DEFAULT_UNIXSOCKET, 0);
+    m_statsConnector = new AsyncDBConnector(m_countersDb);
+    m_statsTable = new Table(m_countersDb, m_statsConnector, COUNTERS_ORCH_STATS_TABLE);
 }
 
 OrchDaemon::~OrchDaemon()
@@ -31,6 +39,10 @@ OrchDaemon::~OrchDaemon()
     SWSS_LOG_ENTER();
     for (Orch *o : m_orchList)
         delete(o);
+
+    delete m_statsTable;
+    delete m_statsConnector;
+    delete m_countersDb;
 }
 
 bool OrchDaemon::init()
@@ -149,21 +161,82 @@ void OrchDaemon::flush()
     }
 }
 
+void OrchDaemon::retry()
+{
+    SWSS_LOG_ENTER();
+
+    /* Visit only the orchs with woken tasks or expired retry timers. A
+     * pass may wake more tasks, keep sweeping while it does. Dependency
+     * chains can't be longer than the number of orchs. */
+    for (size_t i = 0; i < m_orchList.size(); i++)
+    {
+        bool swept = false;
+
+        for (Orch *o : m_orchList)
+        {
+            if (!o->isRetryDue())
+                continue;
+
+            o->doTask();
+            swept = true;
+        }
+
+        if (!swept)
+            break;
+    }
+}
+
+/* Wait no longer than the earliest retry timer of the orchs */
+unsigned int OrchDaemon::getSelectTimeout()
+{
+    unsigned int timeout = SELECT_TIMEOUT;
+
+    for (Orch *o : m_orchList)
+    {
+        int retry = o->getRetryTimeout();
+        if (retry >= 0 && (unsigned int)retry < timeout)
+            timeout = (unsigned int)retry;
+    }
+
+    return timeout;
+}
+
+void OrchDaemon::dumpStats()
+{
+    SWSS_LOG_ENTER();
+
+    /* Skip this round until COUNTERS_DB has taken the previous one */
+    if (m_statsConnector->inflight() > 0)
+        return;
+
+    for (Orch *o : m_orchList)
+        o->dumpStats(*m_statsTable);
+}
+
 void OrchDaemon::start()
 {
     SWSS_LOG_ENTER();
 
     for (Orch *o : m_orchList)
     {
-        m_select->addSelectables(o->getSelectables());
+        for (Selectable *s : o->getSelectables())
+        {
+            m_select->addSelectable(s);
+            m_consumerOrch[s] = o;
+        }
     }
 
+    m_select->addSelectable(m_statsConnector);
+
+    auto lastStats = chrono::steady_clock::now();
+
     while (true)
     {
-        Selectable *s;
-        int fd, ret;
+        vector<Selectable *> ready;
+        vector<int> fds;
+        int ret;
 
-        ret = m_select->select(&s, &fd, SELECT_TIMEOUT);
+        ret = m_select->select(ready, fds, getSelectTimeout());
 
         if (ret == Select::ERROR)
         {
@@ -179,20 +252,33 @@ void OrchDaemon::start()
              * requests live in it. When the daemon has nothing to do, it
              * is a good chance to flush the pipeline  */
             flush();
-            continue;
         }
 
-        TableConsumable *c = (TableConsumable *)s;
-        Orch *o = getOrchByConsumer(c);
-        o->execute(c->getTableName());
+        /* Drain every ready consumer before looking at the pending tasks */
+        for (Selectable *s : ready)
+        {
+            if (s == m_statsConnector)
+            {
+                m_statsConnector->processReplies();
+                continue;
+            }
+
+            TableConsumable *c = (TableConsumable *)s;
+            Orch *o = getOrchByConsumer(c);
+            o->execute(c->getTableName());
+        }
 
-        /* After each iteration, periodically check all m_toSync map to
-         * execute all the remaining tasks that need to be retried. */
+        /* Retry only the tasks woken up by the drained ones or whose retry
+         * timer expired */
+        retry();
 
-        /* TODO: Abstract Orch class to have a specific todo list */
-        for (Orch *o : m_orchList)
-            o->doTask();
+        auto now = chrono::steady_clock::now();
 
+        if (now - lastStats >= STATS_INTERVAL)
+        {
+            dumpStats();
+            lastStats = now;
+        }
     }
 }
 
@@ -200,11 +286,9 @@ Orch *OrchDaemon::getOrchByConsumer(TableConsumable *c)
 {
     SWSS_LOG_ENTER();
 
-    for (Orch *o : m_orchList)
-    {
-        if (o->hasSelectable(c))
-            return o;
-    }
+    auto it = m_consumerOrch.find(c);
+    if (it != m_consumerOrch.end())
+        return it->second;
 
     SWSS_LOG_ERROR("Failed to get Orch class by ConsumerTable:%s",
             c->getTableName().c_str());
@@ -1,10 +1,12 @@
 #ifndef SWSS_ORCHDAEMON_H
 #define SWSS_ORCHDAEMON_H
 
+#include <unordered_map>
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "consumertable.h"
 #include "select.h"
+#include "asyncdbconnector.h"
 
 #include "portsorch.h"
 #include "intfsorch.h"
@@ -32,12 +34,20 @@ public:
     void start();
 private:
     DBConnector *m_applDb;
+    DBConnector *m_countersDb;
+    /* Statistics are written without blocking the consumers */
+    AsyncDBConnector *m_statsConnector;
+    Table *m_statsTable;
 
     std::vector<Orch *> m_orchList;
+    std::unordered_map<Selectable *, Orch *> m_consumerOrch;
     Select *m_select;
 
     Orch *getOrchByConsumer(TableConsumable *c);
     void flush();
+    void retry();
+    unsigned int getSelectTimeout();
+    void dumpStats();
 };
 
 #endif /* SWSS_ORCHDAEMON_H */
@@ -15,6 +15,8 @@
 #define PFC_WD_RESTORATION_TIME_MIN     100
 #define PFC_WD_TC_MAX                   8
 #define PFC_WD_POLL_TIMEOUT             5000
+#define PFC_WD_FLEX_COUNTER_GROUP       "PFC_WD"
+#define PFC_WD_POLL_MSECS               100
 
 extern sai_port_api_t *sai_port_api;
 extern sai_queue_api_t *sai_queue_api;
@@ -43,7 +45,7 @@ void PfcWdOrch<DropHandler, ForwardHandler>::doTask(Consumer& consumer)
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
+        auto &t = it->second;
 
         string key = kfvKey(t);
         string op = kfvOp(t);
@@ -88,6 +90,14 @@ string PfcWdSwOrch<DropHandler, ForwardHandler>::counterIdsToStr(
     return str;
 }
 
+template <typename DropHandler, typename ForwardHandler>
+string PfcWdSwOrch<DropHandler, ForwardHandler>::getFlexCounterTableKey(const string &key)
+{
+    SWSS_LOG_ENTER();
+
+    return string(PFC_WD_FLEX_COUNTER_GROUP) + ":" + key;
+}
+
 template <typename DropHandler, typename ForwardHandler>
 PfcWdAction PfcWdOrch<DropHandler, ForwardHandler>::deserializeAction(const string& key)
 {
@@ -247,10 +257,10 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::registerInWdDb(const Port& port,
     {
         vector<FieldValueTuple> fieldValues;
         string str = counterIdsToStr(c_portStatIds, &sai_serialize_port_stat);
-        fieldValues.emplace_back(PFC_WD_PORT_COUNTER_ID_LIST, str);
+        fieldValues.emplace_back(PORT_COUNTER_ID_LIST, str);
 
-        m_pfcWdTable->set(
-                sai_serialize_object_id(port.m_port_id),
+        m_flexCounterTable->set(
+                getFlexCounterTableKey(sai_serialize_object_id(port.m_port_id)),
                 fieldValues);
     }
 
@@ -277,13 +287,13 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::registerInWdDb(const Port& port,
         if (!c_queueStatIds.empty())
         {
             string str = counterIdsToStr(c_queueStatIds, sai_serialize_queue_stat);
-            queueFieldValues.emplace_back(PFC_WD_QUEUE_COUNTER_ID_LIST, str);
+            queueFieldValues.emplace_back(QUEUE_COUNTER_ID_LIST, str);
         }
 
         // Create internal entry
         m_entryMap.emplace(queueId, PfcWdQueueEntry(action, port.m_port_id, i));
 
-        m_pfcWdTable->set(queueIdStr, queueFieldValues);
+        m_flexCounterTable->set(getFlexCounterTableKey(queueIdStr), queueFieldValues);
 
         // Initialize PFC WD related counters
         PfcWdActionHandler::initWdCounters(
@@ -302,9 +312,14 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::unregisterFromWdDb(const Port& po
         sai_object_id_t queueId = port.m_queue_ids[i];
 
         // Unregister in syncd
-        m_pfcWdTable->del(sai_serialize_object_id(queueId));
+        m_flexCounterTable->del(getFlexCounterTableKey(sai_serialize_object_id(queueId)));
         m_entryMap.erase(queueId);
     }
+
+    if (!c_portStatIds.empty())
+    {
+        m_flexCounterTable->del(getFlexCounterTableKey(sai_serialize_object_id(port.m_port_id)));
+    }
 }
 
 template <typename DropHandler, typename ForwardHandler>
@@ -315,13 +330,18 @@ PfcWdSwOrch<DropHandler, ForwardHandler>::PfcWdSwOrch(
         vector<sai_queue_stat_t> queueStatIds):
     PfcWdOrch<DropHandler,
     ForwardHandler>(db, tableNames),
-    m_pfcWdDb(new DBConnector(PFC_WD_DB, DBConnector::DEFAULT_UNIXSOCKET, 0)),
-    m_pfcWdTable(new ProducerStateTable(m_pfcWdDb.get(), PFC_WD_STATE_TABLE)),
+    m_flexCounterDb(new DBConnector(FLEX_COUNTER_DB, DBConnector::DEFAULT_UNIXSOCKET, 0)),
+    m_flexCounterTable(new ProducerStateTable(m_flexCounterDb.get(), FLEX_COUNTER_TABLE)),
+    m_flexCounterGroupTable(new ProducerStateTable(m_flexCounterDb.get(), FLEX_COUNTER_GROUP_TABLE)),
     c_portStatIds(portStatIds),
     c_queueStatIds(queueStatIds)
 {
     SWSS_LOG_ENTER();
 
+    vector<FieldValueTuple> groupFieldValues;
+    groupFieldValues.emplace_back(POLL_INTERVAL_FIELD, to_string(PFC_WD_POLL_MSECS));
+    m_flexCounterGroupTable->set(PFC_WD_FLEX_COUNTER_GROUP, groupFieldValues);
+
     string platform = getenv("platform") ? getenv("platform") : "";
 
     if (platform == "")
@@ -347,11 +367,9 @@ PfcWdSwOrch<DropHandler, ForwardHandler>::PfcWdSwOrch(
                 restoreLuaScript);
 
         vector<FieldValueTuple> fieldValues;
-        fieldValues.emplace_back(SAI_OBJECT_TYPE, sai_serialize_object_type(SAI_OBJECT_TYPE_QUEUE));
+        fieldValues.emplace_back(QUEUE_PLUGIN_FIELD, detectSha + "," + restoreSha);
 
-        auto pluginTable = ProducerStateTable(m_pfcWdDb.get(), PLUGIN_TABLE);
-        pluginTable.set(detectSha, fieldValues);
-        pluginTable.set(restoreSha, fieldValues);
+        m_flexCounterGroupTable->set(PFC_WD_FLEX_COUNTER_GROUP, fieldValues);
     }
     catch (...)
     {
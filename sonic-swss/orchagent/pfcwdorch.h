@@ -83,6 +83,7 @@ private:
 
     template <typename T>
     static string counterIdsToStr(const vector<T> ids, string (*convert)(T));
+    static string getFlexCounterTableKey(const string &key);
     void registerInWdDb(const Port& port,
             uint32_t detectionTime, uint32_t restorationTime, PfcWdAction action);
     void unregisterFromWdDb(const Port& port);
@@ -97,8 +98,9 @@ private:
     const vector<sai_port_stat_t> c_portStatIds;
     const vector<sai_queue_stat_t> c_queueStatIds;
 
-    shared_ptr<DBConnector> m_pfcWdDb = nullptr;
-    shared_ptr<ProducerStateTable> m_pfcWdTable = nullptr;
+    shared_ptr<DBConnector> m_flexCounterDb = nullptr;
+    shared_ptr<ProducerStateTable> m_flexCounterTable = nullptr;
+    shared_ptr<ProducerStateTable> m_flexCounterGroupTable = nullptr;
 
     atomic_bool m_runPfcWdSwOrchThread = { false };
     shared_ptr<thread> m_pfcWatchdogThread = nullptr;
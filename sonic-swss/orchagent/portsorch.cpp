@@ -76,7 +76,7 @@ PortsOrch::PortsOrch(DBConnector *db, vector<string> tableNames) :
 
     m_cpuPort = Port("CPU", Port::CPU);
     m_cpuPort.m_port_id = attr.value.oid;
-    m_portList[m_cpuPort.m_alias] = m_cpuPort;
+    setPort(m_cpuPort.m_alias, m_cpuPort);
 
     /* Get port number */
     attr.id = SAI_SWITCH_ATTR_PORT_NUMBER;
@@ -250,66 +250,153 @@ bool PortsOrch::getPort(string alias, Port &p)
 {
     SWSS_LOG_ENTER();
 
-    if (m_portList.find(alias) == m_portList.end())
+    const Port *port = findPort(alias);
+
+    if (port == nullptr)
     {
         return false;
     }
-    else
-    {
-        p = m_portList[alias];
-        return true;
-    }
+
+    p = *port;
+    return true;
 }
 
 bool PortsOrch::getPort(sai_object_id_t id, Port &port)
 {
     SWSS_LOG_ENTER();
 
-    for (const auto& portIter: m_portList)
+    const Port *p = findPort(id);
+
+    if (p == nullptr)
     {
-        switch (portIter.second.m_type)
-        {
-        case Port::PHY:
-            if(portIter.second.m_port_id == id)
-            {
-                port = portIter.second;
-                return true;
-            }
-            break;
-        case Port::LAG:
-            if(portIter.second.m_lag_id == id)
-            {
-                port = portIter.second;
-                return true;
-            }
-            break;
-        default:
-            continue;
-        }
+        return false;
     }
 
-    return false;
+    port = *p;
+    return true;
 }
 
 bool PortsOrch::getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port)
 {
     SWSS_LOG_ENTER();
 
-    for (auto &it: m_portList)
+    const Port *p = findPortByBridgePortId(bridge_port_id);
+
+    if (p == nullptr)
     {
-        if (it.second.m_bridge_port_id == bridge_port_id)
-        {
-            port = it.second;
-            return true;
-        }
+        return false;
+    }
+
+    port = *p;
+    return true;
+}
+
+void PortsOrch::setPort(const string &alias, const Port &p)
+{
+    auto it = m_portList.find(alias);
+
+    if (it == m_portList.end())
+    {
+        it = m_portList.emplace(alias, p).first;
+    }
+    else
+    {
+        unindexPort(it->second);
+        it->second = p;
     }
 
-    return false;
+    indexPort(it->second);
 }
 
-void PortsOrch::setPort(string alias, Port p)
+const Port* PortsOrch::findPort(const string &alias) const
 {
-    m_portList[alias] = p;
+    auto it = m_portList.find(alias);
+
+    return it == m_portList.end() ? nullptr : &it->second;
+}
+
+const Port* PortsOrch::findPort(sai_object_id_t id) const
+{
+    auto it = m_portIdIndex.find(id);
+
+    if (it != m_portIdIndex.end() && it->second->m_type == Port::PHY)
+    {
+        return it->second;
+    }
+
+    it = m_lagIdIndex.find(id);
+
+    return it == m_lagIdIndex.end() ? nullptr : it->second;
+}
+
+const Port* PortsOrch::findPortByBridgePortId(sai_object_id_t bridge_port_id) const
+{
+    auto it = m_bridgePortIdIndex.find(bridge_port_id);
+
+    return it == m_bridgePortIdIndex.end() ? nullptr : it->second;
+}
+
+const Port* PortsOrch::findPortByRifId(sai_object_id_t rif_id) const
+{
+    auto it = m_rifIdIndex.find(rif_id);
+
+    return it == m_rifIdIndex.end() ? nullptr : it->second;
+}
+
+void PortsOrch::erasePort(const string &alias)
+{
+    auto it = m_portList.find(alias);
+
+    if (it == m_portList.end())
+    {
+        return;
+    }
+
+    unindexPort(it->second);
+    m_portList.erase(it);
+}
+
+void PortsOrch::indexPort(Port &port)
+{
+    if (port.m_port_id != SAI_NULL_OBJECT_ID)
+    {
+        m_portIdIndex[port.m_port_id] = &port;
+    }
+
+    /* LAG members carry the LAG OID too, only the LAG itself is indexed */
+    if (port.m_type == Port::LAG && port.m_lag_id != SAI_NULL_OBJECT_ID)
+    {
+        m_lagIdIndex[port.m_lag_id] = &port;
+    }
+
+    if (port.m_bridge_port_id != SAI_NULL_OBJECT_ID)
+    {
+        m_bridgePortIdIndex[port.m_bridge_port_id] = &port;
+    }
+
+    if (port.m_rif_id != SAI_NULL_OBJECT_ID)
+    {
+        m_rifIdIndex[port.m_rif_id] = &port;
+    }
+}
+
+static void unindexPortId(unordered_map<sai_object_id_t, Port*> &index, sai_object_id_t id, const Port &port)
+{
+    auto it = index.find(id);
+
+    /* Entry may already point to another port reusing the OID */
+    if (it != index.end() && it->second == &port)
+    {
+        index.erase(it);
+    }
+}
+
+void PortsOrch::unindexPort(const Port &port)
+{
+    unindexPortId(m_portIdIndex, port.m_port_id, port);
+    unindexPortId(m_lagIdIndex, port.m_lag_id, port);
+    unindexPortId(m_bridgePortIdIndex, port.m_bridge_port_id, port);
+    unindexPortId(m_rifIdIndex, port.m_rif_id, port);
 }
 
 void PortsOrch::getCpuPort(Port &port)
@@ -443,42 +530,41 @@ bool PortsOrch::setHostIntfsOperStatus(sai_object_id_t port_id, bool up)
 {
     SWSS_LOG_ENTER();
 
-    for (auto it = m_portList.begin(); it != m_portList.end(); it++)
+    auto it = m_portIdIndex.find(port_id);
+    if (it == m_portIdIndex.end())
     {
-        if (it->second.m_port_id == port_id)
-        {
-            sai_attribute_t attr;
-            attr.id = SAI_HOSTIF_ATTR_OPER_STATUS;
-            attr.value.booldata = up;
+        return false;
+    }
 
-            sai_status_t status = sai_hostif_api->set_hostif_attribute(it->second.m_hif_id, &attr);
-            if (status != SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_WARN("Failed to set operation status %s to host interface %s",
-                              up ? "UP" : "DOWN", it->second.m_alias.c_str());
-                return false;
-            }
-            SWSS_LOG_NOTICE("Set operation status %s to host interface %s",
-                            up ? "UP" : "DOWN", it->second.m_alias.c_str());
-            return true;
-        }
+    const Port &port = *it->second;
+
+    sai_attribute_t attr;
+    attr.id = SAI_HOSTIF_ATTR_OPER_STATUS;
+    attr.value.booldata = up;
+
+    sai_status_t status = sai_hostif_api->set_hostif_attribute(port.m_hif_id, &attr);
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_WARN("Failed to set operation status %s to host interface %s",
+                      up ? "UP" : "DOWN", port.m_alias.c_str());
+        return false;
     }
-    return false;
+    SWSS_LOG_NOTICE("Set operation status %s to host interface %s",
+                    up ? "UP" : "DOWN", port.m_alias.c_str());
+    return true;
 }
 
 void PortsOrch::updateDbPortOperStatus(sai_object_id_t id, sai_port_oper_status_t status)
 {
     SWSS_LOG_ENTER();
 
-    for (auto it = m_portList.begin(); it != m_portList.end(); it++)
+    auto it = m_portIdIndex.find(id);
+    if (it != m_portIdIndex.end())
     {
-        if (it->second.m_port_id == id)
-        {
-            vector<FieldValueTuple> tuples;
-            FieldValueTuple tuple("oper_status", oper_status_strings.at(status));
-            tuples.push_back(tuple);
-            m_portTable->set(it->first, tuples);
-        }
+        vector<FieldValueTuple> tuples;
+        FieldValueTuple tuple("oper_status", oper_status_strings.at(status));
+        tuples.push_back(tuple);
+        m_portTable->set(it->second->m_alias, tuples);
     }
 }
 
@@ -556,7 +642,7 @@ bool PortsOrch::initPort(const string &alias, const set<int> &lane_set)
             if (initializePort(p))
             {
                 /* Add port to port list */
-                m_portList[alias] = p;
+                setPort(alias, p);
                 /* Add port name map to counter table */
                 FieldValueTuple tuple(p.m_alias, sai_serialize_object_id(p.m_port_id));
                 vector<FieldValueTuple> vector;
@@ -1444,7 +1530,7 @@ bool PortsOrch::addVlan(string vlan_alias)
     vlan.m_vlan_oid = vlan_oid;
     vlan.m_vlan_id = vlan_id;
     vlan.m_members = set<string>();
-    m_portList[vlan_alias] = vlan;
+    setPort(vlan_alias, vlan);
 
     return true;
 }
@@ -1469,7 +1555,7 @@ bool PortsOrch::removeVlan(Port vlan)
 
     SWSS_LOG_NOTICE("Remove VLAN %s vid:%hu", vlan.m_alias.c_str(), vlan.m_vlan_id);
 
-    m_portList.erase(vlan.m_alias);
+    erasePort(vlan.m_alias);
 
     return true;
 }
@@ -1529,9 +1615,9 @@ bool PortsOrch::addVlanMember(Port vlan, Port port, string& tagging_mode)
     port.m_vlan_id = vlan.m_vlan_id;
     port.m_port_vlan_id = vlan.m_vlan_id;
     port.m_vlan_member_id = vlan_member_id;
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     vlan.m_members.insert(port.m_alias);
-    m_portList[vlan.m_alias] = vlan;
+    setPort(vlan.m_alias, vlan);
 
     VlanMemberUpdate update = { vlan, port, true };
     notify(SUBJECT_TYPE_VLAN_MEMBER_CHANGE, static_cast<void *>(&update));
@@ -1570,9 +1656,9 @@ bool PortsOrch::removeVlanMember(Port vlan, Port port)
     port.m_vlan_id = 0;
     port.m_port_vlan_id = DEFAULT_PORT_VLAN_ID;
     port.m_vlan_member_id = 0;
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     vlan.m_members.erase(port.m_alias);
-    m_portList[vlan.m_alias] = vlan;
+    setPort(vlan.m_alias, vlan);
 
     VlanMemberUpdate update = { vlan, port, false };
     notify(SUBJECT_TYPE_VLAN_MEMBER_CHANGE, static_cast<void *>(&update));
@@ -1598,7 +1684,7 @@ bool PortsOrch::addLag(string lag_alias)
     Port lag(lag_alias, Port::LAG);
     lag.m_lag_id = lag_id;
     lag.m_members = set<string>();
-    m_portList[lag_alias] = lag;
+    setPort(lag_alias, lag);
 
     return true;
 }
@@ -1623,7 +1709,7 @@ bool PortsOrch::removeLag(Port lag)
 
     SWSS_LOG_NOTICE("Remove LAG %s lid:%lx", lag.m_alias.c_str(), lag.m_lag_id);
 
-    m_portList.erase(lag.m_alias);
+    erasePort(lag.m_alias);
 
     return true;
 }
@@ -1658,10 +1744,10 @@ bool PortsOrch::addLagMember(Port lag, Port port)
 
     port.m_lag_id = lag.m_lag_id;
     port.m_lag_member_id = lag_member_id;
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     lag.m_members.insert(port.m_alias);
 
-    m_portList[lag.m_alias] = lag;
+    setPort(lag.m_alias, lag);
 
     LagMemberUpdate update = { lag, port, true };
     notify(SUBJECT_TYPE_LAG_MEMBER_CHANGE, static_cast<void *>(&update));
@@ -1685,9 +1771,9 @@ bool PortsOrch::removeLagMember(Port lag, Port port)
 
     port.m_lag_id = 0;
     port.m_lag_member_id = 0;
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     lag.m_members.erase(port.m_alias);
-    m_portList[lag.m_alias] = lag;
+    setPort(lag.m_alias, lag);
 
     LagMemberUpdate update = { lag, port, false };
     notify(SUBJECT_TYPE_LAG_MEMBER_CHANGE, static_cast<void *>(&update));
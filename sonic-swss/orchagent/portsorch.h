@@ -2,6 +2,7 @@
 #define SWSS_PORTSORCH_H
 
 #include <map>
+#include <unordered_map>
 
 #include "orch.h"
 #include "port.h"
@@ -50,7 +51,17 @@ public:
     bool getPort(string alias, Port &port);
     bool getPort(sai_object_id_t id, Port &port);
     bool getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port);
-    void setPort(string alias, Port port);
+    void setPort(const string &alias, const Port &port);
+
+    /*
+     * Lookups without copying the port, nullptr when there is no such port.
+     * Returned port is valid until the port list is changed.
+     */
+    const Port* findPort(const string &alias) const;
+    /* Physical port by port OID or LAG by LAG OID */
+    const Port* findPort(sai_object_id_t id) const;
+    const Port* findPortByBridgePortId(sai_object_id_t bridge_port_id) const;
+    const Port* findPortByRifId(sai_object_id_t rif_id) const;
     void getCpuPort(Port &port);
 
     bool setHostIntfsOperStatus(sai_object_id_t id, bool up);
@@ -76,6 +87,16 @@ private:
     map<set<int>, tuple<string, uint32_t>> m_lanesAliasSpeedMap;
     map<string, Port> m_portList;
 
+    /* Indexes into m_portList, kept in sync by setPort and erasePort */
+    unordered_map<sai_object_id_t, Port*> m_portIdIndex;
+    unordered_map<sai_object_id_t, Port*> m_lagIdIndex;
+    unordered_map<sai_object_id_t, Port*> m_bridgePortIdIndex;
+    unordered_map<sai_object_id_t, Port*> m_rifIdIndex;
+
+    void erasePort(const string &alias);
+    void indexPort(Port &port);
+    void unindexPort(const Port &port);
+
     void doTask(Consumer &consumer);
     void doPortTask(Consumer &consumer);
     void doVlanTask(Consumer &consumer);
@@ -0,0 +1,376 @@
+// Path compressed binary (Patricia) trie of IP prefixes
+//
+// Answers which prefixes of the trie are inside a prefix and which is the
+// longest prefix of the trie containing an address, walking at most prefix
+// length bits instead of every entry.
+//
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <string.h>
+#include "ipaddress.h"
+#include "ipprefix.h"
+
+namespace swss {
+
+template <class T>
+class PrefixTrie
+{
+public:
+    PrefixTrie() : m_size(0) {}
+
+    PrefixTrie(const PrefixTrie&) = delete;
+    PrefixTrie& operator=(const PrefixTrie&) = delete;
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    void clear()
+    {
+        m_root[0].reset();
+        m_root[1].reset();
+        m_size = 0;
+    }
+
+    /* Inserts prefix with value, existing value is kept. Returns value of prefix */
+    T& insert(const IpPrefix &prefix, const T &value = T())
+    {
+        Key key(prefix);
+
+        std::unique_ptr<Node> *slot = &root(prefix.isV4());
+
+        while (true)
+        {
+            Node *node = slot->get();
+
+            if (node == nullptr)
+            {
+                slot->reset(new Node(key, value));
+                m_size++;
+                return (*slot)->value;
+            }
+
+            uint8_t common = key.common(node->key, std::min(node->key.len, key.len));
+
+            if (common == node->key.len && common == key.len)
+            {
+                if (!node->hasValue)
+                {
+                    /* Branching node key may have other bits past its length */
+                    node->key = key;
+                    node->hasValue = true;
+                    node->value = value;
+                    m_size++;
+                }
+
+                return node->value;
+            }
+
+            if (common == node->key.len)
+            {
+                slot = &node->child[key.bit(node->key.len)];
+                continue;
+            }
+
+            /* Split, new node goes in between */
+
+            std::unique_ptr<Node> split;
+
+            if (common == key.len)
+            {
+                split.reset(new Node(key, value));
+                m_size++;
+            }
+            else
+            {
+                split.reset(new Node(key, common));
+                split->child[key.bit(common)].reset(new Node(key, value));
+                m_size++;
+            }
+
+            split->child[node->key.bit(common)] = std::move(*slot);
+            *slot = std::move(split);
+
+            return common == key.len ? (*slot)->value : (*slot)->child[key.bit(common)]->value;
+        }
+    }
+
+    T* find(const IpPrefix &prefix)
+    {
+        Node *node = findNode(Key(prefix), prefix.isV4());
+
+        return node && node->hasValue ? &node->value : nullptr;
+    }
+
+    bool erase(const IpPrefix &prefix)
+    {
+        return erase(root(prefix.isV4()), Key(prefix));
+    }
+
+    /* Longest prefix containing address, nullptr when there is none */
+    T* longestMatch(const IpAddress &address, IpPrefix *match = nullptr)
+    {
+        Key key(address);
+
+        Node *node = root(address.isV4()).get();
+        Node *best = nullptr;
+
+        while (node != nullptr && node->key.len <= key.len &&
+                key.common(node->key, node->key.len) == node->key.len)
+        {
+            if (node->hasValue)
+            {
+                best = node;
+            }
+
+            if (node->key.len == key.len)
+            {
+                break;
+            }
+
+            node = node->child[key.bit(node->key.len)].get();
+        }
+
+        if (best == nullptr)
+        {
+            return nullptr;
+        }
+
+        if (match != nullptr)
+        {
+            *match = best->key.toIpPrefix();
+        }
+
+        return &best->value;
+    }
+
+    /* Calls func(const IpPrefix&, T&) for every prefix of the trie inside prefix */
+    template <class F>
+    void forEachCovered(const IpPrefix &prefix, F func)
+    {
+        Key key(prefix);
+
+        Node *node = root(prefix.isV4()).get();
+
+        while (node != nullptr)
+        {
+            uint8_t len = std::min(node->key.len, key.len);
+
+            if (key.common(node->key, len) != len)
+            {
+                return;
+            }
+
+            if (node->key.len >= key.len)
+            {
+                visit(node, func);
+                return;
+            }
+
+            node = node->child[key.bit(node->key.len)].get();
+        }
+    }
+
+    /* Calls func(const IpPrefix&, T&) for every prefix of the trie */
+    template <class F>
+    void forEach(F func)
+    {
+        visit(m_root[0].get(), func);
+        visit(m_root[1].get(), func);
+    }
+
+private:
+    /* Node prefix, IPv4 address in the first 4 bytes */
+    struct Key
+    {
+        uint8_t bytes[16];
+        uint8_t family;
+        uint8_t len;
+
+        Key(const IpAddress &address)
+        {
+            init(address);
+            len = address.isV4() ? 32 : 128;
+        }
+
+        Key(const IpPrefix &prefix)
+        {
+            init(prefix.getIp());
+            len = (uint8_t)prefix.getMaskLength();
+        }
+
+        void init(const IpAddress &address)
+        {
+            memset(bytes, 0, sizeof(bytes));
+
+            if (address.isV4())
+            {
+                uint32_t addr = address.getV4Addr();
+                memcpy(bytes, &addr, sizeof(addr));
+                family = AF_INET;
+            }
+            else
+            {
+                memcpy(bytes, address.getV6Addr(), 16);
+                family = AF_INET6;
+            }
+        }
+
+        IpPrefix toIpPrefix() const
+        {
+            ip_addr_t ip;
+
+            ip.family = family;
+
+            if (family == AF_INET)
+            {
+                memcpy(&ip.ip_addr.ipv4_addr, bytes, 4);
+            }
+            else
+            {
+                memcpy(ip.ip_addr.ipv6_addr, bytes, 16);
+            }
+
+            return IpPrefix(IpAddress(ip), len);
+        }
+
+        uint8_t bit(uint8_t index) const
+        {
+            return (uint8_t)((bytes[index >> 3] >> (7 - (index & 7))) & 1);
+        }
+
+        /* Number of leading bits equal in both keys, at most len */
+        uint8_t common(const Key &other, uint8_t len) const
+        {
+            uint8_t index = 0;
+
+            while (index < len)
+            {
+                uint8_t diff = (uint8_t)(bytes[index >> 3] ^ other.bytes[index >> 3]);
+
+                if (diff == 0)
+                {
+                    index = (uint8_t)((index | 7) + 1);
+                    continue;
+                }
+
+                index = (uint8_t)((index & ~7) + __builtin_clz(diff) - 24);
+                break;
+            }
+
+            return std::min(index, len);
+        }
+    };
+
+    /* Prefix is rebuilt from the key, nodes don't keep an IpPrefix */
+    struct Node
+    {
+        Key key;
+        bool hasValue;
+        T value;
+        std::unique_ptr<Node> child[2];
+
+        /* Node holding value */
+        Node(const Key &k, const T &v) :
+            key(k), hasValue(true), value(v)
+        {
+        }
+
+        /* Branching node without value */
+        Node(const Key &k, uint8_t len) :
+            key(k), hasValue(false), value()
+        {
+            key.len = len;
+        }
+    };
+
+    std::unique_ptr<Node>& root(bool v4)
+    {
+        return m_root[v4 ? 0 : 1];
+    }
+
+    Node* findNode(const Key &key, bool v4)
+    {
+        Node *node = root(v4).get();
+
+        while (node != nullptr && node->key.len <= key.len &&
+                key.common(node->key, node->key.len) == node->key.len)
+        {
+            if (node->key.len == key.len)
+            {
+                return node;
+            }
+
+            node = node->child[key.bit(node->key.len)].get();
+        }
+
+        return nullptr;
+    }
+
+    bool erase(std::unique_ptr<Node> &slot, const Key &key)
+    {
+        Node *node = slot.get();
+
+        if (node == nullptr || node->key.len > key.len ||
+                key.common(node->key, node->key.len) != node->key.len)
+        {
+            return false;
+        }
+
+        if (node->key.len == key.len)
+        {
+            if (!node->hasValue)
+            {
+                return false;
+            }
+
+            node->hasValue = false;
+            node->value = T();
+            m_size--;
+        }
+        else if (!erase(node->child[key.bit(node->key.len)], key))
+        {
+            return false;
+        }
+
+        /* Node without value is only kept when it branches */
+
+        if (!node->hasValue && !(node->child[0] && node->child[1]))
+        {
+            std::unique_ptr<Node> child = std::move(node->child[node->child[0] ? 0 : 1]);
+            slot = std::move(child);
+        }
+
+        return true;
+    }
+
+    template <class F>
+    void visit(Node *node, F &func)
+    {
+        if (node == nullptr)
+        {
+            return;
+        }
+
+        if (node->hasValue)
+        {
+            func(node->key.toIpPrefix(), node->value);
+        }
+
+        visit(node->child[0].get(), func);
+        visit(node->child[1].get(), func);
+    }
+
+    std::unique_ptr<Node> m_root[2];
+    size_t m_size;
+};
+
+}
@@ -1,8 +1,11 @@
 #include <assert.h>
+#include <iterator>
 #include "routeorch.h"
 #include "logger.h"
 #include "swssnet.h"
 
+#include <sairedis.h>
+
 extern sai_object_id_t gVirtualRouterId;
 extern sai_object_id_t gSwitchId;
 
@@ -12,6 +15,11 @@ extern sai_switch_api_t*            sai_switch_api;
 
 extern PortsOrch *gPortsOrch;
 
+/* Dependencies of the routes which can't be added yet */
+#define RESYNC_DEPENDENCY           "RESYNC"
+#define NEXTHOP_DEPENDENCY_PREFIX   "NEXTHOP:"
+#define NHGRP_SLOT_DEPENDENCY       "NEXTHOP_GROUP_SLOT"
+
 /* Default maximum number of next hop groups */
 #define DEFAULT_NUMBER_OF_ECMP_GROUPS   128
 #define DEFAULT_MAX_ECMP_GROUP_SIZE     32
@@ -74,7 +82,8 @@ RouteOrch::RouteOrch(DBConnector *db, string tableName, NeighOrch *neighOrch) :
     }
 
     /* Add default IPv4 route into the m_syncdRoutes */
-    m_syncdRoutes[default_ip_prefix] = IpAddresses();
+    m_syncdRouteTrie.insert(default_ip_prefix,
+            &*m_syncdRoutes.emplace(PackedPrefix(default_ip_prefix), m_nextHopSets.intern(IpAddresses())).first);
 
     SWSS_LOG_NOTICE("Create IPv4 default route with packet action drop");
 
@@ -91,20 +100,68 @@ RouteOrch::RouteOrch(DBConnector *db, string tableName, NeighOrch *neighOrch) :
     }
 
     /* Add default IPv6 route into the m_syncdRoutes */
-    m_syncdRoutes[v6_default_ip_prefix] = IpAddresses();
+    m_syncdRouteTrie.insert(v6_default_ip_prefix,
+            &*m_syncdRoutes.emplace(PackedPrefix(v6_default_ip_prefix), m_nextHopSets.intern(IpAddresses())).first);
 
     SWSS_LOG_NOTICE("Create IPv6 default route with packet action drop");
+
+    /* Wake up the routes waiting for a neighbor */
+    m_neighOrch->attach(this);
+}
+
+void RouteOrch::update(SubjectType type, void *cntx)
+{
+    SWSS_LOG_ENTER();
+
+    assert(cntx);
+
+    if (type != SUBJECT_TYPE_NEIGH_CHANGE)
+        return;
+
+    NeighborUpdate *update = static_cast<NeighborUpdate *>(cntx);
+    if (update->add)
+    {
+        wake(NEXTHOP_DEPENDENCY_PREFIX + update->entry.ip_address.to_string());
+    }
+}
+
+/* Declare what a route which failed to be added is waiting for. Routes
+ * which failed for any other reason are retried on the timer. */
+void RouteOrch::waitForNextHops(Consumer& consumer, const string& key, const NextHopSetRef& nextHops)
+{
+    for (const auto &ip_address : *nextHops)
+    {
+        if (!m_neighOrch->hasNextHop(ip_address))
+        {
+            waitFor(consumer, key, NEXTHOP_DEPENDENCY_PREFIX + ip_address.to_string());
+            return;
+        }
+    }
+
+    if (nextHops->size() > 1 && !hasNextHopGroup(nextHops) &&
+        m_nextHopGroupCount >= m_maxNextHopGroupCount)
+    {
+        waitFor(consumer, key, NHGRP_SLOT_DEPENDENCY);
+    }
 }
 
 bool RouteOrch::hasNextHopGroup(const IpAddresses& ipAddresses) const
 {
-    return m_syncdNextHopGroups.find(ipAddresses) != m_syncdNextHopGroups.end();
+    /* A next hop group keeps its next hop set interned */
+    NextHopSetRef nextHops = m_nextHopSets.find(ipAddresses);
+
+    return nextHops && hasNextHopGroup(nextHops);
+}
+
+bool RouteOrch::hasNextHopGroup(const NextHopSetRef& nextHops) const
+{
+    return m_syncdNextHopGroups.find(nextHops) != m_syncdNextHopGroups.end();
 }
 
 sai_object_id_t RouteOrch::getNextHopGroupId(const IpAddresses& ipAddresses)
 {
     assert(hasNextHopGroup(ipAddresses));
-    return m_syncdNextHopGroups[ipAddresses].next_hop_group_id;
+    return m_syncdNextHopGroups[m_nextHopSets.find(ipAddresses)].next_hop_group_id;
 }
 
 void RouteOrch::attach(Observer *observer, const IpAddress& dstAddr)
@@ -113,28 +170,25 @@ void RouteOrch::attach(Observer *observer, const IpAddress& dstAddr)
 
     SWSS_LOG_INFO("Attaching next hop observer for %s destination IP\n", dstAddr.to_string().c_str());
 
-    auto observerEntry = m_nextHopObservers.find(dstAddr);
+    IpPrefix hostPrefix(dstAddr.to_string());
+
+    auto observerEntry = m_nextHopObservers.find(hostPrefix);
 
-    if (observerEntry == m_nextHopObservers.end())
+    if (observerEntry == nullptr)
     {
-        m_nextHopObservers.emplace(dstAddr, NextHopObserverEntry());
-        observerEntry = m_nextHopObservers.find(dstAddr);
+        observerEntry = &m_nextHopObservers.insert(hostPrefix);
 
-        for (auto route : m_syncdRoutes)
-        {
-            if (route.first.isAddressInSubnet(dstAddr))
-            {
-                observerEntry->second.routeTable.emplace(route.first, route.second);
-            }
-        }
+        /* Default route should always exists. */
+        observerEntry->bestPrefix = IpPrefix(dstAddr.isV4() ? "0.0.0.0/0" : "::/0");
+        m_syncdRouteTrie.longestMatch(dstAddr, &observerEntry->bestPrefix);
     }
 
-    observerEntry->second.observers.push_back(observer);
+    observerEntry->observers.push_back(observer);
 
-    auto route = observerEntry->second.routeTable.rbegin();
-    if (route != observerEntry->second.routeTable.rend())
+    auto route = m_syncdRouteTrie.find(observerEntry->bestPrefix);
+    if (route != nullptr)
     {
-        NextHopUpdate update = { route->first, route->second };
+        NextHopUpdate update = { observerEntry->bestPrefix, (*route)->second->toIpAddresses() };
         observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
     }
 }
@@ -142,22 +196,31 @@ void RouteOrch::attach(Observer *observer, const IpAddress& dstAddr)
 void RouteOrch::detach(Observer *observer, const IpAddress& dstAddr)
 {
     SWSS_LOG_ENTER();
-    auto observerEntry = m_nextHopObservers.find(dstAddr);
 
-    if (observerEntry == m_nextHopObservers.end())
+    IpPrefix hostPrefix(dstAddr.to_string());
+
+    auto observerEntry = m_nextHopObservers.find(hostPrefix);
+
+    if (observerEntry == nullptr)
     {
         SWSS_LOG_ERROR("Failed to detach observer for %s. Entry not found.\n", dstAddr.to_string().c_str());
         assert(false);
+        return;
     }
 
-    for (auto iter = observerEntry->second.observers.begin(); iter != observerEntry->second.observers.end(); ++iter)
+    for (auto iter = observerEntry->observers.begin(); iter != observerEntry->observers.end(); ++iter)
     {
         if (observer == *iter)
         {
-            m_observers.erase(iter);
+            observerEntry->observers.erase(iter);
             break;
         }
     }
+
+    if (observerEntry->observers.empty())
+    {
+        m_nextHopObservers.erase(hostPrefix);
+    }
 }
 
 void RouteOrch::doTask(Consumer& consumer)
@@ -167,7 +230,7 @@ void RouteOrch::doTask(Consumer& consumer)
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
+        auto &t = it->second;
 
         string key = kfvKey(t);
         string op = kfvOp(t);
@@ -182,15 +245,19 @@ void RouteOrch::doTask(Consumer& consumer)
          */
         if (key == "resync")
         {
+            /* Complete the routes queued so far against the current table */
+            flushRoutes(consumer);
+
             if (op == "SET")
             {
                 /* Mark all current routes as dirty (DEL) in consumer.m_toSync map */
                 SWSS_LOG_NOTICE("Start resync routes\n");
-                for (auto i : m_syncdRoutes)
+                for (const auto &i : m_syncdRoutes)
                 {
+                    string prefix = i.first.toIpPrefix().to_string();
                     vector<FieldValueTuple> v;
-                    auto x = KeyOpFieldsValuesTuple(i.first.to_string(), DEL_COMMAND, v);
-                    consumer.m_toSync[i.first.to_string()] = x;
+                    auto x = KeyOpFieldsValuesTuple(prefix, DEL_COMMAND, v);
+                    consumer.m_toSync[prefix] = x;
                 }
                 m_resync = true;
             }
@@ -198,6 +265,7 @@ void RouteOrch::doTask(Consumer& consumer)
             {
                 SWSS_LOG_NOTICE("Complete resync routes\n");
                 m_resync = false;
+                wake(RESYNC_DEPENDENCY);
             }
 
             it = consumer.m_toSync.erase(it);
@@ -206,11 +274,13 @@ void RouteOrch::doTask(Consumer& consumer)
 
         if (m_resync)
         {
+            waitFor(consumer, key, RESYNC_DEPENDENCY);
             it++;
             continue;
         }
 
         IpPrefix ip_prefix = IpPrefix(key);
+        auto it_route = m_syncdRoutes.find(PackedPrefix(ip_prefix));
 
         if (op == SET_COMMAND)
         {
@@ -239,24 +309,29 @@ void RouteOrch::doTask(Consumer& consumer)
             {
                 /* If any existing routes are updated to point to the
                  * above interfaces, remove them from the ASIC. */
-                if (m_syncdRoutes.find(ip_prefix) != m_syncdRoutes.end())
+                if (it_route != m_syncdRoutes.end())
                 {
-                    if (removeRoute(ip_prefix))
-                        it = consumer.m_toSync.erase(it);
-                    else
-                        it++;
+                    removeRoute(key, ip_prefix);
+                    it++;
                 }
                 else
                     it = consumer.m_toSync.erase(it);
                 continue;
             }
 
-            if (m_syncdRoutes.find(ip_prefix) == m_syncdRoutes.end() || m_syncdRoutes[ip_prefix] != ip_addresses)
+            /* Queued routes stay in m_toSync until flushRoutes completes them */
+            if (it_route == m_syncdRoutes.end() || !it_route->second->equals(ip_addresses))
             {
-                if (addRoute(ip_prefix, ip_addresses))
+                NextHopSetRef next_hops = m_nextHopSets.intern(ip_addresses);
+                if (it_route != m_syncdRoutes.end() && updateNextHopGroup(ip_prefix, it_route, next_hops))
+                {
+                    /* Done in place, nothing to queue */
                     it = consumer.m_toSync.erase(it);
-                else
-                    it++;
+                    continue;
+                }
+                if (!addRoute(key, ip_prefix, next_hops))
+                    waitForNextHops(consumer, key, next_hops);
+                it++;
             }
             else
                 /* Duplicate entry */
@@ -264,12 +339,10 @@ void RouteOrch::doTask(Consumer& consumer)
         }
         else if (op == DEL_COMMAND)
         {
-            if (m_syncdRoutes.find(ip_prefix) != m_syncdRoutes.end())
+            if (it_route != m_syncdRoutes.end())
             {
-                if (removeRoute(ip_prefix))
-                    it = consumer.m_toSync.erase(it);
-                else
-                    it++;
+                removeRoute(key, ip_prefix);
+                it++;
             }
             else
                 /* Cannot locate the route */
@@ -281,140 +354,128 @@ void RouteOrch::doTask(Consumer& consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    flushRoutes(consumer);
 }
 
-void RouteOrch::notifyNextHopChangeObservers(IpPrefix prefix, IpAddresses nexthops, bool add)
+void RouteOrch::notifyNextHopChangeObservers(const IpPrefix& prefix, const NextHopSetRef& nexthops, bool add)
 {
     SWSS_LOG_ENTER();
 
-    for (auto& entry : m_nextHopObservers)
+    /* Only the destinations inside the prefix can have it as best match */
+    m_nextHopObservers.forEachCovered(prefix, [&](const IpPrefix &dst, NextHopObserverEntry &entry)
     {
-        if (!prefix.isAddressInSubnet(entry.first))
-        {
-            continue;
-        }
-
         if (add)
         {
-            bool update_required = false;
-            NextHopUpdate update = { prefix, nexthops };
-
-            /* Table should not be empty. Default route should always exists. */
-            assert(!entry.second.routeTable.empty());
-
-            auto route = entry.second.routeTable.find(prefix);
-            if (route == entry.second.routeTable.end())
+            /* Added route is best match, or best match route changed */
+            if (prefix.getMaskLength() < entry.bestPrefix.getMaskLength())
             {
-                /* If added route is best match update observers */
-                if (entry.second.routeTable.rbegin()->first < prefix)
-                {
-                    update_required = true;
-                }
-
-                entry.second.routeTable.emplace(prefix, nexthops);
-            }
-            else
-            {
-                if (route->second != nexthops)
-                {
-                    route->second = nexthops;
-                    /* If changed route is best match update observers */
-                    if (entry.second.routeTable.rbegin()->first == route->first)
-                    {
-                        update_required = true;
-                    }
-                }
+                return;
             }
 
-            if (update_required)
+            entry.bestPrefix = prefix;
+
+            NextHopUpdate update = { prefix, nexthops->toIpAddresses() };
+
+            for (auto observer : entry.observers)
             {
-                for (auto observer : entry.second.observers)
-                {
-                    observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
-                }
+                observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
             }
         }
         else
         {
-            auto route = entry.second.routeTable.find(prefix);
-            if (route != entry.second.routeTable.end())
+            /* If removed route was best match find another best match route */
+            if (!(entry.bestPrefix == prefix))
             {
-                /* If removed route was best match find another best match route */
-                if (route->first == entry.second.routeTable.rbegin()->first)
-                {
-                    entry.second.routeTable.erase(route);
+                return;
+            }
 
-                    /* Table should not be empty. Default route should always exists. */
-                    assert(!entry.second.routeTable.empty());
+            /* Default route should always exists. */
+            auto route = m_syncdRouteTrie.longestMatch(dst.getIp(), &entry.bestPrefix);
+            assert(route != nullptr);
 
-                    auto route = entry.second.routeTable.rbegin();
-                    NextHopUpdate update = { route->first, route->second };
+            NextHopUpdate update = { entry.bestPrefix, (*route)->second->toIpAddresses() };
 
-                    for (auto observer : entry.second.observers)
-                    {
-                        observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
-                    }
-                }
-                else
-                {
-                    entry.second.routeTable.erase(route);
-                }
+            for (auto observer : entry.observers)
+            {
+                observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
             }
         }
-    }
+    });
 }
 
 void RouteOrch::increaseNextHopRefCount(IpAddresses ipAddresses)
+{
+    increaseNextHopRefCount(m_nextHopSets.intern(ipAddresses));
+}
+
+void RouteOrch::increaseNextHopRefCount(const NextHopSetRef& nextHops)
 {
     /* Return when there is no next hop (dropped) */
-    if (ipAddresses.getSize() == 0)
+    if (nextHops->size() == 0)
     {
         return;
     }
-    else if (ipAddresses.getSize() == 1)
+    else if (nextHops->size() == 1)
     {
-        IpAddress ip_address(ipAddresses.to_string());
-        m_neighOrch->increaseNextHopRefCount(ip_address);
+        m_neighOrch->increaseNextHopRefCount((*nextHops)[0]);
     }
     else
     {
-        m_syncdNextHopGroups[ipAddresses].ref_count ++;
+        m_syncdNextHopGroups[nextHops].ref_count ++;
     }
 }
+
 void RouteOrch::decreaseNextHopRefCount(IpAddresses ipAddresses)
+{
+    decreaseNextHopRefCount(m_nextHopSets.intern(ipAddresses));
+}
+
+void RouteOrch::decreaseNextHopRefCount(const NextHopSetRef& nextHops)
 {
     /* Return when there is no next hop (dropped) */
-    if (ipAddresses.getSize() == 0)
+    if (nextHops->size() == 0)
     {
         return;
     }
-    else if (ipAddresses.getSize() == 1)
+    else if (nextHops->size() == 1)
     {
-        IpAddress ip_address(ipAddresses.to_string());
-
-        m_neighOrch->decreaseNextHopRefCount(ip_address);
+        m_neighOrch->decreaseNextHopRefCount((*nextHops)[0]);
     }
     else
     {
-        m_syncdNextHopGroups[ipAddresses].ref_count --;
+        m_syncdNextHopGroups[nextHops].ref_count --;
     }
 }
 
 bool RouteOrch::isRefCounterZero(const IpAddresses& ipAddresses) const
 {
-    if (!hasNextHopGroup(ipAddresses))
+    NextHopSetRef nextHops = m_nextHopSets.find(ipAddresses);
+
+    return !nextHops || isRefCounterZero(nextHops);
+}
+
+bool RouteOrch::isRefCounterZero(const NextHopSetRef& nextHops) const
+{
+    auto it = m_syncdNextHopGroups.find(nextHops);
+    if (it == m_syncdNextHopGroups.end())
     {
         return true;
     }
 
-    return m_syncdNextHopGroups.at(ipAddresses).ref_count == 0;
+    return it->second.ref_count == 0;
 }
 
 bool RouteOrch::addNextHopGroup(IpAddresses ipAddresses)
+{
+    return addNextHopGroup(m_nextHopSets.intern(ipAddresses));
+}
+
+bool RouteOrch::addNextHopGroup(const NextHopSetRef& nextHops)
 {
     SWSS_LOG_ENTER();
 
-    assert(!hasNextHopGroup(ipAddresses));
+    assert(!hasNextHopGroup(nextHops));
 
     if (m_nextHopGroupCount >= m_maxNextHopGroupCount)
     {
@@ -423,22 +484,15 @@ bool RouteOrch::addNextHopGroup(IpAddresses ipAddresses)
         return false;
     }
 
-    vector<sai_object_id_t> next_hop_ids;
-    set<IpAddress> next_hop_set = ipAddresses.getIpAddresses();
-
-    /* Assert each IP address exists in m_syncdNextHops table,
-     * and add the corresponding next_hop_id to next_hop_ids. */
-    for (auto it : next_hop_set)
+    /* Assert each IP address exists in m_syncdNextHops table */
+    for (const auto &it : *nextHops)
     {
         if (!m_neighOrch->hasNextHop(it))
         {
             SWSS_LOG_INFO("Failed to get next hop %s in %s",
-                    it.to_string().c_str(), ipAddresses.to_string().c_str());
+                    it.to_string().c_str(), nextHops->to_string().c_str());
             return false;
         }
-
-        sai_object_id_t next_hop_id = m_neighOrch->getNextHopId(it);
-        next_hop_ids.push_back(next_hop_id);
     }
 
     sai_attribute_t nhg_attr;
@@ -455,81 +509,172 @@ bool RouteOrch::addNextHopGroup(IpAddresses ipAddresses)
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to create next hop group %s, rv:%d",
-                       ipAddresses.to_string().c_str(), status);
+                       nextHops->to_string().c_str(), status);
         return false;
     }
 
     m_nextHopGroupCount ++;
-    SWSS_LOG_NOTICE("Create next hop group %s", ipAddresses.to_string().c_str());
+    SWSS_LOG_NOTICE("Create next hop group %s", nextHops->to_string().c_str());
 
     NextHopGroupEntry next_hop_group_entry;
     next_hop_group_entry.next_hop_group_id = next_hop_group_id;
 
-    for (auto nhid: next_hop_ids)
+    vector<IpAddress> next_hops(nextHops->begin(), nextHops->end());
+
+    if (!addNextHopGroupMembers(next_hop_group_entry, next_hops))
     {
-        // Create a next hop group member
-        vector<sai_attribute_t> nhgm_attrs;
+        /* Clean up the members which were created and the group */
+        removeNextHopGroupMembers(next_hop_group_entry, next_hops);
+
+        sai_next_hop_group_api->remove_next_hop_group(next_hop_group_id);
+        m_nextHopGroupCount --;
+
+        return false;
+    }
+
+    /*
+     * Initialize the next hop group structure with ref_count as 0. This
+     * count will increase once the route is successfully syncd.
+     */
+    next_hop_group_entry.ref_count = 0;
+    m_syncdNextHopGroups[nextHops] = next_hop_group_entry;
+
+    return true;
+}
+
+/*
+ * Create the group members of the next hops in one bulk call. Each created
+ * member references its next hop. Return false if any member failed, the
+ * created ones are kept in the entry.
+ */
+bool RouteOrch::addNextHopGroupMembers(NextHopGroupEntry& entry, const vector<IpAddress>& nextHops)
+{
+    SWSS_LOG_ENTER();
+
+    uint32_t member_count = (uint32_t)nextHops.size();
+
+    if (member_count == 0)
+    {
+        return true;
+    }
 
+    vector<sai_attribute_t> nhgm_attrs;
+
+    for (const auto &ip : nextHops)
+    {
         sai_attribute_t nhgm_attr;
         nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
-        nhgm_attr.value.oid = next_hop_group_id;
+        nhgm_attr.value.oid = entry.next_hop_group_id;
         nhgm_attrs.push_back(nhgm_attr);
 
         nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
-        nhgm_attr.value.oid = nhid;
+        nhgm_attr.value.oid = m_neighOrch->getNextHopId(ip);
         nhgm_attrs.push_back(nhgm_attr);
+    }
 
-        sai_object_id_t next_hop_group_member_id;
-        status = sai_next_hop_group_api->
-                create_next_hop_group_member(&next_hop_group_member_id, gSwitchId, (uint32_t)nhgm_attrs.size(), nhgm_attrs.data());
+    vector<uint32_t> nhgm_attr_counts(member_count, 2);
+    vector<const sai_attribute_t *> nhgm_attr_lists;
+    for (uint32_t i = 0; i < member_count; i++)
+        nhgm_attr_lists.push_back(&nhgm_attrs[2 * i]);
 
-        if (status != SAI_STATUS_SUCCESS)
+    vector<sai_object_id_t> next_hop_group_member_ids(member_count, SAI_NULL_OBJECT_ID);
+    vector<sai_status_t> statuses(member_count, SAI_STATUS_FAILURE);
+
+    sai_status_t status = sai_next_hop_group_api->create_next_hop_group_members(gSwitchId, member_count,
+            nhgm_attr_counts.data(), nhgm_attr_lists.data(), SAI_REDIS_BULK_OP_TYPE_WAIT(SAI_BULK_OP_TYPE_INGORE_ERROR),
+            next_hop_group_member_ids.data(), statuses.data());
+
+    /* Save the membership into next hop structure */
+    for (uint32_t i = 0; i < member_count; i++)
+    {
+        if (statuses[i] == SAI_STATUS_SUCCESS)
         {
-            // TODO: do we need to clean up?
-            SWSS_LOG_ERROR("Failed to create next hop group %lx member %lx: %d\n",
-                           next_hop_group_id, next_hop_group_member_id, status);
-            return false;
+            entry.next_hop_group_members[nextHops[i]] = next_hop_group_member_ids[i];
+            m_neighOrch->increaseNextHopRefCount(nextHops[i]);
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Failed to create next hop group %lx member for next hop %s: %d\n",
+                           entry.next_hop_group_id, nextHops[i].to_string().c_str(), statuses[i]);
         }
+    }
 
-        // Save the membership into next hop structure
-        next_hop_group_entry.next_hop_group_members.insert(next_hop_group_member_id);
+    return status == SAI_STATUS_SUCCESS;
+}
+
+/*
+ * Remove the group members of the next hops in one bulk call. Return false
+ * if any member failed, it is kept in the entry to be removed on the next
+ * attempt.
+ */
+bool RouteOrch::removeNextHopGroupMembers(NextHopGroupEntry& entry, const vector<IpAddress>& nextHops)
+{
+    SWSS_LOG_ENTER();
+
+    vector<IpAddress> member_ips;
+    vector<sai_object_id_t> next_hop_group_member_ids;
+
+    for (const auto &ip : nextHops)
+    {
+        auto member = entry.next_hop_group_members.find(ip);
+        if (member != entry.next_hop_group_members.end())
+        {
+            member_ips.push_back(ip);
+            next_hop_group_member_ids.push_back(member->second);
+        }
     }
 
-    /* Increate the ref_count for the next hops used by the next hop group. */
-    for (auto it : next_hop_set)
-        m_neighOrch->increaseNextHopRefCount(it);
+    if (next_hop_group_member_ids.empty())
+    {
+        return true;
+    }
 
-    /*
-     * Initialize the next hop group structure with ref_count as 0. This
-     * count will increase once the route is successfully syncd.
-     */
-    next_hop_group_entry.ref_count = 0;
-    m_syncdNextHopGroups[ipAddresses] = next_hop_group_entry;
+    vector<sai_status_t> statuses(next_hop_group_member_ids.size(), SAI_STATUS_FAILURE);
 
-    return true;
+    sai_status_t status = sai_next_hop_group_api->remove_next_hop_group_members((uint32_t)next_hop_group_member_ids.size(),
+            next_hop_group_member_ids.data(), SAI_REDIS_BULK_OP_TYPE_WAIT(SAI_BULK_OP_TYPE_INGORE_ERROR), statuses.data());
+
+    /* Forget the removed members, the others are removed on the next attempt */
+    for (size_t i = 0; i < next_hop_group_member_ids.size(); i++)
+    {
+        if (statuses[i] == SAI_STATUS_SUCCESS)
+        {
+            entry.next_hop_group_members.erase(member_ips[i]);
+            m_neighOrch->decreaseNextHopRefCount(member_ips[i]);
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Failed to remove next hop group member %lx, rv:%d",
+                           next_hop_group_member_ids[i], statuses[i]);
+        }
+    }
+
+    return status == SAI_STATUS_SUCCESS;
 }
 
 bool RouteOrch::removeNextHopGroup(IpAddresses ipAddresses)
+{
+    return removeNextHopGroup(m_nextHopSets.find(ipAddresses));
+}
+
+bool RouteOrch::removeNextHopGroup(const NextHopSetRef& nextHops)
 {
     SWSS_LOG_ENTER();
 
-    sai_status_t status;
-    assert(hasNextHopGroup(ipAddresses));
+    assert(hasNextHopGroup(nextHops));
 
-    if (m_syncdNextHopGroups[ipAddresses].ref_count == 0)
+    if (m_syncdNextHopGroups[nextHops].ref_count == 0)
     {
-        auto next_hop_group_entry = m_syncdNextHopGroups[ipAddresses];
+        auto &next_hop_group_entry = m_syncdNextHopGroups[nextHops];
         sai_object_id_t next_hop_group_id = next_hop_group_entry.next_hop_group_id;
 
-        for (auto next_hop_group_member_id: next_hop_group_entry.next_hop_group_members)
-        {
-            status = sai_next_hop_group_api->remove_next_hop_group_member(next_hop_group_member_id);
-            if (status != SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_ERROR("Failed to remove next hop group member %lx, rv:%d", next_hop_group_member_id, status);
-                return false;
-            }
-        }
+        /* Remove all the next hop group members in one call */
+        vector<IpAddress> next_hops;
+        for (const auto &member : next_hop_group_entry.next_hop_group_members)
+            next_hops.push_back(member.first);
+
+        if (!removeNextHopGroupMembers(next_hop_group_entry, next_hops))
+            return false;
 
         sai_status_t status = sai_next_hop_group_api->remove_next_hop_group(next_hop_group_id);
         if (status != SAI_STATUS_SUCCESS)
@@ -540,60 +685,180 @@ bool RouteOrch::removeNextHopGroup(IpAddresses ipAddresses)
 
         m_nextHopGroupCount --;
 
-        set<IpAddress> ip_address_set = ipAddresses.getIpAddresses();
-        for (auto it : ip_address_set)
-            m_neighOrch->decreaseNextHopRefCount(it);
+        m_syncdNextHopGroups.erase(nextHops);
 
-        m_syncdNextHopGroups.erase(ipAddresses);
+        /* A next hop group slot is free */
+        wake(NHGRP_SLOT_DEPENDENCY);
     }
 
     return true;
 }
 
-void RouteOrch::addTempRoute(IpPrefix ipPrefix, IpAddresses nextHops)
+/*
+ * Change the next hops of a route in place when its next hop group is only
+ * referenced by this route and no group exists for the new next hops yet.
+ * Members are added before the old ones are removed, and the route keeps
+ * pointing to the same group, so no route is set and no group slot is
+ * needed. Return false when the route has to be set to another group.
+ */
+bool RouteOrch::updateNextHopGroup(const IpPrefix& ipPrefix, RouteTable::iterator it_route, const NextHopSetRef& nextHops)
 {
     SWSS_LOG_ENTER();
 
-    auto next_hop_set = nextHops.getIpAddresses();
+    const NextHopSetRef current = it_route->second;
+
+    if (current->size() <= 1 || nextHops->size() <= 1 || hasNextHopGroup(nextHops))
+    {
+        return false;
+    }
+
+    auto it_group = m_syncdNextHopGroups.find(current);
+    if (it_group == m_syncdNextHopGroups.end() || it_group->second.ref_count != 1)
+    {
+        return false;
+    }
+
+    vector<IpAddress> added, removed;
 
-    /* Remove next hops that are not in m_syncdNextHops */
-    for (auto it = next_hop_set.begin(); it != next_hop_set.end();)
+    set_difference(nextHops->begin(), nextHops->end(), current->begin(), current->end(), back_inserter(added));
+    set_difference(current->begin(), current->end(), nextHops->begin(), nextHops->end(), back_inserter(removed));
+
+    for (const auto &ip : added)
     {
-        if (!m_neighOrch->hasNextHop(*it))
+        if (!m_neighOrch->hasNextHop(ip))
+        {
+            return false;
+        }
+    }
+
+    NextHopGroupEntry &entry = it_group->second;
+
+    if (!addNextHopGroupMembers(entry, added))
+    {
+        /* The group is left as it was */
+        removeNextHopGroupMembers(entry, added);
+        return false;
+    }
+
+    if (!removeNextHopGroupMembers(entry, removed))
+    {
+        /*
+         * Restore the members of the group, it stays under its old key and
+         * the route is updated by addRoute.
+         */
+        vector<IpAddress> restored;
+        for (const auto &ip : removed)
+        {
+            if (entry.next_hop_group_members.find(ip) == entry.next_hop_group_members.end())
+            {
+                restored.push_back(ip);
+            }
+        }
+
+        if (!addNextHopGroupMembers(entry, restored) || !removeNextHopGroupMembers(entry, added))
+        {
+            SWSS_LOG_ERROR("Failed to restore next hop group %lx members to %s",
+                    entry.next_hop_group_id, current->to_string().c_str());
+        }
+        return false;
+    }
+
+    SWSS_LOG_INFO("Update next hop group %lx from %s to %s for route %s",
+            entry.next_hop_group_id, current->to_string().c_str(),
+            nextHops->to_string().c_str(), ipPrefix.to_string().c_str());
+
+    /* The reference of the route moves with the group */
+    NextHopGroupEntry updated = std::move(entry);
+    m_syncdNextHopGroups.erase(it_group);
+    m_syncdNextHopGroups[nextHops] = updated;
+
+    it_route->second = nextHops;
+
+    notifyNextHopChangeObservers(ipPrefix, nextHops, true);
+
+    return true;
+}
+
+/*
+ * Point the route to part of its next hops while their next hop group can't
+ * be added: the widest existing group made of its next hops, or else one of
+ * its next hops picked at random. Nothing is done when the route already
+ * points to a part at least as wide.
+ */
+void RouteOrch::addTempRoute(IpPrefix ipPrefix, const NextHopSetRef& nextHops)
+{
+    SWSS_LOG_ENTER();
+
+    size_t current_size = 0;
+
+    auto it_route = m_syncdRoutes.find(PackedPrefix(ipPrefix));
+    if (it_route != m_syncdRoutes.end() && it_route->second->isSubsetOf(*nextHops))
+    {
+        current_size = it_route->second->size();
+    }
+
+    /* Share the group with other routes, the group slots are exhausted */
+    NextHopSetRef group;
+    for (const auto &it : m_syncdNextHopGroups)
+    {
+        if (it.first->size() > max(current_size, group ? group->size() : 0) &&
+            it.first->isSubsetOf(*nextHops))
+        {
+            group = it.first;
+        }
+    }
+
+    if (group)
+    {
+        SWSS_LOG_INFO("Use next hop group %s for %s temporarily",
+                group->to_string().c_str(), ipPrefix.to_string().c_str());
+        addRoute("", ipPrefix, group);
+        return;
+    }
+
+    if (current_size != 0)
+        return;
+
+    /* Skip next hops that are not in m_syncdNextHops */
+    vector<IpAddress> next_hop_set;
+    for (const auto &it : *nextHops)
+    {
+        if (!m_neighOrch->hasNextHop(it))
         {
             SWSS_LOG_INFO("Failed to get next hop %s for %s",
-                   (*it).to_string().c_str(), ipPrefix.to_string().c_str());
-            it = next_hop_set.erase(it);
+                   it.to_string().c_str(), ipPrefix.to_string().c_str());
         }
         else
-            it++;
+            next_hop_set.push_back(it);
     }
 
     /* Return if next_hop_set is empty */
     if (next_hop_set.empty())
         return;
 
-    /* Randomly pick an address from the set */
-    auto it = next_hop_set.begin();
-    advance(it, rand() % next_hop_set.size());
-
-    /* Set the route's temporary next hop to be the randomly picked one */
-    IpAddresses tmp_next_hop((*it).to_string());
-    addRoute(ipPrefix, tmp_next_hop);
+    /* Set the route's temporary next hop to be a randomly picked one,
+     * there is no task to complete when it is synced */
+    IpAddresses tmp_next_hop;
+    tmp_next_hop.add(next_hop_set[rand() % next_hop_set.size()]);
+    addRoute("", ipPrefix, m_nextHopSets.intern(tmp_next_hop));
 }
 
-bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
+/*
+ * Queue the route to be created or updated by flushRoutes. Return false if
+ * the next hop (group) of the route can't be resolved yet.
+ */
+bool RouteOrch::addRoute(const string& key, IpPrefix ipPrefix, const NextHopSetRef& nextHops)
 {
     SWSS_LOG_ENTER();
 
     /* next_hop_id indicates the next hop id or next hop group id of this route */
     sai_object_id_t next_hop_id;
-    auto it_route = m_syncdRoutes.find(ipPrefix);
+    auto it_route = m_syncdRoutes.find(PackedPrefix(ipPrefix));
 
     /* The route is pointing to a next hop */
-    if (nextHops.getSize() == 1)
+    if (nextHops->size() == 1)
     {
-        IpAddress ip_address(nextHops.to_string());
+        const IpAddress &ip_address = (*nextHops)[0];
         if (m_neighOrch->hasNextHop(ip_address))
         {
             next_hop_id = m_neighOrch->getNextHopId(ip_address);
@@ -601,7 +866,7 @@ bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
         else
         {
             SWSS_LOG_INFO("Failed to get next hop %s for %s",
-                    nextHops.to_string().c_str(), ipPrefix.to_string().c_str());
+                    nextHops->to_string().c_str(), ipPrefix.to_string().c_str());
             return false;
         }
     }
@@ -614,22 +879,7 @@ bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
             /* Try to create a new next hop group */
             if (!addNextHopGroup(nextHops))
             {
-                /* Failed to create the next hop group and check if a temporary route is needed */
-
-                /* If the current next hop is part of the next hop group to sync,
-                 * then return false and no need to add another temporary route. */
-                if (it_route != m_syncdRoutes.end() && it_route->second.getSize() == 1)
-                {
-                    IpAddress ip_address(it_route->second.to_string());
-                    if (nextHops.contains(ip_address))
-                    {
-                        return false;
-                    }
-                }
-
-                /* Add a temporary route when a next hop group cannot be added,
-                 * and there is no temporary route right now or the current temporary
-                 * route is not pointing to a member of the next hop group to sync. */
+                /* Add a temporary route when a next hop group cannot be added */
                 addTempRoute(ipPrefix, nextHops);
                 /* Return false since the original route is not successfully added */
                 return false;
@@ -639,145 +889,110 @@ bool RouteOrch::addRoute(IpPrefix ipPrefix, IpAddresses nextHops)
         next_hop_id = m_syncdNextHopGroups[nextHops].next_hop_group_id;
     }
 
-    /* Sync the route entry */
-    sai_route_entry_t route_entry;
-    route_entry.vr_id = gVirtualRouterId;
-    route_entry.switch_id = gSwitchId;
-    copy(route_entry.destination, ipPrefix);
+    RouteBulkEntry entry;
+    entry.key = key;
+    entry.prefix = ipPrefix;
+    entry.nextHops = nextHops;
+    entry.route_entry.vr_id = gVirtualRouterId;
+    entry.route_entry.switch_id = gSwitchId;
+    copy(entry.route_entry.destination, ipPrefix);
 
     sai_attribute_t route_attr;
+    route_attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+    route_attr.value.oid = next_hop_id;
+    entry.attrs.push_back(route_attr);
+
+    /* Set the packet action to forward after the next hop when there was no next hop (dropped) */
+    if (it_route != m_syncdRoutes.end() && it_route->second->size() == 0)
+    {
+        route_attr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+        route_attr.value.s32 = SAI_PACKET_ACTION_FORWARD;
+        entry.attrs.push_back(route_attr);
+    }
 
-    /* If the prefix is not in m_syncdRoutes, then we need to create the route
+    /* Reference the next hop (group) until the route is synced or failed.
+     * If the prefix is not in m_syncdRoutes, then we need to create the route
      * for this prefix with the new next hop (group) id. If the prefix is already
      * in m_syncdRoutes, then we need to update the route with a new next hop
-     * (group) id. The old next hop (group) is then not used and the reference
-     * count will decrease by 1.
+     * (group) id, the old next hop (group) is released by completeRoute.
      */
+    increaseNextHopRefCount(nextHops);
+
     if (it_route == m_syncdRoutes.end())
     {
-        route_attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
-        route_attr.value.oid = next_hop_id;
-
         /* Default SAI_ROUTE_ATTR_PACKET_ACTION is SAI_PACKET_ACTION_FORWARD */
-        sai_status_t status = sai_route_api->create_route_entry(&route_entry, 1, &route_attr);
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            SWSS_LOG_ERROR("Failed to create route %s with next hop(s) %s",
-                    ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
-            /* Clean up the newly created next hop group entry */
-            if (nextHops.getSize() > 1)
-            {
-                removeNextHopGroup(nextHops);
-            }
-            return false;
-        }
-
-        /* Increase the ref_count for the next hop (group) entry */
-        increaseNextHopRefCount(nextHops);
-        SWSS_LOG_INFO("Create route %s with next hop(s) %s",
-                ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
+        m_bulkCreate.push_back(entry);
     }
     else
     {
-        sai_status_t status;
-
-        /* Set the packet action to forward when there was no next hop (dropped) */
-        if (it_route->second.getSize() == 0)
-        {
-            route_attr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
-            route_attr.value.s32 = SAI_PACKET_ACTION_FORWARD;
-
-            status = sai_route_api->set_route_entry_attribute(&route_entry, &route_attr);
-            if (status != SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_ERROR("Failed to set route %s with packet action forward, %d",
-                               ipPrefix.to_string().c_str(), status);
-                return false;
-            }
-        }
-
-        route_attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
-        route_attr.value.oid = next_hop_id;
-
-        /* Set the next hop ID to a new value */
-        status = sai_route_api->set_route_entry_attribute(&route_entry, &route_attr);
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            SWSS_LOG_ERROR("Failed to set route %s with next hop(s) %s",
-                    ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
-            return false;
-        }
-
-        /* Increase the ref_count for the next hop (group) entry */
-        increaseNextHopRefCount(nextHops);
-
-        decreaseNextHopRefCount(it_route->second);
-        if (it_route->second.getSize() > 1
-            && m_syncdNextHopGroups[it_route->second].ref_count == 0)
-        {
-            removeNextHopGroup(it_route->second);
-        }
-        SWSS_LOG_INFO("Set route %s with next hop(s) %s",
-                ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
+        m_bulkSet.push_back(entry);
     }
 
-    m_syncdRoutes[ipPrefix] = nextHops;
-
-    notifyNextHopChangeObservers(ipPrefix, nextHops, true);
     return true;
 }
 
-bool RouteOrch::removeRoute(IpPrefix ipPrefix)
+/*
+ * Queue the route to be removed by flushRoutes. The default route is not
+ * removed but set to drop.
+ */
+bool RouteOrch::removeRoute(const string& key, IpPrefix ipPrefix)
 {
     SWSS_LOG_ENTER();
 
-    sai_route_entry_t route_entry;
-    route_entry.vr_id = gVirtualRouterId;
-    route_entry.switch_id = gSwitchId;
-    copy(route_entry.destination, ipPrefix);
+    RouteBulkEntry entry;
+    entry.key = key;
+    entry.prefix = ipPrefix;
+    entry.nextHops = m_nextHopSets.intern(IpAddresses());
+    entry.route_entry.vr_id = gVirtualRouterId;
+    entry.route_entry.switch_id = gSwitchId;
+    copy(entry.route_entry.destination, ipPrefix);
 
-    // set to blackhole for default route
+    // set to blackhole for default route, drop before the next hop is removed
     if (ipPrefix.isDefaultRoute())
     {
         sai_attribute_t attr;
         attr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
         attr.value.s32 = SAI_PACKET_ACTION_DROP;
-
-        sai_status_t status = sai_route_api->set_route_entry_attribute(&route_entry, &attr);
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            SWSS_LOG_ERROR("Failed to set route %s packet action to drop, rv:%d",
-                    ipPrefix.to_string().c_str(), status);
-            return false;
-        }
-
-        SWSS_LOG_INFO("Set route %s packet action to drop", ipPrefix.to_string().c_str());
+        entry.attrs.push_back(attr);
 
         attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
         attr.value.oid = SAI_NULL_OBJECT_ID;
+        entry.attrs.push_back(attr);
 
-        status = sai_route_api->set_route_entry_attribute(&route_entry, &attr);
-        if (status != SAI_STATUS_SUCCESS)
-        {
-            SWSS_LOG_ERROR("Failed to set route %s next hop ID to NULL, rv:%d",
-                    ipPrefix.to_string().c_str(), status);
-            return false;
-        }
-
-        SWSS_LOG_INFO("Set route %s next hop ID to NULL", ipPrefix.to_string().c_str());
+        m_bulkSet.push_back(entry);
     }
     else
     {
-        sai_status_t status = sai_route_api->remove_route_entry(&route_entry);
-        if (status != SAI_STATUS_SUCCESS)
+        m_bulkRemove.push_back(entry);
+    }
+
+    return true;
+}
+
+/*
+ * Update the tables after a queued route operation. On success the old next
+ * hop (group) of the route is released and the task is done. On failure the
+ * new next hop (group) is released and the task stays in m_toSync to be
+ * retried.
+ */
+void RouteOrch::completeRoute(Consumer& consumer, const RouteBulkEntry& entry, bool success)
+{
+    SWSS_LOG_ENTER();
+
+    const IpPrefix &ipPrefix = entry.prefix;
+    const NextHopSetRef &nextHops = entry.nextHops;
+
+    if (!success)
+    {
+        decreaseNextHopRefCount(nextHops);
+        if (nextHops->size() > 1 && isRefCounterZero(nextHops))
         {
-            SWSS_LOG_ERROR("Failed to remove route prefix:%s\n", ipPrefix.to_string().c_str());
-            return false;
+            removeNextHopGroup(nextHops);
         }
+        return;
     }
 
-    /* Remove next hop group entry if ref_count is zero */
-    auto it_route = m_syncdRoutes.find(ipPrefix);
+    auto it_route = m_syncdRoutes.find(PackedPrefix(ipPrefix));
     if (it_route != m_syncdRoutes.end())
     {
         /*
@@ -787,28 +1002,171 @@ bool RouteOrch::removeRoute(IpPrefix ipPrefix)
          * to remove the next hop group.
          */
         decreaseNextHopRefCount(it_route->second);
-        if (it_route->second.getSize() > 1
+        if (it_route->second->size() > 1
             && m_syncdNextHopGroups[it_route->second].ref_count == 0)
         {
             removeNextHopGroup(it_route->second);
         }
     }
-    SWSS_LOG_INFO("Remove route %s with next hop(s) %s",
-            ipPrefix.to_string().c_str(), it_route->second.to_string().c_str());
 
-    if (ipPrefix.isDefaultRoute())
+    if (nextHops->size() != 0)
     {
-        m_syncdRoutes[ipPrefix] = IpAddresses();
+        SWSS_LOG_INFO("%s route %s with next hop(s) %s",
+                it_route == m_syncdRoutes.end() ? "Create" : "Set",
+                ipPrefix.to_string().c_str(), nextHops->to_string().c_str());
+
+        if (it_route == m_syncdRoutes.end())
+        {
+            m_syncdRouteTrie.insert(ipPrefix, &*m_syncdRoutes.emplace(PackedPrefix(ipPrefix), nextHops).first);
 
-        /* Notify about default route next hop change */
-        notifyNextHopChangeObservers(ipPrefix, m_syncdRoutes[ipPrefix], true);
+            notifyNextHopChangeObservers(ipPrefix, nextHops, true);
+        }
+        else if (it_route->second != nextHops)
+        {
+            it_route->second = nextHops;
+
+            notifyNextHopChangeObservers(ipPrefix, nextHops, true);
+        }
     }
     else
     {
-        m_syncdRoutes.erase(ipPrefix);
+        SWSS_LOG_INFO("Remove route %s", ipPrefix.to_string().c_str());
+
+        if (ipPrefix.isDefaultRoute())
+        {
+            if (it_route->second->size() != 0)
+            {
+                it_route->second = nextHops;
+
+                /* Notify about default route next hop change */
+                notifyNextHopChangeObservers(ipPrefix, it_route->second, true);
+            }
+        }
+        else
+        {
+            m_syncdRouteTrie.erase(ipPrefix);
+            m_syncdRoutes.erase(PackedPrefix(ipPrefix));
+
+            /* Notify about the route next hop removal */
+            notifyNextHopChangeObservers(ipPrefix, nextHops, false);
+        }
+    }
 
-        /* Notify about the route next hop removal */
-        notifyNextHopChangeObservers(ipPrefix, IpAddresses(), false);
+    if (!entry.key.empty())
+    {
+        consumer.m_toSync.erase(entry.key);
+    }
+}
+
+/*
+ * Send the queued route operations to the ASIC, one bulk call per operation
+ * type, and complete each route with its own status.
+ */
+void RouteOrch::flushRoutes(Consumer& consumer)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_bulkCreate.empty())
+    {
+        uint32_t count = (uint32_t)m_bulkCreate.size();
+        vector<sai_route_entry_t> route_entries;
+        vector<uint32_t> attr_counts;
+        vector<const sai_attribute_t *> attr_lists;
+        vector<sai_status_t> statuses(count, SAI_STATUS_FAILURE);
+
+        for (const auto &entry : m_bulkCreate)
+        {
+            route_entries.push_back(entry.route_entry);
+            attr_counts.push_back((uint32_t)entry.attrs.size());
+            attr_lists.push_back(entry.attrs.data());
+        }
+
+        sai_bulk_create_route_entry(count, route_entries.data(), attr_counts.data(),
+                attr_lists.data(), SAI_REDIS_BULK_OP_TYPE_WAIT(SAI_BULK_OP_TYPE_INGORE_ERROR), statuses.data());
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const auto &entry = m_bulkCreate[i];
+            if (statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to create route %s with next hop(s) %s, rv:%d",
+                        entry.prefix.to_string().c_str(), entry.nextHops->to_string().c_str(), statuses[i]);
+            }
+            completeRoute(consumer, entry, statuses[i] == SAI_STATUS_SUCCESS);
+        }
+
+        m_bulkCreate.clear();
+    }
+
+    if (!m_bulkSet.empty())
+    {
+        /* One object per attribute, attributes of a route are set in order */
+        vector<sai_route_entry_t> route_entries;
+        vector<sai_attribute_t> attrs;
+
+        for (const auto &entry : m_bulkSet)
+        {
+            for (const auto &attr : entry.attrs)
+            {
+                route_entries.push_back(entry.route_entry);
+                attrs.push_back(attr);
+            }
+        }
+
+        uint32_t count = (uint32_t)attrs.size();
+        vector<sai_status_t> statuses(count, SAI_STATUS_FAILURE);
+
+        sai_bulk_set_route_entry_attribute(count, route_entries.data(), attrs.data(),
+                SAI_REDIS_BULK_OP_TYPE_WAIT(SAI_BULK_OP_TYPE_INGORE_ERROR), statuses.data());
+
+        size_t index = 0;
+        for (const auto &entry : m_bulkSet)
+        {
+            sai_status_t status = SAI_STATUS_SUCCESS;
+            for (size_t i = 0; i < entry.attrs.size(); i++, index++)
+            {
+                if (statuses[index] != SAI_STATUS_SUCCESS)
+                {
+                    status = statuses[index];
+                }
+            }
+
+            if (status != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to set route %s with next hop(s) %s, rv:%d",
+                        entry.prefix.to_string().c_str(), entry.nextHops->to_string().c_str(), status);
+            }
+            completeRoute(consumer, entry, status == SAI_STATUS_SUCCESS);
+        }
+
+        m_bulkSet.clear();
+    }
+
+    if (!m_bulkRemove.empty())
+    {
+        uint32_t count = (uint32_t)m_bulkRemove.size();
+        vector<sai_route_entry_t> route_entries;
+        vector<sai_status_t> statuses(count, SAI_STATUS_FAILURE);
+
+        for (const auto &entry : m_bulkRemove)
+        {
+            route_entries.push_back(entry.route_entry);
+        }
+
+        sai_bulk_remove_route_entry(count, route_entries.data(),
+                SAI_REDIS_BULK_OP_TYPE_WAIT(SAI_BULK_OP_TYPE_INGORE_ERROR), statuses.data());
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const auto &entry = m_bulkRemove[i];
+            if (statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to remove route prefix:%s, rv:%d",
+                        entry.prefix.to_string().c_str(), statuses[i]);
+            }
+            completeRoute(consumer, entry, statuses[i] == SAI_STATUS_SUCCESS);
+        }
+
+        m_bulkRemove.clear();
     }
-    return true;
 }
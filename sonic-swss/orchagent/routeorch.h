@@ -9,8 +9,11 @@
 #include "ipaddress.h"
 #include "ipaddresses.h"
 #include "ipprefix.h"
+#include "prefixtrie.h"
+#include "routetable.h"
 
 #include <map>
+#include <unordered_map>
 
 /* Maximum next hop group number */
 #define NHGRP_MAX_SIZE 128
@@ -18,7 +21,7 @@
 struct NextHopGroupEntry
 {
     sai_object_id_t         next_hop_group_id;      // next hop group id
-    std::set<sai_object_id_t>    next_hop_group_members; // next hop group member ids
+    std::map<IpAddress, sai_object_id_t> next_hop_group_members; // next hop IP address, group member id
     int                     ref_count;              // reference count
 };
 
@@ -30,24 +33,40 @@ struct NextHopUpdate
 
 struct NextHopObserverEntry;
 
+/*
+ * Route operation queued by doTask and sent to the ASIC in bulk at the end
+ * of the pass. The next hop (group) of nextHops is referenced at queue time
+ * so it can't be removed before the operation completes.
+ */
+struct RouteBulkEntry
+{
+    string key;                         // task to complete, empty for temporary routes
+    IpPrefix prefix;
+    NextHopSetRef nextHops;             // empty set for a removal
+    sai_route_entry_t route_entry;
+    vector<sai_attribute_t> attrs;      // attributes to create, or to set in order
+};
+
 /* NextHopGroupTable: next hop group IP addersses, NextHopGroupEntry */
-typedef std::map<IpAddresses, NextHopGroupEntry> NextHopGroupTable;
-/* RouteTable: destination network, next hop IP address(es) */
-typedef std::map<IpPrefix, IpAddresses> RouteTable;
-/* NextHopObserverTable: Destination IP address, next hop observer entry */
-typedef std::map<IpAddress, NextHopObserverEntry> NextHopObserverTable;
+typedef std::unordered_map<NextHopSetRef, NextHopGroupEntry, NextHopSetRefHash> NextHopGroupTable;
+/* RouteTrie: destination network, route in RouteTable */
+typedef PrefixTrie<RouteTable::value_type *> RouteTrie;
+/* NextHopObserverTable: Destination IP address as host prefix, next hop observer entry */
+typedef PrefixTrie<NextHopObserverEntry> NextHopObserverTable;
 
 struct NextHopObserverEntry
 {
-    RouteTable routeTable;
+    IpPrefix bestPrefix;        // longest route prefix containing the destination
     list<Observer *> observers;
 };
 
-class RouteOrch : public Orch, public Subject
+class RouteOrch : public Orch, public Subject, public Observer
 {
 public:
     RouteOrch(DBConnector *db, string tableName, NeighOrch *neighOrch);
 
+    void update(SubjectType, void *);
+
     bool hasNextHopGroup(const IpAddresses&) const;
     sai_object_id_t getNextHopGroupId(const IpAddresses&);
 
@@ -62,6 +81,9 @@ public:
     bool removeNextHopGroup(IpAddresses);
 
 private:
+    /* Interned next hops of routes and next hop groups, outlives both tables */
+    NextHopSetPool m_nextHopSets;
+
     NeighOrch *m_neighOrch;
 
     int m_nextHopGroupCount;
@@ -69,17 +91,37 @@ private:
     bool m_resync;
 
     RouteTable m_syncdRoutes;
+    /* Same routes as m_syncdRoutes for longest prefix match */
+    RouteTrie m_syncdRouteTrie;
     NextHopGroupTable m_syncdNextHopGroups;
 
     NextHopObserverTable m_nextHopObservers;
 
-    void addTempRoute(IpPrefix, IpAddresses);
-    bool addRoute(IpPrefix, IpAddresses);
-    bool removeRoute(IpPrefix);
+    vector<RouteBulkEntry> m_bulkCreate;
+    vector<RouteBulkEntry> m_bulkSet;
+    vector<RouteBulkEntry> m_bulkRemove;
+
+    bool hasNextHopGroup(const NextHopSetRef&) const;
+    void increaseNextHopRefCount(const NextHopSetRef&);
+    void decreaseNextHopRefCount(const NextHopSetRef&);
+    bool isRefCounterZero(const NextHopSetRef&) const;
+    bool addNextHopGroup(const NextHopSetRef&);
+    bool removeNextHopGroup(const NextHopSetRef&);
+    bool addNextHopGroupMembers(NextHopGroupEntry&, const vector<IpAddress>&);
+    bool removeNextHopGroupMembers(NextHopGroupEntry&, const vector<IpAddress>&);
+    bool updateNextHopGroup(const IpPrefix&, RouteTable::iterator, const NextHopSetRef&);
+
+    void addTempRoute(IpPrefix, const NextHopSetRef&);
+    bool addRoute(const string&, IpPrefix, const NextHopSetRef&);
+    bool removeRoute(const string&, IpPrefix);
+
+    void flushRoutes(Consumer&);
+    void completeRoute(Consumer&, const RouteBulkEntry&, bool);
 
     void doTask(Consumer& consumer);
+    void waitForNextHops(Consumer&, const string&, const NextHopSetRef&);
 
-    void notifyNextHopChangeObservers(IpPrefix, IpAddresses, bool);
+    void notifyNextHopChangeObservers(const IpPrefix&, const NextHopSetRef&, bool);
 };
 
 #endif /* SWSS_ROUTEORCH_H */
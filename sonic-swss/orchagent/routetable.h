@@ -0,0 +1,415 @@
+// Compact route and next hop group storage of RouteOrch
+//
+// Routes are hashed on a packed prefix and point to an interned next hop
+// set, so routes with the same next hops share one sorted array of
+// addresses instead of each holding its own std::set.
+//
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <string.h>
+#include "ipaddress.h"
+#include "ipaddresses.h"
+#include "ipprefix.h"
+
+namespace swss {
+
+/* FNV-1a */
+inline size_t hashBytes(const void *data, size_t size, size_t hash = 14695981039346656037ULL)
+{
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+inline size_t hashIpAddress(const IpAddress &ip, size_t hash)
+{
+    uint8_t family = ip.isV4() ? AF_INET : AF_INET6;
+
+    hash = hashBytes(&family, sizeof(family), hash);
+
+    if (ip.isV4())
+    {
+        uint32_t addr = ip.getV4Addr();
+        return hashBytes(&addr, sizeof(addr), hash);
+    }
+
+    return hashBytes(ip.getV6Addr(), 16, hash);
+}
+
+/* IP prefix packed in 18 bytes */
+struct PackedPrefix
+{
+    uint8_t addr[16];       // IPv4 address in the first 4 bytes
+    uint8_t family;
+    uint8_t len;
+
+    PackedPrefix()
+    {
+        memset(this, 0, sizeof(*this));
+    }
+
+    explicit PackedPrefix(const IpPrefix &prefix)
+    {
+        memset(this, 0, sizeof(*this));
+
+        IpAddress ip = prefix.getIp();
+
+        if (ip.isV4())
+        {
+            uint32_t v4 = ip.getV4Addr();
+            memcpy(addr, &v4, sizeof(v4));
+            family = AF_INET;
+        }
+        else
+        {
+            memcpy(addr, ip.getV6Addr(), 16);
+            family = AF_INET6;
+        }
+
+        len = (uint8_t)prefix.getMaskLength();
+    }
+
+    IpPrefix toIpPrefix() const
+    {
+        ip_addr_t ip;
+
+        ip.family = family;
+
+        if (family == AF_INET)
+        {
+            memcpy(&ip.ip_addr.ipv4_addr, addr, 4);
+        }
+        else
+        {
+            memcpy(ip.ip_addr.ipv6_addr, addr, 16);
+        }
+
+        return IpPrefix(IpAddress(ip), len);
+    }
+
+    bool operator==(const PackedPrefix &o) const
+    {
+        return memcmp(this, &o, sizeof(*this)) == 0;
+    }
+};
+
+static_assert(sizeof(PackedPrefix) == 18, "PackedPrefix must not have padding");
+
+struct PackedPrefixHash
+{
+    size_t operator()(const PackedPrefix &prefix) const
+    {
+        return hashBytes(&prefix, sizeof(prefix));
+    }
+};
+
+class NextHopSetPool;
+
+/*
+ * Sorted next hop addresses, interned by NextHopSetPool and referenced
+ * through NextHopSetRef. Immutable once interned.
+ */
+class NextHopSet
+{
+public:
+    typedef std::vector<IpAddress>::const_iterator const_iterator;
+
+    size_t size() const
+    {
+        return m_addresses.size();
+    }
+
+    bool empty() const
+    {
+        return m_addresses.empty();
+    }
+
+    const_iterator begin() const
+    {
+        return m_addresses.begin();
+    }
+
+    const_iterator end() const
+    {
+        return m_addresses.end();
+    }
+
+    const IpAddress& operator[](size_t index) const
+    {
+        return m_addresses[index];
+    }
+
+    size_t hash() const
+    {
+        return m_hash;
+    }
+
+    bool contains(const IpAddress &ip) const
+    {
+        return std::binary_search(m_addresses.begin(), m_addresses.end(), ip);
+    }
+
+    /* True when every address of this set is in other */
+    bool isSubsetOf(const NextHopSet &other) const
+    {
+        return std::includes(other.m_addresses.begin(), other.m_addresses.end(),
+                m_addresses.begin(), m_addresses.end());
+    }
+
+    bool equals(const IpAddresses &ips) const
+    {
+        const auto &set = ips.getIpAddresses();
+
+        return set.size() == m_addresses.size() && std::equal(set.begin(), set.end(), m_addresses.begin());
+    }
+
+    IpAddresses toIpAddresses() const
+    {
+        IpAddresses ips;
+
+        for (const auto &ip : m_addresses)
+        {
+            ips.add(ip);
+        }
+
+        return ips;
+    }
+
+    /* Same format as IpAddresses::to_string */
+    std::string to_string() const
+    {
+        std::string str;
+
+        for (size_t i = 0; i < m_addresses.size(); i++)
+        {
+            if (i != 0)
+            {
+                str += ",";
+            }
+
+            str += m_addresses[i].to_string();
+        }
+
+        return str;
+    }
+
+    static size_t hash(const IpAddresses &ips)
+    {
+        size_t hash = hashBytes(nullptr, 0);
+
+        for (const auto &ip : ips.getIpAddresses())
+        {
+            hash = hashIpAddress(ip, hash);
+        }
+
+        return hash;
+    }
+
+private:
+    friend class NextHopSetPool;
+    friend class NextHopSetRef;
+
+    NextHopSet(NextHopSetPool *pool, const IpAddresses &ips, size_t hash) :
+        m_addresses(ips.getIpAddresses().begin(), ips.getIpAddresses().end()),
+        m_hash(hash),
+        m_refCount(0),
+        m_pool(pool)
+    {
+    }
+
+    NextHopSet(const NextHopSet&) = delete;
+    NextHopSet& operator=(const NextHopSet&) = delete;
+
+    inline void release();
+
+    std::vector<IpAddress> m_addresses;
+    size_t m_hash;
+    size_t m_refCount;
+    NextHopSetPool *m_pool;
+};
+
+/* Counted reference to an interned next hop set, compares by identity */
+class NextHopSetRef
+{
+public:
+    NextHopSetRef() : m_set(nullptr) {}
+
+    NextHopSetRef(const NextHopSetRef &o) : m_set(o.m_set)
+    {
+        acquire();
+    }
+
+    NextHopSetRef(NextHopSetRef &&o) noexcept : m_set(o.m_set)
+    {
+        o.m_set = nullptr;
+    }
+
+    ~NextHopSetRef()
+    {
+        reset();
+    }
+
+    NextHopSetRef& operator=(NextHopSetRef o)
+    {
+        std::swap(m_set, o.m_set);
+        return *this;
+    }
+
+    void reset()
+    {
+        if (m_set != nullptr)
+        {
+            m_set->release();
+            m_set = nullptr;
+        }
+    }
+
+    explicit operator bool() const
+    {
+        return m_set != nullptr;
+    }
+
+    const NextHopSet& operator*() const
+    {
+        return *m_set;
+    }
+
+    const NextHopSet* operator->() const
+    {
+        return m_set;
+    }
+
+    bool operator==(const NextHopSetRef &o) const
+    {
+        return m_set == o.m_set;
+    }
+
+    bool operator!=(const NextHopSetRef &o) const
+    {
+        return m_set != o.m_set;
+    }
+
+private:
+    friend class NextHopSetPool;
+
+    explicit NextHopSetRef(NextHopSet *set) : m_set(set)
+    {
+        acquire();
+    }
+
+    void acquire()
+    {
+        if (m_set != nullptr)
+        {
+            m_set->m_refCount++;
+        }
+    }
+
+    NextHopSet *m_set;
+};
+
+struct NextHopSetRefHash
+{
+    size_t operator()(const NextHopSetRef &ref) const
+    {
+        return ref ? ref->hash() : 0;
+    }
+};
+
+/*
+ * Interns next hop sets, equal sets share one NextHopSet. A set is freed
+ * with its last reference, so the pool must outlive all references.
+ */
+class NextHopSetPool
+{
+public:
+    NextHopSetPool() {}
+
+    NextHopSetPool(const NextHopSetPool&) = delete;
+    NextHopSetPool& operator=(const NextHopSetPool&) = delete;
+
+    /* Returns the set equal to ips, interning it first if needed */
+    NextHopSetRef intern(const IpAddresses &ips)
+    {
+        size_t hash = NextHopSet::hash(ips);
+
+        NextHopSet *set = lookup(ips, hash);
+
+        if (set == nullptr)
+        {
+            set = new NextHopSet(this, ips, hash);
+            m_sets.emplace(hash, set);
+        }
+
+        return NextHopSetRef(set);
+    }
+
+    /* Returns the set equal to ips, or an empty reference when not interned */
+    NextHopSetRef find(const IpAddresses &ips) const
+    {
+        return NextHopSetRef(lookup(ips, NextHopSet::hash(ips)));
+    }
+
+    size_t size() const
+    {
+        return m_sets.size();
+    }
+
+private:
+    friend class NextHopSet;
+
+    NextHopSet* lookup(const IpAddresses &ips, size_t hash) const
+    {
+        auto range = m_sets.equal_range(hash);
+
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second->equals(ips))
+            {
+                return it->second;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void erase(NextHopSet *set)
+    {
+        auto range = m_sets.equal_range(set->m_hash);
+
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second == set)
+            {
+                m_sets.erase(it);
+                break;
+            }
+        }
+
+        delete set;
+    }
+
+    std::unordered_multimap<size_t, NextHopSet *> m_sets;
+};
+
+inline void NextHopSet::release()
+{
+    if (--m_refCount == 0)
+    {
+        m_pool->erase(this);
+    }
+}
+
+/* RouteTable: destination network, next hop IP address(es) */
+typedef std::unordered_map<PackedPrefix, NextHopSetRef, PackedPrefixHash> RouteTable;
+
+}
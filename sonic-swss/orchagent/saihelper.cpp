@@ -5,7 +5,6 @@ extern "C" {
 
 #include <fstream>
 #include <map>
-#include <sys/time.h>
 
 #include <logger.h>
 #include <sairedis.h>
@@ -43,8 +42,7 @@ sai_fdb_api_t*              sai_fdb_api;
 extern sai_object_id_t gSwitchId;
 extern bool gSairedisRecord;
 extern bool gSwssRecord;
-extern ofstream gRecordOfs;
-extern string gRecordFile;
+extern bool gRecordBinary;
 
 map<string, string> gProfileMap;
 
@@ -152,18 +150,6 @@ void initSaiApi()
     sai_log_set(SAI_API_ACL,                    SAI_LOG_LEVEL_NOTICE);
 }
 
-string getTimestamp()
-{
-    char buffer[64];
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-
-    size_t size = strftime(buffer, 32 ,"%Y-%m-%d.%T.", localtime(&tv.tv_sec));
-    snprintf(&buffer[size], 32, "%06ld", tv.tv_usec);
-
-    return string(buffer);
-}
-
 void initSaiRedis(const string &record_location)
 {
     /**
@@ -190,6 +176,16 @@ void initSaiRedis(const string &record_location)
                 record_location.c_str(), status);
             exit(EXIT_FAILURE);
         }
+
+        attr.id = SAI_REDIS_SWITCH_ATTR_RECORDING_BINARY;
+        attr.value.booldata = gRecordBinary;
+
+        status = sai_switch_api->set_switch_attribute(gSwitchId, &attr);
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to set SAI Redis recording format, rv:%d", status);
+            exit(EXIT_FAILURE);
+        }
     }
 
     /* Disable/enable SAI Redis recording */
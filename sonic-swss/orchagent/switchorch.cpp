@@ -28,6 +28,8 @@ const map<string, sai_packet_action_t> packet_action_map =
 SwitchOrch::SwitchOrch(DBConnector *db, string tableName) :
         Orch(db, tableName)
 {
+    /* Every switch attribute is applied on its own */
+    enableDeltaPops(tableName);
 }
 
 void SwitchOrch::doTask(Consumer &consumer)
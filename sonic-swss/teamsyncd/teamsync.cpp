@@ -206,6 +206,11 @@ bool TeamSync::TeamPortSync::isMe(fd_set *fd)
     return FD_ISSET(team_get_event_fd(m_team), fd);
 }
 
+int TeamSync::TeamPortSync::getFd()
+{
+    return team_get_event_fd(m_team);
+}
+
 int TeamSync::TeamPortSync::readCache()
 {
     return NODATA;
@@ -0,0 +1,287 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+#include "aclorch.h"
+#include "neighorch.h"
+#include "routeorch.h"
+#include <sairedis.h>
+
+using namespace std;
+using namespace swss;
+
+/* Globals of orchagent referenced by aclorch.cpp and port.cpp */
+sai_acl_api_t *sai_acl_api;
+sai_port_api_t *sai_port_api;
+sai_switch_api_t *sai_switch_api;
+sai_object_id_t gSwitchId = 0x21000000000000;
+
+/* SAI as seen by the ACL rules: created objects, set attributes, failures to inject */
+static sai_object_id_t g_nextOid;
+static vector<sai_attribute_t> g_entrySets;
+static set<uint32_t> g_failEntryCreates;
+static set<uint32_t> g_failEntryRemoves;
+static size_t g_counterRemoves;
+
+static sai_status_t getSwitchAttribute(sai_object_id_t, uint32_t attr_count, sai_attribute_t *attr_list)
+{
+    for (uint32_t i = 0; i < attr_count; i++)
+        attr_list[i].value.u32 = i == 0 ? 0 : 1000;
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t setAclEntryAttribute(sai_object_id_t, const sai_attribute_t *attr)
+{
+    g_entrySets.push_back(*attr);
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t createAclRange(sai_object_id_t *oid, sai_object_id_t, uint32_t, const sai_attribute_t *)
+{
+    *oid = ++g_nextOid;
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t removeAclRange(sai_object_id_t)
+{
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t redis_bulk_object_create_acl_entries(sai_object_id_t, uint32_t object_count, const uint32_t *,
+        const sai_attribute_t *const *, sai_bulk_op_type_t, sai_object_id_t *object_id, sai_status_t *object_statuses)
+{
+    for (uint32_t i = 0; i < object_count; i++)
+    {
+        bool fail = g_failEntryCreates.count(i) != 0;
+        object_id[i] = fail ? SAI_NULL_OBJECT_ID : ++g_nextOid;
+        object_statuses[i] = fail ? SAI_STATUS_FAILURE : SAI_STATUS_SUCCESS;
+    }
+    return g_failEntryCreates.empty() ? SAI_STATUS_SUCCESS : SAI_STATUS_FAILURE;
+}
+
+sai_status_t redis_bulk_object_remove_acl_entries(uint32_t object_count, const sai_object_id_t *,
+        sai_bulk_op_type_t, sai_status_t *object_statuses)
+{
+    for (uint32_t i = 0; i < object_count; i++)
+        object_statuses[i] = g_failEntryRemoves.count(i) ? SAI_STATUS_FAILURE : SAI_STATUS_SUCCESS;
+    return g_failEntryRemoves.empty() ? SAI_STATUS_SUCCESS : SAI_STATUS_FAILURE;
+}
+
+sai_status_t redis_bulk_object_create_acl_counters(sai_object_id_t, uint32_t object_count, const uint32_t *,
+        const sai_attribute_t *const *, sai_bulk_op_type_t, sai_object_id_t *object_id, sai_status_t *object_statuses)
+{
+    for (uint32_t i = 0; i < object_count; i++)
+    {
+        object_id[i] = ++g_nextOid;
+        object_statuses[i] = SAI_STATUS_SUCCESS;
+    }
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t redis_bulk_object_remove_acl_counters(uint32_t object_count, const sai_object_id_t *,
+        sai_bulk_op_type_t, sai_status_t *object_statuses)
+{
+    for (uint32_t i = 0; i < object_count; i++)
+        object_statuses[i] = SAI_STATUS_SUCCESS;
+    g_counterRemoves += object_count;
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Orchs the rules may reference, none of the tested rules redirect or mirror */
+const Port* PortsOrch::findPort(const string &) const { return nullptr; }
+bool PortsOrch::getPort(sai_object_id_t, Port &) { return false; }
+bool MirrorOrch::sessionExists(const string&) { return false; }
+bool MirrorOrch::getSessionState(const string&, bool&) { return false; }
+bool MirrorOrch::getSessionOid(const string&, sai_object_id_t&) { return false; }
+bool MirrorOrch::increaseRefCount(const string&) { return false; }
+bool MirrorOrch::decreaseRefCount(const string&) { return false; }
+bool NeighOrch::hasNextHop(IpAddress) { return false; }
+sai_object_id_t NeighOrch::getNextHopId(const IpAddress&) { return SAI_NULL_OBJECT_ID; }
+void NeighOrch::increaseNextHopRefCount(const IpAddress&) { }
+void NeighOrch::decreaseNextHopRefCount(const IpAddress&) { }
+bool RouteOrch::hasNextHopGroup(const IpAddresses&) const { return false; }
+sai_object_id_t RouteOrch::getNextHopGroupId(const IpAddresses&) { return SAI_NULL_OBJECT_ID; }
+void RouteOrch::increaseNextHopRefCount(IpAddresses) { }
+void RouteOrch::decreaseNextHopRefCount(IpAddresses) { }
+bool RouteOrch::isRefCounterZero(const IpAddresses&) const { return false; }
+bool RouteOrch::addNextHopGroup(IpAddresses) { return false; }
+bool RouteOrch::removeNextHopGroup(IpAddresses) { return false; }
+
+class AclOrchTest : public ::testing::Test
+{
+protected:
+    const sai_object_id_t tableOid = 0x7000000000001;
+
+    sai_acl_api_t aclApi;
+    sai_switch_api_t switchApi;
+    unique_ptr<AclOrch> orch;
+
+    void SetUp() override
+    {
+        memset(&aclApi, 0, sizeof(aclApi));
+        aclApi.set_acl_entry_attribute = setAclEntryAttribute;
+        aclApi.create_acl_range = createAclRange;
+        aclApi.remove_acl_range = removeAclRange;
+        sai_acl_api = &aclApi;
+
+        memset(&switchApi, 0, sizeof(switchApi));
+        switchApi.get_switch_attribute = getSwitchAttribute;
+        sai_switch_api = &switchApi;
+
+        g_nextOid = 0x8000000000000;
+        g_entrySets.clear();
+        g_failEntryCreates.clear();
+        g_failEntryRemoves.clear();
+        g_counterRemoves = 0;
+
+        /* No flex counters, registering them would write to redis */
+        AclOrch::m_bCollectCounters = false;
+
+        vector<string> tableNames;
+        orch.reset(new AclOrch(nullptr, tableNames, nullptr, nullptr, nullptr, nullptr));
+
+        AclTable table;
+        table.id = "T";
+        table.type = ACL_TABLE_L3;
+        orch->m_AclTables[tableOid] = table;
+    }
+
+    void TearDown() override
+    {
+        orch.reset();
+    }
+
+    shared_ptr<AclRule> makeRule(const string &name, const vector<FieldValueTuple> &fields)
+    {
+        auto rule = make_shared<AclRuleL3>(orch.get(), name, "T", ACL_TABLE_L3);
+
+        for (const auto &fv : fields)
+        {
+            EXPECT_TRUE(rule->validateAddPriority(fvField(fv), fvValue(fv)) ||
+                        rule->validateAddMatch(fvField(fv), fvValue(fv)) ||
+                        rule->validateAddAction(fvField(fv), fvValue(fv)));
+        }
+        EXPECT_TRUE(rule->validate());
+
+        return rule;
+    }
+
+    shared_ptr<AclRule> installRule(const string &name, const vector<FieldValueTuple> &fields)
+    {
+        auto rule = makeRule(name, fields);
+
+        EXPECT_EQ(AclRule::createInBulk({ rule }), vector<bool>({ true }));
+        orch->m_AclTables[tableOid].rules[name] = rule;
+
+        return rule;
+    }
+
+    static sai_object_id_t ruleOid(const shared_ptr<AclRule> &rule) { return rule->m_ruleOid; }
+    static sai_object_id_t counterOid(const shared_ptr<AclRule> &rule) { return rule->m_counterOid; }
+
+    void flush(Consumer &consumer, const vector<AclRuleChange> &changes)
+    {
+        orch->flushAclRules(consumer, changes);
+    }
+
+    size_t installedRules()
+    {
+        return orch->m_AclTables[tableOid].rules.size();
+    }
+};
+
+TEST_F(AclOrchTest, update_priority_in_place)
+{
+    auto installed = installRule("R", { { "PRIORITY", "10" }, { "SRC_IP", "10.0.0.1/32" }, { "PACKET_ACTION", "DROP" } });
+    sai_object_id_t entry = ruleOid(installed);
+    sai_object_id_t counter = counterOid(installed);
+
+    auto rule = makeRule("R", { { "PRIORITY", "20" }, { "SRC_IP", "10.0.0.1/32" }, { "PACKET_ACTION", "DROP" } });
+
+    ASSERT_TRUE(rule->updateInPlace(*installed));
+
+    /* Only the priority is set, the entry and its counter are taken over */
+    ASSERT_EQ(g_entrySets.size(), 1u);
+    EXPECT_EQ(g_entrySets[0].id, (sai_attr_id_t)SAI_ACL_ENTRY_ATTR_PRIORITY);
+    EXPECT_EQ(g_entrySets[0].value.u32, 20u);
+
+    EXPECT_EQ(ruleOid(rule), entry);
+    EXPECT_EQ(counterOid(rule), counter);
+    EXPECT_EQ(ruleOid(installed), SAI_NULL_OBJECT_ID);
+    EXPECT_EQ(counterOid(installed), SAI_NULL_OBJECT_ID);
+}
+
+TEST_F(AclOrchTest, update_removed_match_and_changed_action_in_place)
+{
+    auto installed = installRule("R", { { "PRIORITY", "10" }, { "SRC_IP", "10.0.0.1/32" }, { "IP_PROTOCOL", "6" }, { "PACKET_ACTION", "DROP" } });
+
+    auto rule = makeRule("R", { { "PRIORITY", "10" }, { "SRC_IP", "10.0.0.1/32" }, { "PACKET_ACTION", "FORWARD" } });
+
+    ASSERT_TRUE(rule->updateInPlace(*installed));
+
+    /* Removed match is disabled, changed action is set, the same match is left alone */
+    ASSERT_EQ(g_entrySets.size(), 2u);
+    EXPECT_EQ(g_entrySets[0].id, (sai_attr_id_t)SAI_ACL_ENTRY_ATTR_FIELD_IP_PROTOCOL);
+    EXPECT_FALSE(g_entrySets[0].value.aclfield.enable);
+    EXPECT_EQ(g_entrySets[1].id, (sai_attr_id_t)SAI_ACL_ENTRY_ATTR_ACTION_PACKET_ACTION);
+    EXPECT_TRUE(g_entrySets[1].value.aclaction.enable);
+    EXPECT_EQ(g_entrySets[1].value.aclaction.parameter.s32, SAI_PACKET_ACTION_FORWARD);
+}
+
+TEST_F(AclOrchTest, changed_range_is_not_updated_in_place)
+{
+    auto installed = installRule("R", { { "PRIORITY", "10" }, { "L4_SRC_PORT_RANGE", "100-200" }, { "PACKET_ACTION", "DROP" } });
+    sai_object_id_t entry = ruleOid(installed);
+
+    auto rule = makeRule("R", { { "PRIORITY", "10" }, { "L4_SRC_PORT_RANGE", "100-300" }, { "PACKET_ACTION", "DROP" } });
+
+    /* Range objects can't be swapped under the entry, the rule is recreated */
+    EXPECT_FALSE(rule->updateInPlace(*installed));
+    EXPECT_TRUE(g_entrySets.empty());
+    EXPECT_EQ(ruleOid(installed), entry);
+    EXPECT_EQ(ruleOid(rule), SAI_NULL_OBJECT_ID);
+}
+
+TEST_F(AclOrchTest, remove_in_bulk_partial_failure)
+{
+    auto a = installRule("A", { { "PRIORITY", "10" }, { "SRC_IP", "10.0.0.1/32" }, { "PACKET_ACTION", "DROP" } });
+    auto b = installRule("B", { { "PRIORITY", "20" }, { "SRC_IP", "10.0.0.2/32" }, { "PACKET_ACTION", "DROP" } });
+    sai_object_id_t entry = ruleOid(b);
+
+    g_failEntryRemoves = { 1 };
+
+    EXPECT_EQ(AclRule::removeInBulk({ a, b }), vector<bool>({ true, false }));
+
+    /* Counter of the rule whose entry is still there is kept */
+    EXPECT_EQ(g_counterRemoves, 1u);
+    EXPECT_EQ(ruleOid(a), SAI_NULL_OBJECT_ID);
+    EXPECT_EQ(counterOid(a), SAI_NULL_OBJECT_ID);
+    EXPECT_EQ(ruleOid(b), entry);
+    EXPECT_NE(counterOid(b), SAI_NULL_OBJECT_ID);
+}
+
+TEST_F(AclOrchTest, flush_keeps_failed_creates_in_to_sync)
+{
+    auto a = makeRule("A", { { "PRIORITY", "10" }, { "SRC_IP", "10.0.0.1/32" }, { "PACKET_ACTION", "DROP" } });
+    auto b = makeRule("B", { { "PRIORITY", "20" }, { "SRC_IP", "10.0.0.2/32" }, { "PACKET_ACTION", "DROP" } });
+
+    Consumer consumer(nullptr);
+    consumer.m_toSync.emplace("T:A", KeyOpFieldsValuesTuple("T:A", SET_COMMAND, vector<FieldValueTuple>()));
+    consumer.m_toSync.emplace("T:B", KeyOpFieldsValuesTuple("T:B", SET_COMMAND, vector<FieldValueTuple>()));
+
+    g_failEntryCreates = { 1 };
+
+    flush(consumer, { { "T:A", tableOid, nullptr, a }, { "T:B", tableOid, nullptr, b } });
+
+    /* Created rule is done, the failed one is retried and its counter released */
+    EXPECT_EQ(consumer.m_toSync.count("T:A"), 0u);
+    EXPECT_EQ(consumer.m_toSync.count("T:B"), 1u);
+    EXPECT_EQ(installedRules(), 1u);
+    EXPECT_NE(ruleOid(a), SAI_NULL_OBJECT_ID);
+    EXPECT_EQ(ruleOid(b), SAI_NULL_OBJECT_ID);
+    EXPECT_EQ(counterOid(b), SAI_NULL_OBJECT_ID);
+    EXPECT_EQ(g_counterRemoves, 1u);
+}
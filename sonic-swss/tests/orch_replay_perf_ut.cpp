@@ -0,0 +1,276 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+#include "orch.h"
+#include "portsorch.h"
+#include "recorder.h"
+
+using namespace std;
+using namespace swss;
+
+/* Globals of orchagent referenced by orch.cpp */
+int gBatchSize = 128;
+mutex gDbMutex;
+PortsOrch *gPortsOrch = nullptr;
+bool gSwssRecord = false;
+Recorder gRecorder;
+
+bool PortsOrch::isInitDone()
+{
+    return true;
+}
+
+/* Count heap allocations to measure the cost of the consumer path */
+static size_t g_allocations = 0;
+
+void *operator new(size_t size)
+{
+    g_allocations++;
+    void *p = malloc(size);
+    if (p == nullptr)
+        throw bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+/* Replay input: table name, popped tuple */
+typedef deque<pair<string, KeyOpFieldsValuesTuple>> Replay;
+
+/*
+ * Parse a swss.rec recording, lines are
+ * timestamp|TABLE:key|op|field:value|field:value...
+ */
+static void loadRecord(const string &file, Replay &replay)
+{
+    ifstream in(file);
+    string line;
+
+    while (getline(in, line))
+    {
+        vector<string> items;
+        size_t start = 0, end;
+        while ((end = line.find('|', start)) != string::npos)
+        {
+            items.push_back(line.substr(start, end - start));
+            start = end + 1;
+        }
+        items.push_back(line.substr(start));
+
+        if (items.size() < 3)
+            continue;
+
+        size_t colon = items[1].find(':');
+        if (colon == string::npos)
+            continue;
+
+        vector<FieldValueTuple> values;
+        for (size_t i = 3; i < items.size(); i++)
+        {
+            size_t pos = items[i].find(':');
+            if (pos == string::npos)
+                continue;
+            values.emplace_back(items[i].substr(0, pos), items[i].substr(pos + 1));
+        }
+
+        replay.emplace_back(items[1].substr(0, colon),
+                KeyOpFieldsValuesTuple(items[1].substr(colon + 1), items[2], values));
+    }
+}
+
+/* A full route table download followed by a churn of next hop updates */
+static void makeRouteDownload(size_t routes, Replay &replay)
+{
+    for (size_t i = 0; i < routes; i++)
+    {
+        string prefix = "10." + to_string(i >> 16 & 0xff) + "." + to_string(i >> 8 & 0xff) + "." + to_string(i & 0xff) + "/32";
+        vector<FieldValueTuple> values = {
+            { "nexthop", "192.168.0.1,192.168.0.2,192.168.0.3" },
+            { "ifname", "Ethernet0,Ethernet4,Ethernet8" },
+        };
+        replay.emplace_back("ROUTE_TABLE", KeyOpFieldsValuesTuple(prefix, SET_COMMAND, values));
+
+        if (i % 2 == 0)
+        {
+            vector<FieldValueTuple> update = { { "nexthop", "192.168.0.1,192.168.0.2" } };
+            replay.emplace_back("ROUTE_TABLE", KeyOpFieldsValuesTuple(prefix, SET_COMMAND, update));
+        }
+    }
+}
+
+/* The merge Orch::execute did before Consumer::addToSync, copying every tuple */
+static void copyToSync(Consumer &consumer, deque<KeyOpFieldsValuesTuple> &entries)
+{
+    for (auto entry: entries)
+    {
+        string key = kfvKey(entry);
+        string op  = kfvOp(entry);
+
+        if (consumer.m_toSync.find(key) == consumer.m_toSync.end() || op == DEL_COMMAND)
+        {
+           consumer.m_toSync[key] = entry;
+        }
+        else
+        {
+            KeyOpFieldsValuesTuple existing_data = consumer.m_toSync[key];
+
+            auto new_values = kfvFieldsValues(entry);
+            auto existing_values = kfvFieldsValues(existing_data);
+
+            for (auto it : new_values)
+            {
+                string field = fvField(it);
+                string value = fvValue(it);
+
+                auto iu = existing_values.begin();
+                while (iu != existing_values.end())
+                {
+                    string ofield = fvField(*iu);
+                    if (field == ofield)
+                        iu = existing_values.erase(iu);
+                    else
+                        iu++;
+                }
+                existing_values.push_back(FieldValueTuple(field, value));
+            }
+            consumer.m_toSync[key] = KeyOpFieldsValuesTuple(key, op, existing_values);
+        }
+    }
+}
+
+/*
+ * Replay the input in pops of gBatchSize entries per table. Every pop is
+ * merged into m_toSync and consumed the way doTask does, half of the pops
+ * are consumed later to exercise the merge of pending tasks.
+ */
+template<typename Merge>
+static size_t replay(const Replay &input, Merge merge, map<string, SyncMap> &result, double &seconds)
+{
+    map<string, Consumer> consumers;
+    map<string, deque<KeyOpFieldsValuesTuple>> pops;
+    size_t fields = 0;
+
+    auto consume = [&](Consumer &consumer)
+    {
+        auto it = consumer.m_toSync.begin();
+        while (it != consumer.m_toSync.end())
+        {
+            auto &t = it->second;
+            for (const auto &fv : kfvFieldsValues(t))
+                fields += fvValue(fv).size();
+            it = consumer.m_toSync.erase(it);
+        }
+    };
+
+    /* Build the pops outside of the measurement, they come from redis */
+    deque<pair<string, deque<KeyOpFieldsValuesTuple>>> batches;
+    for (const auto &entry : input)
+    {
+        auto &pop = pops[entry.first];
+        pop.push_back(entry.second);
+        if (pop.size() == (size_t)gBatchSize)
+        {
+            batches.emplace_back(entry.first, move(pop));
+            pop.clear();
+        }
+    }
+    for (auto &pop : pops)
+    {
+        if (!pop.second.empty())
+            batches.emplace_back(pop.first, move(pop.second));
+    }
+
+    size_t allocations = g_allocations;
+    auto start = chrono::steady_clock::now();
+
+    size_t n = 0;
+    for (auto &batch : batches)
+    {
+        auto it = consumers.find(batch.first);
+        if (it == consumers.end())
+            it = consumers.emplace(batch.first, Consumer(nullptr)).first;
+
+        merge(it->second, batch.second);
+        if (++n % 2 == 0)
+            consume(it->second);
+    }
+
+    seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    allocations = g_allocations - allocations;
+
+    for (auto &consumer : consumers)
+        result[consumer.first] = consumer.second.m_toSync;
+
+    EXPECT_GT(fields, 0UL);
+
+    return allocations;
+}
+
+/* Benchmark, run with --gtest_also_run_disabled_tests */
+TEST(Orch, DISABLED_replay_perf)
+{
+    Replay input;
+
+    const char *record = getenv("SWSS_REC");
+    if (record != nullptr)
+        loadRecord(record, input);
+    else
+        makeRouteDownload(50000, input);
+
+    ASSERT_FALSE(input.empty());
+
+    map<string, SyncMap> copied, moved;
+    double copySeconds, moveSeconds;
+
+    size_t copyAllocations = replay(input, copyToSync, copied, copySeconds);
+    size_t moveAllocations = replay(input,
+            [](Consumer &consumer, deque<KeyOpFieldsValuesTuple> &entries)
+            {
+                consumer.addToSync(entries);
+            },
+            moved, moveSeconds);
+
+    cout << "Replayed " << input.size() << " entries" << endl;
+    cout << "copy: " << (double)copyAllocations / (double)input.size() << " allocations/entry, "
+         << (double)input.size() / copySeconds << " entries/sec" << endl;
+    cout << "move: " << (double)moveAllocations / (double)input.size() << " allocations/entry, "
+         << (double)input.size() / moveSeconds << " entries/sec" << endl;
+
+    /* Both merges leave the same pending tasks, modulo the field order */
+    ASSERT_EQ(copied.size(), moved.size());
+    for (auto &table : copied)
+    {
+        auto &tasks = moved[table.first];
+        ASSERT_EQ(table.second.size(), tasks.size());
+        for (auto &task : table.second)
+        {
+            auto it = tasks.find(task.first);
+            ASSERT_NE(it, tasks.end());
+            EXPECT_EQ(kfvOp(task.second), kfvOp(it->second));
+
+            map<string, string> expected, actual;
+            for (auto &fv : kfvFieldsValues(task.second))
+                expected[fvField(fv)] = fvValue(fv);
+            for (auto &fv : kfvFieldsValues(it->second))
+                actual[fvField(fv)] = fvValue(fv);
+            EXPECT_EQ(expected, actual);
+        }
+    }
+
+    EXPECT_LT(moveAllocations, copyAllocations);
+}
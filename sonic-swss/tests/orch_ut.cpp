@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+#include "orch.h"
+
+using namespace std;
+using namespace swss;
+
+static map<string, string> fields(const KeyOpFieldsValuesTuple &t)
+{
+    map<string, string> result;
+
+    for (auto &fv : kfvFieldsValues(t))
+        result[fvField(fv)] = fvValue(fv);
+
+    return result;
+}
+
+TEST(Consumer, addToSync_merge)
+{
+    Consumer consumer(nullptr);
+
+    deque<KeyOpFieldsValuesTuple> entries = {
+        KeyOpFieldsValuesTuple("10.0.0.0/24", SET_COMMAND, { { "nexthop", "1.1.1.1" }, { "ifname", "Ethernet0" } }),
+        KeyOpFieldsValuesTuple("10.0.1.0/24", SET_COMMAND, { { "nexthop", "1.1.1.1" } }),
+        KeyOpFieldsValuesTuple("10.0.0.0/24", SET_COMMAND, { { "nexthop", "2.2.2.2" } }),
+        KeyOpFieldsValuesTuple("10.0.1.0/24", DEL_COMMAND, { }),
+    };
+
+    ASSERT_TRUE(consumer.addToSync(entries));
+    EXPECT_TRUE(entries.empty());
+    ASSERT_EQ(consumer.m_toSync.size(), 2UL);
+
+    auto &set = consumer.m_toSync["10.0.0.0/24"];
+    EXPECT_EQ(kfvOp(set), SET_COMMAND);
+    EXPECT_EQ(fields(set), (map<string, string>{ { "nexthop", "2.2.2.2" }, { "ifname", "Ethernet0" } }));
+
+    auto &del = consumer.m_toSync["10.0.1.0/24"];
+    EXPECT_EQ(kfvOp(del), DEL_COMMAND);
+    EXPECT_TRUE(kfvFieldsValues(del).empty());
+}
+
+TEST(Consumer, addToSync_del_then_set)
+{
+    Consumer consumer(nullptr);
+
+    deque<KeyOpFieldsValuesTuple> entries = {
+        KeyOpFieldsValuesTuple("10.0.0.0/24", DEL_COMMAND, { }),
+        KeyOpFieldsValuesTuple("10.0.0.0/24", SET_COMMAND, { { "nexthop", "2.2.2.2" } }),
+    };
+
+    /* The SET replaces the pending DEL */
+    ASSERT_TRUE(consumer.addToSync(entries));
+    EXPECT_TRUE(entries.empty());
+    ASSERT_EQ(consumer.m_toSync.size(), 1UL);
+
+    auto &set = consumer.m_toSync["10.0.0.0/24"];
+    EXPECT_EQ(kfvOp(set), SET_COMMAND);
+    EXPECT_EQ(fields(set), (map<string, string>{ { "nexthop", "2.2.2.2" } }));
+}
+
+TEST(Consumer, addToSync_delta_del_then_set)
+{
+    Consumer consumer(nullptr);
+    consumer.m_deltaPops = true;
+
+    deque<KeyOpFieldsValuesTuple> entries = {
+        KeyOpFieldsValuesTuple("10.0.0.0/24", DEL_COMMAND, { }),
+        KeyOpFieldsValuesTuple("10.0.0.0/24", SET_COMMAND, { { "nexthop", "2.2.2.2" } }),
+        KeyOpFieldsValuesTuple("10.0.1.0/24", SET_COMMAND, { { "nexthop", "1.1.1.1" } }),
+    };
+
+    /* The SET waits until doTask ran the DEL */
+    ASSERT_FALSE(consumer.addToSync(entries));
+    ASSERT_EQ(entries.size(), 2UL);
+    ASSERT_EQ(consumer.m_toSync.size(), 1UL);
+    EXPECT_EQ(kfvOp(consumer.m_toSync["10.0.0.0/24"]), DEL_COMMAND);
+
+    consumer.m_toSync.clear();
+
+    ASSERT_TRUE(consumer.addToSync(entries));
+    EXPECT_TRUE(entries.empty());
+    ASSERT_EQ(consumer.m_toSync.size(), 2UL);
+    EXPECT_EQ(kfvOp(consumer.m_toSync["10.0.0.0/24"]), SET_COMMAND);
+
+    /* A DEL still pending after doTask is replaced by the SET */
+    entries = {
+        KeyOpFieldsValuesTuple("10.0.1.0/24", DEL_COMMAND, { }),
+        KeyOpFieldsValuesTuple("10.0.1.0/24", SET_COMMAND, { { "nexthop", "3.3.3.3" } }),
+    };
+
+    ASSERT_FALSE(consumer.addToSync(entries));
+    ASSERT_EQ(entries.size(), 1UL);
+    EXPECT_EQ(kfvOp(consumer.m_toSync["10.0.1.0/24"]), DEL_COMMAND);
+
+    ASSERT_TRUE(consumer.addToSync(entries));
+    EXPECT_TRUE(entries.empty());
+
+    auto &set = consumer.m_toSync["10.0.1.0/24"];
+    EXPECT_EQ(kfvOp(set), SET_COMMAND);
+    EXPECT_EQ(fields(set), (map<string, string>{ { "nexthop", "3.3.3.3" } }));
+}
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "prefixtrie.h"
+
+using namespace std;
+using namespace swss;
+
+static vector<string> covered(PrefixTrie<int> &trie, const string &prefix)
+{
+    vector<string> result;
+
+    trie.forEachCovered(IpPrefix(prefix), [&](const IpPrefix &p, int &)
+    {
+        result.push_back(p.to_string());
+    });
+
+    sort(result.begin(), result.end());
+
+    return result;
+}
+
+static string longestMatch(PrefixTrie<int> &trie, const string &address)
+{
+    IpPrefix match;
+
+    if (trie.longestMatch(IpAddress(address), &match) == nullptr)
+    {
+        return "";
+    }
+
+    return match.to_string();
+}
+
+TEST(prefixtrie, insert_find_erase)
+{
+    PrefixTrie<int> trie;
+
+    trie.insert(IpPrefix("10.0.0.0/8"), 1);
+    trie.insert(IpPrefix("10.1.0.0/16"), 2);
+    trie.insert(IpPrefix("10.1.2.0/24"), 3);
+    trie.insert(IpPrefix("10.2.0.0/16"), 4);
+    trie.insert(IpPrefix("0.0.0.0/0"), 5);
+    trie.insert(IpPrefix("::/0"), 6);
+    trie.insert(IpPrefix("2001:db8::/32"), 7);
+
+    EXPECT_EQ(trie.size(), 7u);
+
+    /* Existing value is kept */
+    EXPECT_EQ(trie.insert(IpPrefix("10.1.0.0/16"), 20), 2);
+    EXPECT_EQ(trie.size(), 7u);
+
+    ASSERT_NE(trie.find(IpPrefix("10.1.2.0/24")), nullptr);
+    EXPECT_EQ(*trie.find(IpPrefix("10.1.2.0/24")), 3);
+    EXPECT_EQ(trie.find(IpPrefix("10.1.0.0/15")), nullptr);
+    EXPECT_EQ(trie.find(IpPrefix("10.1.2.0/25")), nullptr);
+    EXPECT_EQ(*trie.find(IpPrefix("::/0")), 6);
+
+    EXPECT_TRUE(trie.erase(IpPrefix("10.1.0.0/16")));
+    EXPECT_FALSE(trie.erase(IpPrefix("10.1.0.0/16")));
+    EXPECT_FALSE(trie.erase(IpPrefix("10.3.0.0/16")));
+    EXPECT_EQ(trie.size(), 6u);
+
+    EXPECT_EQ(*trie.find(IpPrefix("10.1.2.0/24")), 3);
+    EXPECT_EQ(trie.find(IpPrefix("10.1.0.0/16")), nullptr);
+}
+
+TEST(prefixtrie, longest_match)
+{
+    PrefixTrie<int> trie;
+
+    EXPECT_EQ(longestMatch(trie, "10.1.2.3"), "");
+
+    trie.insert(IpPrefix("0.0.0.0/0"));
+    trie.insert(IpPrefix("10.0.0.0/8"));
+    trie.insert(IpPrefix("10.1.0.0/16"));
+    trie.insert(IpPrefix("10.1.2.3/32"));
+    trie.insert(IpPrefix("::/0"));
+    trie.insert(IpPrefix("2001:db8::/32"));
+    trie.insert(IpPrefix("2001:db8::1/128"));
+
+    EXPECT_EQ(longestMatch(trie, "10.1.2.3"), "10.1.2.3/32");
+    EXPECT_EQ(longestMatch(trie, "10.1.2.4"), "10.1.0.0/16");
+    EXPECT_EQ(longestMatch(trie, "10.2.2.4"), "10.0.0.0/8");
+    EXPECT_EQ(longestMatch(trie, "11.0.0.1"), "0.0.0.0/0");
+    EXPECT_EQ(longestMatch(trie, "2001:db8::1"), "2001:db8::1/128");
+    EXPECT_EQ(longestMatch(trie, "2001:db8::2"), "2001:db8::/32");
+    EXPECT_EQ(longestMatch(trie, "2001:db9::2"), "::/0");
+
+    trie.erase(IpPrefix("10.1.0.0/16"));
+    EXPECT_EQ(longestMatch(trie, "10.1.2.4"), "10.0.0.0/8");
+
+    trie.erase(IpPrefix("0.0.0.0/0"));
+    EXPECT_EQ(longestMatch(trie, "11.0.0.1"), "");
+}
+
+TEST(prefixtrie, covered)
+{
+    PrefixTrie<int> trie;
+
+    trie.insert(IpPrefix("10.1.2.3"));
+    trie.insert(IpPrefix("10.1.2.4"));
+    trie.insert(IpPrefix("10.1.3.4"));
+    trie.insert(IpPrefix("10.2.0.1"));
+    trie.insert(IpPrefix("192.168.0.1"));
+    trie.insert(IpPrefix("2001:db8::1"));
+
+    EXPECT_EQ(covered(trie, "10.1.2.0/24"), vector<string>({ "10.1.2.3/32", "10.1.2.4/32" }));
+    EXPECT_EQ(covered(trie, "10.1.0.0/16"), vector<string>({ "10.1.2.3/32", "10.1.2.4/32", "10.1.3.4/32" }));
+    EXPECT_EQ(covered(trie, "10.1.2.3/32"), vector<string>({ "10.1.2.3/32" }));
+    EXPECT_EQ(covered(trie, "10.1.2.5/32"), vector<string>());
+    EXPECT_EQ(covered(trie, "10.3.0.0/16"), vector<string>());
+    EXPECT_EQ(covered(trie, "0.0.0.0/0").size(), 5u);
+    EXPECT_EQ(covered(trie, "::/0"), vector<string>({ "2001:db8::1/128" }));
+}
+
+/* Compare with linear scan on random prefixes */
+TEST(prefixtrie, random)
+{
+    mt19937 rng(42);
+
+    PrefixTrie<int> trie;
+    map<IpPrefix, int> prefixes;
+
+    for (int i = 0; i < 5000; i++)
+    {
+        uint32_t addr = htonl(rng() & 0xff0fff00);
+        int mask = (int)(rng() % 33);
+
+        IpPrefix prefix(addr & (mask ? htonl(0xffffffffu << (32 - mask)) : 0), mask);
+
+        if (rng() % 4 == 0 && !prefixes.empty())
+        {
+            auto it = prefixes.begin();
+            advance(it, rng() % prefixes.size());
+
+            EXPECT_TRUE(trie.erase(it->first));
+            prefixes.erase(it);
+            continue;
+        }
+
+        if (prefixes.emplace(prefix, i).second)
+        {
+            trie.insert(prefix, i);
+        }
+    }
+
+    EXPECT_EQ(trie.size(), prefixes.size());
+
+    for (int i = 0; i < 2000; i++)
+    {
+        IpAddress address(htonl(rng() & 0xff0fffff));
+
+        const IpPrefix *best = nullptr;
+
+        for (const auto &p : prefixes)
+        {
+            if (p.first.isAddressInSubnet(address) &&
+                    (best == nullptr || best->getMaskLength() < p.first.getMaskLength()))
+            {
+                best = &p.first;
+            }
+        }
+
+        IpPrefix match;
+        int *value = trie.longestMatch(address, &match);
+
+        ASSERT_EQ(value == nullptr, best == nullptr);
+
+        if (best != nullptr)
+        {
+            EXPECT_EQ(best->getMaskLength(), match.getMaskLength());
+            EXPECT_EQ(*value, prefixes[match]);
+        }
+
+        IpPrefix within(address.getV4Addr(), (int)(rng() % 33));
+
+        size_t expected = 0, count = 0;
+
+        for (const auto &p : prefixes)
+        {
+            if (p.first.getMaskLength() >= within.getMaskLength() && within.isAddressInSubnet(p.first.getIp()))
+            {
+                expected++;
+            }
+        }
+
+        trie.forEachCovered(within, [&](const IpPrefix &, int &) { count++; });
+
+        EXPECT_EQ(count, expected);
+    }
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <malloc.h>
+#include <set>
+#include "prefixtrie.h"
+#include "routetable.h"
+
+using namespace std;
+using namespace swss;
+
+TEST(RouteTable, packed_prefix)
+{
+    for (auto str : { "10.1.2.0/24", "0.0.0.0/0", "10.1.2.3/32", "2001:db8::/32", "::/0", "2001:db8::1/128" })
+    {
+        IpPrefix prefix(str);
+        PackedPrefix packed(prefix);
+
+        EXPECT_EQ(packed.toIpPrefix(), prefix);
+        EXPECT_EQ(packed, PackedPrefix(IpPrefix(str)));
+        EXPECT_EQ(PackedPrefixHash()(packed), PackedPrefixHash()(PackedPrefix(IpPrefix(str))));
+    }
+
+    EXPECT_FALSE(PackedPrefix(IpPrefix("10.1.2.0/24")) == PackedPrefix(IpPrefix("10.1.2.0/25")));
+    EXPECT_FALSE(PackedPrefix(IpPrefix("0.0.0.0/0")) == PackedPrefix(IpPrefix("::/0")));
+}
+
+TEST(RouteTable, next_hop_set_pool)
+{
+    NextHopSetPool pool;
+
+    {
+        NextHopSetRef a = pool.intern(IpAddresses("10.0.0.2,10.0.0.1"));
+        NextHopSetRef b = pool.intern(IpAddresses("10.0.0.1,10.0.0.2"));
+        NextHopSetRef c = pool.intern(IpAddresses("10.0.0.1"));
+
+        EXPECT_EQ(pool.size(), 2u);
+        EXPECT_TRUE(a == b);
+        EXPECT_TRUE(a != c);
+
+        EXPECT_EQ(a->size(), 2u);
+        EXPECT_EQ(a->to_string(), "10.0.0.1,10.0.0.2");
+        EXPECT_EQ(a->to_string(), IpAddresses("10.0.0.1,10.0.0.2").to_string());
+        EXPECT_TRUE(a->equals(IpAddresses("10.0.0.2,10.0.0.1")));
+        EXPECT_FALSE(a->equals(IpAddresses("10.0.0.2")));
+        EXPECT_TRUE(a->contains(IpAddress("10.0.0.2")));
+        EXPECT_FALSE(a->contains(IpAddress("10.0.0.3")));
+        EXPECT_TRUE(c->isSubsetOf(*a));
+        EXPECT_TRUE(a->isSubsetOf(*a));
+        EXPECT_FALSE(a->isSubsetOf(*c));
+        EXPECT_EQ(a->toIpAddresses(), IpAddresses("10.0.0.1,10.0.0.2"));
+
+        EXPECT_TRUE(pool.find(IpAddresses("10.0.0.1")) == c);
+        EXPECT_FALSE(pool.find(IpAddresses("10.0.0.3")));
+
+        /* Set is freed with its last reference */
+        c.reset();
+        EXPECT_EQ(pool.size(), 1u);
+        EXPECT_FALSE(pool.find(IpAddresses("10.0.0.1")));
+
+        NextHopSetRef empty = pool.intern(IpAddresses());
+        EXPECT_TRUE(empty->empty());
+        EXPECT_EQ(pool.size(), 2u);
+
+        unordered_map<NextHopSetRef, int, NextHopSetRefHash> groups;
+        groups[a] = 1;
+        a.reset();
+        EXPECT_EQ(groups.count(b), 1u);
+    }
+
+    EXPECT_EQ(pool.size(), 0u);
+}
+
+static size_t heapInUse()
+{
+#if __GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33)
+    return mallinfo2().uordblks;
+#else
+    return (size_t)(unsigned)mallinfo().uordblks;
+#endif
+}
+
+/* i-th route of a full table, /24 and /32 prefixes spread over 64 ECMP groups */
+static IpPrefix makePrefix(size_t i)
+{
+    uint32_t addr = (uint32_t)(0x0a000000 + (i << 8));
+    int mask = 24;
+
+    if (i % 4 == 0)
+    {
+        addr += 1;
+        mask = 32;
+    }
+
+    return IpPrefix(htonl(addr), mask);
+}
+
+static IpAddresses makeNextHops(size_t i)
+{
+    IpAddresses ips;
+
+    for (size_t j = 0; j < 4; j++)
+    {
+        ips.add(IpAddress(htonl((uint32_t)(0xc0a80000 + ((i + j * 7) % 64)))));
+    }
+
+    return ips;
+}
+
+/*
+ * Memory per route and full table load time of the route table against the
+ * ordered maps it replaced, both with the prefix trie of RouteOrch.
+ *
+ * Benchmark, run with --gtest_also_run_disabled_tests.
+ */
+TEST(RouteTable, DISABLED_load_perf)
+{
+    const size_t count = 500000;
+
+    vector<IpPrefix> prefixes;
+    vector<IpAddresses> nextHops;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        prefixes.push_back(makePrefix(i));
+        nextHops.push_back(makeNextHops(i % 997));
+    }
+
+    size_t mapBytes, tableBytes;
+    double mapSeconds, tableSeconds;
+
+    {
+        size_t heap = heapInUse();
+        auto start = chrono::steady_clock::now();
+
+        NextHopSetPool pool;
+        RouteTable routes;
+        PrefixTrie<RouteTable::value_type *> trie;
+        unordered_map<NextHopSetRef, int, NextHopSetRefHash> groups;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            PackedPrefix prefix(prefixes[i]);
+
+            auto it = routes.find(prefix);
+            if (it != routes.end() && it->second->equals(nextHops[i]))
+            {
+                continue;
+            }
+
+            NextHopSetRef set = pool.intern(nextHops[i]);
+            groups[set]++;
+            trie.insert(prefixes[i], &*routes.emplace(prefix, set).first);
+        }
+
+        tableSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        tableBytes = heapInUse() - heap;
+
+        EXPECT_EQ(routes.size(), count);
+        EXPECT_EQ(trie.size(), count);
+        EXPECT_EQ(pool.size(), set<IpAddresses>(nextHops.begin(), nextHops.end()).size());
+
+        for (size_t i = 0; i < count; i += 1009)
+        {
+            auto it = routes.find(PackedPrefix(prefixes[i]));
+            ASSERT_NE(it, routes.end());
+            EXPECT_TRUE(it->second->equals(nextHops[i]));
+            EXPECT_EQ(*trie.find(prefixes[i]), &*it);
+        }
+    }
+
+    {
+        size_t heap = heapInUse();
+        auto start = chrono::steady_clock::now();
+
+        map<IpPrefix, IpAddresses> routes;
+        PrefixTrie<map<IpPrefix, IpAddresses>::iterator> trie;
+        map<IpAddresses, int> groups;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            groups[nextHops[i]]++;
+            trie.insert(prefixes[i], routes.emplace(prefixes[i], nextHops[i]).first);
+        }
+
+        mapSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        mapBytes = heapInUse() - heap;
+
+        EXPECT_EQ(routes.size(), count);
+    }
+
+    cout << "Loaded " << count << " routes" << endl;
+    cout << "map:   " << (double)mapBytes / (double)count << " bytes/route, "
+         << (double)count / mapSeconds << " routes/sec" << endl;
+    cout << "table: " << (double)tableBytes / (double)count << " bytes/route, "
+         << (double)count / tableSeconds << " routes/sec" << endl;
+}